@@ -0,0 +1,174 @@
+#include "bench.h"
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace atlas::bench {
+
+namespace {
+
+constexpr uint64_t kMaxIterations = 1000000000ull;
+
+std::string Escape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+std::string CompilerName() {
+    std::ostringstream oss;
+#if defined(__clang__)
+    oss << "clang " << __clang_major__ << "." << __clang_minor__;
+#elif defined(__GNUC__)
+    oss << "gcc " << __GNUC__ << "." << __GNUC_MINOR__;
+#elif defined(_MSC_VER)
+    oss << "msvc " << _MSC_VER;
+#else
+    oss << "unknown";
+#endif
+    return oss.str();
+}
+
+std::string UtcTimestamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm tm{};
+#if defined(_WIN32)
+    gmtime_s(&tm, &now);
+#else
+    gmtime_r(&now, &tm);
+#endif
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    return buf;
+}
+
+} // namespace
+
+void State::SetCounter(const std::string& name, double value) {
+    for (auto& counter : m_counters) {
+        if (counter.first == name) {
+            counter.second = value;
+            return;
+        }
+    }
+    m_counters.emplace_back(name, value);
+}
+
+void Registry::Add(const std::string& name, BenchmarkFn fn, std::vector<size_t> sizes) {
+    m_benchmarks.push_back({name, std::move(fn), std::move(sizes)});
+}
+
+std::vector<Result> Registry::Run(const RunOptions& options) const {
+    std::vector<Result> results;
+    for (const auto& bench : m_benchmarks) {
+        for (size_t size : bench.sizes) {
+            std::string fullName = bench.name + "/" + std::to_string(size);
+            if (!options.filter.empty() && fullName.find(options.filter) == std::string::npos) {
+                continue;
+            }
+
+            // Grow the iteration count until one run takes minSeconds;
+            // that run is the first repetition.
+            uint64_t iterations = 1;
+            std::vector<double> nsPerOp;
+            State last(size, iterations);
+            for (;;) {
+                State state(size, iterations);
+                bench.fn(state);
+                double elapsed = state.ElapsedSeconds();
+                if (elapsed >= options.minSeconds || iterations >= kMaxIterations) {
+                    nsPerOp.push_back(elapsed * 1e9 / static_cast<double>(iterations));
+                    last = std::move(state);
+                    break;
+                }
+                double scale = elapsed > 0.0 ? 1.4 * options.minSeconds / elapsed : 10.0;
+                scale = std::clamp(scale, 2.0, 10.0);
+                iterations = std::min(kMaxIterations,
+                                      static_cast<uint64_t>(static_cast<double>(iterations) * scale));
+            }
+            for (int rep = 1; rep < options.repetitions; ++rep) {
+                State state(size, iterations);
+                bench.fn(state);
+                nsPerOp.push_back(state.ElapsedSeconds() * 1e9 / static_cast<double>(iterations));
+            }
+
+            std::vector<double> sorted = nsPerOp;
+            std::sort(sorted.begin(), sorted.end());
+
+            Result result;
+            result.name = bench.name;
+            result.size = size;
+            result.iterations = iterations;
+            result.nsPerOp = sorted[sorted.size() / 2];
+            result.nsPerOpMin = sorted.front();
+            if (last.ItemsPerIteration() > 0.0 && result.nsPerOp > 0.0) {
+                result.itemsPerSecond = last.ItemsPerIteration() * 1e9 / result.nsPerOp;
+            }
+            result.itemLabel = last.ItemLabel();
+            result.counters = last.Counters();
+
+            std::cout << std::left << std::setw(40) << fullName << std::right
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(14) << result.nsPerOp << " ns/op"
+                      << std::setw(12) << iterations << " iters";
+            if (result.itemsPerSecond > 0.0) {
+                std::cout << std::setprecision(3) << std::setw(12)
+                          << result.itemsPerSecond / 1e6 << " M " << result.itemLabel << "/s";
+            }
+            std::cout << std::endl;
+
+            results.push_back(std::move(result));
+        }
+    }
+    return results;
+}
+
+bool WriteJson(const std::string& path, const std::vector<Result>& results,
+               const RunOptions& options, const std::string& label) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+
+    out << std::setprecision(6);
+    out << "{\n  \"context\": {\n";
+    out << "    \"label\": \"" << Escape(label) << "\",\n";
+    out << "    \"date\": \"" << UtcTimestamp() << "\",\n";
+    out << "    \"compiler\": \"" << Escape(CompilerName()) << "\",\n";
+#if defined(NDEBUG)
+    out << "    \"build\": \"release\",\n";
+#else
+    out << "    \"build\": \"debug\",\n";
+#endif
+    out << "    \"min_time_s\": " << options.minSeconds << ",\n";
+    out << "    \"repetitions\": " << options.repetitions << "\n";
+    out << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << Escape(r.name) << "\", \"size\": " << r.size
+            << ", \"iterations\": " << r.iterations
+            << ", \"ns_per_op\": " << r.nsPerOp
+            << ", \"ns_per_op_min\": " << r.nsPerOpMin
+            << ", \"items_per_second\": " << r.itemsPerSecond
+            << ", \"item\": \"" << Escape(r.itemLabel) << "\"";
+        if (!r.counters.empty()) {
+            out << ", \"counters\": {";
+            for (size_t c = 0; c < r.counters.size(); ++c) {
+                out << (c == 0 ? "" : ", ") << "\"" << Escape(r.counters[c].first)
+                    << "\": " << r.counters[c].second;
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.good();
+}
+
+} // namespace atlas::bench
@@ -0,0 +1,157 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace atlas::bench {
+
+/// Keeps `value` (and the work that produced it) from being optimised away.
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+    static const volatile void* s_sink;
+    s_sink = &value;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+/// Sanity check on what a benchmark computed; a benchmark that stopped
+/// doing its work would otherwise just report a speed-up.
+inline void Expect(bool ok, const char* what) {
+    if (ok) return;
+    std::fprintf(stderr, "benchmark check failed: %s\n", what);
+    std::abort();
+}
+
+/**
+ * Passed to a benchmark body. Setup before the loop is not timed:
+ *
+ *   void BM_Thing(State& state) {
+ *       Thing thing(state.Size());
+ *       while (state.KeepRunning()) {
+ *           DoNotOptimize(thing.Work());
+ *       }
+ *       state.SetItemsPerIteration(state.Size());
+ *   }
+ *
+ * Work that must not be timed inside the loop goes between
+ * PauseTiming() and ResumeTiming().
+ */
+class State {
+public:
+    State(size_t size, uint64_t iterations) : m_size(size), m_iterations(iterations) {}
+
+    /// Input size this run was registered with.
+    size_t Size() const { return m_size; }
+
+    bool KeepRunning() {
+        if (m_done == 0 && !m_started) {
+            m_started = true;
+            ResumeTiming();
+        }
+        if (m_done < m_iterations) {
+            ++m_done;
+            return true;
+        }
+        PauseTiming();
+        return false;
+    }
+
+    void PauseTiming() {
+        if (!m_running) return;
+        m_elapsed += Clock::now() - m_start;
+        m_running = false;
+    }
+
+    void ResumeTiming() {
+        if (m_running) return;
+        m_start = Clock::now();
+        m_running = true;
+    }
+
+    /// Items (entities, bytes, instructions...) one iteration handles.
+    void SetItemsPerIteration(double items) { m_itemsPerIteration = items; }
+
+    /// Name of the items, for the report ("entities", "bytes", ...).
+    void SetItemLabel(const std::string& label) { m_itemLabel = label; }
+
+    /// Reported alongside the timings, e.g. an encoded size.
+    void SetCounter(const std::string& name, double value);
+
+    uint64_t Iterations() const { return m_iterations; }
+    double ElapsedSeconds() const { return std::chrono::duration<double>(m_elapsed).count(); }
+    double ItemsPerIteration() const { return m_itemsPerIteration; }
+    const std::string& ItemLabel() const { return m_itemLabel; }
+    const std::vector<std::pair<std::string, double>>& Counters() const { return m_counters; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    size_t m_size;
+    uint64_t m_iterations;
+    uint64_t m_done = 0;
+    bool m_started = false;
+    bool m_running = false;
+    Clock::time_point m_start;
+    Clock::duration m_elapsed{0};
+    double m_itemsPerIteration = 0.0;
+    std::string m_itemLabel = "items";
+    std::vector<std::pair<std::string, double>> m_counters;
+};
+
+using BenchmarkFn = std::function<void(State&)>;
+
+struct Benchmark {
+    std::string name;           ///< "<area>/<what>", e.g. "ecs/view_each"
+    BenchmarkFn fn;
+    std::vector<size_t> sizes;  ///< One run per size
+};
+
+struct RunOptions {
+    double minSeconds = 0.2;    ///< Grow the iteration count until a run takes this long
+    int repetitions = 3;        ///< Timed runs per size; the median is reported
+    std::string filter;         ///< Substring of "<name>/<size>" to run, empty for all
+};
+
+/// One benchmark at one size.
+struct Result {
+    std::string name;
+    size_t size = 0;
+    uint64_t iterations = 0;
+    double nsPerOp = 0.0;       ///< Median over the repetitions
+    double nsPerOpMin = 0.0;
+    double itemsPerSecond = 0.0;
+    std::string itemLabel;
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+class Registry {
+public:
+    void Add(const std::string& name, BenchmarkFn fn, std::vector<size_t> sizes);
+
+    const std::vector<Benchmark>& Benchmarks() const { return m_benchmarks; }
+
+    /// Run everything matching `options.filter`, printing a line per result.
+    std::vector<Result> Run(const RunOptions& options) const;
+
+private:
+    std::vector<Benchmark> m_benchmarks;
+};
+
+/// Write results as JSON, for tools/bench_compare.py. `label` names the
+/// run (typically the commit it was built from).
+bool WriteJson(const std::string& path, const std::vector<Result>& results,
+               const RunOptions& options, const std::string& label);
+
+} // namespace atlas::bench
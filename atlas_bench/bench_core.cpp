@@ -0,0 +1,52 @@
+#include "bench.h"
+#include "../engine/core/EventBus.h"
+
+using namespace atlas::bench;
+
+namespace {
+
+/// One event to `Size()` subscribers of its type.
+void BM_EventBusPublish(State& state) {
+    atlas::EventBus bus;
+    int64_t received = 0;
+    for (size_t i = 0; i < state.Size(); ++i) {
+        bus.Subscribe("DAMAGE", [&received](const atlas::Event& e) { received += e.intParam; });
+    }
+    // Listeners of other types must not cost anything
+    bus.Subscribe("SHIELD_DOWN", [&received](const atlas::Event&) { --received; });
+
+    atlas::Event event{"DAMAGE", 42, 1, 12.5, ""};
+    while (state.KeepRunning()) {
+        bus.Publish(event);
+    }
+    DoNotOptimize(received);
+    Expect(received == static_cast<int64_t>(state.Iterations() * state.Size()),
+           "every subscriber receives every event");
+    state.SetItemsPerIteration(static_cast<double>(state.Size()));
+    state.SetItemLabel("deliveries");
+}
+
+/// `Size()` queued events, dispatched by one Flush.
+void BM_EventBusEnqueueFlush(State& state) {
+    atlas::EventBus bus;
+    int64_t received = 0;
+    bus.Subscribe("DAMAGE", [&received](const atlas::Event& e) { received += e.intParam; });
+
+    atlas::Event event{"DAMAGE", 42, 1, 12.5, ""};
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < state.Size(); ++i) bus.Enqueue(event);
+        bus.Flush();
+    }
+    DoNotOptimize(received);
+    Expect(received == static_cast<int64_t>(state.Iterations() * state.Size()),
+           "flush delivers every queued event");
+    state.SetItemsPerIteration(static_cast<double>(state.Size()));
+    state.SetItemLabel("events");
+}
+
+} // namespace
+
+void register_core_benchmarks(Registry& registry) {
+    registry.Add("core/event_bus_publish", BM_EventBusPublish, {1, 8, 64});
+    registry.Add("core/event_bus_enqueue_flush", BM_EventBusEnqueueFlush, {16, 256, 4096});
+}
@@ -0,0 +1,121 @@
+#include "bench.h"
+#include "../engine/ecs/ECS.h"
+
+using namespace atlas::bench;
+using atlas::ecs::EntityID;
+using atlas::ecs::World;
+
+namespace {
+
+struct BenchPosition {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+struct BenchVelocity {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+constexpr uint32_t kPositionTag = 1;
+constexpr uint32_t kVelocityTag = 2;
+
+std::vector<EntityID> Populate(World& world, size_t count) {
+    world.RegisterComponent<BenchPosition>(kPositionTag);
+    world.RegisterComponent<BenchVelocity>(kVelocityTag);
+    std::vector<EntityID> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        EntityID id = world.CreateEntity();
+        float f = static_cast<float>(i);
+        world.AddComponent(id, BenchPosition{f, f * 0.5f, 0.0f});
+        // Every fourth entity is static, so views have something to skip
+        if (i % 4 != 0) world.AddComponent(id, BenchVelocity{1.0f, 0.0f, -1.0f});
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+void BM_CreateAdd(State& state) {
+    const size_t count = state.Size();
+    while (state.KeepRunning()) {
+        World world;
+        Populate(world, count);
+        DoNotOptimize(world.EntityCount());
+    }
+    state.SetItemsPerIteration(static_cast<double>(count));
+    state.SetItemLabel("entities");
+}
+
+void BM_GetComponent(State& state) {
+    World world;
+    std::vector<EntityID> ids = Populate(world, state.Size());
+    float sum = 0.0f;
+    while (state.KeepRunning()) {
+        for (EntityID id : ids) {
+            sum += world.GetComponent<BenchPosition>(id)->x;
+        }
+        DoNotOptimize(sum);
+    }
+    state.SetItemsPerIteration(static_cast<double>(ids.size()));
+    state.SetItemLabel("lookups");
+}
+
+void BM_ViewEach(State& state) {
+    World world;
+    Populate(world, state.Size());
+    size_t visited = 0;
+    while (state.KeepRunning()) {
+        visited = 0;
+        world.View<BenchPosition, BenchVelocity>().Each(
+            [&](EntityID, BenchPosition& p, const BenchVelocity& v) {
+                p.x += v.x * 0.016f;
+                p.y += v.y * 0.016f;
+                p.z += v.z * 0.016f;
+                ++visited;
+            });
+        DoNotOptimize(visited);
+    }
+    Expect(visited == state.Size() - (state.Size() + 3) / 4, "view visits moving entities only");
+    state.SetItemsPerIteration(static_cast<double>(visited));
+    state.SetItemLabel("entities");
+}
+
+void BM_Serialize(State& state) {
+    World world;
+    Populate(world, state.Size());
+    std::vector<uint8_t> bytes;
+    while (state.KeepRunning()) {
+        world.SerializeInto(bytes);
+        DoNotOptimize(bytes.data());
+    }
+    state.SetItemsPerIteration(static_cast<double>(state.Size()));
+    state.SetItemLabel("entities");
+    state.SetCounter("bytes", static_cast<double>(bytes.size()));
+}
+
+void BM_Deserialize(State& state) {
+    World source;
+    Populate(source, state.Size());
+    std::vector<uint8_t> bytes = source.Serialize();
+
+    World world;
+    world.RegisterComponent<BenchPosition>(kPositionTag);
+    world.RegisterComponent<BenchVelocity>(kVelocityTag);
+    bool ok = true;
+    while (state.KeepRunning()) {
+        ok = world.Deserialize(bytes) && ok;
+    }
+    Expect(ok && world.EntityCount() == state.Size(), "deserialize restores every entity");
+    state.SetItemsPerIteration(static_cast<double>(state.Size()));
+    state.SetItemLabel("entities");
+}
+
+} // namespace
+
+void register_ecs_benchmarks(Registry& registry) {
+    const std::vector<size_t> sizes = {100, 1000, 10000, 100000};
+    registry.Add("ecs/create_add", BM_CreateAdd, sizes);
+    registry.Add("ecs/get_component", BM_GetComponent, sizes);
+    registry.Add("ecs/view_each", BM_ViewEach, sizes);
+    registry.Add("ecs/serialize", BM_Serialize, sizes);
+    registry.Add("ecs/deserialize", BM_Deserialize, sizes);
+}
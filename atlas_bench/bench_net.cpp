@@ -0,0 +1,135 @@
+#include "bench.h"
+#include "../engine/net/DeltaCompression.h"
+#include "../engine/net/JitterBuffer.h"
+#include "../engine/net/LagCompensation.h"
+
+using namespace atlas::bench;
+using namespace atlas::net;
+
+namespace {
+
+std::vector<EntitySnapshot> MakeSnapshots(size_t count) {
+    std::vector<EntitySnapshot> snaps(count);
+    for (size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        snaps[i].entityId = static_cast<uint32_t>(i + 1);
+        snaps[i].posX = f * 10.0f;
+        snaps[i].posY = 100.0f;
+        snaps[i].posZ = -f * 5.0f;
+        snaps[i].velX = (i % 3 == 0) ? 0.0f : 12.5f;
+        snaps[i].velZ = (i % 5 == 0) ? 0.0f : -3.0f;
+        snaps[i].rotYaw = static_cast<float>(i % 360);
+    }
+    return snaps;
+}
+
+/// One server tick: moving entities advance, static ones do not.
+void Step(std::vector<EntitySnapshot>& snaps, uint32_t tick) {
+    for (auto& s : snaps) {
+        s.tick = tick;
+        s.posX += s.velX * 0.05f;
+        s.posZ += s.velZ * 0.05f;
+    }
+}
+
+void BM_DeltaEncode(State& state) {
+    DeltaCompression codec;
+    std::vector<EntitySnapshot> snaps = MakeSnapshots(state.Size());
+    uint32_t tick = 0;
+    size_t entries = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        Step(snaps, ++tick);
+        state.ResumeTiming();
+        CompressedFrame frame = codec.Encode(snaps);
+        entries = frame.entries.size();
+        DoNotOptimize(frame.entries.data());
+    }
+    Expect(entries <= snaps.size(), "encode emits at most one entry per entity");
+    state.SetItemsPerIteration(static_cast<double>(snaps.size()));
+    state.SetItemLabel("entities");
+}
+
+void BM_DeltaDecode(State& state) {
+    // Two keyframe intervals of frames, so cycling through them always
+    // decodes deltas against the keyframe they were encoded against.
+    DeltaCompression encoder;
+    std::vector<EntitySnapshot> snaps = MakeSnapshots(state.Size());
+    std::vector<CompressedFrame> frames;
+    for (uint32_t tick = 1; tick <= 2 * encoder.KeyframeInterval(); ++tick) {
+        Step(snaps, tick);
+        frames.push_back(encoder.Encode(snaps));
+    }
+
+    DeltaCompression decoder;
+    size_t next = 0;
+    size_t decoded = 0;
+    while (state.KeepRunning()) {
+        std::vector<EntitySnapshot> out = decoder.Decode(frames[next]);
+        decoded = out.size();
+        DoNotOptimize(out.data());
+        next = (next + 1) % frames.size();
+    }
+    Expect(decoded > 0, "decode produces snapshots");
+    state.SetItemsPerIteration(static_cast<double>(snaps.size()));
+    state.SetItemLabel("entities");
+}
+
+void BM_JitterPushFlush(State& state) {
+    const size_t count = state.Size();
+    JitterBuffer buffer(0.05f, count, true);
+    std::vector<uint8_t> payload(64, 0xAB);
+    uint32_t tick = 0;
+    float now = 0.0f;
+    size_t flushed = 0;
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < count; ++i) {
+            // Deterministic +-7 ms jitter around a 50 ms send interval
+            float jitter = static_cast<float>(static_cast<int>((tick * 2654435761u) >> 28) - 8) * 0.001f;
+            now += 0.05f;
+            buffer.Push(++tick, now + jitter, payload);
+        }
+        flushed = buffer.Flush(now + 1.0f).size();
+        DoNotOptimize(flushed);
+        now += 1.0f;
+    }
+    Expect(flushed == count, "flush drains every buffered packet");
+    state.SetItemsPerIteration(static_cast<double>(count));
+    state.SetItemLabel("packets");
+}
+
+void BM_LagGetStateAtTick(State& state) {
+    const size_t count = state.Size();
+    constexpr uint32_t kTicks = 64;
+    LagCompensation lag(kTicks);
+    std::vector<EntitySnapshot> snaps = MakeSnapshots(count);
+    for (uint32_t tick = 1; tick <= kTicks; ++tick) {
+        Step(snaps, tick);
+        for (const auto& s : snaps) lag.StoreSnapshot(s);
+    }
+
+    // Rewind to between two stored ticks, as a shot fired with 20.5 ticks of latency
+    const float rewindTick = static_cast<float>(kTicks) - 20.5f;
+    size_t valid = 0;
+    while (state.KeepRunning()) {
+        valid = 0;
+        for (const auto& s : snaps) {
+            InterpolatedState st = lag.GetStateAtTick(s.entityId, rewindTick);
+            valid += st.valid ? 1 : 0;
+            DoNotOptimize(st);
+        }
+    }
+    Expect(valid == count, "every entity has history at the rewind tick");
+    state.SetItemsPerIteration(static_cast<double>(count));
+    state.SetItemLabel("lookups");
+}
+
+} // namespace
+
+void register_net_benchmarks(Registry& registry) {
+    const std::vector<size_t> entities = {64, 512, 4096};
+    registry.Add("net/delta_encode", BM_DeltaEncode, entities);
+    registry.Add("net/delta_decode", BM_DeltaDecode, entities);
+    registry.Add("net/jitter_push_flush", BM_JitterPushFlush, {16, 64, 256});
+    registry.Add("net/lag_get_state_at_tick", BM_LagGetStateAtTick, entities);
+}
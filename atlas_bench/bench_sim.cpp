@@ -0,0 +1,44 @@
+#include "bench.h"
+#include "../engine/sim/StateHasher.h"
+
+using namespace atlas::bench;
+using atlas::sim::HashBackend;
+using atlas::sim::StateHasher;
+
+namespace {
+
+void AdvanceTick(State& state, HashBackend backend) {
+    std::vector<uint8_t> world(state.Size());
+    for (size_t i = 0; i < world.size(); ++i) {
+        world[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    std::vector<uint8_t> inputs(32, 0x5A);
+
+    StateHasher hasher;
+    hasher.SetBackend(backend);
+    hasher.Reset(0x4A7A5);
+    uint64_t tick = 0;
+    while (state.KeepRunning()) {
+        if ((++tick & 4095) == 0) {
+            // Keep the history (one entry per tick) from growing without bound
+            state.PauseTiming();
+            hasher.Reset(0x4A7A5);
+            state.ResumeTiming();
+        }
+        hasher.AdvanceTick(tick, world.data(), world.size(), inputs.data(), inputs.size());
+        DoNotOptimize(hasher.CurrentHash());
+    }
+    state.SetItemsPerIteration(static_cast<double>(world.size() + inputs.size()));
+    state.SetItemLabel("bytes");
+}
+
+void BM_StateHasherFast(State& state) { AdvanceTick(state, HashBackend::Fast); }
+void BM_StateHasherFnv(State& state) { AdvanceTick(state, HashBackend::FNV1a); }
+
+} // namespace
+
+void register_sim_benchmarks(Registry& registry) {
+    const std::vector<size_t> stateBytes = {256, 4096, 65536, 1 << 20};
+    registry.Add("sim/state_hasher_advance_fast", BM_StateHasherFast, stateBytes);
+    registry.Add("sim/state_hasher_advance_fnv1a", BM_StateHasherFnv, stateBytes);
+}
@@ -0,0 +1,41 @@
+#include "bench.h"
+#include "../engine/ui/UILayoutSolver.h"
+
+using namespace atlas::bench;
+using namespace atlas::ui;
+
+namespace {
+
+void Solve(State& state, LayoutDirection direction) {
+    UILayoutSolver solver;
+    for (size_t i = 0; i < state.Size(); ++i) {
+        UIConstraint c;
+        c.minWidth = 8 + static_cast<int32_t>(i % 5) * 4;
+        c.minHeight = 8;
+        c.preferredWidth = 40 + static_cast<int32_t>(i % 7) * 10;
+        c.preferredHeight = 24 + static_cast<int32_t>(i % 3) * 8;
+        if (i % 4 == 0) c.maxWidth = 120;
+        c.weight = 1.0f + static_cast<float>(i % 3);
+        solver.AddEntry(static_cast<uint32_t>(i + 1), c);
+    }
+
+    const UILayoutRect bounds{0, 0, 1920, 1080};
+    while (state.KeepRunning()) {
+        solver.Solve(bounds, direction);
+        DoNotOptimize(solver.Entries().data());
+    }
+    Expect(solver.GetResolved(1) != nullptr, "solver resolves its entries");
+    state.SetItemsPerIteration(static_cast<double>(state.Size()));
+    state.SetItemLabel("widgets");
+}
+
+void BM_SolveHorizontal(State& state) { Solve(state, LayoutDirection::Horizontal); }
+void BM_SolveVertical(State& state) { Solve(state, LayoutDirection::Vertical); }
+
+} // namespace
+
+void register_ui_benchmarks(Registry& registry) {
+    const std::vector<size_t> widgets = {8, 64, 512};
+    registry.Add("ui/layout_solve_horizontal", BM_SolveHorizontal, widgets);
+    registry.Add("ui/layout_solve_vertical", BM_SolveVertical, widgets);
+}
@@ -0,0 +1,166 @@
+#include "bench.h"
+#include "../engine/graphvm/GraphVM.h"
+#include "../engine/graphvm/GraphCompiler.h"
+#include "../engine/script/ScriptVM.h"
+
+using namespace atlas::bench;
+
+namespace {
+
+// ---- GraphVM ------------------------------------------------
+
+/// for (i = 0; i < n; ++i) acc += i * 3;   locals: 0 = i, 1 = acc
+atlas::vm::Bytecode GraphLoop(int64_t n) {
+    using atlas::vm::OpCode;
+    atlas::vm::Bytecode bc;
+    bc.constants = {0, n, 3, 1};
+    bc.instructions = {
+        {OpCode::LOAD_CONST, 0, 0, 0},      //  0: i = 0
+        {OpCode::STORE_VAR, 0, 0, 0},       //  1
+        {OpCode::LOAD_VAR, 0, 0, 0},        //  2: loop: i < n
+        {OpCode::LOAD_CONST, 1, 0, 0},      //  3
+        {OpCode::CMP_LT, 0, 0, 0},          //  4
+        {OpCode::JUMP_IF_FALSE, 17, 0, 0},  //  5
+        {OpCode::LOAD_VAR, 1, 0, 0},        //  6: acc += i * 3
+        {OpCode::LOAD_VAR, 0, 0, 0},        //  7
+        {OpCode::LOAD_CONST, 2, 0, 0},      //  8
+        {OpCode::MUL, 0, 0, 0},             //  9
+        {OpCode::ADD, 0, 0, 0},             // 10
+        {OpCode::STORE_VAR, 1, 0, 0},       // 11
+        {OpCode::LOAD_VAR, 0, 0, 0},        // 12: ++i
+        {OpCode::LOAD_CONST, 3, 0, 0},      // 13
+        {OpCode::ADD, 0, 0, 0},             // 14
+        {OpCode::STORE_VAR, 0, 0, 0},       // 15
+        {OpCode::JUMP, 2, 0, 0},            // 16
+        {OpCode::END, 0, 0, 0},             // 17
+    };
+    return bc;
+}
+
+int64_t LoopResult(int64_t n) { return 3 * n * (n - 1) / 2; }
+
+void BM_GraphExecuteBytecode(State& state) {
+    const int64_t n = static_cast<int64_t>(state.Size());
+    atlas::vm::Bytecode bc = GraphLoop(n);
+    atlas::vm::GraphVM vm;
+    atlas::vm::VMContext ctx;
+    while (state.KeepRunning()) {
+        vm.Execute(bc, ctx);
+        DoNotOptimize(vm.GetLocal(1));
+    }
+    Expect(vm.LastError().empty() && vm.GetLocal(1) == LoopResult(n), "graph loop result");
+    state.SetItemsPerIteration(static_cast<double>(n));
+    state.SetItemLabel("loop iterations");
+}
+
+void BM_GraphExecuteLowered(State& state) {
+    const int64_t n = static_cast<int64_t>(state.Size());
+    atlas::vm::RegisterProgram program;
+    Expect(atlas::vm::GraphCompiler::Lower(GraphLoop(n), program), "graph loop lowers");
+    atlas::vm::GraphVM vm;
+    atlas::vm::VMContext ctx;
+    while (state.KeepRunning()) {
+        vm.Execute(program, ctx);
+        DoNotOptimize(vm.GetLocal(1));
+    }
+    Expect(vm.GetLocal(1) == LoopResult(n), "lowered graph loop result");
+    state.SetItemsPerIteration(static_cast<double>(n));
+    state.SetItemLabel("loop iterations");
+}
+
+/// Straight-line per-entity graph: local 0 = entity * 7 + tick
+void BM_GraphExecuteBatch(State& state) {
+    using atlas::vm::OpCode;
+    atlas::vm::Bytecode bc;
+    bc.constants = {7};
+    bc.instructions = {
+        {OpCode::LOAD_ENTITY, 0, 0, 0},
+        {OpCode::LOAD_CONST, 0, 0, 0},
+        {OpCode::MUL, 0, 0, 0},
+        {OpCode::LOAD_TICK, 0, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::STORE_VAR, 0, 0, 0},
+        {OpCode::END, 0, 0, 0},
+    };
+    atlas::vm::RegisterProgram program;
+    Expect(atlas::vm::GraphCompiler::Lower(bc, program), "batch graph lowers");
+
+    std::vector<atlas::vm::VMContext> contexts(state.Size());
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        contexts[i].entity = static_cast<uint32_t>(i + 1);
+        contexts[i].tick = 100;
+    }
+    std::vector<atlas::vm::Value> locals(contexts.size() * program.LocalCount());
+    atlas::vm::GraphVM vm;
+    while (state.KeepRunning()) {
+        vm.ExecuteBatch(program, contexts.data(), contexts.size(), locals.data());
+        DoNotOptimize(locals.data());
+    }
+    Expect(locals.back() == static_cast<atlas::vm::Value>(contexts.size() * 7 + 100),
+           "batch graph result");
+    state.SetItemsPerIteration(static_cast<double>(contexts.size()));
+    state.SetItemLabel("entities");
+}
+
+// ---- ScriptVM -----------------------------------------------
+
+/// Same loop as GraphLoop, with named variables.
+atlas::script::CompiledScript ScriptLoop(int64_t n) {
+    using atlas::script::Opcode;
+    using atlas::script::ScriptValue;
+    atlas::script::CompiledScript script;
+    script.name = "bench_loop";
+    script.constants = {
+        ScriptValue(int64_t(0)), ScriptValue(n), ScriptValue(int64_t(3)), ScriptValue(int64_t(1)),
+        ScriptValue(std::string("i")), ScriptValue(std::string("acc")),
+    };
+    script.code = {
+        {Opcode::PUSH_INT, 0},    //  0: i = 0
+        {Opcode::STORE_VAR, 4},   //  1
+        {Opcode::PUSH_INT, 0},    //  2: acc = 0
+        {Opcode::STORE_VAR, 5},   //  3
+        {Opcode::LOAD_VAR, 4},    //  4: loop: exit unless i < n
+        {Opcode::PUSH_INT, 1},    //  5
+        {Opcode::LT, 0},          //  6
+        {Opcode::NOT, 0},         //  7
+        {Opcode::JMP_IF, 20},     //  8
+        {Opcode::LOAD_VAR, 5},    //  9: acc += i * 3
+        {Opcode::LOAD_VAR, 4},    // 10
+        {Opcode::PUSH_INT, 2},    // 11
+        {Opcode::MUL, 0},         // 12
+        {Opcode::ADD, 0},         // 13
+        {Opcode::STORE_VAR, 5},   // 14
+        {Opcode::LOAD_VAR, 4},    // 15: ++i
+        {Opcode::PUSH_INT, 3},    // 16
+        {Opcode::ADD, 0},         // 17
+        {Opcode::STORE_VAR, 4},   // 18
+        {Opcode::JMP, 4},         // 19
+        {Opcode::LOAD_VAR, 5},    // 20: return acc
+        {Opcode::HALT, 0},        // 21
+    };
+    return script;
+}
+
+void BM_ScriptLoop(State& state) {
+    const int64_t n = static_cast<int64_t>(state.Size());
+    atlas::script::CompiledScript script = ScriptLoop(n);
+    atlas::script::ScriptVM vm;
+    atlas::script::ScriptValue result;
+    while (state.KeepRunning()) {
+        result = vm.Execute(script);
+        DoNotOptimize(result.intVal);
+    }
+    Expect(result.intVal == LoopResult(n), "script loop result");
+    state.SetItemsPerIteration(static_cast<double>(n));
+    state.SetItemLabel("loop iterations");
+}
+
+} // namespace
+
+void register_vm_benchmarks(Registry& registry) {
+    const std::vector<size_t> loopCounts = {10, 100, 1000, 10000};
+    registry.Add("graphvm/execute_bytecode", BM_GraphExecuteBytecode, loopCounts);
+    registry.Add("graphvm/execute_lowered", BM_GraphExecuteLowered, loopCounts);
+    registry.Add("graphvm/execute_batch", BM_GraphExecuteBatch, {64, 1024, 16384});
+    registry.Add("script/loop", BM_ScriptLoop, loopCounts);
+}
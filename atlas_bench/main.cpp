@@ -0,0 +1,95 @@
+#include "bench.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using atlas::bench::Registry;
+using atlas::bench::RunOptions;
+
+// Benchmark registration, one function per bench_*.cpp
+void register_ecs_benchmarks(Registry& registry);
+void register_net_benchmarks(Registry& registry);
+void register_sim_benchmarks(Registry& registry);
+void register_vm_benchmarks(Registry& registry);
+void register_core_benchmarks(Registry& registry);
+void register_ui_benchmarks(Registry& registry);
+
+static void PrintUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " [options]\n"
+              << "  --filter <text>     Run benchmarks whose <name>/<size> contains text\n"
+              << "  --out <file>        Write results as JSON\n"
+              << "  --label <text>      Run label stored in the JSON (e.g. a commit hash)\n"
+              << "  --min-time <sec>    Minimum time per measurement (default 0.2)\n"
+              << "  --repetitions <n>   Measurements per benchmark, median reported (default 3)\n"
+              << "  --list              List benchmarks and exit\n"
+              << "Compare two JSON files with tools/bench_compare.py.\n";
+}
+
+int main(int argc, char* argv[]) {
+    RunOptions options;
+    std::string outPath;
+    std::string label;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << argv[i] << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (std::strcmp(argv[i], "--filter") == 0) {
+            options.filter = value();
+        } else if (std::strcmp(argv[i], "--out") == 0) {
+            outPath = value();
+        } else if (std::strcmp(argv[i], "--label") == 0) {
+            label = value();
+        } else if (std::strcmp(argv[i], "--min-time") == 0) {
+            options.minSeconds = std::atof(value());
+        } else if (std::strcmp(argv[i], "--repetitions") == 0) {
+            options.repetitions = std::max(1, std::atoi(value()));
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else {
+            PrintUsage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    Registry registry;
+    register_ecs_benchmarks(registry);
+    register_net_benchmarks(registry);
+    register_sim_benchmarks(registry);
+    register_vm_benchmarks(registry);
+    register_core_benchmarks(registry);
+    register_ui_benchmarks(registry);
+
+    if (list) {
+        for (const auto& bench : registry.Benchmarks()) {
+            for (size_t size : bench.sizes) std::cout << bench.name << "/" << size << "\n";
+        }
+        return 0;
+    }
+
+#if !defined(NDEBUG)
+    std::cout << "Warning: AtlasBench was built without NDEBUG; timings are not representative.\n";
+#endif
+
+    auto results = registry.Run(options);
+    if (results.empty()) {
+        std::cerr << "No benchmarks matched '" << options.filter << "'\n";
+        return 1;
+    }
+
+    if (!outPath.empty()) {
+        if (!atlas::bench::WriteJson(outPath, results, options, label)) {
+            std::cerr << "Failed to write " << outPath << "\n";
+            return 1;
+        }
+        std::cout << "Wrote " << results.size() << " results to " << outPath << "\n";
+    }
+    return 0;
+}
@@ -17,6 +17,10 @@ void test_variables();
 void test_create_entity();
 void test_destroy_entity();
 void test_tick_callback();
+void test_ecs_view_iterates_matching();
+void test_ecs_destroy_reuses_slot_cleanly();
+void test_ecs_generation_tracks_rollback();
+void test_ecs_hash_components_per_type();
 
 // ECS Component tests
 void test_add_and_get_component();
@@ -636,6 +640,14 @@ void test_dc_clear();
 void test_dc_decode_delta_without_baseline();
 void test_dc_empty_encode();
 void test_dc_encode_decode_full_sequence();
+void test_dc_peer_first_packet_is_keyframe();
+void test_dc_peer_delta_after_ack();
+void test_dc_peer_lossy_keeps_old_baseline();
+void test_dc_peer_keyframe_outside_window();
+void test_dc_peer_missing_baseline_rejected();
+void test_dc_peer_spawn_and_remove();
+void test_dc_peer_rule_quantization();
+void test_dc_peer_remove();
 
 // JitterBuffer tests
 void test_jb_defaults();
@@ -1300,6 +1312,10 @@ int main(int argc, char* argv[]) {
     RUN_TEST(test_create_entity);
     RUN_TEST(test_destroy_entity);
     RUN_TEST(test_tick_callback);
+    RUN_TEST(test_ecs_view_iterates_matching);
+    RUN_TEST(test_ecs_destroy_reuses_slot_cleanly);
+    RUN_TEST(test_ecs_generation_tracks_rollback);
+    RUN_TEST(test_ecs_hash_components_per_type);
 
     // ECS Components
     log.BeginSection("ECS Components");
@@ -1982,6 +1998,14 @@ int main(int argc, char* argv[]) {
     RUN_TEST(test_dc_decode_delta_without_baseline);
     RUN_TEST(test_dc_empty_encode);
     RUN_TEST(test_dc_encode_decode_full_sequence);
+    RUN_TEST(test_dc_peer_first_packet_is_keyframe);
+    RUN_TEST(test_dc_peer_delta_after_ack);
+    RUN_TEST(test_dc_peer_lossy_keeps_old_baseline);
+    RUN_TEST(test_dc_peer_keyframe_outside_window);
+    RUN_TEST(test_dc_peer_missing_baseline_rejected);
+    RUN_TEST(test_dc_peer_spawn_and_remove);
+    RUN_TEST(test_dc_peer_rule_quantization);
+    RUN_TEST(test_dc_peer_remove);
 
     // Jitter Buffer
     log.BeginSection("Jitter Buffer");
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <vector>
 #include "../engine/net/DeltaCompression.h"
+#include "../engine/net/Replication.h"
 
 using namespace atlas::net;
 
@@ -299,3 +300,182 @@ void test_dc_encode_decode_full_sequence() {
         assert(approxEq(decoded[0].rotYaw, s.rotYaw, 0.11f));
     }
 }
+
+// ══════════════════════════════════════════════════════════════════
+// Per-peer acked baselines
+// ══════════════════════════════════════════════════════════════════
+
+static std::vector<EntitySnapshot> peerWorld(uint32_t tick, uint32_t count) {
+    std::vector<EntitySnapshot> out;
+    for (uint32_t i = 1; i <= count; ++i) {
+        EntitySnapshot s;
+        s.entityId = i;
+        s.tick     = tick;
+        // Only entity 1 moves; the rest stay put
+        s.posX     = (i == 1) ? static_cast<float>(tick) * 2.0f : static_cast<float>(i) * 100.0f;
+        s.posY     = static_cast<float>(i);
+        s.velX     = (i == 1) ? 2.0f : 0.0f;
+        s.rotYaw   = static_cast<float>(i) * 5.0f;
+        out.push_back(s);
+    }
+    return out;
+}
+
+void test_dc_peer_first_packet_is_keyframe() {
+    DeltaCompression server;
+    DeltaCompression client;
+    auto world = peerWorld(1, 3);
+    auto packet = server.EncodeForPeer(7, 1, world);
+    assert(server.HasPeer(7));
+
+    std::vector<EntitySnapshot> out;
+    PeerPacketHeader hdr;
+    assert(client.DecodePacket(packet, out, &hdr));
+    assert(hdr.sequence == 1);
+    assert(hdr.baseline == 0);
+    assert(out.size() == 3);
+    for (size_t i = 0; i < out.size(); ++i) {
+        assert(out[i].entityId == world[i].entityId);
+        assert(out[i].tick == 1);
+        assert(approxEq(out[i].posX, world[i].posX));
+        assert(approxEq(out[i].posY, world[i].posY));
+        assert(approxEq(out[i].rotYaw, world[i].rotYaw, 0.11f));
+    }
+}
+
+void test_dc_peer_delta_after_ack() {
+    DeltaCompression server;
+    DeltaCompression client;
+    std::vector<EntitySnapshot> out;
+    auto keyframe = server.EncodeForPeer(1, 1, peerWorld(1, 50));
+    assert(client.DecodePacket(keyframe, out));
+    server.Acknowledge(1, 1);
+    assert(server.AckedSequence(1) == 1);
+
+    auto delta = server.EncodeForPeer(1, 2, peerWorld(2, 50));
+    PeerPacketHeader hdr;
+    assert(client.DecodePacket(delta, out, &hdr));
+    assert(hdr.baseline == 1);
+    // Only one of 50 entities changed, so the delta is far smaller
+    assert(delta.size() * 10 < keyframe.size());
+    assert(out.size() == 50);
+    assert(approxEq(out[0].posX, 4.0f));
+    assert(approxEq(out[49].posX, 5000.0f));
+}
+
+void test_dc_peer_lossy_keeps_old_baseline() {
+    DeltaCompression server;
+    DeltaCompression client;
+    std::vector<EntitySnapshot> out;
+    assert(client.DecodePacket(server.EncodeForPeer(1, 1, peerWorld(1, 4)), out));
+    server.Acknowledge(1, 1);
+
+    // Packets 2..5 are lost; each is still a delta against 1
+    for (uint32_t seq = 2; seq <= 5; ++seq) {
+        server.EncodeForPeer(1, seq, peerWorld(seq, 4));
+    }
+    auto packet = server.EncodeForPeer(1, 6, peerWorld(6, 4));
+    PeerPacketHeader hdr;
+    assert(client.DecodePacket(packet, out, &hdr));
+    assert(hdr.baseline == 1);
+    assert(out.size() == 4);
+    assert(approxEq(out[0].posX, 12.0f));
+
+    // Stale acks never move the baseline backwards
+    server.Acknowledge(1, 6);
+    server.Acknowledge(1, 3);
+    assert(server.AckedSequence(1) == 6);
+}
+
+void test_dc_peer_keyframe_outside_window() {
+    DeltaCompression server;
+    server.SetHistoryWindow(4);
+    assert(server.HistoryWindow() == 4);
+    std::vector<EntitySnapshot> out;
+    DeltaCompression client;
+    client.SetHistoryWindow(4);
+
+    assert(client.DecodePacket(server.EncodeForPeer(1, 1, peerWorld(1, 2)), out));
+    server.Acknowledge(1, 1);
+    // Sequence 5 evicts 1 from the 4-entry ring
+    for (uint32_t seq = 2; seq <= 5; ++seq) {
+        server.EncodeForPeer(1, seq, peerWorld(seq, 2));
+    }
+    PeerPacketHeader hdr;
+    auto packet = server.EncodeForPeer(1, 6, peerWorld(6, 2));
+    assert(client.DecodePacket(packet, out, &hdr));
+    assert(hdr.baseline == 0);
+    assert(out.size() == 2);
+
+    // Acks for evicted snapshots are ignored
+    server.Acknowledge(1, 2);
+    assert(server.AckedSequence(1) == 1);
+}
+
+void test_dc_peer_missing_baseline_rejected() {
+    DeltaCompression server;
+    DeltaCompression client;
+    server.EncodeForPeer(1, 1, peerWorld(1, 2));   // lost on the way
+    server.Acknowledge(1, 1);                      // forged / mismatched ack
+    auto packet = server.EncodeForPeer(1, 2, peerWorld(2, 2));
+    std::vector<EntitySnapshot> out;
+    assert(!client.DecodePacket(packet, out));
+    assert(!client.DecodePacket({0x01, 0x02}, out));
+}
+
+void test_dc_peer_spawn_and_remove() {
+    DeltaCompression server;
+    DeltaCompression client;
+    std::vector<EntitySnapshot> out;
+    assert(client.DecodePacket(server.EncodeForPeer(1, 1, peerWorld(1, 3)), out));
+    server.Acknowledge(1, 1);
+
+    auto world = peerWorld(2, 3);
+    world.erase(world.begin() + 1);   // entity 2 despawned
+    EntitySnapshot fresh;
+    fresh.entityId = 900;
+    fresh.posX     = -12.5f;
+    fresh.rotYaw   = 90.0f;
+    world.push_back(fresh);
+
+    assert(client.DecodePacket(server.EncodeForPeer(1, 2, world), out));
+    assert(out.size() == 3);
+    assert(out[0].entityId == 1);
+    assert(out[1].entityId == 3);
+    assert(out[2].entityId == 900);
+    assert(approxEq(out[2].posX, -12.5f));
+    assert(approxEq(out[2].rotYaw, 90.0f, 0.11f));
+}
+
+void test_dc_peer_rule_quantization() {
+    ReplicationRule rule;
+    rule.componentName = "Transform";
+    rule.quantizeStep  = 0.5f;
+
+    DeltaCompression server;
+    DeltaCompression client;
+    server.ApplyRule(SnapshotField::Position, rule);
+    client.ApplyRule(SnapshotField::Position, rule);
+    assert(server.Quantization(SnapshotField::Position) == 0.5f);
+
+    EntitySnapshot s;
+    s.entityId = 1;
+    s.posX     = 10.3f;
+    std::vector<EntitySnapshot> out;
+    assert(client.DecodePacket(server.EncodeForPeer(1, 1, {s}), out));
+    assert(approxEq(out[0].posX, 10.5f, 0.001f));
+
+    // A zero step falls back to the default precision
+    rule.quantizeStep = 0.0f;
+    server.ApplyRule(SnapshotField::Position, rule);
+    assert(approxEq(server.Quantization(SnapshotField::Position), 0.01f, 1e-6f));
+}
+
+void test_dc_peer_remove() {
+    DeltaCompression server;
+    server.EncodeForPeer(3, 1, peerWorld(1, 1));
+    server.Acknowledge(3, 1);
+    server.RemovePeer(3);
+    assert(!server.HasPeer(3));
+    assert(server.AckedSequence(3) == 0);
+}
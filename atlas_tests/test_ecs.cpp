@@ -40,3 +40,144 @@ void test_tick_callback() {
 
     assert(receivedDt > 0.03f && receivedDt < 0.04f);
 }
+
+namespace {
+
+struct ViewPos {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct ViewVel {
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+
+}  // namespace
+
+void test_ecs_view_iterates_matching() {
+    World world;
+    EntityID both1 = world.CreateEntity();
+    EntityID posOnly = world.CreateEntity();
+    EntityID both2 = world.CreateEntity();
+    world.CreateEntity();
+
+    world.AddComponent<ViewPos>(both1, {1.0f, 1.0f});
+    world.AddComponent<ViewVel>(both1, {1.0f, 0.0f});
+    world.AddComponent<ViewPos>(posOnly, {5.0f, 5.0f});
+    world.AddComponent<ViewPos>(both2, {2.0f, 2.0f});
+    world.AddComponent<ViewVel>(both2, {0.0f, 3.0f});
+
+    size_t count = 0;
+    for (EntityID e : world.View<ViewPos, ViewVel>()) {
+        assert(e == both1 || e == both2);
+        ++count;
+    }
+    assert(count == 2);
+
+    world.View<ViewPos, ViewVel>().Each([](EntityID, ViewPos& p, ViewVel& v) {
+        p.x += v.dx;
+        p.y += v.dy;
+    });
+    assert(world.GetComponent<ViewPos>(both1)->x == 2.0f);
+    assert(world.GetComponent<ViewPos>(both2)->y == 5.0f);
+    assert(world.GetComponent<ViewPos>(posOnly)->x == 5.0f);
+
+    // A type no entity has gives an empty view
+    World empty;
+    assert(empty.View<ViewPos>().SizeHint() == 0);
+    for (EntityID e : empty.View<ViewPos>()) { (void)e; assert(false); }
+}
+
+void test_ecs_destroy_reuses_slot_cleanly() {
+    World world;
+    EntityID ids[5];
+    for (int i = 0; i < 5; ++i) {
+        ids[i] = world.CreateEntity();
+        world.AddComponent<ViewPos>(ids[i], {static_cast<float>(i), 0.0f});
+    }
+
+    world.DestroyEntity(ids[1]);
+    world.DestroyEntity(ids[3]);
+    assert(world.EntityCount() == 3);
+    assert(!world.IsAlive(ids[1]));
+    assert(world.GetComponent<ViewPos>(ids[1]) == nullptr);
+    assert(world.GetComponent<ViewPos>(ids[4])->x == 4.0f);
+
+    // The new entity takes a freed slot but none of its components
+    EntityID fresh = world.CreateEntity();
+    assert(!world.HasComponent<ViewPos>(fresh));
+    assert(world.EntityCount() == 4);
+
+    // Components can only be added to live entities
+    world.AddComponent<ViewPos>(ids[1], {9.0f, 9.0f});
+    assert(!world.HasComponent<ViewPos>(ids[1]));
+}
+
+void test_ecs_generation_tracks_rollback() {
+    World world;
+    world.RegisterComponent<ViewPos>(1);
+    EntityID kept = world.CreateEntity();
+    world.AddComponent<ViewPos>(kept, {1.0f, 2.0f});
+    auto snapshot = world.Serialize();
+
+    EntityID later = world.CreateEntity();
+    assert(world.Generation(later) == 0);
+
+    assert(world.Deserialize(snapshot));
+    assert(!world.IsAlive(later));
+    assert(world.Generation(later) == 1);
+    assert(world.Generation(kept) == 0);
+    assert(world.GetComponent<ViewPos>(kept)->y == 2.0f);
+
+    // The ID is handed out again, with a new generation
+    assert(world.CreateEntity() == later);
+    assert(world.Generation(later) == 1);
+
+    // Same state serializes to the same bytes
+    World copy;
+    copy.RegisterComponent<ViewPos>(1);
+    assert(copy.Deserialize(world.Serialize()));
+    assert(copy.Serialize() == world.Serialize());
+}
+
+void test_ecs_hash_components_per_type() {
+    World world;
+    world.RegisterComponent<ViewPos>(1);
+    world.RegisterComponent<ViewVel>(2);
+    for (int i = 0; i < 6; ++i) {
+        EntityID e = world.CreateEntity();
+        world.AddComponent<ViewPos>(e, {static_cast<float>(i), 1.0f});
+        if (i % 2 == 0) world.AddComponent<ViewVel>(e, {0.5f, static_cast<float>(i)});
+    }
+
+    std::vector<ComponentHash> before;
+    world.HashComponents(before);
+    assert(before.size() == 3);
+    assert(before[0].typeTag == 1 && before[1].typeTag == 2);
+    assert(before[2].typeTag == kEntityTableTag);
+
+    // Same state in a different dense order hashes the same
+    World copy;
+    copy.RegisterComponent<ViewPos>(1);
+    copy.RegisterComponent<ViewVel>(2);
+    assert(copy.Deserialize(world.Serialize()));
+    std::vector<ComponentHash> copied;
+    copy.HashComponents(copied);
+    for (size_t i = 0; i < before.size(); ++i) {
+        assert(copied[i].hash == before[i].hash);
+    }
+
+    // A write through GetComponent changes only that type's hash
+    world.GetComponent<ViewVel>(world.GetEntities()[2])->dx = 9.0f;
+    std::vector<ComponentHash> after;
+    world.HashComponents(after);
+    assert(after[0].hash == before[0].hash);
+    assert(after[1].hash != before[1].hash);
+    assert(after[2].hash == before[2].hash);
+
+    // Destroying an entity changes the entity table
+    world.DestroyEntity(world.GetEntities()[1]);
+    world.HashComponents(after);
+    assert(after[2].hash != before[2].hash);
+}
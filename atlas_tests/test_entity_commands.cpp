@@ -22,6 +22,9 @@ using namespace atlas::editor;
 
 // ── Test component ──────────────────────────────────────────────────
 
+// Local to this file: test_components.cpp has a different Health.
+namespace {
+
 struct Health {
     float hp = 100.0f;
 };
@@ -30,6 +33,8 @@ struct Name {
     std::string value;
 };
 
+}  // namespace
+
 // ── CreateEntityCommand tests ───────────────────────────────────────
 
 void test_create_entity_cmd_executes() {
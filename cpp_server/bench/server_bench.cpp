@@ -0,0 +1,854 @@
+/**
+ * @file server_bench.cpp
+ * @brief Headless load benchmark for the dedicated server tick
+ *
+ * Builds an ecs::World with the production system set
+ * (systems::addServerSystems), populates it from a scenario file and
+ * runs it for a fixed number of ticks with a fixed step.  Players are
+ * fake in-process clients: each owns a ship, is registered with
+ * interest management, issues movement / lock commands on a schedule
+ * and is sent a delta snapshot every tick, as GameSession::update does.
+ *
+ * Everything that decides what happens (placement, commands) comes from
+ * the scenario seed, so two runs of one scenario simulate the same
+ * ticks; the report's state_checksum shows whether they did.
+ *
+ * Usage:
+ *   server_bench <scenario.json> [--ticks N] [--warmup N] [--seed N]
+ *                [--threads N] [--out report.json]
+ *
+ * The JSON report goes to --out, or stdout.  Progress goes to stderr.
+ */
+
+#include "ecs/world.h"
+#include "components/game_components.h"
+#include "systems/server_system_set.h"
+#include "systems/movement_system.h"
+#include "systems/targeting_system.h"
+#include "systems/interest_management_system.h"
+#include "systems/snapshot_replication_system.h"
+#include "utils/json_helpers.h"
+#include "utils/logger.h"
+#include "utils/tick_profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace atlas;
+
+namespace {
+
+constexpr float kPi = 3.14159265f;
+
+// ---------------------------------------------------------------------------
+// Scenario
+// ---------------------------------------------------------------------------
+
+struct Scenario {
+    std::string name = "unnamed";
+    std::string description;
+    int ticks = 600;
+    int warmup_ticks = 60;
+    float tick_rate = 30.0f;
+    int seed = 1;
+    int worker_threads = 0;
+    float world_radius = 100000.0f;   ///< stations, fields and battles sit on rings inside this
+
+    int stations = 1;
+
+    int npc_fleets = 0;               ///< paired off: fleet 2k fights fleet 2k+1
+    int ships_per_fleet = 0;
+    float fleet_spread = 2000.0f;
+    float engagement_distance = 20000.0f;
+
+    int asteroid_fields = 0;
+    int deposits_per_field = 0;
+    int miners = 0;
+
+    int haulers = 0;
+
+    int players = 0;
+    float binary_fraction = 0.5f;     ///< share of clients on the binary wire encoding
+    int command_interval_ticks = 30;
+};
+
+bool loadScenario(const std::string& path, Scenario& s) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    std::string name = json::extractString(text, "name");
+    if (!name.empty()) s.name = name;
+    s.description = json::extractString(text, "description");
+    s.ticks = json::extractInt(text, "ticks", s.ticks);
+    s.warmup_ticks = json::extractInt(text, "warmup_ticks", s.warmup_ticks);
+    s.tick_rate = json::extractFloat(text, "tick_rate", s.tick_rate);
+    s.seed = json::extractInt(text, "seed", s.seed);
+    s.worker_threads = json::extractInt(text, "worker_threads", s.worker_threads);
+    s.world_radius = json::extractFloat(text, "world_radius", s.world_radius);
+    s.stations = json::extractInt(text, "stations", s.stations);
+
+    std::string fleets = json::extractObject(text, "npc_fleets");
+    s.npc_fleets = json::extractInt(fleets, "count", s.npc_fleets);
+    s.ships_per_fleet = json::extractInt(fleets, "ships_per_fleet", s.ships_per_fleet);
+    s.fleet_spread = json::extractFloat(fleets, "spread", s.fleet_spread);
+    s.engagement_distance = json::extractFloat(fleets, "engagement_distance",
+                                               s.engagement_distance);
+
+    std::string mining = json::extractObject(text, "miners");
+    s.miners = json::extractInt(mining, "count", s.miners);
+    s.asteroid_fields = json::extractInt(mining, "fields", s.asteroid_fields);
+    s.deposits_per_field = json::extractInt(mining, "deposits_per_field", s.deposits_per_field);
+
+    std::string hauling = json::extractObject(text, "haulers");
+    s.haulers = json::extractInt(hauling, "count", s.haulers);
+
+    std::string players = json::extractObject(text, "players");
+    s.players = json::extractInt(players, "count", s.players);
+    s.binary_fraction = json::extractFloat(players, "binary_fraction", s.binary_fraction);
+    s.command_interval_ticks = json::extractInt(players, "command_interval_ticks",
+                                                s.command_interval_ticks);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Deterministic randomness (splitmix64; <random> distributions are not
+// specified bit-for-bit across standard libraries)
+// ---------------------------------------------------------------------------
+
+class BenchRng {
+public:
+    explicit BenchRng(uint64_t seed) : state_(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /// Uniform in [0, 1)
+    float unit() { return static_cast<float>(next() >> 40) / static_cast<float>(1ull << 24); }
+    float range(float lo, float hi) { return lo + (hi - lo) * unit(); }
+    size_t below(size_t n) { return n ? static_cast<size_t>(next() % n) : 0; }
+
+private:
+    uint64_t state_;
+};
+
+// ---------------------------------------------------------------------------
+// Population
+// ---------------------------------------------------------------------------
+
+struct Vec3 {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+/// A place load gathers around; players pick their targets from its members
+struct Anchor {
+    std::string kind;
+    Vec3 center;
+    std::vector<std::string> members;
+};
+
+struct FakeClient {
+    int client_id = 0;
+    std::string entity_id;
+    bool binary = false;
+    size_t anchor = 0;
+    uint64_t bytes = 0;          ///< payload bytes over the measured ticks
+};
+
+struct Hauler {
+    std::string entity_id;
+    size_t next_station = 0;
+};
+
+const char* const kFleetFactions[2] = {"Iron Corsairs", "Crimson Order"};
+
+Vec3 onRing(float radius, size_t index, size_t count, float phase) {
+    float angle = phase + 2.0f * kPi * static_cast<float>(index) /
+                  static_cast<float>(std::max<size_t>(count, 1));
+    return {radius * std::cos(angle), 0.0f, radius * std::sin(angle)};
+}
+
+Vec3 scatter(BenchRng& rng, const Vec3& center, float spread) {
+    return {center.x + rng.range(-spread, spread),
+            center.y + rng.range(-spread * 0.1f, spread * 0.1f),
+            center.z + rng.range(-spread, spread)};
+}
+
+ecs::Entity* spawnShip(ecs::World& world, const std::string& id, const Vec3& at,
+                       const std::string& ship_name, const std::string& faction,
+                       float max_speed) {
+    auto* entity = world.createEntity(id);
+    if (!entity) return nullptr;
+
+    auto pos = std::make_unique<components::Position>();
+    pos->x = at.x;  pos->y = at.y;  pos->z = at.z;
+    entity->addComponent(std::move(pos));
+
+    auto vel = std::make_unique<components::Velocity>();
+    vel->max_speed = max_speed;
+    entity->addComponent(std::move(vel));
+
+    auto hp = std::make_unique<components::Health>();
+    hp->shield_hp = hp->shield_max = 450.0f;
+    hp->armor_hp  = hp->armor_max  = 350.0f;
+    hp->hull_hp   = hp->hull_max   = 300.0f;
+    hp->shield_recharge_rate = 3.5f;
+    entity->addComponent(std::move(hp));
+
+    auto ship = std::make_unique<components::Ship>();
+    ship->ship_name = ship_name;
+    ship->ship_type = ship_name;
+    entity->addComponent(std::move(ship));
+
+    auto fac = std::make_unique<components::Faction>();
+    fac->faction_name = faction;
+    entity->addComponent(std::move(fac));
+
+    auto cap = std::make_unique<components::Capacitor>();
+    cap->capacitor = cap->capacitor_max = 250.0f;
+    cap->recharge_rate = 3.0f;
+    entity->addComponent(std::move(cap));
+
+    entity->addComponent(std::make_unique<components::Target>());
+    return entity;
+}
+
+class LoadDriver {
+public:
+    LoadDriver(const Scenario& scenario, ecs::World& world, const systems::ServerSystems& set)
+        : s_(scenario), world_(world), set_(set), rng_(static_cast<uint64_t>(scenario.seed)) {}
+
+    void populate();
+
+    /// Fake clients and haulers act before the tick, as dispatched messages would
+    void beforeTick(int tick);
+
+    /// One delta snapshot per client; returns the payload bytes sent
+    uint64_t replicate(bool measured);
+
+    const std::vector<FakeClient>& clients() const { return clients_; }
+    size_t stationCount() const { return stations_.size(); }
+    size_t depositCount() const { return deposit_count_; }
+    size_t npcShipCount() const { return npc_ships_; }
+    size_t minerCount() const { return miner_count_; }
+    size_t haulerCount() const { return haulers_.size(); }
+    uint64_t spawnMessages() const { return spawn_messages_; }
+    uint64_t despawnMessages() const { return despawn_messages_; }
+    uint64_t commandsIssued() const { return commands_issued_; }
+
+private:
+    void spawnStations();
+    void spawnFleets();
+    void spawnMining();
+    void spawnHaulers();
+    void spawnPlayers();
+    void loadCargo(ecs::Entity* hauler);
+    void issueCommand(FakeClient& client);
+    const std::string* pickTarget(const Anchor& anchor, const std::string& self);
+
+    const Scenario& s_;
+    ecs::World& world_;
+    systems::ServerSystems set_;
+    BenchRng rng_;
+
+    std::vector<Anchor> anchors_;
+    std::vector<size_t> stations_;          ///< indices into anchors_
+    std::vector<Hauler> haulers_;
+    std::vector<FakeClient> clients_;
+    size_t deposit_count_ = 0;
+    size_t npc_ships_ = 0;
+    size_t miner_count_ = 0;
+    uint64_t sequence_ = 0;
+    uint64_t spawn_messages_ = 0;
+    uint64_t despawn_messages_ = 0;
+    uint64_t commands_issued_ = 0;
+};
+
+void LoadDriver::populate() {
+    spawnStations();
+    spawnFleets();
+    spawnMining();
+    spawnHaulers();
+    spawnPlayers();
+    // Apply anything a system or handler deferred while spawning
+    world_.flushCommands();
+}
+
+void LoadDriver::spawnStations() {
+    const size_t count = static_cast<size_t>(std::max(s_.stations, 0));
+    for (size_t i = 0; i < count; ++i) {
+        Anchor anchor;
+        anchor.kind = "station";
+        anchor.center = onRing(s_.world_radius * 0.25f, i, count, 0.0f);
+
+        std::string id = "station_" + std::to_string(i);
+        auto* entity = world_.createEntity(id);
+        if (!entity) continue;
+        auto pos = std::make_unique<components::Position>();
+        pos->x = anchor.center.x;  pos->y = anchor.center.y;  pos->z = anchor.center.z;
+        entity->addComponent(std::move(pos));
+        auto station = std::make_unique<components::Station>();
+        station->station_name = "Bench Station " + std::to_string(i);
+        entity->addComponent(std::move(station));
+
+        anchor.members.push_back(id);
+        stations_.push_back(anchors_.size());
+        anchors_.push_back(std::move(anchor));
+    }
+}
+
+void LoadDriver::spawnFleets() {
+    const size_t fleets = static_cast<size_t>(std::max(s_.npc_fleets, 0));
+    const size_t sites = (fleets + 1) / 2;
+    for (size_t site = 0; site < sites; ++site) {
+        Anchor anchor;
+        anchor.kind = "battle";
+        anchor.center = onRing(s_.world_radius * 0.75f, site, sites, 0.5f);
+
+        for (size_t side = 0; side < 2; ++side) {
+            size_t fleet = site * 2 + side;
+            if (fleet >= fleets) break;
+            const char* faction = kFleetFactions[side];
+            const char* enemy = kFleetFactions[1 - side];
+            Vec3 center = anchor.center;
+            center.x += (side == 0 ? -0.5f : 0.5f) * s_.engagement_distance;
+
+            for (int i = 0; i < s_.ships_per_fleet; ++i) {
+                std::string id = "npc_f" + std::to_string(fleet) + "_" + std::to_string(i);
+                auto* entity = spawnShip(world_, id, scatter(rng_, center, s_.fleet_spread),
+                                         "Falk", faction, 250.0f);
+                if (!entity) continue;
+
+                auto standings = std::make_unique<components::Standings>();
+                standings->faction_standings[faction] = 5.0f;
+                standings->faction_standings[enemy] = -5.0f;
+                entity->addComponent(std::move(standings));
+
+                auto ai = std::make_unique<components::AI>();
+                ai->behavior = components::AI::Behavior::Aggressive;
+                ai->awareness_range = s_.engagement_distance * 2.0f;
+                entity->addComponent(std::move(ai));
+
+                auto weapon = std::make_unique<components::Weapon>();
+                weapon->damage = 12.0f;
+                weapon->optimal_range = 5000.0f;
+                weapon->rate_of_fire = 4.0f;
+                entity->addComponent(std::move(weapon));
+
+                anchor.members.push_back(id);
+                ++npc_ships_;
+            }
+        }
+        anchors_.push_back(std::move(anchor));
+    }
+}
+
+void LoadDriver::spawnMining() {
+    const size_t fields = static_cast<size_t>(std::max(s_.asteroid_fields, 0));
+    std::vector<size_t> field_anchors;
+    for (size_t f = 0; f < fields; ++f) {
+        Anchor anchor;
+        anchor.kind = "asteroid_field";
+        anchor.center = onRing(s_.world_radius * 0.5f, f, fields, 0.25f);
+        for (int d = 0; d < s_.deposits_per_field; ++d) {
+            std::string id = "deposit_" + std::to_string(f) + "_" + std::to_string(d);
+            auto* entity = world_.createEntity(id);
+            if (!entity) continue;
+            Vec3 at = scatter(rng_, anchor.center, 8000.0f);
+            auto pos = std::make_unique<components::Position>();
+            pos->x = at.x;  pos->y = at.y;  pos->z = at.z;
+            entity->addComponent(std::move(pos));
+            auto deposit = std::make_unique<components::MineralDeposit>();
+            deposit->mineral_type = (d % 2) ? "Ferrite" : "Galvite";
+            entity->addComponent(std::move(deposit));
+            anchor.members.push_back(id);
+            ++deposit_count_;
+        }
+        field_anchors.push_back(anchors_.size());
+        anchors_.push_back(std::move(anchor));
+    }
+    if (field_anchors.empty()) return;
+
+    for (int i = 0; i < s_.miners; ++i) {
+        Anchor& field = anchors_[field_anchors[static_cast<size_t>(i) % field_anchors.size()]];
+        std::string id = "npc_miner_" + std::to_string(i);
+        auto* entity = spawnShip(world_, id, scatter(rng_, field.center, 12000.0f),
+                                 "Venture", "Solari", 200.0f);
+        if (!entity) continue;
+
+        auto ai = std::make_unique<components::AI>();
+        ai->behavior = components::AI::Behavior::Passive;
+        ai->awareness_range = 30000.0f;
+        if (!stations_.empty()) {
+            ai->haul_station_id = anchors_[stations_[static_cast<size_t>(i) % stations_.size()]]
+                                      .members.front();
+        }
+        entity->addComponent(std::move(ai));
+        entity->addComponent(std::make_unique<components::MiningLaser>());
+        entity->addComponent(std::make_unique<components::Inventory>());
+
+        field.members.push_back(id);
+        ++miner_count_;
+    }
+}
+
+void LoadDriver::spawnHaulers() {
+    if (stations_.empty()) return;
+    for (int i = 0; i < s_.haulers; ++i) {
+        size_t home = static_cast<size_t>(i) % stations_.size();
+        Anchor& station = anchors_[stations_[home]];
+        std::string id = "npc_hauler_" + std::to_string(i);
+        auto* entity = spawnShip(world_, id, scatter(rng_, station.center, 3000.0f),
+                                 "Badger", "Aurelian", 150.0f);
+        if (!entity) continue;
+
+        auto ai = std::make_unique<components::AI>();
+        ai->behavior = components::AI::Behavior::Passive;
+        entity->addComponent(std::move(ai));
+        entity->addComponent(std::make_unique<components::Inventory>());
+
+        station.members.push_back(id);
+        haulers_.push_back({id, (home + 1) % stations_.size()});
+    }
+}
+
+void LoadDriver::spawnPlayers() {
+    if (anchors_.empty() || s_.players <= 0) return;
+    const size_t binary_clients = static_cast<size_t>(
+        std::lround(std::clamp(s_.binary_fraction, 0.0f, 1.0f) * static_cast<float>(s_.players)));
+
+    for (int i = 0; i < s_.players; ++i) {
+        FakeClient client;
+        client.client_id = 1000 + i;
+        client.entity_id = "player_" + std::to_string(i);
+        client.binary = static_cast<size_t>(i) < binary_clients;
+        client.anchor = static_cast<size_t>(i) % anchors_.size();
+
+        const Anchor& anchor = anchors_[client.anchor];
+        auto* entity = spawnShip(world_, client.entity_id, scatter(rng_, anchor.center, 5000.0f),
+                                 "Fang", "Keldari", 300.0f);
+        if (!entity) continue;
+
+        auto player = std::make_unique<components::Player>();
+        player->player_id = "bench_" + std::to_string(i);
+        player->character_name = "Bench Pilot " + std::to_string(i);
+        entity->addComponent(std::move(player));
+
+        // Same defaults as GameSession::createPlayerEntity: hostile to pirates
+        auto standings = std::make_unique<components::Standings>();
+        for (const char* faction : kFleetFactions) {
+            standings->faction_standings[faction] = -5.0f;
+        }
+        entity->addComponent(std::move(standings));
+
+        auto weapon = std::make_unique<components::Weapon>();
+        weapon->damage = 15.0f;
+        weapon->optimal_range = 6000.0f;
+        entity->addComponent(std::move(weapon));
+
+        set_.interest->registerClient(client.client_id, client.entity_id);
+        clients_.push_back(std::move(client));
+    }
+}
+
+void LoadDriver::loadCargo(ecs::Entity* hauler) {
+    auto* inv = hauler->getComponent<components::Inventory>();
+    if (!inv) return;
+    components::Inventory::Item item;
+    item.item_id = "Ferrite";
+    item.name = "Ferrite";
+    item.type = "ore";
+    item.quantity = 1000;
+    item.volume = 0.1f;
+    inv->items.push_back(item);
+}
+
+const std::string* LoadDriver::pickTarget(const Anchor& anchor, const std::string& self) {
+    if (anchor.members.empty()) return nullptr;
+    // A few tries: fleet members die and players are their own anchor members
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        const std::string& id = anchor.members[rng_.below(anchor.members.size())];
+        if (id != self && world_.getEntity(id)) return &id;
+    }
+    return nullptr;
+}
+
+void LoadDriver::issueCommand(FakeClient& client) {
+    if (!world_.getEntity(client.entity_id)) return;   // ship destroyed
+
+    float roll = rng_.unit();
+    const Anchor& anchor = anchors_[client.anchor];
+    ++commands_issued_;
+
+    if (roll < 0.10f && anchors_.size() > 1) {
+        // Leave for another anchor
+        client.anchor = (client.anchor + 1 + rng_.below(anchors_.size() - 1)) % anchors_.size();
+        Vec3 to = scatter(rng_, anchors_[client.anchor].center, 5000.0f);
+        set_.movement->commandWarp(client.entity_id, to.x, to.y, to.z);
+        return;
+    }
+    if (roll < 0.20f) {
+        set_.movement->commandStop(client.entity_id);
+        return;
+    }
+
+    const std::string* target = pickTarget(anchor, client.entity_id);
+    if (!target) return;
+    if (roll < 0.50f) {
+        set_.movement->commandApproach(client.entity_id, *target);
+    } else if (roll < 0.80f) {
+        set_.movement->commandOrbit(client.entity_id, *target, 2500.0f);
+    } else {
+        set_.targeting->startLock(client.entity_id, *target);
+    }
+}
+
+void LoadDriver::beforeTick(int tick) {
+    // Haulers that delivered (and went idle) load up for the next station
+    for (auto& hauler : haulers_) {
+        auto* entity = world_.getEntity(hauler.entity_id);
+        if (!entity) continue;
+        auto* ai = entity->getComponent<components::AI>();
+        if (!ai || ai->state != components::AI::State::Idle) continue;
+        loadCargo(entity);
+        ai->haul_station_id = anchors_[stations_[hauler.next_station]].members.front();
+        ai->state = components::AI::State::Hauling;
+        hauler.next_station = (hauler.next_station + 1) % stations_.size();
+    }
+
+    // Each client acts every command_interval_ticks, staggered by id
+    const int interval = std::max(s_.command_interval_ticks, 1);
+    for (auto& client : clients_) {
+        if ((tick + client.client_id) % interval == 0) issueCommand(client);
+    }
+}
+
+uint64_t LoadDriver::replicate(bool measured) {
+    uint64_t total = 0;
+    for (auto& client : clients_) {
+        uint64_t seq = sequence_++;
+        std::string state_msg = client.binary
+            ? set_.replication->buildDeltaUpdateBinary(client.client_id, seq)
+            : set_.replication->buildDeltaUpdate(client.client_id, seq);
+        if (!measured) continue;
+        client.bytes += state_msg.size();
+        total += state_msg.size();
+        spawn_messages_ += set_.replication->getLastSpawned().size();
+        despawn_messages_ += set_.replication->getLastDespawned().size();
+    }
+    return total;
+}
+
+// ---------------------------------------------------------------------------
+// Measurement
+// ---------------------------------------------------------------------------
+
+/// Peak resident set size of this process in KiB (0 where unsupported)
+long peakRssKb() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;   // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+/// Nearest-rank percentile of sorted, non-empty `values`
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/// FNV-1a over every entity's id, position and health, in id order
+uint64_t stateChecksum(ecs::World& world) {
+    std::vector<ecs::Entity*> entities = world.getAllEntities();
+    std::sort(entities.begin(), entities.end(),
+              [](const ecs::Entity* a, const ecs::Entity* b) { return a->getId() < b->getId(); });
+
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+    };
+    for (auto* entity : entities) {
+        mix(entity->getId().data(), entity->getId().size());
+        if (auto* pos = entity->getComponent<components::Position>()) {
+            float v[3] = {pos->x, pos->y, pos->z};
+            mix(v, sizeof(v));
+        }
+        if (auto* hp = entity->getComponent<components::Health>()) {
+            float v[3] = {hp->shield_hp, hp->armor_hp, hp->hull_hp};
+            mix(v, sizeof(v));
+        }
+    }
+    return hash;
+}
+
+/// Ships whose hull is gone; the production set applies damage but leaves
+/// removal to the session, so they stay in the world
+size_t destroyedShips(ecs::World& world) {
+    size_t count = 0;
+    for (auto* entity : world.getAllEntities()) {
+        auto* hp = entity->getComponent<components::Health>();
+        if (hp && !hp->isAlive()) ++count;
+    }
+    return count;
+}
+
+struct ZoneTotals {
+    utils::ProfileCategory category = utils::ProfileCategory::Other;
+    double total_ms = 0.0;
+};
+
+void usage() {
+    std::cerr << "usage: server_bench <scenario.json> [--ticks N] [--warmup N] [--seed N]\n"
+                 "                    [--threads N] [--out report.json]\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+
+    Scenario scenario;
+    const std::string scenario_path = argv[1];
+    if (!loadScenario(scenario_path, scenario)) {
+        std::cerr << "server_bench: cannot read scenario " << scenario_path << "\n";
+        return 1;
+    }
+
+    std::string out_path;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (arg == "--ticks") scenario.ticks = std::atoi(value);
+        else if (arg == "--warmup") scenario.warmup_ticks = std::atoi(value);
+        else if (arg == "--seed") scenario.seed = std::atoi(value);
+        else if (arg == "--threads") scenario.worker_threads = std::atoi(value);
+        else if (arg == "--out") out_path = value;
+        else {
+            usage();
+            return 2;
+        }
+    }
+    scenario.ticks = std::max(scenario.ticks, 1);
+    scenario.warmup_ticks = std::max(scenario.warmup_ticks, 0);
+    if (scenario.tick_rate <= 0.0f) scenario.tick_rate = 30.0f;
+
+    // System logging would dominate the timings (and stdout)
+    auto& log = utils::Logger::instance();
+    log.setConsoleOutput(false);
+    log.setFileOutput(false);
+
+    ecs::World world;
+    systems::ServerSystems set = systems::addServerSystems(&world);
+    if (scenario.worker_threads > 0) {
+        world.setWorkerThreads(static_cast<size_t>(scenario.worker_threads));
+    }
+
+    utils::TickProfiler profiler;
+    profiler.setThreadName("tick");
+    world.setProfiler(&profiler);
+
+    LoadDriver driver(scenario, world, set);
+    driver.populate();
+    const size_t entities_start = world.getEntityCount();
+    const long setup_rss_kb = peakRssKb();
+
+    std::cerr << "server_bench: " << scenario.name << ", " << entities_start << " entities, "
+              << driver.clients().size() << " clients, " << scenario.warmup_ticks << " + "
+              << scenario.ticks << " ticks\n";
+
+    const float dt = 1.0f / scenario.tick_rate;
+    const int total_ticks = scenario.warmup_ticks + scenario.ticks;
+    std::vector<double> tick_ms;
+    tick_ms.reserve(static_cast<size_t>(scenario.ticks));
+    std::map<std::string, ZoneTotals> zone_totals;
+    uint64_t replicated_bytes = 0;
+
+    for (int tick = 0; tick < total_ticks; ++tick) {
+        const bool measured = tick >= scenario.warmup_ticks;
+        if (tick == scenario.warmup_ticks) {
+            // Restart the rolling statistics so they cover only measured ticks
+            profiler.setWindowTicks(static_cast<size_t>(scenario.ticks));
+        }
+
+        int64_t start_ns = utils::TickProfiler::nowNs();
+        {
+            utils::ProfileScope zone(&profiler, "Bench::clientCommands",
+                                     utils::ProfileCategory::Network);
+            driver.beforeTick(tick);
+        }
+        world.update(dt);
+        {
+            utils::ProfileScope zone(&profiler, "GameSession::update",
+                                     utils::ProfileCategory::Network);
+            replicated_bytes += driver.replicate(measured);
+        }
+        int64_t end_ns = utils::TickProfiler::nowNs();
+        profiler.record("Server::tick", utils::ProfileCategory::Tick, start_ns, end_ns);
+        profiler.endTick();
+
+        if (!measured) continue;
+        tick_ms.push_back(static_cast<double>(end_ns - start_ns) / 1.0e6);
+        for (const auto& sample : profiler.getLastTick()) {
+            ZoneTotals& totals = zone_totals[sample.name];
+            totals.category = sample.category;
+            totals.total_ms += sample.ms;
+        }
+    }
+
+    // --- Report ---------------------------------------------------------
+
+    const double measured_ticks = static_cast<double>(tick_ms.size());
+    std::vector<double> sorted = tick_ms;
+    std::sort(sorted.begin(), sorted.end());
+    double tick_total = 0.0;
+    for (double ms : tick_ms) tick_total += ms;
+    const double budget_ms = 1000.0 / static_cast<double>(scenario.tick_rate);
+    size_t over_budget = static_cast<size_t>(
+        sorted.end() - std::upper_bound(sorted.begin(), sorted.end(), budget_ms));
+
+    uint64_t json_bytes = 0, binary_bytes = 0, max_client_bytes = 0;
+    size_t json_clients = 0, binary_clients = 0;
+    for (const auto& client : driver.clients()) {
+        (client.binary ? binary_bytes : json_bytes) += client.bytes;
+        (client.binary ? binary_clients : json_clients) += 1;
+        max_client_bytes = std::max(max_client_bytes, client.bytes);
+    }
+    auto perClientTick = [&](uint64_t bytes, size_t clients) {
+        return clients ? static_cast<double>(bytes) / (static_cast<double>(clients) * measured_ticks)
+                       : 0.0;
+    };
+    const double bytes_per_client_tick = perClientTick(replicated_bytes, driver.clients().size());
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(4);
+    out << "{\n"
+        << "  \"benchmark\": \"server_bench\",\n"
+        << "  \"scenario\": \"" << json::escapeString(scenario.name) << "\",\n"
+        << "  \"description\": \"" << json::escapeString(scenario.description) << "\",\n"
+        << "  \"seed\": " << scenario.seed << ",\n"
+        << "  \"ticks\": " << scenario.ticks << ",\n"
+        << "  \"warmup_ticks\": " << scenario.warmup_ticks << ",\n"
+        << "  \"tick_rate\": " << scenario.tick_rate << ",\n"
+        << "  \"worker_threads\": " << world.getWorkerThreads() << ",\n"
+        << "  \"systems_under_test\": \"" << systems::serverSystemNames() << "\",\n";
+
+    out << "  \"population\": {\n"
+        << "    \"stations\": " << driver.stationCount() << ",\n"
+        << "    \"deposits\": " << driver.depositCount() << ",\n"
+        << "    \"npc_ships\": " << driver.npcShipCount() << ",\n"
+        << "    \"miners\": " << driver.minerCount() << ",\n"
+        << "    \"haulers\": " << driver.haulerCount() << ",\n"
+        << "    \"players\": " << driver.clients().size() << ",\n"
+        << "    \"entities_start\": " << entities_start << ",\n"
+        << "    \"entities_end\": " << world.getEntityCount() << ",\n"
+        << "    \"destroyed_ships\": " << destroyedShips(world) << ",\n"
+        << "    \"client_commands\": " << driver.commandsIssued() << "\n"
+        << "  },\n";
+
+    out << "  \"tick_ms\": {\n"
+        << "    \"budget\": " << budget_ms << ",\n"
+        << "    \"mean\": " << tick_total / measured_ticks << ",\n"
+        << "    \"p50\": " << percentile(sorted, 0.50) << ",\n"
+        << "    \"p90\": " << percentile(sorted, 0.90) << ",\n"
+        << "    \"p99\": " << percentile(sorted, 0.99) << ",\n"
+        << "    \"max\": " << sorted.back() << ",\n"
+        << "    \"over_budget\": " << over_budget << "\n"
+        << "  },\n";
+
+    // Costliest first, as the console's profile table
+    std::vector<utils::ProfileZoneStats> stats = profiler.getStats();
+    out << "  \"zones\": [";
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const auto& z = stats[i];
+        const ZoneTotals& totals = zone_totals[z.name];
+        out << (i ? ",\n" : "\n")
+            << "    {\"name\": \"" << json::escapeString(z.name) << "\""
+            << ", \"category\": \"" << utils::profileCategoryName(z.category) << "\""
+            << ", \"ticks\": " << z.samples
+            << ", \"mean_ms\": " << totals.total_ms / measured_ticks
+            << ", \"p50_ms\": " << z.p50_ms
+            << ", \"p99_ms\": " << z.p99_ms
+            << ", \"max_ms\": " << z.max_ms
+            << ", \"share\": " << (tick_total > 0.0 ? totals.total_ms / tick_total : 0.0) << "}";
+    }
+    out << "\n  ],\n";
+
+    out << "  \"memory\": {\n"
+        << "    \"setup_peak_rss_kb\": " << setup_rss_kb << ",\n"
+        << "    \"peak_rss_kb\": " << peakRssKb() << "\n"
+        << "  },\n";
+
+    out << std::setprecision(1)
+        << "  \"replication\": {\n"
+        << "    \"clients\": " << driver.clients().size() << ",\n"
+        << "    \"json_clients\": " << json_clients << ",\n"
+        << "    \"binary_clients\": " << binary_clients << ",\n"
+        << "    \"payload_bytes\": " << replicated_bytes << ",\n"
+        << "    \"bytes_per_client_tick\": " << bytes_per_client_tick << ",\n"
+        << "    \"bytes_per_client_second\": " << bytes_per_client_tick * scenario.tick_rate << ",\n"
+        << "    \"json_bytes_per_client_tick\": " << perClientTick(json_bytes, json_clients) << ",\n"
+        << "    \"binary_bytes_per_client_tick\": " << perClientTick(binary_bytes, binary_clients) << ",\n"
+        << "    \"max_client_bytes\": " << max_client_bytes << ",\n"
+        << "    \"spawn_messages\": " << driver.spawnMessages() << ",\n"
+        << "    \"despawn_messages\": " << driver.despawnMessages() << "\n"
+        << "  },\n";
+
+    std::ostringstream checksum;
+    checksum << std::hex << std::setw(16) << std::setfill('0') << stateChecksum(world);
+    out << "  \"state_checksum\": \"" << checksum.str() << "\"\n"
+        << "}\n";
+
+    if (out_path.empty()) {
+        std::cout << out.str();
+    } else {
+        std::ofstream file(out_path);
+        if (!file.is_open()) {
+            std::cerr << "server_bench: cannot write " << out_path << "\n";
+            return 1;
+        }
+        file << out.str();
+        std::cerr << "server_bench: report written to " << out_path << "\n";
+    }
+
+    std::cerr << std::fixed << std::setprecision(3) << "server_bench: tick p50 "
+              << percentile(sorted, 0.50) << " ms, p99 " << percentile(sorted, 0.99)
+              << " ms, max " << sorted.back() << " ms\n";
+    return 0;
+}
@@ -2,6 +2,7 @@
 #define NOVAFORGE_COMPONENTS_CORE_COMPONENTS_H
 
 #include "ecs/component.h"
+#include "ecs/entity_handle.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -192,6 +193,10 @@ public:
     bool use_dynamic_orbit = false;  // if true, orbit_distance set from ship class
     float engagement_range = 0.0f;  // 0 = derive from weapon optimal+falloff
     std::string haul_station_id;    // destination station for hauling ore
+
+    // Handle caches for the string IDs above (see World::resolve)
+    ecs::EntityHandle target_handle;
+    ecs::EntityHandle haul_station_handle;
     
     COMPONENT_TYPE(AI)
 };
@@ -2,6 +2,7 @@
 #define NOVAFORGE_COMPONENTS_SHIP_COMPONENTS_H
 
 #include "ecs/component.h"
+#include "ecs/entity_handle.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -277,6 +278,7 @@ public:
 class Docked : public ecs::Component {
 public:
     std::string station_id;              // entity id of the station
+    ecs::EntityHandle station_handle;    // cache for station_id (see World::resolve)
 
     COMPONENT_TYPE(Docked)
 };
@@ -17,6 +17,8 @@ struct ServerConfig {
     std::string host = "0.0.0.0";
     uint16_t port = 8765;
     int max_connections = 100;
+    int network_io_threads = 2;             // epoll reactor threads (Linux)
+    int max_send_queue_kb = 1024;           // per-client outbound limit before disconnect
     
     // Server settings
     std::string server_name = "Nova Forge Dedicated Server";
@@ -24,6 +26,10 @@ struct ServerConfig {
     bool persistent_world = true;
     bool auto_save = true;
     int save_interval_seconds = 300; // 5 minutes
+    bool compress_saves = false;     // json format only: write world_state.json.gz
+    std::string save_format = "binary";  // "binary" (world_state.bin) or "json"
+    int journal_interval_seconds = 5;    // change journal between saves; 0 = off
+    int journal_max_mb = 64;             // save early once the journal is this big
     
     // Access control
     bool use_whitelist = false;
@@ -39,6 +45,8 @@ struct ServerConfig {
     // Game settings
     float tick_rate = 30.0f;
     int max_entities = 10000;
+    bool tick_profiler = true;           // per-system tick timings (console: profile)
+    int profiler_window_ticks = 600;     // ticks behind the profiler's p50/p99/max
     
     // Paths
     std::string data_path = "../data";
@@ -0,0 +1,99 @@
+#ifndef NOVAFORGE_DATA_ASYNC_WORLD_SAVER_H
+#define NOVAFORGE_DATA_ASYNC_WORLD_SAVER_H
+
+#include "data/world_persistence.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief Saves world state on a background thread
+ *
+ * requestSave() is the only part that runs on the caller's (tick) thread:
+ * it takes a World::clone() of the live world, which costs one component
+ * copy per component and no formatting.  Serialisation in the requested
+ * SaveFormat, gzip compression for CompressedJson and the atomic rename onto the save file
+ * (WorldPersistence::writeSaveFile) then happen on the saver's worker.
+ *
+ * One save runs at a time.  A request made while another is still queued
+ * replaces the queued one, since only the newest state is worth writing.
+ */
+class AsyncWorldSaver {
+public:
+    struct Result {
+        std::string filepath;
+        bool success = false;
+        double duration_ms = 0.0;   ///< serialise + compress + write
+        size_t bytes = 0;           ///< serialised size before compression
+        uint64_t tag = 0;           ///< as passed to requestSave
+    };
+
+    using CompletionHandler = std::function<void(const Result&)>;
+
+    AsyncWorldSaver() = default;
+    ~AsyncWorldSaver();
+
+    AsyncWorldSaver(const AsyncWorldSaver&) = delete;
+    AsyncWorldSaver& operator=(const AsyncWorldSaver&) = delete;
+
+    /**
+     * @brief Capture `world` now and write it to `filepath` in the background
+     *
+     * Call at a tick boundary.  Returns the time spent capturing, in ms,
+     * which is all the caller's thread pays.  `tag` comes back in the
+     * Result (the server passes its WorldJournal snapshot mark).
+     */
+    double requestSave(const ecs::World* world, const std::string& filepath,
+                       SaveFormat format = SaveFormat::Json, uint64_t tag = 0);
+
+    /// Called on the worker thread after every save attempt
+    void setCompletionHandler(CompletionHandler handler);
+
+    /// True while a save is queued or being written
+    bool isBusy() const;
+
+    /// Block until every requested save has finished
+    void waitIdle();
+
+    uint64_t getCompletedCount() const;
+    uint64_t getFailedCount() const;
+    /// Queued saves dropped because a newer request replaced them
+    uint64_t getSupersededCount() const;
+
+private:
+    struct Job {
+        std::unique_ptr<ecs::World> snapshot;
+        std::string filepath;
+        SaveFormat format = SaveFormat::Json;
+        uint64_t tag = 0;
+    };
+
+    void workerLoop();
+
+    WorldPersistence persistence_;
+    CompletionHandler on_complete_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::unique_ptr<Job> pending_;
+    bool writing_ = false;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    uint64_t completed_ = 0;
+    uint64_t failed_ = 0;
+    uint64_t superseded_ = 0;
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // NOVAFORGE_DATA_ASYNC_WORLD_SAVER_H
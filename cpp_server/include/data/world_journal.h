@@ -0,0 +1,141 @@
+#ifndef NOVAFORGE_DATA_WORLD_JOURNAL_H
+#define NOVAFORGE_DATA_WORLD_JOURNAL_H
+
+#include "data/world_persistence.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace atlas {
+namespace data {
+
+/**
+ * @brief Append-only journal of component changes between full saves
+ *
+ * flush() finds the rows (see WorldPersistence::BinaryDelta) that
+ * changed since the previous flush and appends them to the journal
+ * file as one record: a binary delta image framed by a sequence number
+ * and a CRC.  Components are written through raw pointers all over
+ * the server, so there is no write barrier to hook.  A change is
+ * detected by hashing each row and comparing it with the hash from the
+ * last flush.  That costs CPU per component, but the I/O only grows with
+ * what actually changed.
+ *
+ * Records hold whole rows, not field diffs, so replaying a journal that
+ * starts before a snapshot was captured still ends in the current state.
+ * Compaction relies on this:
+ *
+ *  - beginSnapshot() flushes and moves the current file to `path.prev`,
+ *    then returns a mark for the snapshot captured next.
+ *  - commitSnapshot(mark) deletes `path.prev` once that snapshot is on
+ *    disk.  If a snapshot fails, `.prev` stays (later records keep going
+ *    to `path`) until a newer snapshot commits.
+ *  - open() replays `path.prev`, then `path`, on top of the loaded
+ *    snapshot.  It stops at the first damaged record and drops the torn
+ *    tail.
+ *
+ * Records are flushed to the OS on write, so a process crash loses
+ * nothing that was flushed.  A power loss can lose what the OS had not
+ * yet written out.
+ */
+class WorldJournal {
+public:
+    struct FlushStats {
+        size_t entities = 0;    ///< entities with new or changed rows
+        size_t rows = 0;        ///< rows written
+        size_t destroyed = 0;
+        size_t removed = 0;     ///< components dropped from live entities
+        size_t bytes = 0;       ///< record size, 0 if nothing changed
+        double duration_ms = 0.0;
+    };
+
+    WorldJournal() = default;
+    ~WorldJournal();
+
+    WorldJournal(const WorldJournal&) = delete;
+    WorldJournal& operator=(const WorldJournal&) = delete;
+
+    /**
+     * @brief Recover from and start appending to the journal at `path`
+     *
+     * Replays `path.prev` and `path` onto `world`, which should already hold
+     * the last full save.  The result becomes the baseline for the next flush.
+     * @return false if the journal file cannot be opened for appending
+     */
+    bool open(ecs::World* world, const std::string& path);
+
+    void close();
+    bool isOpen() const;
+
+    /// Append the changes since the last flush as one record (none if
+    /// nothing changed).  Call at a tick boundary.
+    /// @return false on a write error
+    bool flush(const ecs::World* world);
+
+    /// Flush, then rotate so the records the next snapshot covers can be
+    /// dropped.  Returns the mark to pass to commitSnapshot().
+    uint64_t beginSnapshot(const ecs::World* world);
+
+    /// The snapshot captured at `mark` is durable.  Safe to call from the
+    /// background saver's thread.
+    void commitSnapshot(uint64_t mark);
+
+    /**
+     * @brief Apply the records in a journal file to `world`
+     *
+     * Stops at the first damaged record.
+     * @param valid_bytes receives the length of the undamaged prefix
+     * @param last_sequence receives the last applied record's sequence
+     * @return records applied, or -1 if the file cannot be read
+     */
+    static int replay(ecs::World* world, const std::string& path,
+                      size_t* valid_bytes = nullptr, uint64_t* last_sequence = nullptr);
+
+    const FlushStats& getLastFlush() const { return last_flush_; }
+    uint64_t getRecordCount() const { return records_; }
+    /// Bytes in the journal files on disk (current + .prev)
+    uint64_t getJournalBytes() const;
+
+private:
+    struct Shadow {
+        std::vector<std::pair<uint32_t, uint64_t>> rows;   ///< (kind, hash) in kind order
+        uint64_t stamp = 0;
+    };
+
+    /// Diff `world` against the shadow and fill `delta`; the new row
+    /// hashes wait in pending_ until commitChanges()
+    void collectChanges(const ecs::World* world, WorldPersistence::BinaryDelta& delta,
+                        size_t& rows);
+    /// Make `delta` (just written) the new baseline
+    void commitChanges(const WorldPersistence::BinaryDelta& delta);
+    bool appendRecord(const std::string& image);
+    bool openForAppend();
+
+    WorldPersistence persistence_;
+    std::string path_;
+    std::FILE* file_ = nullptr;
+
+    std::unordered_map<std::string, Shadow> shadow_;
+    uint64_t stamp_ = 0;
+    std::vector<std::pair<uint32_t, uint64_t>> scratch_;
+    std::vector<std::vector<std::pair<uint32_t, uint64_t>>> pending_;   // parallel to delta.entities
+
+    mutable std::mutex mutex_;     // guards the fields below, file_ and the files
+    uint64_t sequence_ = 0;        // last record written
+    bool has_prev_ = false;
+    uint64_t prev_last_sequence_ = 0;
+    uint64_t current_bytes_ = 0;
+    uint64_t prev_bytes_ = 0;
+
+    uint64_t records_ = 0;
+    FlushStats last_flush_;
+};
+
+} // namespace data
+} // namespace atlas
+
+#endif // NOVAFORGE_DATA_WORLD_JOURNAL_H
@@ -2,11 +2,22 @@
 #define NOVAFORGE_DATA_WORLD_PERSISTENCE_H
 
 #include "ecs/world.h"
+#include <cstdint>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace atlas {
 namespace data {
 
+/// On-disk encodings a world save can use
+enum class SaveFormat : uint8_t {
+    Json,            ///< plain JSON (export / debugging)
+    CompressedJson,  ///< gzip-compressed JSON
+    Binary           ///< versioned columnar binary (see saveWorldBinary)
+};
+
 /**
  * @brief Serializes and deserializes world state for persistent worlds
  *
@@ -16,6 +27,14 @@ namespace data {
  * emotional state, captain memory, fleet formation, fleet cargo pool,
  * rumor log, mineral deposit, system resources, market hub) to a JSON
  * file and restores it on load.
+ *
+ * The binary format stores the same data column-wise for fast restarts:
+ * a header, the entity ID column, then one block per component type
+ * with its field schema (name + type per column) ahead of the values.
+ * Loading matches columns to fields by name, so saves written before a
+ * field was added still load (the new field keeps its default) and
+ * columns that no longer exist are skipped.  Components that hold
+ * nested containers are stored as one JSON column instead.
  */
 class WorldPersistence {
 public:
@@ -47,13 +66,91 @@ public:
     /// Deserialize a JSON string into the world.
     bool deserializeWorld(ecs::World* world, const std::string& json) const;
 
+    /// Save the world in the binary columnar format.
+    /// @return true on success
+    bool saveWorldBinary(const ecs::World* world, const std::string& filepath);
+
+    /// Load a binary save.  The file is memory-mapped where supported and
+    /// each component column is built in one pass.
+    /// @return true on success, false on missing, truncated or foreign files
+    bool loadWorldBinary(ecs::World* world, const std::string& filepath);
+
+    /// Serialize world state to the binary format (bytes in a string).
+    std::string serializeWorldBinary(const ecs::World* world) const;
+
+    /// Deserialize a binary save image into the world.
+    bool deserializeWorldBinary(ecs::World* world, const void* data, size_t size) const;
+
+    /// Save in the given format.
+    bool saveWorldAs(const ecs::World* world, const std::string& filepath, SaveFormat format);
+
+    /// Load a save of any format, detected from the file's first bytes.
+    bool loadWorldFile(ecs::World* world, const std::string& filepath);
+
+    /// Serialize in the given format (compression happens in writeSaveFile).
+    std::string serializeAs(const ecs::World* world, SaveFormat format) const;
+
+    // --- Binary rows, for incremental journaling (see WorldJournal) ---
+    //
+    // A row is what the binary format stores for one component of one
+    // entity.  Row kinds number the component blocks in a fixed order,
+    // with the nested-component JSON row last.  Kinds are only stable
+    // within a process; delta images name blocks by key.
+
+    /// Changes to write as one binary delta image
+    struct BinaryDelta {
+        std::vector<const ecs::Entity*> entities;   ///< entities with new or changed rows
+        std::vector<std::vector<uint32_t>> kinds;   ///< per entity: the row kinds to write
+        std::vector<std::string> destroyed;         ///< IDs of entities that no longer exist
+        std::vector<std::pair<std::string, uint32_t>> removed;  ///< (entity ID, kind) dropped
+    };
+
+    /// Number of row kinds
+    static size_t binaryRowKinds();
+
+    /// Hash every row `entity` has, as (kind, hash) in kind order
+    void hashBinaryRows(const ecs::Entity* entity,
+                        std::vector<std::pair<uint32_t, uint64_t>>& rows) const;
+
+    /// Encode a delta: listed rows, destroyed entities and removed components
+    std::string serializeDeltaBinary(const BinaryDelta& delta) const;
+
+    /// Apply a delta image on top of the world's current state.  Listed
+    /// rows replace the component (creating the entity if needed), then
+    /// destroyed entities and removed components are dropped.
+    bool applyDeltaBinary(ecs::World* world, const void* data, size_t size) const;
+
+    /// Write serialized world data to `filepath`, gzip-compressed if asked.
+    /// The data goes to `filepath + ".tmp"` and is then renamed over the
+    /// target, so an interrupted save never replaces the last good file.
+    /// @return true on success
+    static bool writeSaveFile(const std::string& data, const std::string& filepath,
+                              bool compressed);
+
 private:
+    /// gzip `json` into `filepath` (world_persistence_compressed.cpp)
+    static bool writeCompressed(const std::string& json, const std::string& filepath);
+
     /// Serialize a single entity to a JSON object string.
     std::string serializeEntity(const ecs::Entity* entity) const;
 
     /// Deserialize a single entity JSON object and create it in the world.
     bool deserializeEntity(ecs::World* world, const std::string& json) const;
 
+    /// Components holding nested containers (standings, inventory, orders, ...).
+    /// Shared by the JSON format and the binary format's JSON column.
+    void serializeNestedComponents(const ecs::Entity* entity, std::ostringstream& json) const;
+    void deserializeNestedComponents(ecs::Entity* entity, const std::string& json) const;
+    void removeNestedComponents(ecs::Entity* entity) const;
+
+    /// Nested components as one JSON object, or "" if the entity has none
+    std::string nestedJsonRow(const ecs::Entity* entity) const;
+
+    /// Shared writer/reader for full images and deltas (world_binary.cpp)
+    std::string writeBinaryImage(const std::vector<const ecs::Entity*>& entities,
+                                 const BinaryDelta* delta) const;
+    bool readBinaryImage(ecs::World* world, const void* data, size_t size, bool delta) const;
+
     // Lightweight JSON helpers
     static std::string extractString(const std::string& json, const std::string& key);
     static float extractFloat(const std::string& json, const std::string& key, float fallback = 0.0f);
@@ -0,0 +1,189 @@
+#ifndef NOVAFORGE_ECS_COMPONENT_POOL_H
+#define NOVAFORGE_ECS_COMPONENT_POOL_H
+
+#include "component.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+class Entity;
+class EntityQuery;
+
+/// Dense, process-wide identifier assigned to each component type on first use
+using ComponentTypeId = uint32_t;
+
+/// Dense, process-wide identifier for a query's component type list
+using QuerySignatureId = uint32_t;
+
+namespace detail {
+ComponentTypeId nextComponentTypeId();
+QuerySignatureId nextQuerySignatureId();
+} // namespace detail
+
+/**
+ * @brief Get the dense type id for component type T
+ *
+ * Ids are handed out in first-use order and are only stable for the
+ * lifetime of the process — never persist them.
+ */
+template<typename T>
+ComponentTypeId componentTypeId() {
+    static const ComponentTypeId id = detail::nextComponentTypeId();
+    return id;
+}
+
+/**
+ * @brief Get the id for a query over ComponentTypes...
+ *
+ * Different orderings of the same types get different signature ids but
+ * resolve to the same EntityQuery.
+ */
+template<typename... ComponentTypes>
+QuerySignatureId querySignatureId() {
+    static const QuerySignatureId id = detail::nextQuerySignatureId();
+    return id;
+}
+
+/**
+ * @brief Sparse-set storage for a single component type
+ *
+ * Entities are addressed by their World slot index.  The sparse array
+ * maps slot → dense position; the dense arrays hold the owning entity
+ * and a pointer to its component side by side, so queries walk a
+ * contiguous index instead of hashing into every entity.  Component
+ * bodies keep their own heap allocation (callers hand them over as
+ * unique_ptr and may hold the raw pointer), so reading one still costs
+ * a dereference.  Removal swaps the last element into the hole, so
+ * component addresses stay stable but dense order does not.
+ */
+class ComponentPool {
+public:
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+    bool contains(uint32_t slot) const {
+        return slot < sparse_.size() && sparse_[slot] != npos;
+    }
+
+    Component* get(uint32_t slot) const {
+        return contains(slot) ? components_[sparse_[slot]].get() : nullptr;
+    }
+
+    /// Component for a slot known to be present (no membership check)
+    Component* at(uint32_t slot) const {
+        return components_[sparse_[slot]].get();
+    }
+
+    /// Insert (or replace) the component for an entity slot
+    void insert(uint32_t slot, Entity* entity, std::unique_ptr<Component> component);
+
+    /// Remove the component for an entity slot; returns false if absent
+    bool remove(uint32_t slot);
+
+    /// Pre-size the dense arrays for `additional` more components
+    void reserve(size_t additional) {
+        entities_.reserve(entities_.size() + additional);
+        slots_.reserve(slots_.size() + additional);
+        components_.reserve(components_.size() + additional);
+    }
+
+    size_t size() const { return entities_.size(); }
+    bool empty() const { return entities_.empty(); }
+
+    /// Dense entity array, parallel to components()
+    const std::vector<Entity*>& entities() const { return entities_; }
+    const std::vector<std::unique_ptr<Component>>& components() const { return components_; }
+
+private:
+    std::vector<uint32_t> sparse_;
+    std::vector<uint32_t> slots_;
+    std::vector<Entity*> entities_;
+    std::vector<std::unique_ptr<Component>> components_;
+};
+
+/**
+ * @brief Owns one ComponentPool per component type used by a World,
+ *        plus the World's cached EntityQuery objects.
+ *
+ * All structural changes (add/remove component, entity destruction) go
+ * through here so that registered queries are updated incrementally.
+ */
+class ComponentStorage {
+public:
+    ComponentStorage();
+    ~ComponentStorage();
+
+    ComponentStorage(const ComponentStorage&) = delete;
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    /// Pool for T, or nullptr if no T has ever been added
+    template<typename T>
+    ComponentPool* find() const {
+        return find(componentTypeId<T>());
+    }
+
+    ComponentPool* find(ComponentTypeId id) const {
+        return id < pools_.size() ? pools_[id].get() : nullptr;
+    }
+
+    /// Pool for a runtime type_index, or nullptr if unknown
+    ComponentPool* find(const std::type_index& type) const;
+
+    /// Pool for T, created on first use
+    template<typename T>
+    ComponentPool& acquire() {
+        return acquire(componentTypeId<T>(), std::type_index(typeid(T)));
+    }
+
+    ComponentPool& acquire(ComponentTypeId id, const std::type_index& type);
+
+    /// Insert (or replace) a component and update affected queries
+    void insert(ComponentTypeId id, const std::type_index& type, uint32_t slot,
+                Entity* entity, std::unique_ptr<Component> component);
+
+    /// Remove a component and update affected queries
+    void remove(ComponentTypeId id, uint32_t slot);
+
+    /// Drop every component owned by an entity slot
+    void removeAll(uint32_t slot);
+
+    const std::vector<std::unique_ptr<ComponentPool>>& pools() const { return pools_; }
+
+    /**
+     * @brief Get (registering on first use) the query for a signature.
+     *
+     * `types` and `label` are only consulted the first time a signature
+     * is seen.  Registration is serialised so systems running in parallel
+     * may look queries up concurrently.
+     */
+    EntityQuery& query(QuerySignatureId signature,
+                       const std::vector<ComponentTypeId>& types,
+                       const std::string& label);
+
+    /// All registered queries, in registration order
+    std::vector<const EntityQuery*> queries() const;
+
+private:
+    bool matches(const EntityQuery& query, uint32_t slot) const;
+
+    std::vector<std::unique_ptr<ComponentPool>> pools_;
+    std::unordered_map<std::type_index, ComponentTypeId> type_ids_;
+
+    std::vector<std::unique_ptr<EntityQuery>> queries_;
+    std::map<std::vector<ComponentTypeId>, EntityQuery*> queries_by_types_;
+    std::vector<EntityQuery*> queries_by_signature_;
+    std::vector<std::vector<EntityQuery*>> queries_by_component_;
+    mutable std::mutex query_mutex_;
+};
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // NOVAFORGE_ECS_COMPONENT_POOL_H
@@ -2,8 +2,9 @@
 #define NOVAFORGE_ECS_ENTITY_H
 
 #include "component.h"
+#include "component_pool.h"
+#include "entity_handle.h"
 #include <string>
-#include <unordered_map>
 #include <typeindex>
 #include <memory>
 #include <vector>
@@ -16,14 +17,27 @@ namespace ecs {
  * 
  * Entities are just IDs with attached components.
  * They represent ships, NPCs, projectiles, stations, etc.
+ *
+ * Components are not stored on the entity itself; they live in the
+ * owning World's per-type ComponentPools, addressed by the entity's
+ * slot index.  Entities are only created through World::createEntity.
  */
 class Entity {
 public:
-    explicit Entity(const std::string& id);
+    Entity(const std::string& id, EntityHandle handle, ComponentStorage* storage);
     ~Entity() = default;
+
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
     
     // Get entity ID
     const std::string& getId() const { return id_; }
+
+    // Slot index of this entity in its World's component pools
+    uint32_t getSlot() const { return slot_; }
+
+    // Generational handle for this entity (stays unique after destruction)
+    EntityHandle getHandle() const { return {slot_, generation_}; }
     
     // Component management
     template<typename T>
@@ -46,47 +60,45 @@ public:
     
 private:
     std::string id_;
-    std::unordered_map<std::type_index, std::unique_ptr<Component>> components_;
+    uint32_t slot_;
+    uint32_t generation_;
+    ComponentStorage* storage_;
 };
 
 // Template implementation
 template<typename T>
 Entity& Entity::addComponent(std::unique_ptr<T> component) {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    components_[std::type_index(typeid(T))] = std::move(component);
+    storage_->insert(componentTypeId<T>(), std::type_index(typeid(T)), slot_, this,
+                     std::move(component));
     return *this;
 }
 
 template<typename T>
 void Entity::removeComponent() {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    components_.erase(std::type_index(typeid(T)));
+    storage_->remove(componentTypeId<T>(), slot_);
 }
 
 template<typename T>
 T* Entity::getComponent() {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    auto it = components_.find(std::type_index(typeid(T)));
-    if (it != components_.end()) {
-        return static_cast<T*>(it->second.get());
-    }
-    return nullptr;
+    auto* pool = storage_->find<T>();
+    return pool ? static_cast<T*>(pool->get(slot_)) : nullptr;
 }
 
 template<typename T>
 const T* Entity::getComponent() const {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    auto it = components_.find(std::type_index(typeid(T)));
-    if (it != components_.end()) {
-        return static_cast<const T*>(it->second.get());
-    }
-    return nullptr;
+    auto* pool = storage_->find<T>();
+    return pool ? static_cast<const T*>(pool->get(slot_)) : nullptr;
 }
 
 template<typename T>
 bool Entity::hasComponent() const {
     static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-    return components_.find(std::type_index(typeid(T))) != components_.end();
+    auto* pool = storage_->find<T>();
+    return pool && pool->contains(slot_);
 }
 
 } // namespace ecs
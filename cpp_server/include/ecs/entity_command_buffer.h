@@ -0,0 +1,151 @@
+#ifndef NOVAFORGE_ECS_ENTITY_COMMAND_BUFFER_H
+#define NOVAFORGE_ECS_ENTITY_COMMAND_BUFFER_H
+
+#include "component.h"
+#include "component_pool.h"
+#include "entity.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+// Forward declaration
+class World;
+
+/**
+ * @brief Records structural changes for a World and applies them later.
+ *
+ * Creating/destroying entities and adding/removing components invalidate
+ * queries and pool iteration, so code that is not on the tick thread
+ * (network handlers) or that runs while other systems iterate (parallel
+ * systems) records them here instead.  Commands are applied in recording
+ * order by playback(), which World calls at its sync points: before the
+ * first system and after the last one in World::update().
+ *
+ * Commands name entities by string ID, so a command may refer to an
+ * entity created earlier in the same buffer.  Commands whose entity no
+ * longer exists at playback are dropped.
+ *
+ * Recording and playback are serialised by an internal mutex; each thread
+ * normally records into its own buffer (World::commands()), so the lock is
+ * uncontended except while the tick thread plays that buffer back.
+ *
+ * Usage:
+ * @code
+ *   auto& cmd = world_->commands();
+ *   cmd.destroyEntity(entity_id);
+ *   cmd.createEntity("npc_7", [](Entity* e) {
+ *       e->addComponent(std::make_unique<components::Position>());
+ *   });
+ * @endcode
+ */
+class EntityCommandBuffer {
+public:
+    using InitFn = std::function<void(Entity*)>;
+    using BatchInitFn = std::function<void(Entity*, size_t)>;
+
+    EntityCommandBuffer() = default;
+
+    EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+    EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+    /// Create (or replace) an entity; init runs right after creation
+    void createEntity(const std::string& id, InitFn init = nullptr);
+
+    /**
+     * @brief Create N entities with a single round of world/pool growth.
+     *
+     * Slot tables, the ID map and the pools for ComponentTypes are grown
+     * once for the whole batch before init(entity, index) runs for each.
+     */
+    template<typename... ComponentTypes>
+    void spawnBatch(std::vector<std::string> ids, BatchInitFn init);
+
+    void destroyEntity(const std::string& id);
+
+    template<typename T>
+    void addComponent(const std::string& id, std::unique_ptr<T> component);
+
+    template<typename T>
+    void removeComponent(const std::string& id);
+
+    /// Arbitrary deferred effect, applied in order with the other commands
+    void run(std::function<void(World&)> fn);
+
+    /// Apply and clear every recorded command
+    void playback(World& world);
+
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+private:
+    enum class Kind { Create, SpawnBatch, Destroy, AddComponent, RemoveComponent, Run };
+
+    using AddFn = void (*)(Entity*, std::unique_ptr<Component>);
+    using RemoveFn = void (*)(Entity*);
+
+    struct Command {
+        explicit Command(Kind k) : kind(k) {}
+
+        Kind kind;
+        std::string id;
+        std::vector<std::string> ids;          // SpawnBatch
+        std::unique_ptr<Component> component;  // AddComponent
+        AddFn add = nullptr;
+        RemoveFn remove = nullptr;
+        std::vector<std::pair<ComponentTypeId, std::type_index>> reserve;  // SpawnBatch
+        InitFn init;
+        BatchInitFn batch_init;
+        std::function<void(World&)> fn;       // Run
+    };
+
+    void push(Command command);
+
+    mutable std::mutex mutex_;
+    std::vector<Command> commands_;
+    std::vector<Command> playing_;   // swapped in by playback(); keeps capacity
+};
+
+// Template implementation
+
+template<typename... ComponentTypes>
+void EntityCommandBuffer::spawnBatch(std::vector<std::string> ids, BatchInitFn init) {
+    Command command(Kind::SpawnBatch);
+    command.ids = std::move(ids);
+    command.batch_init = std::move(init);
+    command.reserve = {{componentTypeId<ComponentTypes>(), std::type_index(typeid(ComponentTypes))}...};
+    push(std::move(command));
+}
+
+template<typename T>
+void EntityCommandBuffer::addComponent(const std::string& id, std::unique_ptr<T> component) {
+    static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+    Command command(Kind::AddComponent);
+    command.id = id;
+    command.component = std::move(component);
+    command.add = [](Entity* entity, std::unique_ptr<Component> c) {
+        entity->addComponent(std::unique_ptr<T>(static_cast<T*>(c.release())));
+    };
+    push(std::move(command));
+}
+
+template<typename T>
+void EntityCommandBuffer::removeComponent(const std::string& id) {
+    static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+    Command command(Kind::RemoveComponent);
+    command.id = id;
+    command.remove = [](Entity* entity) { entity->template removeComponent<T>(); };
+    push(std::move(command));
+}
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // NOVAFORGE_ECS_ENTITY_COMMAND_BUFFER_H
@@ -0,0 +1,57 @@
+#ifndef NOVAFORGE_ECS_ENTITY_HANDLE_H
+#define NOVAFORGE_ECS_ENTITY_HANDLE_H
+
+#include <cstdint>
+#include <functional>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Generational integer reference to an entity
+ *
+ * `index` is the entity's World slot; `generation` is bumped every time
+ * that slot is freed, so a handle to a destroyed entity never resolves
+ * to whatever reuses its slot.  Resolving is two array reads — no string
+ * hashing or allocation.  Generation 0 is never issued, so a default-
+ * constructed handle is the null handle.
+ *
+ * Handles are process-local: protocol messages and saves keep using the
+ * entity's string ID (see World::getEntityName / World::findHandle).
+ */
+struct EntityHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    bool isNull() const { return generation == 0; }
+    explicit operator bool() const { return generation != 0; }
+
+    /// Pack into a single 64-bit value (e.g. for use as a map key)
+    uint64_t value() const {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+
+    static EntityHandle fromValue(uint64_t v) {
+        return {static_cast<uint32_t>(v & 0xFFFFFFFFu), static_cast<uint32_t>(v >> 32)};
+    }
+
+    bool operator==(const EntityHandle& o) const {
+        return index == o.index && generation == o.generation;
+    }
+    bool operator!=(const EntityHandle& o) const { return !(*this == o); }
+    bool operator<(const EntityHandle& o) const { return value() < o.value(); }
+};
+
+} // namespace ecs
+} // namespace atlas
+
+namespace std {
+template<>
+struct hash<atlas::ecs::EntityHandle> {
+    size_t operator()(const atlas::ecs::EntityHandle& h) const {
+        return std::hash<uint64_t>()(h.value());
+    }
+};
+} // namespace std
+
+#endif // NOVAFORGE_ECS_ENTITY_HANDLE_H
@@ -0,0 +1,83 @@
+#ifndef NOVAFORGE_ECS_ENTITY_QUERY_H
+#define NOVAFORGE_ECS_ENTITY_QUERY_H
+
+#include "component_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Persistent, incrementally maintained set of entities that have
+ *        every component in a fixed type list.
+ *
+ * Queries are registered once per World (see World::query) and kept up
+ * to date by ComponentStorage on add/remove-component and entity
+ * destruction, so reading one never rescans the world.  Iterating it
+ * does not allocate.
+ *
+ * The range is invalidated by any structural change that touches one of
+ * the query's component types (and by entity destruction).  Loops that
+ * add/remove those components or destroy entities must iterate a copy,
+ * e.g. World::getEntities.
+ *
+ * Usage:
+ * @code
+ *   auto& hostiles = world_->query<components::Position, components::AI>();
+ *   for (auto* entity : hostiles) { ... }
+ * @endcode
+ */
+class EntityQuery {
+public:
+    using const_iterator = std::vector<Entity*>::const_iterator;
+
+    EntityQuery(std::vector<ComponentTypeId> types, std::string label)
+        : types_(std::move(types)), label_(std::move(label)) {}
+
+    EntityQuery(const EntityQuery&) = delete;
+    EntityQuery& operator=(const EntityQuery&) = delete;
+
+    const_iterator begin() const { return entities_.begin(); }
+    const_iterator end() const { return entities_.end(); }
+    size_t size() const { return entities_.size(); }
+    bool empty() const { return entities_.empty(); }
+
+    /// Matching entities, in insertion order (perturbed by swap-removal)
+    const std::vector<Entity*>& entities() const { return entities_; }
+
+    bool contains(uint32_t slot) const {
+        return slot < sparse_.size() && sparse_[slot] != ComponentPool::npos;
+    }
+
+    /// Sorted component type ids this query matches on
+    const std::vector<ComponentTypeId>& types() const { return types_; }
+
+    /// Human-readable component list, for diagnostics
+    const std::string& label() const { return label_; }
+
+    /// Number of times this query was fetched through World::query/getEntities
+    uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    void recordHit() const { hits_.fetch_add(1, std::memory_order_relaxed); }
+    void resetHits() { hits_.store(0, std::memory_order_relaxed); }
+
+private:
+    friend class ComponentStorage;
+
+    void add(uint32_t slot, Entity* entity);
+    void remove(uint32_t slot);
+
+    std::vector<ComponentTypeId> types_;
+    std::string label_;
+    std::vector<uint32_t> sparse_;
+    std::vector<uint32_t> slots_;
+    std::vector<Entity*> entities_;
+    mutable std::atomic<uint64_t> hits_{0};
+};
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // NOVAFORGE_ECS_ENTITY_QUERY_H
@@ -3,7 +3,12 @@
 
 #include "system.h"
 #include "world.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace atlas {
 namespace ecs {
@@ -35,6 +40,16 @@ namespace ecs {
  *       }
  *   };
  * @endcode
+ *
+ * Parallel mode (opt-in via enableParallel()): the query result is split
+ * into fixed-size chunks that run on the World's thread pool.  processEntity
+ * must then only touch the entity's own component C; anything else
+ * (structural changes, writes to other entities) goes through defer(),
+ * which is applied on the calling thread after all chunks finish, in
+ * entity order.  Without a pool (World::setWorkerThreads(0)) the system
+ * runs serially and defer() executes immediately.  Deferred effects still
+ * run inside update(), so a system that defers structural changes must not
+ * declare component access (see System::reads).
  */
 template <typename C>
 class SingleComponentSystem : public System {
@@ -42,11 +57,38 @@ public:
     using System::System;  // inherit constructor
 
     void update(float delta_time) override {
-        auto entities = world_->getEntities<C>();
-        for (auto* entity : entities) {
-            auto* comp = entity->template getComponent<C>();
-            if (!comp) continue;
-            processEntity(entity, comp, delta_time);
+        // Snapshot the cached query into a reused buffer so processEntity
+        // may change structure without invalidating the iteration, and
+        // steady-state ticks do not allocate.
+        const auto& matching = world_->template query<C>();
+        entities_.assign(matching.begin(), matching.end());
+
+        ThreadPool* pool = world_->getThreadPool();
+        if (chunk_size_ == 0 || !pool || entities_.size() <= chunk_size_) {
+            for (auto* entity : entities_) {
+                auto* comp = entity->template getComponent<C>();
+                if (!comp) continue;
+                processEntity(entity, comp, delta_time);
+            }
+            return;
+        }
+
+        size_t chunk_count = (entities_.size() + chunk_size_ - 1) / chunk_size_;
+        if (deferred_.size() < chunk_count) deferred_.resize(chunk_count);
+        {
+            TaskGroup group(*pool);
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+                group.run([this, chunk, delta_time] { runChunk(chunk, delta_time); });
+            }
+            group.wait();
+        }
+
+        // Sync point: apply deferred effects in entity order
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            for (auto& effect : deferred_[chunk]) {
+                effect();
+            }
+            deferred_[chunk].clear();
         }
     }
 
@@ -58,8 +100,53 @@ protected:
      * @param dt      Delta time in seconds.
      */
     virtual void processEntity(Entity* entity, C* comp, float dt) = 0;
+
+    /**
+     * @brief Opt in to chunked parallel execution.
+     * @param chunk_size Entities per task; 0 turns parallel mode off.
+     */
+    void enableParallel(size_t chunk_size = 256) { chunk_size_ = chunk_size; }
+
+    /**
+     * @brief Run an effect after the parallel pass (immediately when serial).
+     *
+     * Use for anything outside the entity's own component: creating or
+     * destroying entities, adding/removing components, writing to other
+     * entities.
+     */
+    void defer(std::function<void()> effect) {
+        if (current_chunk_) {
+            current_chunk_->push_back(std::move(effect));
+        } else {
+            effect();
+        }
+    }
+
+private:
+    void runChunk(size_t chunk, float delta_time) {
+        auto* outer = current_chunk_;
+        current_chunk_ = &deferred_[chunk];
+        size_t begin = chunk * chunk_size_;
+        size_t end = std::min(begin + chunk_size_, entities_.size());
+        for (size_t i = begin; i < end; ++i) {
+            auto* comp = entities_[i]->template getComponent<C>();
+            if (!comp) continue;
+            processEntity(entities_[i], comp, delta_time);
+        }
+        current_chunk_ = outer;
+    }
+
+    std::vector<Entity*> entities_;
+    size_t chunk_size_ = 0;
+    std::vector<std::vector<std::function<void()>>> deferred_;
+
+    // Deferred-effect list of the chunk running on this thread
+    static thread_local std::vector<std::function<void()>>* current_chunk_;
 };
 
+template <typename C>
+thread_local std::vector<std::function<void()>>* SingleComponentSystem<C>::current_chunk_ = nullptr;
+
 } // namespace ecs
 } // namespace atlas
 
@@ -1,7 +1,10 @@
 #ifndef NOVAFORGE_ECS_SYSTEM_H
 #define NOVAFORGE_ECS_SYSTEM_H
 
+#include "component_pool.h"
+#include "entity_command_buffer.h"
 #include <string>
+#include <vector>
 
 namespace atlas {
 namespace ecs {
@@ -9,9 +12,26 @@ namespace ecs {
 // Forward declaration
 class World;
 
+/**
+ * @brief Component access a System declares for the parallel scheduler
+ *
+ * A system that declares nothing is treated as exclusive: it runs alone,
+ * ordered against every other system, exactly as in serial mode.
+ */
+struct SystemAccess {
+    std::vector<ComponentTypeId> reads;
+    std::vector<ComponentTypeId> writes;
+    bool declared = false;
+
+    bool exclusive() const { return !declared; }
+
+    /// True if the two systems must keep their registration order
+    bool conflictsWith(const SystemAccess& other) const;
+};
+
 /**
  * @brief Base class for all systems
- * 
+ *
  * Systems operate on entities with specific component combinations.
  * They contain the game logic that processes component data.
  */
@@ -19,20 +39,60 @@ class System {
 public:
     explicit System(World* world) : world_(world) {}
     virtual ~System() = default;
-    
+
     /**
      * @brief Update this system
      * @param delta_time Time elapsed since last update (in seconds)
      */
     virtual void update(float delta_time) = 0;
-    
+
     /**
      * @brief Get system name for debugging
      */
     virtual std::string getName() const = 0;
-    
+
+    /// Component access declared via reads<T>() / writes<T>()
+    const SystemAccess& getAccess() const { return access_; }
+
 protected:
+    /**
+     * @brief Declare that update() reads component T
+     *
+     * Once a system declares any access it may run concurrently with
+     * systems it does not conflict with.  Such a system must only touch
+     * the declared components and its own members during update(); it
+     * must record entity creation/destruction and component add/remove
+     * through commands() instead of applying them directly.
+     */
+    template<typename T>
+    void reads() {
+        access_.reads.push_back(componentTypeId<T>());
+        access_.declared = true;
+    }
+
+    /// Declare that update() writes component T (see reads())
+    template<typename T>
+    void writes() {
+        access_.writes.push_back(componentTypeId<T>());
+        access_.declared = true;
+    }
+
+    /**
+     * @brief This system's structural-change buffer.
+     *
+     * Played back by World::update() after every system has run, in system
+     * registration order, so the result does not depend on which worker
+     * ran the system.
+     */
+    EntityCommandBuffer& commands() { return commands_; }
+
     World* world_;
+
+private:
+    friend class World;
+
+    SystemAccess access_;
+    EntityCommandBuffer commands_;
 };
 
 } // namespace ecs
@@ -0,0 +1,65 @@
+#ifndef NOVAFORGE_ECS_SYSTEM_SCHEDULER_H
+#define NOVAFORGE_ECS_SYSTEM_SCHEDULER_H
+
+#include "system.h"
+#include "thread_pool.h"
+#include "utils/tick_profiler.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Dependency graph over a World's systems, built from SystemAccess
+ *
+ * System j depends on an earlier-registered system i when their declared
+ * accesses conflict (write/write, write/read, or either is exclusive).
+ * Running the graph therefore produces the same component state as
+ * running the systems serially in registration order: any two systems
+ * that could observe each other keep that order, and the rest touch
+ * disjoint data.
+ */
+class SystemScheduler {
+public:
+    /// Rebuild the graph; systems must outlive the scheduler or next build()
+    void build(const std::vector<System*>& systems);
+
+    /// Run every system once, in parallel where the graph allows
+    void run(ThreadPool& pool, float delta_time);
+
+    /// Run every system once on the calling thread, in registration order
+    void runSerial(float delta_time);
+
+    size_t getSystemCount() const { return systems_.size(); }
+
+    /// Time every System::update into `profiler` (nullptr: stop)
+    void setProfiler(utils::TickProfiler* profiler);
+
+    /// Indices of the systems that must finish before `index` may start
+    const std::vector<size_t>& getDependencies(size_t index) const { return dependencies_[index]; }
+
+    /// Number of sequential stages on the longest dependency chain
+    size_t getCriticalPathLength() const { return critical_path_; }
+
+private:
+    void runNode(ThreadPool& pool, TaskGroup& group, size_t index, float delta_time);
+    void runSystem(size_t index, float delta_time);
+    void internZoneNames();
+
+    std::vector<System*> systems_;
+    std::vector<std::vector<size_t>> dependencies_;
+    std::vector<std::vector<size_t>> dependents_;
+    std::vector<size_t> roots_;
+    std::unique_ptr<std::atomic<size_t>[]> remaining_;   // per-run countdown
+    size_t critical_path_ = 0;
+    utils::TickProfiler* profiler_ = nullptr;
+    std::vector<const char*> zone_names_;   // per system, interned in profiler_
+};
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // NOVAFORGE_ECS_SYSTEM_SCHEDULER_H
@@ -0,0 +1,87 @@
+#ifndef NOVAFORGE_ECS_THREAD_POOL_H
+#define NOVAFORGE_ECS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace atlas {
+namespace ecs {
+
+/**
+ * @brief Small work-stealing thread pool for the simulation tick
+ *
+ * Each worker owns a deque: it pops its own newest task and, when empty,
+ * steals the oldest task from another worker.  Tasks submitted from a
+ * worker go to that worker's deque (good locality for fan-out); tasks
+ * from outside are spread round-robin.
+ *
+ * Waiting is cooperative: a thread blocked in TaskGroup::wait() runs
+ * queued tasks itself, so nested fan-out never deadlocks and a pool
+ * with zero workers still makes progress on the calling thread.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t worker_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getWorkerCount() const { return workers_.size(); }
+
+    void submit(Task task);
+
+    /// Run one queued task on the calling thread; false if none was found
+    bool tryRunOne();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popTask(size_t preferred, Task& out);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<size_t> pending_{0};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
+
+/**
+ * @brief Tracks a batch of tasks and waits for all of them
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+    ~TaskGroup() { wait(); }
+
+    void run(ThreadPool::Task task);
+
+    /// Block until every task started through this group has finished
+    void wait();
+
+private:
+    ThreadPool& pool_;
+    std::atomic<size_t> outstanding_{0};
+    std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+} // namespace ecs
+} // namespace atlas
+
+#endif // NOVAFORGE_ECS_THREAD_POOL_H
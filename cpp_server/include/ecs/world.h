@@ -2,13 +2,22 @@
 #define NOVAFORGE_ECS_WORLD_H
 
 #include "entity.h"
+#include "component_pool.h"
+#include "entity_query.h"
+#include "entity_handle.h"
+#include "entity_command_buffer.h"
 #include "system.h"
+#include "system_scheduler.h"
+#include "thread_pool.h"
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <typeindex>
 #include <algorithm>
+#include <utility>
 
 namespace atlas {
 namespace ecs {
@@ -18,6 +27,25 @@ namespace ecs {
  * 
  * The World represents the game state and coordinates
  * all entities and systems in the game.
+ *
+ * Entities are named by string ID for protocol and persistence, but
+ * each one also occupies an integer slot.  Components are stored per
+ * type in sparse-set ComponentPools keyed by that slot, so multi-
+ * component queries walk the smallest matching pool densely rather
+ * than hashing into every entity.
+ *
+ * Component-filtered lookups are served by cached EntityQuery objects
+ * that are registered on first use and maintained incrementally as
+ * components are added/removed and entities destroyed.
+ *
+ * Systems run serially in registration order by default.  With
+ * setWorkerThreads(n > 0) they are scheduled on a work-stealing pool
+ * according to the component access each System declares; the result
+ * matches the serial order (see SystemScheduler).
+ *
+ * Structural changes from other threads, or from systems that run in
+ * parallel, are recorded in EntityCommandBuffers and applied at the sync
+ * points in update(): before the first system and after the last one.
  */
 class World {
 public:
@@ -27,58 +55,258 @@ public:
     // Entity management
     Entity* createEntity(const std::string& id);
     void destroyEntity(const std::string& id);
+
+    /**
+     * @brief Create several entities, growing the slot tables and ID map
+     *        once for the whole batch.
+     */
+    std::vector<Entity*> createEntities(const std::vector<std::string>& ids);
+
+    /// Pre-size the pools of ComponentTypes for `count` more components
+    template<typename... ComponentTypes>
+    void reserveComponents(size_t count) {
+        reserveComponents({{componentTypeId<ComponentTypes>(),
+                            std::type_index(typeid(ComponentTypes))}...}, count);
+    }
+    void reserveComponents(const std::vector<std::pair<ComponentTypeId, std::type_index>>& types,
+                           size_t count);
+
+    /**
+     * @brief Command buffer for the calling thread.
+     *
+     * Safe to call from any thread (e.g. network handlers).  Each thread
+     * gets its own buffer; buffers are played back at the next sync point
+     * in the order the threads first asked for one.  Inside a system's
+     * update(), prefer System::commands(), whose playback order is fixed.
+     */
+    EntityCommandBuffer& commands();
+
+    /// Apply every pending command buffer now (a sync point)
+    void flushCommands();
+
     Entity* getEntity(const std::string& id);
     const Entity* getEntity(const std::string& id) const;
     
+    // Generational handles (see EntityHandle)
+    Entity* resolve(EntityHandle handle) const {
+        return handle.index < slots_.size() && generations_[handle.index] == handle.generation
+                   ? slots_[handle.index] : nullptr;
+    }
+    bool isAlive(EntityHandle handle) const { return resolve(handle) != nullptr; }
+
+    /**
+     * @brief Resolve a string reference through a cached handle.
+     *
+     * Components that keep a string ID for protocol/persistence can keep
+     * an EntityHandle beside it.  While the cached handle is live and
+     * still names `id`, this is an O(1) slot read plus a string compare;
+     * otherwise it falls back to one by-name lookup and refreshes `cache`
+     * (to the null handle if `id` does not exist).
+     */
+    Entity* resolve(EntityHandle& cache, const std::string& id) const;
+
+    /// Handle → name side table, for protocol and persistence (nullptr if stale)
+    const std::string* getEntityName(EntityHandle handle) const {
+        const Entity* entity = resolve(handle);
+        return entity ? &entity->getId() : nullptr;
+    }
+
+    /// Name → handle (null handle if no such entity)
+    EntityHandle findHandle(const std::string& id) const {
+        const Entity* entity = getEntity(id);
+        return entity ? entity->getHandle() : EntityHandle{};
+    }
+    
     // Get all entities
     std::vector<Entity*> getAllEntities();
+
+    /**
+     * @brief Deep copy of every entity and component, for saving.
+     *
+     * Entities keep their IDs and slot order, so serialising the copy
+     * gives the same output as serialising this World; slots are
+     * compacted, so handles cached in components only resolve by name.
+     * Systems, queries and pending commands are not copied.  Call at a
+     * tick boundary; the copy can then be read on another thread.
+     */
+    std::unique_ptr<World> clone() const;
     
-    // Get entities with specific components
+    /**
+     * @brief Get entities with specific components
+     *
+     * Returns a copy of the cached query for ComponentTypes, so callers
+     * may freely create/destroy entities or change components while
+     * iterating the result.  Prefer query() in read-only hot loops.
+     */
     template<typename... ComponentTypes>
     std::vector<Entity*> getEntities();
+
+    /**
+     * @brief Persistent query over entities having all ComponentTypes
+     *
+     * Registered on first call and kept up to date afterwards; iterating
+     * it does not allocate.  Each call counts as one hit on the query.
+     * See EntityQuery for iterator invalidation rules.
+     */
+    template<typename... ComponentTypes>
+    EntityQuery& query();
+
+    /// All queries registered on this world, with their hit counters
+    std::vector<const EntityQuery*> getQueries() const { return storage_.queries(); }
+
+    /**
+     * @brief Invoke fn(Entity*, ComponentTypes*...) for every entity that
+     *        has all of the given components, without allocating.
+     *
+     * fn must not add or remove any of the queried component types, nor
+     * create or destroy entities, while iterating.
+     */
+    template<typename... ComponentTypes, typename Fn>
+    void each(Fn&& fn);
     
     // System management
     void addSystem(std::unique_ptr<System> system);
     
     // Update all systems
     void update(float delta_time);
+
+    /**
+     * @brief Set the number of worker threads used by update().
+     *
+     * 0 (the default) runs every system on the calling thread.  The
+     * calling thread also executes systems while it waits, so n workers
+     * give up to n + 1 systems in flight.
+     */
+    void setWorkerThreads(size_t count);
+    size_t getWorkerThreads() const { return pool_ ? pool_->getWorkerCount() : 0; }
+
+    /// Pool behind setWorkerThreads(), for intra-system parallelism (nullptr if serial)
+    ThreadPool* getThreadPool() const { return pool_.get(); }
+
+    /// Dependency graph used by update() (rebuilt when systems change)
+    const SystemScheduler& getScheduler();
+
+    /**
+     * @brief Time each system's update() and the command sync points
+     *
+     * Zones are named after System::getName().  nullptr stops profiling;
+     * the profiler must outlive the World or be unset first.
+     */
+    void setProfiler(utils::TickProfiler* profiler);
+    utils::TickProfiler* getProfiler() const { return profiler_; }
     
     // Get entity count
     size_t getEntityCount() const { return entities_.size(); }
     
 private:
+    ComponentStorage storage_;
     std::unordered_map<std::string, std::unique_ptr<Entity>> entities_;
+    std::vector<Entity*> slots_;          // slot → entity (nullptr if free)
+    std::vector<uint32_t> generations_;   // slot → current generation
+    std::vector<uint32_t> free_slots_;
     std::vector<std::unique_ptr<System>> systems_;
-    
-    // Helper to get type indices from component types
+    SystemScheduler scheduler_;
+    bool schedule_dirty_ = true;
+    std::unique_ptr<ThreadPool> pool_;
+    utils::TickProfiler* profiler_ = nullptr;
+
+    mutable std::mutex command_mutex_;
+    std::vector<std::pair<std::thread::id, std::unique_ptr<EntityCommandBuffer>>> thread_commands_;
+
+    void flushSystemCommands();
+    uint32_t allocateSlot();
+
+    /**
+     * @brief Pools for a query, resolved once per call.
+     *
+     * `driver` indexes the smallest pool, which the query walks densely;
+     * the remaining pools are only probed for membership.
+     */
+    template<size_t N>
+    struct PoolSet {
+        ComponentPool* pools[N];
+        size_t driver = 0;
+
+        bool matches(uint32_t slot) const {
+            for (size_t k = 0; k < N; ++k) {
+                if (k != driver && !pools[k]->contains(slot)) return false;
+            }
+            return true;
+        }
+    };
+
+    // Resolve the pools for a query; returns false if any pool is empty
     template<typename... ComponentTypes>
-    std::vector<std::type_index> getTypeIndices();
+    bool resolvePools(PoolSet<sizeof...(ComponentTypes)>& set) const;
+
+    template<typename... ComponentTypes, typename Fn, size_t... Is>
+    void eachImpl(const PoolSet<sizeof...(ComponentTypes)>& set, Fn& fn,
+                  std::index_sequence<Is...>);
 };
 
 // Template implementation
+template<typename... ComponentTypes>
+bool World::resolvePools(PoolSet<sizeof...(ComponentTypes)>& set) const {
+    ComponentPool* pools[] = {storage_.find<ComponentTypes>()...};
+    for (size_t k = 0; k < sizeof...(ComponentTypes); ++k) {
+        if (!pools[k] || pools[k]->empty()) return false;
+        set.pools[k] = pools[k];
+        if (pools[k]->size() < pools[set.driver]->size()) set.driver = k;
+    }
+    return true;
+}
+
 template<typename... ComponentTypes>
 std::vector<Entity*> World::getEntities() {
-    std::vector<Entity*> result;
-    
     if constexpr (sizeof...(ComponentTypes) == 0) {
         // Return all entities if no component types specified
         return getAllEntities();
     } else {
-        // Get type indices for the requested components
-        std::vector<std::type_index> types = {std::type_index(typeid(ComponentTypes))...};
-        
-        // Filter entities that have all requested components
-        for (auto& pair : entities_) {
-            Entity* entity = pair.second.get();
-            if (entity->hasComponents(types)) {
-                result.push_back(entity);
-            }
-        }
+        return query<ComponentTypes...>().entities();
     }
-    
+}
+
+template<typename... ComponentTypes>
+EntityQuery& World::query() {
+    static_assert(sizeof...(ComponentTypes) > 0, "query() needs at least one component type");
+    static const std::vector<ComponentTypeId> types = {componentTypeId<ComponentTypes>()...};
+    static const std::string label = [] {
+        std::string names;
+        for (const char* name : {typeid(ComponentTypes).name()...}) {
+            if (!names.empty()) names += ",";
+            names += name;
+        }
+        return names;
+    }();
+
+    EntityQuery& result = storage_.query(querySignatureId<ComponentTypes...>(), types, label);
+    result.recordHit();
     return result;
 }
 
+template<typename... ComponentTypes, typename Fn, size_t... Is>
+void World::eachImpl(const PoolSet<sizeof...(ComponentTypes)>& set, Fn& fn,
+                     std::index_sequence<Is...>) {
+    const ComponentPool* driver = set.pools[set.driver];
+    const auto& entities = driver->entities();
+    const auto& components = driver->components();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        uint32_t slot = entities[i]->getSlot();
+        if (!set.matches(slot)) continue;
+        fn(entities[i], static_cast<ComponentTypes*>(
+                            Is == set.driver ? components[i].get()
+                                             : set.pools[Is]->at(slot))...);
+    }
+}
+
+template<typename... ComponentTypes, typename Fn>
+void World::each(Fn&& fn) {
+    static_assert(sizeof...(ComponentTypes) > 0, "each() needs at least one component type");
+    PoolSet<sizeof...(ComponentTypes)> set;
+    if (!resolvePools<ComponentTypes...>(set)) return;
+    eachImpl<ComponentTypes...>(set, fn, std::index_sequence_for<ComponentTypes...>{});
+}
+
 } // namespace ecs
 } // namespace atlas
 
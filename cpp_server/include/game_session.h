@@ -4,7 +4,10 @@
 #include "ecs/world.h"
 #include "network/tcp_server.h"
 #include "network/protocol_handler.h"
+#include "network/wire_format.h"
 #include "data/ship_database.h"
+#include "utils/tick_profiler.h"
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <mutex>
@@ -91,6 +94,12 @@ public:
     /// Set pointer to the PCGManager for procedural content generation
     void setPCGManager(pcg::PCGManager* mgr) { pcg_manager_ = mgr; }
 
+    /// Time each message handler into `profiler`, one zone per message type
+    void setProfiler(utils::TickProfiler* profiler) {
+        profiler_ = profiler;
+        handler_zones_.clear();
+    }
+
     /// Get the ship database (read-only)
     const data::ShipDatabase& getShipDatabase() const { return ship_db_; }
 
@@ -102,6 +111,9 @@ private:
      * @param raw Raw message string from network
      */
     void onClientMessage(const network::ClientConnection& client, const std::string& raw);
+
+    /// Profiler zone name for handlers of `type` ("net:<message type>")
+    const char* handlerZone(network::MessageType type);
     
     /**
      * Handle client connection
@@ -335,6 +347,18 @@ private:
      */
     std::string buildSpawnEntity(const std::string& entity_id) const;
 
+    /**
+     * Build entity removal notification
+     *
+     * @return JSON string with format: {"type":"destroy_entity","data":{"entity_id":...}}
+     */
+    std::string buildDestroyEntity(const std::string& entity_id) const;
+
+    /// True when replication spawns and removes entities per client
+    bool replicatesByInterest() const {
+        return snapshot_replication_ && interest_management_;
+    }
+
     // --- NPC management ---
     void spawnInitialNPCs();
     void spawnNPC(const std::string& id, const std::string& name, const std::string& ship,
@@ -387,12 +411,15 @@ private:
     systems::SnapshotReplicationSystem* snapshot_replication_ = nullptr;
     systems::InterestManagementSystem* interest_management_ = nullptr;
     pcg::PCGManager* pcg_manager_ = nullptr;
+    utils::TickProfiler* profiler_ = nullptr;
+    std::map<network::MessageType, const char*> handler_zones_;
 
     // Map socket → entity_id for connected players
     struct PlayerInfo {
         std::string entity_id;
         std::string character_name;
         network::ClientConnection connection;
+        network::WireEncoding encoding = network::WireEncoding::JSON;  // negotiated at connect
     };
 
     std::unordered_map<int, PlayerInfo> players_;  // keyed by socket fd
@@ -0,0 +1,95 @@
+#ifndef NOVAFORGE_NETWORK_MPSC_QUEUE_H
+#define NOVAFORGE_NETWORK_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+namespace atlas {
+namespace network {
+
+/**
+ * @brief Unbounded lock-free multi-producer / single-consumer queue
+ *
+ * Any thread may push(); exactly one thread may pop().  Producers never
+ * block each other or the consumer (one atomic exchange per push), which
+ * is what the network I/O threads need to hand parsed messages to the
+ * tick thread.  Items pop in the order their push() completed, so items
+ * from a single producer stay in order.
+ *
+ * pop() can briefly report empty while a producer is between its two
+ * stores; the item then shows up on the next pop().
+ *
+ * T must be default-constructible and movable.
+ */
+template<typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+    ~MpscQueue() {
+        T discard;
+        while (pop(discard)) {}
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        link(node);
+    }
+
+    bool pop(T& out) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) return false;
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail_ = next;
+            out = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+        if (tail != head_.load(std::memory_order_acquire)) {
+            return false;   // a producer is mid-push
+        }
+        // `tail` is the last node: park the stub behind it so it can be
+        // detached without racing producers
+        stub_.next.store(nullptr, std::memory_order_relaxed);
+        link(&stub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            out = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    void link(Node* node) {
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    Node stub_;
+    std::atomic<Node*> head_;   // producers
+    Node* tail_;                // consumer only
+};
+
+} // namespace network
+} // namespace atlas
+
+#endif // NOVAFORGE_NETWORK_MPSC_QUEUE_H
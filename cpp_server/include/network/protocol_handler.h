@@ -10,6 +10,9 @@ namespace network {
 
 /**
  * @brief Message types matching Python server protocol
+ *
+ * Binary frames carry the enumerator's numeric value: never reorder,
+ * and add new types after ERROR (updating decodeFrame's range check).
  */
 // The Windows SDK defines ERROR as a macro; temporarily remove it so the
 // enum value compiles on MSVC.
@@ -75,14 +78,18 @@ enum class MessageType {
 /**
  * @brief Protocol handler for JSON-based messages
  * 
- * Compatible with existing Python client/server protocol
+ * Compatible with existing Python client/server protocol.  Clients that
+ * negotiate the binary encoding may also send binary frames, whose
+ * payload for these message types is the JSON "data" object.
  */
 class ProtocolHandler {
 public:
     ProtocolHandler();
     
-    // Message parsing
+    // Message parsing.  Also accepts a binary frame (see wire_format.h),
+    // in which case `data` is the frame payload.
     bool parseMessage(const std::string& json, MessageType& type, std::string& data);
+    bool parseFrame(const std::string& raw, MessageType& type, std::string& data);
     
     // Message creation
     std::string createConnectAck(bool success, const std::string& message);
@@ -129,12 +136,14 @@ public:
     
     // Message validation
     bool validateMessage(const std::string& json);
+
+    /// Wire name of `type` (e.g. "input_move")
+    std::string messageTypeToString(MessageType type);
     
 private:
     std::map<std::string, MessageType> message_type_map_;
     
     void initializeMessageTypes();
-    std::string messageTypeToString(MessageType type);
 };
 
 } // namespace network
@@ -1,6 +1,7 @@
 #ifndef NOVAFORGE_TCP_SERVER_H
 #define NOVAFORGE_TCP_SERVER_H
 
+#include "network/mpsc_queue.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -8,6 +9,7 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -37,8 +39,26 @@ struct ClientConnection {
 
 /**
  * @brief TCP server for handling client connections
- * 
- * Manages network communication with game clients
+ *
+ * Manages network communication with game clients.
+ *
+ * On Linux the server is an epoll reactor: a small pool of I/O threads
+ * (setIoThreads) owns every socket, so the thread count does not grow
+ * with the player count.  Other platforms keep one blocking thread per
+ * client behind the same interface.
+ *
+ * Inbound bytes are buffered per connection and split into messages
+ * (newline-terminated JSON or length-prefixed binary frames, see
+ * extractMessages).  Complete messages are pushed onto a lock-free queue
+ * and handed to the message handler by dispatchMessages(), which the
+ * tick thread calls once per tick, so handlers never race the
+ * simulation.
+ *
+ * sendToClient() never blocks: it appends to the connection's outbound
+ * queue and writes as much as the socket accepts, and the I/O thread
+ * flushes the rest.  A client whose queue grows past
+ * setMaxOutboundBytes() is disconnected rather than allowed to stall
+ * the server or silently miss delta updates.
  */
 class TCPServer {
 public:
@@ -50,40 +70,107 @@ public:
     void start();
     void stop();
     bool isRunning() const { return running_; }
-    
+    /// Listening port (the OS-assigned one if constructed with port 0)
+    uint16_t getPort() const { return port_; }
+
+    /// Number of reactor threads (Linux); takes effect on start()
+    void setIoThreads(int count) { io_thread_count_ = count > 0 ? count : 1; }
+    int getIoThreads() const { return io_thread_count_; }
+
+    /// Outbound bytes a client may have queued before it is dropped
+    void setMaxOutboundBytes(size_t bytes) { max_outbound_bytes_ = bytes; }
+    size_t getMaxOutboundBytes() const { return max_outbound_bytes_; }
+
+    /// Largest inbound message accepted before the client is dropped
+    static constexpr size_t kMaxInboundMessageBytes = 64 * 1024;
+
     // Client management
     int getClientCount() const;
     std::vector<ClientConnection> getClients() const;
-    
+
     // Message handling
     using MessageHandler = std::function<void(const ClientConnection&, const std::string&)>;
     void setMessageHandler(MessageHandler handler);
-    
-    // Send data
+
+    /**
+     * @brief Deliver queued inbound messages to the message handler
+     *
+     * Call from the tick thread.  Messages from one client arrive in the
+     * order they were sent.  Returns the number delivered.
+     */
+    size_t dispatchMessages();
+
+    // Send data (non-blocking; false if the client is gone or was dropped)
     bool sendToClient(const ClientConnection& client, const std::string& data);
     void broadcastToAll(const std::string& data);
-    
+
 private:
+    struct Connection {
+        ClientConnection info;
+        std::string inbound;        // bytes not yet split into messages (I/O thread only)
+        int loop = 0;               // owning reactor
+
+        std::mutex out_mutex;       // guards everything below
+        std::string outbound;       // queued bytes; [out_offset, end) unsent
+        size_t out_offset = 0;
+        bool want_write = false;    // registered for EPOLLOUT
+        bool dropped = false;       // shut down; the reader will close it
+        bool closed = false;        // socket closed; never touch it again
+    };
+
+    struct InboundMessage {
+        ClientConnection client;
+        std::string data;
+    };
+
     std::string host_;
     uint16_t port_;
     int max_connections_;
     socket_t server_socket_;
     std::atomic<bool> running_;
-    
-    std::vector<ClientConnection> clients_;
+
+    int io_thread_count_ = 2;
+    size_t max_outbound_bytes_ = 1024 * 1024;
+
+    std::unordered_map<socket_t, std::shared_ptr<Connection>> connections_;
     mutable std::mutex clients_mutex_;
-    
+
     MessageHandler message_handler_;
-    
-    std::thread accept_thread_;
-    std::vector<std::thread> client_threads_;
-    
+    MpscQueue<InboundMessage> inbound_;
+
     // Internal methods
-    void acceptLoop();
-    void handleClient(ClientConnection client);
+    std::shared_ptr<Connection> findConnection(socket_t socket) const;
+    std::shared_ptr<Connection> addConnection(socket_t socket, const sockaddr_in& addr);
+    void removeConnection(Connection& conn);
+    bool receive(Connection& conn, const char* data, size_t size);
+    bool enqueue(Connection& conn, const std::string& data);
+    bool flushLocked(Connection& conn);
+    void dropLocked(Connection& conn, const char* reason);
     void closeSocket(socket_t socket);
     bool initializeSockets();
     void cleanupSockets();
+
+#ifdef __linux__
+    struct IoLoop {
+        int epoll_fd = -1;
+        int wake_fd = -1;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<IoLoop>> loops_;
+    std::atomic<uint32_t> next_loop_{0};
+
+    void ioLoop(IoLoop& loop);
+    void acceptPending();
+    bool readConnection(Connection& conn);
+    void setWriteInterest(Connection& conn, bool enable);
+#else
+    std::thread accept_thread_;
+    std::vector<std::thread> client_threads_;
+
+    void acceptLoop();
+    void handleClient(std::shared_ptr<Connection> conn);
+#endif
 };
 
 } // namespace network
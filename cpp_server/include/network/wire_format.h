@@ -0,0 +1,147 @@
+#ifndef NOVAFORGE_NETWORK_WIRE_FORMAT_H
+#define NOVAFORGE_NETWORK_WIRE_FORMAT_H
+
+#include "network/protocol_handler.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace network {
+
+/**
+ * @brief How messages are encoded for one client
+ *
+ * JSON is the original text protocol and stays the default; a client
+ * opts into BINARY by sending "encoding":"binary" in its connect data.
+ */
+enum class WireEncoding {
+    JSON,
+    BINARY
+};
+
+/// First byte of every binary frame.  Never a valid first byte of a JSON
+/// message, so binary frames and JSON text can share one stream.
+constexpr uint8_t kWireMagic = 0xA7;
+
+/// Bumped whenever a payload layout changes
+constexpr uint8_t kWireVersion = 1;
+
+/// Quantisation steps used by binary payloads (world units per step)
+constexpr float kWirePositionStep = 1.0f / 16.0f;
+constexpr float kWireVelocityStep = 1.0f / 64.0f;
+constexpr float kWireRotationStep = 1.0f / 1024.0f;
+constexpr float kWireStatStep     = 1.0f / 8.0f;
+
+/**
+ * @brief Appends compact binary fields to a byte buffer
+ *
+ * Integers are LEB128 varints (signed values zig-zag encoded first),
+ * floats are either raw little-endian IEEE-754 or quantised to a fixed
+ * step and sent as signed varints, and strings are length-prefixed.
+ * The buffer is reused across messages: clear() keeps its capacity.
+ */
+class WireWriter {
+public:
+    void clear() { buffer_.clear(); }
+    const std::string& data() const { return buffer_; }
+    size_t size() const { return buffer_.size(); }
+
+    void writeU8(uint8_t v) { buffer_.push_back(static_cast<char>(v)); }
+    void writeVarUInt(uint64_t v);
+    void writeVarInt(int64_t v);
+    void writeFloat(float v);
+    void writeQuantized(float v, float step);
+    void writeString(const std::string& s);
+    void writeBytes(const char* data, size_t size) { buffer_.append(data, size); }
+
+private:
+    std::string buffer_;
+};
+
+/**
+ * @brief Reads fields written by WireWriter
+ *
+ * Every read is bounds-checked and returns false (leaving the reader in
+ * a failed state) on truncated or malformed input.
+ */
+class WireReader {
+public:
+    WireReader(const char* data, size_t size) : data_(data), size_(size) {}
+    explicit WireReader(const std::string& s) : WireReader(s.data(), s.size()) {}
+
+    bool readU8(uint8_t& v);
+    bool readVarUInt(uint64_t& v);
+    bool readVarInt(int64_t& v);
+    bool readFloat(float& v);
+    bool readQuantized(float& v, float step);
+    bool readString(std::string& s);
+
+    size_t remaining() const { return failed_ ? 0 : size_ - pos_; }
+    size_t position() const { return pos_; }
+    bool atEnd() const { return pos_ == size_; }
+    bool failed() const { return failed_; }
+
+private:
+    bool fail() { failed_ = true; return false; }
+
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    bool failed_ = false;
+};
+
+/**
+ * @brief One decoded binary frame
+ *
+ * Layout: magic (u8), version (u8), message type (varint), payload
+ * length (varint), payload bytes.  The message type is the MessageType
+ * enumerator's value, so MessageType must only ever be appended to.
+ */
+struct WireFrame {
+    uint8_t version = 0;
+    MessageType type = MessageType::ERROR;
+    std::string payload;
+};
+
+/// Wrap a payload in a frame header
+void appendFrame(std::string& out, MessageType type, const char* payload, size_t size);
+std::string encodeFrame(MessageType type, const std::string& payload);
+
+/// Result of decodeFrame()
+enum class FrameStatus {
+    OK,          ///< a frame was decoded; `consumed` bytes were used
+    INCOMPLETE,  ///< need more bytes
+    INVALID      ///< not a frame, wrong version, or unknown message type
+};
+
+/**
+ * @brief Decode the frame at the start of `data`
+ *
+ * Suitable for stream reassembly: INCOMPLETE means the caller should
+ * wait for more bytes and try again.
+ */
+FrameStatus decodeFrame(const char* data, size_t size, WireFrame& frame, size_t& consumed);
+
+inline bool isBinaryFrame(const std::string& raw) {
+    return !raw.empty() && static_cast<uint8_t>(raw[0]) == kWireMagic;
+}
+
+/**
+ * @brief Split a connection's inbound byte stream into messages
+ *
+ * JSON messages end at '\n' (a trailing '\r' is dropped and blank lines
+ * are skipped); binary frames are length-prefixed and kept whole, header
+ * included.  Complete messages are appended to `out` and removed from
+ * `buffer`; a trailing partial message stays in `buffer` for the next
+ * read.  Returns false if the stream is malformed or a message is larger
+ * than max_message_bytes, in which case the connection should be dropped.
+ */
+bool extractMessages(std::string& buffer, std::vector<std::string>& out,
+                     size_t max_message_bytes);
+
+} // namespace network
+} // namespace atlas
+
+#endif // NOVAFORGE_NETWORK_WIRE_FORMAT_H
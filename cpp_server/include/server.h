@@ -15,8 +15,13 @@
 #include "systems/station_system.h"
 #include "systems/movement_system.h"
 #include "systems/combat_system.h"
+#include "systems/interest_management_system.h"
+#include "systems/snapshot_replication_system.h"
 #include "data/world_persistence.h"
+#include "data/async_world_saver.h"
+#include "data/world_journal.h"
 #include "utils/server_metrics.h"
+#include "utils/tick_profiler.h"
 #include "ui/server_console.h"
 #include "pcg/pcg_manager.h"
 
@@ -53,11 +58,17 @@ public:
     ecs::World* getWorld() { return game_world_.get(); }
 
     // World persistence
+    /// Save synchronously (waits for any background save first)
     bool saveWorld();
+    /// Capture the world now and write it on the background saver
+    bool saveWorldAsync();
     bool loadWorld();
 
     // Metrics
     const utils::ServerMetrics& getMetrics() const { return metrics_; }
+
+    /// Per-system / per-handler tick timings (see ServerConsole "profile")
+    utils::TickProfiler& getProfiler() { return profiler_; }
     
     // Console
     ServerConsole& getConsole() { return console_; }
@@ -71,11 +82,16 @@ private:
     std::unique_ptr<GameSession> game_session_;
     data::WorldPersistence world_persistence_;
     utils::ServerMetrics metrics_;
+    utils::TickProfiler profiler_;
+    data::WorldJournal world_journal_;
+    data::AsyncWorldSaver world_saver_;   // after metrics_, profiler_ and world_journal_: its handler uses them
     ServerConsole console_;
     systems::TargetingSystem* targeting_system_ = nullptr;
     systems::StationSystem* station_system_ = nullptr;
     systems::MovementSystem* movement_system_ = nullptr;
     systems::CombatSystem* combat_system_ = nullptr;
+    systems::InterestManagementSystem* interest_system_ = nullptr;
+    systems::SnapshotReplicationSystem* replication_system_ = nullptr;
     pcg::PCGManager pcg_manager_;
     
     std::atomic<bool> running_;
@@ -84,6 +100,14 @@ private:
     void mainLoop();
     void updateSteam();
     void initializeGameWorld();
+    bool ensureSaveDirectory();
+    data::SaveFormat saveFormat() const;
+    std::string saveFilePath() const;
+    /// First existing save file, configured format first, then any other, or ""
+    std::string findSaveFile() const;
+    std::string journalFilePath() const;
+    /// Append this interval's changes to the journal
+    void flushJournal();
 };
 
 } // namespace atlas
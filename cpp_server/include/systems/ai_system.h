@@ -3,11 +3,14 @@
 
 #include "ecs/system.h"
 #include "ecs/entity.h"
+#include "components/game_components.h"
 #include <string>
 
 namespace atlas {
 namespace systems {
 
+class SpatialHashSystem;
+
 /**
  * @brief Handles AI behavior for NPCs
  * 
@@ -21,6 +24,13 @@ public:
     
     void update(float delta_time) override;
     std::string getName() const override { return "AISystem"; }
+
+    /**
+     * Use a shared per-tick broadphase for target and deposit searches.
+     * Without one, searches scan every candidate entity (O(N) per NPC).
+     * The index must be updated earlier in the same tick.
+     */
+    void setSpatialIndex(const SpatialHashSystem* index) { spatial_index_ = index; }
     
     /**
      * Select a target using the configured TargetSelection strategy.
@@ -89,6 +99,16 @@ public:
     ecs::Entity* findAttackerOfFriendly(ecs::Entity* entity);
     
 private:
+    /**
+     * Invoke fn(candidate, distance) for entities having Position and
+     * every Required component within `range` of `pos`, through the
+     * spatial index when one is set.
+     */
+    template<typename... Required, typename Fn>
+    void forEachNearby(const components::Position& pos, float range, Fn&& fn);
+
+    const SpatialHashSystem* spatial_index_ = nullptr;
+
     /**
      * Idle behavior state
      * 
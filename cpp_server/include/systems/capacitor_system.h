@@ -16,7 +16,10 @@ namespace systems {
  */
 class CapacitorSystem : public ecs::SingleComponentSystem<components::Capacitor> {
 public:
-    using SingleComponentSystem::SingleComponentSystem;
+    explicit CapacitorSystem(ecs::World* world) : SingleComponentSystem(world) {
+        writes<components::Capacitor>();
+        enableParallel();
+    }
     ~CapacitorSystem() override = default;
     
     std::string getName() const override { return "CapacitorSystem"; }
@@ -2,6 +2,7 @@
 #define NOVAFORGE_SYSTEMS_FLEET_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/entity_handle.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -19,6 +20,7 @@ struct FleetMemberInfo {
     std::string squad_id;
     std::string wing_id;
     bool online = true;
+    ecs::EntityHandle handle;  // cache for entity_id (see World::resolve)
 };
 
 /**
@@ -4,6 +4,7 @@
 #include "ecs/system.h"
 #include "ecs/entity.h"
 #include "ecs/world.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -12,6 +13,21 @@
 namespace atlas {
 namespace systems {
 
+class SpatialHashSystem;
+
+/// Distance band an entity falls into for one client
+enum class RelevanceTier : uint8_t {
+    Near,   ///< < nearRange, force-visible or positionless
+    Mid,    ///< < midRange
+    Far     ///< < farRange
+};
+
+/// One entry of a client's relevance set
+struct RelevantEntity {
+    ecs::EntityHandle handle;
+    RelevanceTier tier = RelevanceTier::Near;
+};
+
 /**
  * @brief Per-client interest management for bandwidth optimisation
  *
@@ -27,7 +43,9 @@ namespace systems {
  *   beyond (>= farRange) → excluded unless force_visible
  *
  * force_visible entities (e.g. the client's own ship, fleet members,
- * locked targets) are always included regardless of distance.
+ * locked targets) are always included regardless of distance, in the
+ * near tier.  SnapshotReplicationSystem reads the tiered list to pick
+ * per-entity update rates.
  */
 class InterestManagementSystem : public ecs::System {
 public:
@@ -37,6 +55,13 @@ public:
     void update(float delta_time) override;
     std::string getName() const override { return "InterestManagementSystem"; }
 
+    /**
+     * Use a shared per-tick broadphase for the range test, so each client
+     * costs O(entities in range) instead of O(all entities).  The index
+     * must be updated earlier in the same tick.
+     */
+    void setSpatialIndex(const SpatialHashSystem* index) { spatial_index_ = index; }
+
     // ------------------------------------------------------------------
     // Client registration
     // ------------------------------------------------------------------
@@ -63,6 +88,12 @@ public:
      */
     const std::unordered_set<std::string>& getRelevantEntities(int client_id) const;
 
+    /**
+     * Relevance set with the tier of each entity, or nullptr for an
+     * unknown client.  Same contents as getRelevantEntities().
+     */
+    const std::vector<RelevantEntity>* getRelevantList(int client_id) const;
+
     /** Check if a specific entity is relevant for a client */
     bool isRelevant(int client_id, const std::string& entity_id) const;
 
@@ -88,11 +119,21 @@ private:
     struct ClientData {
         std::string player_entity_id;
         std::unordered_set<std::string> relevant_entities;
+        std::vector<RelevantEntity> relevant_list;
         std::unordered_set<std::string> force_visible;
     };
 
+    void updateWithIndex();
+    void addRelevant(ClientData& cd, const ecs::Entity* entity, RelevanceTier tier);
+    RelevanceTier tierFor(float dist_sq) const;
+
     std::unordered_map<int, ClientData> client_data_;
 
+    const SpatialHashSystem* spatial_index_ = nullptr;
+
+    // Entities without a Position, gathered once per tick (reused buffer)
+    std::vector<const ecs::Entity*> positionless_;
+
     float near_range_ = 5000.0f;   // 5 km
     float mid_range_  = 20000.0f;  // 20 km
     float far_range_  = 80000.0f;  // 80 km
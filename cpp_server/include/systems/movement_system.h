@@ -2,6 +2,7 @@
 #define NOVAFORGE_SYSTEMS_MOVEMENT_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/entity_handle.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -92,6 +93,9 @@ private:
         float warp_duration = 10.0f; // seconds (computed from distance / warp_speed)
         float align_time = 2.5f;     // seconds for align phase (from Ship component)
         bool warping = false;
+        // Handle caches for the commanded entity and target_id
+        ecs::EntityHandle entity_handle;
+        ecs::EntityHandle target_handle;
     };
     std::map<std::string, MovementCommand> movement_commands_;
 
@@ -3,6 +3,7 @@
 
 #include "ecs/system.h"
 #include "components/game_components.h"
+#include "utils/tick_profiler.h"
 #include <string>
 
 namespace atlas {
@@ -26,6 +27,15 @@ public:
     bool initializeMonitor(const std::string& entity_id, const std::string& server_id,
                            float tick_budget_ms);
 
+    /**
+     * @brief Feed every monitor from a TickProfiler
+     *
+     * Each update() then records the profiler's last closed tick: one
+     * recordSystemTiming() per system zone and one recordTickComplete()
+     * for the whole tick, so nothing needs to call them by hand.
+     */
+    void setProfiler(const utils::TickProfiler* profiler) { profiler_ = profiler; }
+
     // Recording
     bool recordSystemTiming(const std::string& entity_id, const std::string& system_name,
                             float time_ms);
@@ -41,6 +51,15 @@ public:
 
     // Reset
     bool resetMetrics(const std::string& entity_id);
+
+private:
+    static void applySystemTiming(components::ServerPerformanceMetrics& metrics,
+                                  const std::string& system_name, float time_ms);
+    static void applyTickComplete(components::ServerPerformanceMetrics& metrics,
+                                  float total_time_ms, int entity_count);
+
+    const utils::TickProfiler* profiler_ = nullptr;
+    uint64_t profiled_tick_ = 0;   // profiler tick count last consumed
 };
 
 } // namespace systems
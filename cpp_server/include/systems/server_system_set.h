@@ -0,0 +1,49 @@
+#ifndef NOVAFORGE_SYSTEMS_SERVER_SYSTEM_SET_H
+#define NOVAFORGE_SYSTEMS_SERVER_SYSTEM_SET_H
+
+#include "ecs/world.h"
+
+namespace atlas {
+namespace systems {
+
+class SpatialHashSystem;
+class TargetingSystem;
+class StationSystem;
+class MovementSystem;
+class CombatSystem;
+class InterestManagementSystem;
+class SnapshotReplicationSystem;
+
+/**
+ * @brief The systems added by addServerSystems(), for callers that drive them
+ *
+ * Owned by the world they were added to.
+ */
+struct ServerSystems {
+    SpatialHashSystem* spatial_hash = nullptr;
+    TargetingSystem* targeting = nullptr;
+    StationSystem* station = nullptr;
+    MovementSystem* movement = nullptr;
+    CombatSystem* combat = nullptr;
+    InterestManagementSystem* interest = nullptr;
+    SnapshotReplicationSystem* replication = nullptr;
+};
+
+/**
+ * @brief Add the dedicated server's tick systems to `world`
+ *
+ * SpatialHash, Capacitor, ShieldRecharge, AI, Targeting, Station,
+ * Movement, Weapon, Combat, InterestManagement, SnapshotReplication —
+ * the shared broadphase first, replication last.  The server and
+ * server_bench both build their worlds with this, so a benchmark runs
+ * the same tick as production.
+ */
+ServerSystems addServerSystems(ecs::World* world);
+
+/// Names of the systems addServerSystems() adds, in order, for logs and reports
+const char* serverSystemNames();
+
+} // namespace systems
+} // namespace atlas
+
+#endif // NOVAFORGE_SYSTEMS_SERVER_SYSTEM_SET_H
@@ -16,7 +16,10 @@ namespace systems {
  */
 class ShieldRechargeSystem : public ecs::SingleComponentSystem<components::Health> {
 public:
-    using SingleComponentSystem::SingleComponentSystem;
+    explicit ShieldRechargeSystem(ecs::World* world) : SingleComponentSystem(world) {
+        writes<components::Health>();
+        enableParallel();
+    }
     ~ShieldRechargeSystem() override = default;
     
     std::string getName() const override { return "ShieldRechargeSystem"; }
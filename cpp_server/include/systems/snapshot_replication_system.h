@@ -4,30 +4,76 @@
 #include "ecs/system.h"
 #include "ecs/entity.h"
 #include "ecs/world.h"
+#include "network/wire_format.h"
+#include <sstream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <cstdint>
 
 namespace atlas {
 namespace systems {
 
+class InterestManagementSystem;
+
 /**
  * @brief Delta-compressed snapshot replication for network state updates
  *
- * Tracks the last-sent state of each entity per client and computes
- * per-field deltas so that only changed values are included in each
- * state update.  When a client has no previous state for an entity
- * (first time seen or after a full-resync) the full state is sent.
+ * Once per tick the replicated state of every entity (position,
+ * velocity, health, capacitor, ship and faction) is captured into a
+ * shared snapshot.  Capture compares each entity against the values it
+ * last published; a field group that moved by more than its tolerance
+ * (epsilon) is republished and stamped with the snapshot ID, so
+ * micro-jitter is never sent.  A ring of the most recent snapshots
+ * records which entities changed in each one.
+ *
+ * Each client only remembers its baseline: the last snapshot it was
+ * sent (TCP delivers in order, so sent is acknowledged).  A client's
+ * update is the union of the ring entries newer than its baseline, so
+ * the cost follows the number of changed entities rather than clients
+ * × entities.  A client with no baseline, or one older than the ring,
+ * gets every entity with the fields stamped after its baseline.
+ *
+ * Encoded per-entity blocks (JSON and binary) are cached on the
+ * snapshot and shared: every up-to-date client receives the same bytes
+ * for a changed entity, and every client meeting an entity for the
+ * first time receives the same full block.
  *
- * Position/velocity changes are detected using a configurable
- * tolerance (epsilon) to avoid sending micro-jitter.
+ * With an InterestManagementSystem attached, a client is only sent the
+ * entities in its relevance set.  Near entities are updated on every
+ * build, mid and far ones every setTierIntervals() builds (staggered
+ * across clients), each diffed against the snapshot that entity was
+ * last sent at.  Entities entering or leaving the set are reported by
+ * getLastSpawned() / getLastDespawned() so the session can send
+ * spawn_entity / destroy_entity messages; the cost then follows the
+ * density around each client rather than the size of the universe.
  *
  * Usage:
- *   1. Each server tick, call buildDeltaUpdate(client_id) for every
+ *   1. Register the system with the World (update() captures the
+ *      snapshot) or let the build calls capture on demand: a build for
+ *      a client that already has the latest snapshot captures a new one.
+ *   2. Each server tick, call buildDeltaUpdate(client_id) for every
  *      connected client to get a JSON state-update string that
- *      includes only changed fields.
- *   2. Call clearClient(client_id) when a client disconnects to
+ *      includes only changed fields (or buildDeltaUpdateBinary() for
+ *      clients that negotiated the binary encoding).
+ *   3. Call clearClient(client_id) when a client disconnects to
  *      free tracked state.
+ *
+ * Binary STATE_UPDATE payload (wire version 1, see network/wire_format.h):
+ *   varint sequence, varint timestamp_ms, u8 flags (kWireDelta,
+ *   kWireReset), varint entity_count, then per entity:
+ *     varint net_id, u8 field mask (kField* | kWireNewEntity),
+ *     [string entity_id]                    if kWireNewEntity
+ *     [q x, q y, q z (1/16 m), q rot]       if kFieldPosition
+ *     [q vx, q vy, q vz (1/64 m/s)]         if kFieldVelocity
+ *     [q shield, armor, hull, max x3]       if kFieldHealth
+ *     [q current, q max]                    if kFieldCapacitor
+ *     [string ship_type, string ship_name]  if kFieldShip
+ *     [string faction]                      if kFieldFaction
+ *   "q" is a zig-zag varint of value / step.  Net IDs are server-wide and
+ *   replace the string ID after an entity's first appearance; an ID can
+ *   be reused once its entity is gone, and is then introduced again.  A
+ *   reset flag means the client must discard its net-ID table.
  */
 class SnapshotReplicationSystem : public ecs::System {
 public:
@@ -38,7 +84,7 @@ public:
     std::string getName() const override { return "SnapshotReplicationSystem"; }
 
     // ------------------------------------------------------------------
-    // Per-entity cached state (what was last sent to a given client)
+    // Per-entity published state (what clients are sent)
     // ------------------------------------------------------------------
     struct EntitySnapshot {
         // Position
@@ -59,6 +105,23 @@ public:
         bool has_data = false;  // false = first time, full state needed
     };
 
+    /// Field mask bits shared by change detection and the binary payload
+    enum FieldBits : uint32_t {
+        kFieldPosition  = 1u << 0,
+        kFieldVelocity  = 1u << 1,
+        kFieldHealth    = 1u << 2,
+        kFieldCapacitor = 1u << 3,
+        kFieldShip      = 1u << 4,
+        kFieldFaction   = 1u << 5,
+        kWireNewEntity  = 1u << 7   ///< entity_id string follows the mask
+    };
+
+    /// Binary STATE_UPDATE flags
+    enum WireFlags : uint8_t {
+        kWireDelta = 1u << 0,
+        kWireReset = 1u << 1
+    };
+
     // ------------------------------------------------------------------
     // Public API
     // ------------------------------------------------------------------
@@ -83,11 +146,51 @@ public:
      */
     std::string buildFullUpdate(int client_id, uint64_t sequence);
 
+    /**
+     * Binary equivalents of buildDeltaUpdate / buildFullUpdate: the same
+     * change detection, encoded as one STATE_UPDATE frame (layout above).
+     */
+    std::string buildDeltaUpdateBinary(int client_id, uint64_t sequence);
+    std::string buildFullUpdateBinary(int client_id, uint64_t sequence);
+
+    /**
+     * Capture the current world state as a new snapshot.  Called by
+     * update(); the build calls also capture when needed (see above).
+     * @return ID of the new snapshot
+     */
+    uint32_t captureSnapshot();
+
+    /** ID of the most recent snapshot (0 before the first capture) */
+    uint32_t getLatestSnapshotId() const { return latest_id_; }
+
+    /** Snapshot the client was last sent (0 = none) */
+    uint32_t getClientBaseline(int client_id) const;
+
+    /**
+     * Restrict each client to its relevance set (nullptr = every entity).
+     * The interest system must be updated before the snapshot is captured.
+     */
+    void setInterestManagement(const InterestManagementSystem* ims) { interest_ = ims; }
+
+    /** Mid / far entities are refreshed every `mid` / `far` builds (default 3 / 10) */
+    void setTierIntervals(uint32_t mid, uint32_t far);
+    uint32_t getMidInterval() const { return mid_interval_; }
+    uint32_t getFarInterval() const { return far_interval_; }
+
+    /** Entity IDs that entered the client's relevance set in the last build */
+    const std::vector<std::string>& getLastSpawned() const { return last_spawned_; }
+
+    /** Entity IDs that left the set (or were destroyed) in the last build */
+    const std::vector<std::string>& getLastDespawned() const { return last_despawned_; }
+
+    /** Number of per-entity blocks encoded so far (shared blocks count once) */
+    uint64_t getBlocksEncoded() const { return blocks_encoded_; }
+
     /** Remove all tracked state for a disconnected client */
     void clearClient(int client_id);
 
     /** Get the number of clients being tracked */
-    size_t getTrackedClientCount() const { return client_snapshots_.size(); }
+    size_t getTrackedClientCount() const { return clients_.size(); }
 
     /** Get the number of entities tracked for a client */
     size_t getTrackedEntityCount(int client_id) const;
@@ -100,14 +203,78 @@ public:
     void setPositionEpsilon(float eps) { position_epsilon_ = eps; }
     float getPositionEpsilon() const { return position_epsilon_; }
 
+    /** Number of snapshots whose change lists are kept (default 64) */
+    void setHistorySize(size_t frames);
+    size_t getHistorySize() const { return history_.size(); }
+
     /** Set health change tolerance */
     void setHealthEpsilon(float eps) { health_epsilon_ = eps; }
     float getHealthEpsilon() const { return health_epsilon_; }
 
 private:
-    // Per-client map of entity_id → last sent snapshot
-    using EntitySnapshotMap = std::unordered_map<std::string, EntitySnapshot>;
-    std::unordered_map<int, EntitySnapshotMap> client_snapshots_;
+    static constexpr int kFieldGroups = 6;
+
+    /// One block per encoding: the latest snapshot's change, or the full state
+    struct CachedBlock {
+        uint32_t snapshot = 0;      // valid while this equals latest_id_
+        std::string bytes;
+    };
+
+    /// Replication state of one world slot (indexed by EntityHandle::index)
+    struct Slot {
+        EntitySnapshot state;       // last published values
+        std::string entity_id;
+        uint32_t generation = 0;
+        bool live = false;
+        uint32_t present = 0;       // kField* bits for components the entity has
+        uint32_t spawned_at = 0;    // snapshot that introduced this entity
+        uint32_t seen = 0;          // last snapshot that found the entity
+        uint32_t changed_at[kFieldGroups] = {};
+        uint32_t visit = 0;         // union de-duplication stamp
+        CachedBlock json_delta, json_full, binary_delta, binary_full;
+    };
+
+    /// Change list of one snapshot
+    struct Frame {
+        uint32_t id = 0;
+        std::vector<uint32_t> changed;  // slots introduced or republished
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<Frame> history_;    // ring, indexed by id % size
+    uint32_t latest_id_ = 0;
+    uint32_t visit_stamp_ = 0;
+    uint64_t blocks_encoded_ = 0;
+
+    /// An entity a client has been introduced to (interest mode)
+    struct KnownEntity {
+        std::string entity_id;
+        uint32_t generation = 0;
+        uint32_t sent_at = 0;       // snapshot whose state the client has
+        uint32_t seen = 0;          // build that last found it relevant
+    };
+
+    struct ClientState {
+        uint32_t baseline = 0;      // last snapshot sent (0 = needs full state)
+        uint32_t builds = 0;
+        std::unordered_map<uint32_t, KnownEntity> known;   // by slot
+    };
+
+    std::unordered_map<int, ClientState> clients_;
+
+    const InterestManagementSystem* interest_ = nullptr;
+    uint32_t mid_interval_ = 3;
+    uint32_t far_interval_ = 10;
+    std::vector<std::string> last_spawned_;
+    std::vector<std::string> last_despawned_;
+
+    // Reused encode buffers
+    std::ostringstream json_block_;
+    std::string json_scratch_;      // uncached JSON block
+    std::string json_body_;
+    network::WireWriter binary_block_;
+    network::WireWriter binary_body_;
+    network::WireWriter binary_payload_;
 
     float position_epsilon_ = 0.1f;   // minimum position delta to report
     float health_epsilon_   = 0.5f;   // minimum health delta to report
@@ -122,6 +289,27 @@ private:
                           float sm, float am, float hm) const;
     bool hasCapacitorChanged(const EntitySnapshot& prev,
                              float cap, float cap_max) const;
+
+    /// kField* bits for the fields that differ from what `prev` recorded
+    uint32_t diffEntity(const ecs::Entity* entity, const EntitySnapshot& prev) const;
+    /// Record the fields in `mask` as published
+    void commitEntity(const ecs::Entity* entity, uint32_t mask, EntitySnapshot& prev) const;
+
+    /// Fields of `slot` republished after snapshot `baseline`
+    uint32_t changedSince(const Slot& slot, uint32_t baseline) const;
+    /// Call fn(slot_index) for every live slot the client must be sent
+    template<typename Fn>
+    void forEachChangedSlot(uint32_t baseline, Fn&& fn);
+    /// Advance the client to the latest snapshot, capturing if it has it
+    uint32_t beginClientUpdate(ClientState& client, bool reset);
+    /// Call emit(slot_index, mask, introduce) for every block the client needs
+    template<typename Emit>
+    void collectClientUpdate(int client_id, bool reset, Emit&& emit);
+
+    const std::string& jsonBlock(Slot& slot, uint32_t mask, bool introduce);
+    const std::string& binaryBlock(Slot& slot, uint32_t index, uint32_t mask, bool introduce);
+    std::string buildJson(int client_id, uint64_t sequence, bool reset);
+    std::string buildBinary(int client_id, uint64_t sequence, bool reset);
 };
 
 } // namespace systems
@@ -2,7 +2,14 @@
 #define NOVAFORGE_SYSTEMS_SPATIAL_HASH_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/world.h"
+#include "ecs/entity_handle.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include <cstdint>
@@ -11,24 +18,73 @@ namespace atlas {
 namespace systems {
 
 /**
- * @brief Spatial hash grid for O(1) proximity queries
+ * @brief Counters reported by SpatialHashSystem::getStats()
  *
- * Partitions 3-D space into a uniform grid of cells.  Each entity
- * with a Position component is assigned to one cell per tick.
- * Nearby-entity queries only need to inspect the target cell plus
- * its immediate neighbours (27-cell neighbourhood in 3-D).
+ * The per-update fields describe the most recent update(); the query
+ * fields accumulate until resetQueryStats().
+ */
+struct SpatialHashStats {
+    uint64_t updates = 0;
+    uint64_t full_rebuilds = 0;     ///< updates that rebuilt every level
+    size_t entities = 0;
+    size_t inserted = 0;            ///< entities added by the last update
+    size_t removed = 0;             ///< entities dropped by the last update
+    size_t cell_changes = 0;        ///< entities that crossed a level-0 cell boundary
+    double last_update_ms = 0.0;
+    uint64_t queries = 0;
+    uint64_t cells_probed = 0;
+    uint64_t candidates_tested = 0;
+};
+
+/**
+ * @brief Hierarchical spatial hash for proximity, box and ray queries
+ *
+ * Space is partitioned into several uniform grids ("levels").  Level 0
+ * uses the configured cell size and every further level is kLevelRatio
+ * times coarser, so one index serves both metre-scale dogfights and
+ * sensor sweeps tens of kilometres wide: each query picks the finest
+ * level on which it touches only a handful of cells.
  *
- * Cell size should be at least as large as the largest interaction
- * radius in the game (e.g. weapon range or sensor range).
+ * The index is maintained incrementally.  update() refreshes every
+ * entity's position snapshot but only relinks the entities that crossed
+ * a cell boundary (and only on the levels where they did), so the cost
+ * of a tick follows motion rather than population.  Changing the cell
+ * size or level count forces one full rebuild.
+ *
+ * This is the server's shared per-tick broadphase: register it before
+ * the systems that consume it and hand it to them with setSpatialIndex()
+ * (AISystem, TargetingSystem, InterestManagementSystem).  Positions are
+ * snapshotted when the index is updated, so every consumer in a tick sees
+ * the same positions.  The handle-based queries below do not allocate
+ * once the caller's output buffer has grown; entities destroyed since
+ * the last update() are skipped.
  *
  * Usage:
  *   SpatialHashSystem spatialHash(&world);
- *   spatialHash.setCellSize(5000.0f);   // 5 km cells
- *   spatialHash.update(dt);              // rebuild grid
+ *   spatialHash.setCellSize(1000.0f);    // 1 km finest cells
+ *   spatialHash.update(dt);              // relink entities that moved
  *   auto nearby = spatialHash.queryNear(x, y, z, 10000.0f);
+ *
+ *   std::vector<ecs::EntityHandle> hostiles;   // reused across ticks
+ *   spatialHash.queryRadius<components::AI>(x, y, z, 10000.0f, hostiles);
+ *
+ *   SpatialHashSystem::RayHit hit;
+ *   if (spatialHash.raycast<components::Health>(x, y, z, dx, dy, dz,
+ *                                               20000.0f, 50.0f, hit)) { ... }
  */
 class SpatialHashSystem : public ecs::System {
 public:
+    /// Upper bound on setLevelCount()
+    static constexpr int kMaxLevels = 6;
+    /// Each level's cells are this many times wider than the previous level's
+    static constexpr int kLevelRatio = 8;
+
+    /// Result of raycast()
+    struct RayHit {
+        ecs::EntityHandle handle;
+        float distance = 0.0f;   ///< along the ray to the hit sphere's surface
+    };
+
     explicit SpatialHashSystem(ecs::World* world);
     ~SpatialHashSystem() override = default;
 
@@ -39,10 +95,17 @@ public:
     // Configuration
     // ---------------------------------------------------------------
 
-    /** Set the size of each grid cell in world units (metres) */
+    /** Set the size of each level-0 grid cell in world units (metres) */
     void setCellSize(float size);
     float getCellSize() const { return cell_size_; }
 
+    /** Set the number of grid levels (clamped to 1..kMaxLevels) */
+    void setLevelCount(int count);
+    int getLevelCount() const { return level_count_; }
+
+    /** Cell size of the given level in world units */
+    float getLevelCellSize(int level) const;
+
     // ---------------------------------------------------------------
     // Queries (valid after update())
     // ---------------------------------------------------------------
@@ -57,16 +120,71 @@ public:
                                        float radius) const;
 
     /**
-     * @brief Return entity IDs in the same cell as the named entity,
-     *        plus its 26 neighbours.
+     * @brief Return entity IDs in the same level-0 cell as the named
+     *        entity, plus its 26 neighbours.
      */
     std::vector<std::string> queryNeighbours(const std::string& entity_id) const;
 
-    /** Total number of occupied cells after last update */
-    int getOccupiedCellCount() const { return static_cast<int>(grid_.size()); }
+    /**
+     * @brief Invoke fn(Entity*, float dist_sq) for every indexed entity
+     *        within `radius` of the point.  Does not allocate.
+     */
+    template<typename Fn>
+    void forEachInRadius(float x, float y, float z, float radius, Fn&& fn) const;
+
+    /**
+     * @brief Handles of entities within `radius` that have every
+     *        component in Required (none = any indexed entity).
+     *
+     * `out` is cleared and refilled (order unspecified); reuse it across
+     * calls to avoid allocation.  Returns the number of results.
+     */
+    template<typename... Required>
+    size_t queryRadius(float x, float y, float z, float radius,
+                       std::vector<ecs::EntityHandle>& out) const;
+
+    /**
+     * @brief Handles of entities inside the axis-aligned box (bounds
+     *        inclusive) that have every component in Required.
+     */
+    template<typename... Required>
+    size_t queryBox(float min_x, float min_y, float min_z,
+                    float max_x, float max_y, float max_z,
+                    std::vector<ecs::EntityHandle>& out) const;
+
+    /**
+     * @brief The k nearest entities (having every Required component)
+     *        within `max_radius`, closest first.
+     *
+     * Ties are broken by entity slot so results are deterministic.
+     */
+    template<typename... Required>
+    size_t queryNearest(float x, float y, float z, size_t k, float max_radius,
+                        std::vector<ecs::EntityHandle>& out) const;
+
+    /**
+     * @brief First entity (having every Required component) whose sphere
+     *        of `hit_radius` the ray touches within `max_distance`.
+     *
+     * The direction need not be normalised.  `ignore` (e.g. the shooter)
+     * is never reported.  Ties are broken by entity slot.  Walks the grid
+     * cells along the ray, so cost follows ray length, not population.
+     */
+    template<typename... Required>
+    bool raycast(float origin_x, float origin_y, float origin_z,
+                 float dir_x, float dir_y, float dir_z,
+                 float max_distance, float hit_radius, RayHit& hit,
+                 ecs::EntityHandle ignore = {}) const;
+
+    /** Number of occupied cells on a level after last update */
+    int getOccupiedCellCount(int level = 0) const;
 
     /** Total entities indexed */
-    int getIndexedEntityCount() const { return indexed_count_; }
+    int getIndexedEntityCount() const { return static_cast<int>(entries_.size()); }
+
+    /** Update and query counters (see SpatialHashStats) */
+    SpatialHashStats getStats() const;
+    void resetQueryStats();
 
 private:
     // Packed cell key from integer coordinates
@@ -87,18 +205,301 @@ private:
         }
     };
 
-    CellKey cellKeyFor(float x, float y, float z) const;
+    // cell → indices into entries_
+    using CellMap = std::unordered_map<CellKey, std::vector<uint32_t>, CellKeyHash>;
+
+    // Position snapshot plus where the entity is linked on each level
+    struct Entry {
+        ecs::EntityHandle handle;
+        float x, y, z;
+        uint32_t seen;                      // update() stamp
+        CellKey cell[kMaxLevels];
+        uint32_t cell_pos[kMaxLevels];      // index within that cell's vector
+    };
+
+    // Inclusive cell-coordinate range on one level
+    struct CellRange {
+        CellKey lo, hi;
+        double count() const {
+            return (static_cast<double>(hi.cx) - lo.cx + 1.0) *
+                   (static_cast<double>(hi.cy) - lo.cy + 1.0) *
+                   (static_cast<double>(hi.cz) - lo.cz + 1.0);
+        }
+    };
+
+    int32_t coordFor(float v, int level) const;
+    CellKey cellKeyFor(float x, float y, float z, int level = 0) const;
+    static CellKey coarsen(const CellKey& key, int level);
+
+    void insertEntry(ecs::Entity* entity, float x, float y, float z);
+    void removeEntry(uint32_t index);
+    void relinkEntry(uint32_t index, const CellKey& key);
+    void link(int level, const CellKey& key, uint32_t index);
+    void unlink(int level, const CellKey& key, uint32_t pos);
+    void clearIndex();
+
+    // Visit every entry whose cell on the chosen level overlaps the box;
+    // fn(const Entry&) must still test the entry's position.
+    template<typename Fn>
+    void forEachCandidate(float min_x, float min_y, float min_z,
+                          float max_x, float max_y, float max_z, Fn&& fn) const;
+
+    void recordQuery(uint64_t cells, uint64_t candidates) const {
+        query_count_.fetch_add(1, std::memory_order_relaxed);
+        cells_probed_.fetch_add(cells, std::memory_order_relaxed);
+        candidates_tested_.fetch_add(candidates, std::memory_order_relaxed);
+    }
+
+    template<typename... Required>
+    static bool hasAll(const ecs::Entity* entity) {
+        return (entity->hasComponent<Required>() && ...);
+    }
 
-    float cell_size_ = 5000.0f;
-    int indexed_count_ = 0;
+    float cell_size_ = 1000.0f;
+    int level_count_ = 5;
+    bool rebuild_ = true;
+    uint32_t stamp_ = 0;
 
-    // cell → list of entity IDs
-    std::unordered_map<CellKey, std::vector<std::string>, CellKeyHash> grid_;
+    std::vector<Entry> entries_;
+    CellMap levels_[kMaxLevels];
 
-    // entity → cell key (for fast neighbour lookup)
-    std::unordered_map<std::string, CellKey> entity_cells_;
+    // entity slot → index into entries_ (npos if not indexed)
+    std::vector<uint32_t> slot_entries_;
+
+    SpatialHashStats stats_;
+    mutable std::atomic<uint64_t> query_count_{0};
+    mutable std::atomic<uint64_t> cells_probed_{0};
+    mutable std::atomic<uint64_t> candidates_tested_{0};
 };
 
+// Template implementation
+template<typename Fn>
+void SpatialHashSystem::forEachCandidate(float min_x, float min_y, float min_z,
+                                         float max_x, float max_y, float max_z,
+                                         Fn&& fn) const {
+    if (entries_.empty()) return;
+
+    // Finest level on which the box touches at most a 3x3x3 block of cells
+    int level = 0;
+    CellRange range{cellKeyFor(min_x, min_y, min_z), cellKeyFor(max_x, max_y, max_z)};
+    while (level + 1 < level_count_ && range.count() > 27.0) {
+        ++level;
+        range = {coarsen(range.lo, 1), coarsen(range.hi, 1)};
+    }
+
+    uint64_t cells = 0;
+    uint64_t candidates = 0;
+    auto visit = [&](const std::vector<uint32_t>& cell) {
+        ++cells;
+        candidates += cell.size();
+        for (uint32_t index : cell) fn(entries_[index]);
+    };
+
+    // Probing more cells than are occupied is slower than walking them all
+    const CellMap& grid = levels_[level];
+    if (range.count() >= static_cast<double>(grid.size())) {
+        for (const auto& kv : grid) visit(kv.second);
+    } else {
+        for (int32_t cx = range.lo.cx; cx <= range.hi.cx; ++cx) {
+            for (int32_t cy = range.lo.cy; cy <= range.hi.cy; ++cy) {
+                for (int32_t cz = range.lo.cz; cz <= range.hi.cz; ++cz) {
+                    auto it = grid.find({cx, cy, cz});
+                    if (it != grid.end()) visit(it->second);
+                }
+            }
+        }
+    }
+    recordQuery(cells, candidates);
+}
+
+template<typename Fn>
+void SpatialHashSystem::forEachInRadius(float x, float y, float z, float radius,
+                                        Fn&& fn) const {
+    if (radius < 0.0f) return;
+    const float radius_sq = radius * radius;
+    forEachCandidate(x - radius, y - radius, z - radius,
+                     x + radius, y + radius, z + radius,
+                     [&](const Entry& e) {
+        float dx = e.x - x;
+        float dy = e.y - y;
+        float dz = e.z - z;
+        float dist_sq = dx * dx + dy * dy + dz * dz;
+        if (dist_sq > radius_sq) return;
+        if (ecs::Entity* entity = world_->resolve(e.handle)) fn(entity, dist_sq);
+    });
+}
+
+template<typename... Required>
+size_t SpatialHashSystem::queryRadius(float x, float y, float z, float radius,
+                                      std::vector<ecs::EntityHandle>& out) const {
+    out.clear();
+    forEachInRadius(x, y, z, radius, [&](ecs::Entity* entity, float) {
+        if (hasAll<Required...>(entity)) out.push_back(entity->getHandle());
+    });
+    return out.size();
+}
+
+template<typename... Required>
+size_t SpatialHashSystem::queryBox(float min_x, float min_y, float min_z,
+                                   float max_x, float max_y, float max_z,
+                                   std::vector<ecs::EntityHandle>& out) const {
+    out.clear();
+    if (min_x > max_x || min_y > max_y || min_z > max_z) return 0;
+    forEachCandidate(min_x, min_y, min_z, max_x, max_y, max_z, [&](const Entry& e) {
+        if (e.x < min_x || e.x > max_x || e.y < min_y || e.y > max_y ||
+            e.z < min_z || e.z > max_z) return;
+        ecs::Entity* entity = world_->resolve(e.handle);
+        if (entity && hasAll<Required...>(entity)) out.push_back(e.handle);
+    });
+    return out.size();
+}
+
+template<typename... Required>
+size_t SpatialHashSystem::queryNearest(float x, float y, float z, size_t k, float max_radius,
+                                       std::vector<ecs::EntityHandle>& out) const {
+    out.clear();
+    if (k == 0) return 0;
+
+    thread_local std::vector<std::pair<float, ecs::EntityHandle>> scratch;
+    // Grow the search sphere until it holds k matches (or hits max_radius);
+    // every entity inside the final sphere has been seen, so the k closest
+    // of them are exact.
+    float radius = k >= entries_.size() ? max_radius : std::min(cell_size_, max_radius);
+    for (;;) {
+        scratch.clear();
+        forEachInRadius(x, y, z, radius, [&](ecs::Entity* entity, float dist_sq) {
+            if (hasAll<Required...>(entity)) scratch.emplace_back(dist_sq, entity->getHandle());
+        });
+        if (scratch.size() >= k || radius >= max_radius) break;
+        radius = std::min(radius * 2.0f, max_radius);
+    }
+
+    size_t n = std::min(k, scratch.size());
+    std::partial_sort(scratch.begin(), scratch.begin() + n, scratch.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.first != b.first ? a.first < b.first
+                                                    : a.second.index < b.second.index;
+                      });
+    for (size_t i = 0; i < n; ++i) out.push_back(scratch[i].second);
+    return n;
+}
+
+template<typename... Required>
+bool SpatialHashSystem::raycast(float origin_x, float origin_y, float origin_z,
+                                float dir_x, float dir_y, float dir_z,
+                                float max_distance, float hit_radius, RayHit& hit,
+                                ecs::EntityHandle ignore) const {
+    float length = std::sqrt(dir_x * dir_x + dir_y * dir_y + dir_z * dir_z);
+    if (entries_.empty() || length <= 0.0f || !(max_distance >= 0.0f) ||
+        !std::isfinite(max_distance) || hit_radius <= 0.0f) {
+        return false;
+    }
+    const float d[3] = {dir_x / length, dir_y / length, dir_z / length};
+    const float o[3] = {origin_x, origin_y, origin_z};
+    const float radius_sq = hit_radius * hit_radius;
+
+    // Cells at least as wide as the hit sphere, so every hit lies in a
+    // cell adjacent to one the ray passes through; long rays step up a
+    // level rather than walk thousands of small cells.
+    int level = 0;
+    while (level + 1 < level_count_ &&
+           (getLevelCellSize(level) < hit_radius ||
+            max_distance > 256.0f * getLevelCellSize(level))) {
+        ++level;
+    }
+    const float cell = getLevelCellSize(level);
+    const CellMap& grid = levels_[level];
+
+    bool found = false;
+    float best = 0.0f;
+    uint32_t best_slot = 0;
+    uint64_t cells = 0;
+    uint64_t candidates = 0;
+
+    auto test = [&](const Entry& e) {
+        ++candidates;
+        if (e.handle == ignore) return;
+        float px = e.x - o[0];
+        float py = e.y - o[1];
+        float pz = e.z - o[2];
+        float t = px * d[0] + py * d[1] + pz * d[2];
+        float tc = std::max(0.0f, std::min(t, max_distance));
+        float qx = px - d[0] * tc;
+        float qy = py - d[1] * tc;
+        float qz = pz - d[2] * tc;
+        float miss_sq = qx * qx + qy * qy + qz * qz;
+        if (miss_sq > radius_sq) return;
+        // Entry point on the sphere (0 when the ray starts inside it)
+        float perp_sq = std::max(0.0f, (px * px + py * py + pz * pz) - t * t);
+        float along = std::max(0.0f, t - std::sqrt(std::max(0.0f, radius_sq - perp_sq)));
+        if (along > max_distance) return;
+        if (found && (along > best || (along == best && e.handle.index >= best_slot))) return;
+        ecs::Entity* entity = world_->resolve(e.handle);
+        if (!entity || !hasAll<Required...>(entity)) return;
+        found = true;
+        best = along;
+        best_slot = e.handle.index;
+        hit.handle = e.handle;
+        hit.distance = along;
+    };
+    auto probe = [&](const CellKey& centre) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    auto it = grid.find({centre.cx + dx, centre.cy + dy, centre.cz + dz});
+                    if (it == grid.end()) continue;
+                    ++cells;
+                    for (uint32_t index : it->second) test(entries_[index]);
+                }
+            }
+        }
+    };
+
+    // Hit spheres wider than the coarsest cells: test everything
+    if (cell < hit_radius) {
+        for (const Entry& e : entries_) test(e);
+        recordQuery(0, candidates);
+        return found;
+    }
+
+    // 3-D DDA over the level's cells
+    CellKey key = cellKeyFor(o[0], o[1], o[2], level);
+    int32_t* coord[3] = {&key.cx, &key.cy, &key.cz};
+    int step[3];
+    float t_max[3];
+    float t_delta[3];
+    const float inf = std::numeric_limits<float>::infinity();
+    for (int axis = 0; axis < 3; ++axis) {
+        if (d[axis] > 0.0f) {
+            step[axis] = 1;
+            t_max[axis] = ((*coord[axis] + 1) * cell - o[axis]) / d[axis];
+            t_delta[axis] = cell / d[axis];
+        } else if (d[axis] < 0.0f) {
+            step[axis] = -1;
+            t_max[axis] = (*coord[axis] * cell - o[axis]) / d[axis];
+            t_delta[axis] = -cell / d[axis];
+        } else {
+            step[axis] = 0;
+            t_max[axis] = inf;
+            t_delta[axis] = inf;
+        }
+    }
+
+    // A candidate near a cell entered at t can still hit this far back
+    const float reach = 4.5f * cell;
+    float t_enter = 0.0f;
+    while (t_enter <= max_distance && !(found && t_enter - reach > best)) {
+        probe(key);
+        int axis = t_max[0] < t_max[1] ? (t_max[0] < t_max[2] ? 0 : 2)
+                                       : (t_max[1] < t_max[2] ? 1 : 2);
+        t_enter = t_max[axis];
+        *coord[axis] += step[axis];
+        t_max[axis] += t_delta[axis];
+    }
+    recordQuery(cells, candidates);
+    return found;
+}
+
 } // namespace systems
 } // namespace atlas
 
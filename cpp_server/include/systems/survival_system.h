@@ -1,8 +1,7 @@
 #ifndef NOVAFORGE_SYSTEMS_SURVIVAL_SYSTEM_H
 #define NOVAFORGE_SYSTEMS_SURVIVAL_SYSTEM_H
 
-#include "ecs/system.h"
-#include "ecs/entity.h"
+#include "ecs/single_component_system.h"
 #include "components/game_components.h"
 #include <string>
 #include <tuple>
@@ -10,12 +9,11 @@
 namespace atlas {
 namespace systems {
 
-class SurvivalSystem : public ecs::System {
+class SurvivalSystem : public ecs::SingleComponentSystem<components::SurvivalNeeds> {
 public:
     explicit SurvivalSystem(ecs::World* world);
     ~SurvivalSystem() override = default;
 
-    void update(float delta_time) override;
     std::string getName() const override { return "SurvivalSystem"; }
 
     float refillOxygen(const std::string& entity_id, float amount);
@@ -23,6 +21,10 @@ public:
     float rest(const std::string& entity_id, float amount);
     bool isAlive(const std::string& entity_id) const;
     std::tuple<float, float, float> getNeeds(const std::string& entity_id) const;
+
+protected:
+    void processEntity(ecs::Entity* entity, components::SurvivalNeeds* needs,
+                       float dt) override;
 };
 
 } // namespace systems
@@ -3,11 +3,15 @@
 
 #include "ecs/system.h"
 #include "ecs/entity.h"
+#include "ecs/entity_handle.h"
 #include <string>
+#include <vector>
 
 namespace atlas {
 namespace systems {
 
+class SpatialHashSystem;
+
 /**
  * @brief Handles target locking mechanics
  * 
@@ -21,6 +25,20 @@ public:
     
     void update(float delta_time) override;
     std::string getName() const override { return "TargetingSystem"; }
+
+    /** Use a shared per-tick broadphase for range queries */
+    void setSpatialIndex(const SpatialHashSystem* index) { spatial_index_ = index; }
+
+    /**
+     * @brief Collect entities this ship could lock: anything with Health
+     *        within its Ship::max_targeting_range, excluding itself.
+     * @param entity_id Entity that wants to lock
+     * @param out Cleared and refilled with handles, closest first; reuse it
+     *            across calls to avoid allocation
+     * @return Number of lockable targets
+     */
+    size_t getLockableTargets(const std::string& entity_id,
+                              std::vector<ecs::EntityHandle>& out) const;
     
     /**
      * @brief Start locking a target
@@ -44,6 +62,9 @@ public:
      * @return true if target is locked, false otherwise
      */
     bool isTargetLocked(const std::string& entity_id, const std::string& target_id) const;
+
+private:
+    const SpatialHashSystem* spatial_index_ = nullptr;
 };
 
 } // namespace systems
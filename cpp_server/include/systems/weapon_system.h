@@ -2,6 +2,7 @@
 #define NOVAFORGE_SYSTEMS_WEAPON_SYSTEM_H
 
 #include "ecs/system.h"
+#include "ecs/entity.h"
 #include <string>
 
 namespace atlas {
@@ -29,6 +30,9 @@ public:
      * @return true if weapon fired successfully
      */
     bool fireWeapon(const std::string& shooter_id, const std::string& target_id);
+
+    /// Same as above for already-resolved entities (either may be null)
+    bool fireWeapon(ecs::Entity* shooter, ecs::Entity* target);
     
 private:
     /**
@@ -6,7 +6,7 @@
  *
  * Provides:
  *   - Non-blocking stdin command reading
- *   - Command dispatching (status, help, kick, stop, players, uptime)
+ *   - Command dispatching (status, help, kick, stop, players, uptime, profile)
  *   - Log message buffering for display
  *
  * See docs/server_gui_design.md for full design specification.
@@ -167,6 +167,8 @@ private:
     std::string handleMetricsCommand();
     std::string handleSaveCommand();
     std::string handleLoadCommand();
+    std::string handleQueriesCommand();
+    std::string handleProfileCommand(const std::vector<std::string>& args);
 
     /** Tokenize a command string on whitespace. */
     static std::vector<std::string> tokenize(const std::string& input) {
@@ -12,7 +12,7 @@ namespace utils {
 /**
  * @brief Lightweight server performance metrics
  *
- * Tracks tick timing, entity/player counts, and uptime.
+ * Tracks tick timing, entity/player counts, world saves and uptime.
  * Call `recordTickStart()` and `recordTickEnd()` around the
  * main-loop body, and `logSummary()` periodically for a
  * human-readable status line.
@@ -40,6 +40,27 @@ public:
     int  getEntityCount() const;
     int  getPlayerCount() const;
 
+    // --- World saves ---
+    /// Tick-thread time spent capturing state for a save
+    void recordSaveStall(double ms);
+    /// A background save finished (serialise + compress + write time)
+    void recordSaveCompleted(double duration_ms, bool success);
+
+    uint64_t getSaveCount() const;
+    uint64_t getSaveFailures() const;
+    double getLastSaveMs() const;
+    double getMaxSaveMs() const;
+    double getLastSaveStallMs() const;
+    double getMaxSaveStallMs() const;
+
+    // --- Journal ---
+    /// A journal flush finished; `bytes` is 0 when nothing had changed
+    void recordJournalFlush(double duration_ms, uint64_t bytes);
+
+    uint64_t getJournalRecords() const;
+    uint64_t getJournalBytes() const;
+    double getLastJournalFlushMs() const;
+
     // --- Uptime ---
     /// Seconds since the metrics object was created (server start)
     double getUptimeSeconds() const;
@@ -53,6 +74,11 @@ public:
      *
      * Example:
      *   "[Metrics] tick avg=2.13ms min=1.80ms max=4.21ms | entities=42 players=3 | uptime 0d 1h 5m 30s | ticks=113400"
+     *
+     * Once a save has been recorded it also carries
+     *   " | saves=3 failed=0 last=412.50ms stall=6.20ms"
+     * and once the journal has flushed
+     *   " | journal=120 records 5.31MB flush=1.40ms"
      */
     std::string summary() const;
 
@@ -82,6 +108,19 @@ private:
     int entity_count_ = 0;
     int player_count_ = 0;
 
+    uint64_t save_count_ = 0;
+    uint64_t save_failures_ = 0;
+    double last_save_ms_ = 0.0;
+    double max_save_ms_ = 0.0;
+    double last_save_stall_ms_ = 0.0;
+    double max_save_stall_ms_ = 0.0;
+    bool save_recorded_ = false;
+
+    uint64_t journal_records_ = 0;
+    uint64_t journal_bytes_ = 0;
+    uint64_t journal_flushes_ = 0;
+    double last_journal_flush_ms_ = 0.0;
+
     mutable std::mutex mutex_;
 };
 
@@ -0,0 +1,217 @@
+#ifndef NOVAFORGE_TICK_PROFILER_H
+#define NOVAFORGE_TICK_PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace atlas {
+namespace utils {
+
+/// What a profiled zone was doing; the "cat" field of the trace export
+enum class ProfileCategory : uint8_t {
+    Tick,
+    System,
+    Network,
+    Persistence,
+    Other,
+};
+
+const char* profileCategoryName(ProfileCategory category);
+
+/// One zone's cost in the most recently closed tick
+struct ProfileTickSample {
+    const char* name = nullptr;
+    ProfileCategory category = ProfileCategory::Other;
+    double ms = 0.0;          ///< summed over every run in that tick
+};
+
+/// One zone over the rolling window
+struct ProfileZoneStats {
+    std::string name;
+    ProfileCategory category = ProfileCategory::Other;
+    size_t samples = 0;       ///< ticks in the window in which the zone ran
+    double last_ms = 0.0;     ///< most recent such tick
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+/**
+ * @brief Scoped timing for the server tick
+ *
+ * Zones (see ProfileScope) are recorded into a ring buffer owned by the
+ * recording thread.  Recording takes no lock: each ring has a single
+ * writer, and each event carries a sequence number that readers check
+ * before and after copying it, so an event overwritten mid-read is
+ * dropped rather than torn.  A thread's ring is created, under a lock,
+ * the first time it records.
+ *
+ * endTick(), called on the tick thread between ticks, folds the events
+ * recorded since the previous call into one per-tick cost per zone and
+ * keeps the last `window_ticks` of those for p50/p99/max.  The rings
+ * themselves hold the most recent raw events, which writeChromeTrace()
+ * exports in the Chrome trace event format (also read by Perfetto).
+ *
+ * Zone names must outlive the profiler: string literals, or pointers
+ * returned by intern().
+ */
+class TickProfiler {
+public:
+    static constexpr size_t DEFAULT_RING_EVENTS = 1 << 16;
+    static constexpr size_t DEFAULT_WINDOW_TICKS = 600;
+
+    /// `ring_events` is rounded up to a power of two
+    explicit TickProfiler(size_t ring_events = DEFAULT_RING_EVENTS,
+                          size_t window_ticks = DEFAULT_WINDOW_TICKS);
+    ~TickProfiler();
+
+    TickProfiler(const TickProfiler&) = delete;
+    TickProfiler& operator=(const TickProfiler&) = delete;
+
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Change the rolling window; clears the collected statistics
+    void setWindowTicks(size_t window_ticks);
+    size_t getWindowTicks() const { return window_ticks_; }
+
+    /// A copy of `name` that lives as long as the profiler
+    const char* intern(const std::string& name);
+
+    /// Label the calling thread in trace exports
+    void setThreadName(const std::string& name);
+
+    /// Record a finished zone on the calling thread
+    void record(const char* name, ProfileCategory category, int64_t start_ns, int64_t end_ns);
+
+    /**
+     * @brief Close the current tick
+     *
+     * Zones that ran more than once (e.g. one network handler per message)
+     * count as their sum.  Events still being written by other threads are
+     * picked up by the next call.
+     */
+    void endTick();
+
+    /// Zones that ran in the most recently closed tick, in first-seen order
+    const std::vector<ProfileTickSample>& getLastTick() const { return last_tick_; }
+
+    /// Every zone seen in the window, slowest p99 first
+    std::vector<ProfileZoneStats> getStats() const;
+
+    /// Table of the `top_n` slowest zones by p99, for the console
+    std::string statsReport(size_t top_n = 20) const;
+
+    /// Write the events still in the rings as Chrome trace JSON
+    void writeChromeTrace(std::ostream& out) const;
+    bool exportChromeTrace(const std::string& filepath) const;
+
+    uint64_t getTickCount() const { return tick_count_; }
+    /// Events overwritten before endTick() read them
+    uint64_t getDroppedEvents() const { return dropped_events_; }
+
+    /// Clock used for zone timestamps
+    static int64_t nowNs();
+
+private:
+    struct Event {
+        std::atomic<uint64_t> seq{0};   ///< 2n+1 while event n is written, 2n+2 after
+        std::atomic<const char*> name{nullptr};
+        std::atomic<int64_t> start_ns{0};
+        std::atomic<int64_t> end_ns{0};
+        std::atomic<uint8_t> category{0};
+    };
+
+    struct EventCopy {
+        const char* name;
+        ProfileCategory category;
+        int64_t start_ns;
+        int64_t end_ns;
+    };
+
+    struct ThreadRing {
+        std::thread::id owner;
+        uint32_t tid = 0;
+        std::string label;
+        std::unique_ptr<Event[]> events;
+        std::atomic<uint64_t> head{0};  ///< events ever written
+        uint64_t read_cursor = 0;       ///< next event endTick() reads
+    };
+
+    struct Zone {
+        const char* name = nullptr;
+        ProfileCategory category = ProfileCategory::Other;
+        std::vector<float> samples;     ///< ring of per-tick ms
+        size_t next = 0;
+        size_t count = 0;
+        double tick_ms = 0.0;           ///< accumulating for the open tick
+        bool ran = false;
+    };
+
+    ThreadRing* ringForThisThread();
+    ThreadRing* findOrCreateRing();
+    bool readEvent(const ThreadRing& ring, uint64_t n, EventCopy& out) const;
+    size_t zoneFor(const char* name, ProfileCategory category);
+
+    const uint64_t id_;
+    const size_t ring_mask_;
+    size_t window_ticks_;
+    const int64_t epoch_ns_;
+    std::atomic<bool> enabled_{true};
+
+    mutable std::mutex rings_mutex_;
+    std::vector<std::unique_ptr<ThreadRing>> rings_;
+
+    std::mutex names_mutex_;
+    std::unordered_set<std::string> names_;
+
+    // Owned by the tick thread (endTick and the readers of its results)
+    std::vector<Zone> zones_;
+    std::unordered_map<const char*, size_t> zone_by_ptr_;
+    std::unordered_map<std::string, size_t> zone_by_name_;
+    std::vector<size_t> ran_this_tick_;
+    std::vector<ProfileTickSample> last_tick_;
+    uint64_t tick_count_ = 0;
+    uint64_t dropped_events_ = 0;
+};
+
+/**
+ * @brief Times the enclosing scope into a TickProfiler
+ *
+ * A null or disabled profiler costs one branch and no clock reads.
+ */
+class ProfileScope {
+public:
+    ProfileScope(TickProfiler* profiler, const char* name, ProfileCategory category)
+        : profiler_(profiler && profiler->isEnabled() ? profiler : nullptr)
+        , name_(name)
+        , category_(category)
+        , start_ns_(profiler_ ? TickProfiler::nowNs() : 0) {}
+
+    ~ProfileScope() {
+        if (profiler_) profiler_->record(name_, category_, start_ns_, TickProfiler::nowNs());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    TickProfiler* profiler_;
+    const char* name_;
+    ProfileCategory category_;
+    int64_t start_ns_;
+};
+
+} // namespace utils
+} // namespace atlas
+
+#endif // NOVAFORGE_TICK_PROFILER_H
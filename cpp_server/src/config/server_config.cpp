@@ -39,11 +39,17 @@ bool ServerConfig::loadFromFile(const std::string& filepath) {
         if (key == "host") host = value;
         else if (key == "port") port = static_cast<uint16_t>(std::stoi(value));
         else if (key == "max_connections") max_connections = std::stoi(value);
+        else if (key == "network_io_threads") network_io_threads = std::stoi(value);
+        else if (key == "max_send_queue_kb") max_send_queue_kb = std::stoi(value);
         else if (key == "server_name") server_name = value;
         else if (key == "server_description") server_description = value;
         else if (key == "persistent_world") persistent_world = (value == "true");
         else if (key == "auto_save") auto_save = (value == "true");
         else if (key == "save_interval_seconds") save_interval_seconds = std::stoi(value);
+        else if (key == "compress_saves") compress_saves = (value == "true");
+        else if (key == "save_format") save_format = value;
+        else if (key == "journal_interval_seconds") journal_interval_seconds = std::stoi(value);
+        else if (key == "journal_max_mb") journal_max_mb = std::stoi(value);
         else if (key == "use_whitelist") use_whitelist = (value == "true");
         else if (key == "public_server") public_server = (value == "true");
         else if (key == "password") password = value;
@@ -53,6 +59,8 @@ bool ServerConfig::loadFromFile(const std::string& filepath) {
         else if (key == "steam_server_browser") steam_server_browser = (value == "true");
         else if (key == "tick_rate") tick_rate = std::stof(value);
         else if (key == "max_entities") max_entities = std::stoi(value);
+        else if (key == "tick_profiler") tick_profiler = (value == "true");
+        else if (key == "profiler_window_ticks") profiler_window_ticks = std::stoi(value);
         else if (key == "data_path") data_path = value;
         else if (key == "save_path") save_path = value;
         else if (key == "log_path") log_path = value;
@@ -72,11 +80,17 @@ bool ServerConfig::saveToFile(const std::string& filepath) const {
     file << "  \"host\": \"" << host << "\"," << std::endl;
     file << "  \"port\": " << port << "," << std::endl;
     file << "  \"max_connections\": " << max_connections << "," << std::endl;
+    file << "  \"network_io_threads\": " << network_io_threads << "," << std::endl;
+    file << "  \"max_send_queue_kb\": " << max_send_queue_kb << "," << std::endl;
     file << "  \"server_name\": \"" << server_name << "\"," << std::endl;
     file << "  \"server_description\": \"" << server_description << "\"," << std::endl;
     file << "  \"persistent_world\": " << (persistent_world ? "true" : "false") << "," << std::endl;
     file << "  \"auto_save\": " << (auto_save ? "true" : "false") << "," << std::endl;
     file << "  \"save_interval_seconds\": " << save_interval_seconds << "," << std::endl;
+    file << "  \"compress_saves\": " << (compress_saves ? "true" : "false") << "," << std::endl;
+    file << "  \"save_format\": \"" << save_format << "\"," << std::endl;
+    file << "  \"journal_interval_seconds\": " << journal_interval_seconds << "," << std::endl;
+    file << "  \"journal_max_mb\": " << journal_max_mb << "," << std::endl;
     file << "  \"use_whitelist\": " << (use_whitelist ? "true" : "false") << "," << std::endl;
     file << "  \"public_server\": " << (public_server ? "true" : "false") << "," << std::endl;
     file << "  \"password\": \"" << password << "\"," << std::endl;
@@ -86,6 +100,8 @@ bool ServerConfig::saveToFile(const std::string& filepath) const {
     file << "  \"steam_server_browser\": " << (steam_server_browser ? "true" : "false") << "," << std::endl;
     file << "  \"tick_rate\": " << tick_rate << "," << std::endl;
     file << "  \"max_entities\": " << max_entities << "," << std::endl;
+    file << "  \"tick_profiler\": " << (tick_profiler ? "true" : "false") << "," << std::endl;
+    file << "  \"profiler_window_ticks\": " << profiler_window_ticks << "," << std::endl;
     file << "  \"data_path\": \"" << data_path << "\"," << std::endl;
     file << "  \"save_path\": \"" << save_path << "\"," << std::endl;
     file << "  \"log_path\": \"" << log_path << "\"" << std::endl;
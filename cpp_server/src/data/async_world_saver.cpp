@@ -0,0 +1,120 @@
+#include "data/async_world_saver.h"
+#include "utils/logger.h"
+#include <chrono>
+
+namespace atlas {
+namespace data {
+
+AsyncWorldSaver::~AsyncWorldSaver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    // The worker drains a queued save before it exits
+    if (worker_.joinable()) worker_.join();
+}
+
+double AsyncWorldSaver::requestSave(const ecs::World* world,
+                                    const std::string& filepath,
+                                    SaveFormat format,
+                                    uint64_t tag) {
+    auto start = std::chrono::steady_clock::now();
+
+    auto job = std::make_unique<Job>();
+    job->snapshot = world->clone();
+    job->filepath = filepath;
+    job->format = format;
+    job->tag = tag;
+
+    double capture_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_) ++superseded_;
+        pending_ = std::move(job);
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&AsyncWorldSaver::workerLoop, this);
+        }
+    }
+    wake_.notify_one();
+    return capture_ms;
+}
+
+void AsyncWorldSaver::setCompletionHandler(CompletionHandler handler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    on_complete_ = std::move(handler);
+}
+
+bool AsyncWorldSaver::isBusy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_ || writing_;
+}
+
+void AsyncWorldSaver::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !pending_ && !writing_; });
+}
+
+uint64_t AsyncWorldSaver::getCompletedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_;
+}
+
+uint64_t AsyncWorldSaver::getFailedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+uint64_t AsyncWorldSaver::getSupersededCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return superseded_;
+}
+
+void AsyncWorldSaver::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return stopping_ || pending_; });
+        if (!pending_) return;   // stopping with nothing queued
+
+        std::unique_ptr<Job> job = std::move(pending_);
+        writing_ = true;
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        Result result;
+        result.filepath = job->filepath;
+        result.tag = job->tag;
+        std::string data = persistence_.serializeAs(job->snapshot.get(), job->format);
+        job->snapshot.reset();
+        result.bytes = data.size();
+        result.success = WorldPersistence::writeSaveFile(
+            data, job->filepath, job->format == SaveFormat::CompressedJson);
+        result.duration_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        if (result.success) {
+            atlas::utils::Logger::instance().info(
+                "[AsyncWorldSaver] World saved to " + result.filepath + " in " +
+                std::to_string(static_cast<int>(result.duration_ms)) + " ms");
+        } else {
+            atlas::utils::Logger::instance().error(
+                "[AsyncWorldSaver] Save to " + result.filepath + " failed");
+        }
+
+        lock.lock();
+        CompletionHandler handler = on_complete_;
+        lock.unlock();
+        if (handler) handler(result);
+
+        lock.lock();
+        if (result.success) ++completed_;
+        else ++failed_;
+        writing_ = false;
+        if (!pending_) idle_.notify_all();
+    }
+}
+
+} // namespace data
+} // namespace atlas
@@ -0,0 +1,956 @@
+#include "data/world_persistence.h"
+#include "components/game_components.h"
+#include "utils/logger.h"
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace atlas {
+namespace data {
+
+// ---------------------------------------------------------------------------
+// Binary save layout (native little-endian, no padding)
+//
+//   header   magic "NFWORLD\0" | u32 version | u32 byte-order mark
+//            u64 entity_count | u32 block_count | u32 flags
+//   ids      string column of entity_count rows
+//   blocks   block_count times:
+//              string key | u8 encoding | u32 field_count | u64 row_count
+//              field_count x (u8 type | string name)
+//              u64 payload_size
+//              payload: u32 entity_row[row_count], then each column
+//   delta    only with kFlagDelta (journal records):
+//              u64 destroyed_count | string column of destroyed IDs
+//              u64 removed_count | string column of entity IDs
+//                                | string column of block keys
+//
+//   string   u32 length | bytes
+//   column   fixed types: row_count values
+//            strings:     u64 offsets[row_count + 1] | bytes
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr char kMagic[8] = {'N', 'F', 'W', 'O', 'R', 'L', 'D', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint32_t kFlagDelta = 1u << 0;   // rows merge into existing entities
+
+enum class FieldType : uint8_t { F32 = 1, F64 = 2, I32 = 3, Bool = 4, String = 5 };
+
+enum class BlockEncoding : uint8_t {
+    Columns = 0,   // one column per field
+    Json = 1       // one "json" string column (nested components)
+};
+
+size_t fixedWidth(FieldType type) {
+    switch (type) {
+        case FieldType::F32:  return 4;
+        case FieldType::F64:  return 8;
+        case FieldType::I32:  return 4;
+        case FieldType::Bool: return 1;
+        default:              return 0;
+    }
+}
+
+// Appends to the output image
+class ByteWriter {
+public:
+    explicit ByteWriter(std::string& out) : out_(out) {}
+
+    template<typename T>
+    void pod(const T& value) {
+        out_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void str(std::string_view s) {
+        pod(static_cast<uint32_t>(s.size()));
+        out_.append(s.data(), s.size());
+    }
+
+    /// String column of `count` rows: offsets, then the concatenated bytes
+    template<typename Get>
+    void stringColumn(size_t count, Get get) {
+        uint64_t offset = 0;
+        pod(offset);
+        for (size_t i = 0; i < count; ++i) {
+            offset += get(i).size();
+            pod(offset);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const auto& s = get(i);
+            out_.append(s.data(), s.size());
+        }
+    }
+
+    size_t size() const { return out_.size(); }
+
+    void patch(size_t at, uint64_t value) {
+        std::memcpy(&out_[at], &value, sizeof(value));
+    }
+
+    void patch32(size_t at, uint32_t value) {
+        std::memcpy(&out_[at], &value, sizeof(value));
+    }
+
+private:
+    std::string& out_;
+};
+
+// Bounds-checked reads from the mapped image
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : p_(data), end_(data + size) {}
+
+    bool ok() const { return ok_; }
+    size_t remaining() const { return static_cast<size_t>(end_ - p_); }
+
+    template<typename T>
+    T pod() {
+        T value{};
+        if (const uint8_t* at = take(sizeof(T))) std::memcpy(&value, at, sizeof(T));
+        return value;
+    }
+
+    std::string str() {
+        uint32_t len = pod<uint32_t>();
+        const uint8_t* at = take(len);
+        return at ? std::string(reinterpret_cast<const char*>(at), len) : std::string();
+    }
+
+    /// Advance `n` bytes; returns their start or nullptr (and fails) if short
+    const uint8_t* take(size_t n) {
+        if (!ok_ || n > remaining()) {
+            ok_ = false;
+            return nullptr;
+        }
+        const uint8_t* at = p_;
+        p_ += n;
+        return at;
+    }
+
+private:
+    const uint8_t* p_;
+    const uint8_t* end_;
+    bool ok_ = true;
+};
+
+// One column of a block as found in the file
+struct ColumnView {
+    std::string name;
+    FieldType type = FieldType::F32;
+    size_t rows = 0;
+    const uint8_t* values = nullptr;   // fixed values, or string offsets
+    const uint8_t* bytes = nullptr;    // string bytes
+
+    double number(size_t i) const {
+        switch (type) {
+            case FieldType::F32: { float v;   std::memcpy(&v, values + i * 4, 4); return v; }
+            case FieldType::F64: { double v;  std::memcpy(&v, values + i * 8, 8); return v; }
+            case FieldType::I32: { int32_t v; std::memcpy(&v, values + i * 4, 4); return v; }
+            case FieldType::Bool: return values[i] ? 1.0 : 0.0;
+            default: return 0.0;
+        }
+    }
+
+    std::string_view text(size_t i) const {
+        uint64_t begin, end;
+        std::memcpy(&begin, values + i * 8, 8);
+        std::memcpy(&end, values + (i + 1) * 8, 8);
+        return {reinterpret_cast<const char*>(bytes) + begin, static_cast<size_t>(end - begin)};
+    }
+};
+
+// Reads a column body and checks that its string offsets stay in range
+bool readColumn(ByteReader& in, ColumnView& col) {
+    size_t width = fixedWidth(col.type);
+    if (width > 0) {
+        col.values = in.take(col.rows * width);
+        return col.values != nullptr;
+    }
+    if (col.type != FieldType::String) return false;
+
+    col.values = in.take((col.rows + 1) * sizeof(uint64_t));
+    if (!col.values) return false;
+    uint64_t prev = 0;
+    for (size_t i = 0; i <= col.rows; ++i) {
+        uint64_t offset;
+        std::memcpy(&offset, col.values + i * 8, 8);
+        if (offset < prev || (i == 0 && offset != 0)) return false;
+        prev = offset;
+    }
+    col.bytes = in.take(static_cast<size_t>(prev));
+    return col.bytes != nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Column schemas
+// ---------------------------------------------------------------------------
+
+template<typename M>
+constexpr FieldType fieldTypeOf() {
+    if constexpr (std::is_same_v<M, std::string>) return FieldType::String;
+    else if constexpr (std::is_same_v<M, bool>)   return FieldType::Bool;
+    else if constexpr (std::is_same_v<M, float>)  return FieldType::F32;
+    else if constexpr (std::is_same_v<M, double>) return FieldType::F64;
+    else {
+        static_assert(std::is_enum_v<M> || (std::is_integral_v<M> && sizeof(M) <= 4),
+                      "unsupported column type");
+        return FieldType::I32;
+    }
+}
+
+template<typename C>
+struct ColumnField {
+    const char* name;
+    FieldType type;
+    std::function<void(const C* const* rows, size_t count, ByteWriter&)> write;
+    /// Fill `rows` from a column; columns of an incompatible type are ignored
+    std::function<void(const ColumnView&, const std::vector<C*>&)> read;
+};
+
+template<typename C, typename M>
+ColumnField<C> field(const char* name, M C::*member) {
+    ColumnField<C> f;
+    f.name = name;
+    f.type = fieldTypeOf<M>();
+    f.write = [member](const C* const* rows, size_t count, ByteWriter& out) {
+        if constexpr (std::is_same_v<M, std::string>) {
+            out.stringColumn(count, [&](size_t i) -> const std::string& { return rows[i]->*member; });
+        } else if constexpr (std::is_same_v<M, bool>) {
+            for (size_t i = 0; i < count; ++i) out.pod(static_cast<uint8_t>(rows[i]->*member ? 1 : 0));
+        } else if constexpr (std::is_enum_v<M> || std::is_integral_v<M>) {
+            for (size_t i = 0; i < count; ++i) out.pod(static_cast<int32_t>(rows[i]->*member));
+        } else {
+            for (size_t i = 0; i < count; ++i) out.pod(rows[i]->*member);
+        }
+    };
+    f.read = [member](const ColumnView& col, const std::vector<C*>& rows) {
+        if constexpr (std::is_same_v<M, std::string>) {
+            if (col.type != FieldType::String) return;
+            for (size_t i = 0; i < rows.size(); ++i) rows[i]->*member = std::string(col.text(i));
+        } else {
+            if (col.type == FieldType::String) return;
+            for (size_t i = 0; i < rows.size(); ++i) {
+                double v = col.number(i);
+                if constexpr (std::is_same_v<M, bool>) rows[i]->*member = v != 0.0;
+                else if constexpr (std::is_enum_v<M>) rows[i]->*member = static_cast<M>(static_cast<int32_t>(v));
+                else rows[i]->*member = static_cast<M>(v);
+            }
+        }
+    };
+    return f;
+}
+
+class ComponentCodec {
+public:
+    virtual ~ComponentCodec() = default;
+    virtual const std::string& key() const = 0;
+
+    /// Append this component's block for the entities at `candidates`
+    /// (indices into `entities`, all of them if null) that have one.
+    /// Returns false, writing nothing, if none do.
+    virtual bool save(const std::vector<const ecs::Entity*>& entities,
+                      const std::vector<uint32_t>* candidates, ByteWriter& out) const = 0;
+
+    /// Build components for `rows` (indices into `entities`) from `columns`
+    virtual void load(ecs::World* world, const std::vector<ecs::Entity*>& entities,
+                      const uint8_t* rows, size_t row_count,
+                      const std::vector<ColumnView>& columns) const = 0;
+
+    /// Encode one entity's row into `scratch`; false if it has no component
+    virtual bool encodeRow(const ecs::Entity* entity, std::string& scratch) const = 0;
+
+    virtual void remove(ecs::Entity* entity) const = 0;
+};
+
+void writeBlockHeader(ByteWriter& out, const std::string& key, BlockEncoding encoding,
+                      const std::vector<std::pair<const char*, FieldType>>& fields,
+                      size_t row_count) {
+    out.str(key);
+    out.pod(static_cast<uint8_t>(encoding));
+    out.pod(static_cast<uint32_t>(fields.size()));
+    out.pod(static_cast<uint64_t>(row_count));
+    for (const auto& f : fields) {
+        out.pod(static_cast<uint8_t>(f.second));
+        out.str(f.first);
+    }
+}
+
+template<typename C>
+class ColumnCodec : public ComponentCodec {
+public:
+    ColumnCodec(std::string key, std::vector<ColumnField<C>> fields)
+        : key_(std::move(key)), fields_(std::move(fields)) {}
+
+    const std::string& key() const override { return key_; }
+
+    bool save(const std::vector<const ecs::Entity*>& entities,
+              const std::vector<uint32_t>* candidates, ByteWriter& out) const override {
+        std::vector<uint32_t> index;
+        std::vector<const C*> rows;
+        auto consider = [&](uint32_t i) {
+            if (const C* c = entities[i]->getComponent<C>()) {
+                index.push_back(i);
+                rows.push_back(c);
+            }
+        };
+        if (candidates) {
+            for (uint32_t i : *candidates) consider(i);
+        } else {
+            for (size_t i = 0; i < entities.size(); ++i) consider(static_cast<uint32_t>(i));
+        }
+        if (rows.empty()) return false;
+
+        std::vector<std::pair<const char*, FieldType>> schema;
+        for (const auto& f : fields_) schema.emplace_back(f.name, f.type);
+        writeBlockHeader(out, key_, BlockEncoding::Columns, schema, rows.size());
+
+        size_t size_at = out.size();
+        out.pod(uint64_t{0});
+        size_t start = out.size();
+        for (uint32_t i : index) out.pod(i);
+        for (const auto& f : fields_) f.write(rows.data(), rows.size(), out);
+        out.patch(size_at, out.size() - start);
+        return true;
+    }
+
+    bool encodeRow(const ecs::Entity* entity, std::string& scratch) const override {
+        const C* c = entity->getComponent<C>();
+        if (!c) return false;
+        scratch.clear();
+        ByteWriter out(scratch);
+        for (const auto& f : fields_) f.write(&c, 1, out);
+        return true;
+    }
+
+    void remove(ecs::Entity* entity) const override {
+        entity->removeComponent<C>();
+    }
+
+    void load(ecs::World* world, const std::vector<ecs::Entity*>& entities,
+              const uint8_t* rows, size_t row_count,
+              const std::vector<ColumnView>& columns) const override {
+        world->reserveComponents<C>(row_count);
+
+        std::vector<std::unique_ptr<C>> built;
+        std::vector<C*> ptrs;
+        built.reserve(row_count);
+        ptrs.reserve(row_count);
+        for (size_t i = 0; i < row_count; ++i) {
+            built.push_back(std::make_unique<C>());
+            ptrs.push_back(built.back().get());
+        }
+
+        // Match by name: missing columns keep defaults, unknown ones are skipped
+        for (const auto& col : columns) {
+            for (const auto& f : fields_) {
+                if (col.name == f.name) {
+                    f.read(col, ptrs);
+                    break;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < row_count; ++i) {
+            uint32_t row;
+            std::memcpy(&row, rows + i * 4, 4);
+            entities[row]->addComponent(std::move(built[i]));
+        }
+    }
+
+private:
+    std::string key_;
+    std::vector<ColumnField<C>> fields_;
+};
+
+template<typename C>
+std::unique_ptr<ComponentCodec> columns(const char* key, std::vector<ColumnField<C>> fields) {
+    return std::make_unique<ColumnCodec<C>>(key, std::move(fields));
+}
+
+// Same keys and fields as the JSON format (world_serializer.cpp)
+const std::vector<std::unique_ptr<ComponentCodec>>& codecs() {
+    using namespace components;
+    static const std::vector<std::unique_ptr<ComponentCodec>> registry = [] {
+        std::vector<std::unique_ptr<ComponentCodec>> r;
+        r.push_back(columns<Position>("position", {
+            field("x", &Position::x), field("y", &Position::y), field("z", &Position::z),
+            field("rotation", &Position::rotation)}));
+        r.push_back(columns<Velocity>("velocity", {
+            field("vx", &Velocity::vx), field("vy", &Velocity::vy), field("vz", &Velocity::vz),
+            field("angular_velocity", &Velocity::angular_velocity),
+            field("max_speed", &Velocity::max_speed)}));
+        r.push_back(columns<Health>("health", {
+            field("hull_hp", &Health::hull_hp), field("hull_max", &Health::hull_max),
+            field("armor_hp", &Health::armor_hp), field("armor_max", &Health::armor_max),
+            field("shield_hp", &Health::shield_hp), field("shield_max", &Health::shield_max),
+            field("shield_recharge_rate", &Health::shield_recharge_rate),
+            field("hull_em_resist", &Health::hull_em_resist),
+            field("hull_thermal_resist", &Health::hull_thermal_resist),
+            field("hull_kinetic_resist", &Health::hull_kinetic_resist),
+            field("hull_explosive_resist", &Health::hull_explosive_resist),
+            field("armor_em_resist", &Health::armor_em_resist),
+            field("armor_thermal_resist", &Health::armor_thermal_resist),
+            field("armor_kinetic_resist", &Health::armor_kinetic_resist),
+            field("armor_explosive_resist", &Health::armor_explosive_resist),
+            field("shield_em_resist", &Health::shield_em_resist),
+            field("shield_thermal_resist", &Health::shield_thermal_resist),
+            field("shield_kinetic_resist", &Health::shield_kinetic_resist),
+            field("shield_explosive_resist", &Health::shield_explosive_resist)}));
+        r.push_back(columns<Capacitor>("capacitor", {
+            field("capacitor", &Capacitor::capacitor),
+            field("capacitor_max", &Capacitor::capacitor_max),
+            field("recharge_rate", &Capacitor::recharge_rate)}));
+        r.push_back(columns<Ship>("ship", {
+            field("ship_type", &Ship::ship_type), field("ship_class", &Ship::ship_class),
+            field("ship_name", &Ship::ship_name), field("race", &Ship::race),
+            field("cpu", &Ship::cpu), field("cpu_max", &Ship::cpu_max),
+            field("powergrid", &Ship::powergrid), field("powergrid_max", &Ship::powergrid_max),
+            field("signature_radius", &Ship::signature_radius),
+            field("scan_resolution", &Ship::scan_resolution),
+            field("max_locked_targets", &Ship::max_locked_targets),
+            field("max_targeting_range", &Ship::max_targeting_range)}));
+        r.push_back(columns<Faction>("faction", {
+            field("faction_name", &Faction::faction_name)}));
+        r.push_back(columns<AI>("ai", {
+            field("behavior", &AI::behavior), field("state", &AI::state),
+            field("target_entity_id", &AI::target_entity_id),
+            field("orbit_distance", &AI::orbit_distance),
+            field("awareness_range", &AI::awareness_range)}));
+        r.push_back(columns<Weapon>("weapon", {
+            field("weapon_type", &Weapon::weapon_type), field("damage_type", &Weapon::damage_type),
+            field("damage", &Weapon::damage), field("optimal_range", &Weapon::optimal_range),
+            field("falloff_range", &Weapon::falloff_range),
+            field("tracking_speed", &Weapon::tracking_speed),
+            field("rate_of_fire", &Weapon::rate_of_fire),
+            field("capacitor_cost", &Weapon::capacitor_cost),
+            field("ammo_type", &Weapon::ammo_type), field("ammo_count", &Weapon::ammo_count)}));
+        r.push_back(columns<Player>("player", {
+            field("player_id", &Player::player_id),
+            field("character_name", &Player::character_name),
+            field("credits", &Player::credits), field("corporation", &Player::corporation)}));
+        r.push_back(columns<WormholeConnection>("wormhole_connection", {
+            field("wormhole_id", &WormholeConnection::wormhole_id),
+            field("source_system", &WormholeConnection::source_system),
+            field("destination_system", &WormholeConnection::destination_system),
+            field("max_mass", &WormholeConnection::max_mass),
+            field("remaining_mass", &WormholeConnection::remaining_mass),
+            field("max_jump_mass", &WormholeConnection::max_jump_mass),
+            field("max_lifetime_hours", &WormholeConnection::max_lifetime_hours),
+            field("elapsed_hours", &WormholeConnection::elapsed_hours),
+            field("collapsed", &WormholeConnection::collapsed)}));
+        r.push_back(columns<SolarSystem>("solar_system", {
+            field("system_id", &SolarSystem::system_id),
+            field("system_name", &SolarSystem::system_name),
+            field("wormhole_class", &SolarSystem::wormhole_class),
+            field("effect_name", &SolarSystem::effect_name),
+            field("dormants_spawned", &SolarSystem::dormants_spawned)}));
+        r.push_back(columns<FleetMembership>("fleet_membership", {
+            field("fleet_id", &FleetMembership::fleet_id), field("role", &FleetMembership::role),
+            field("squad_id", &FleetMembership::squad_id),
+            field("wing_id", &FleetMembership::wing_id)}));
+        r.push_back(columns<Station>("station", {
+            field("station_name", &Station::station_name),
+            field("docking_range", &Station::docking_range),
+            field("repair_cost_per_hp", &Station::repair_cost_per_hp),
+            field("docked_count", &Station::docked_count)}));
+        r.push_back(columns<Docked>("docked", {
+            field("station_id", &Docked::station_id)}));
+        r.push_back(columns<Wreck>("wreck", {
+            field("source_entity_id", &Wreck::source_entity_id),
+            field("lifetime_remaining", &Wreck::lifetime_remaining),
+            field("salvaged", &Wreck::salvaged)}));
+        r.push_back(columns<CaptainPersonality>("captain_personality", {
+            field("aggression", &CaptainPersonality::aggression),
+            field("sociability", &CaptainPersonality::sociability),
+            field("optimism", &CaptainPersonality::optimism),
+            field("professionalism", &CaptainPersonality::professionalism),
+            field("loyalty", &CaptainPersonality::loyalty),
+            field("paranoia", &CaptainPersonality::paranoia),
+            field("ambition", &CaptainPersonality::ambition),
+            field("adaptability", &CaptainPersonality::adaptability),
+            field("captain_name", &CaptainPersonality::captain_name),
+            field("faction", &CaptainPersonality::faction)}));
+        r.push_back(columns<FleetMorale>("fleet_morale", {
+            field("morale_score", &FleetMorale::morale_score),
+            field("wins", &FleetMorale::wins), field("losses", &FleetMorale::losses),
+            field("ships_lost", &FleetMorale::ships_lost),
+            field("times_saved_by_player", &FleetMorale::times_saved_by_player),
+            field("times_player_saved", &FleetMorale::times_player_saved),
+            field("missions_together", &FleetMorale::missions_together),
+            field("morale_state", &FleetMorale::morale_state)}));
+        r.push_back(columns<EmotionalState>("emotional_state", {
+            field("confidence", &EmotionalState::confidence),
+            field("trust_in_player", &EmotionalState::trust_in_player),
+            field("fatigue", &EmotionalState::fatigue), field("hope", &EmotionalState::hope)}));
+        r.push_back(columns<FleetFormation>("fleet_formation", {
+            field("formation", &FleetFormation::formation),
+            field("slot_index", &FleetFormation::slot_index),
+            field("offset_x", &FleetFormation::offset_x),
+            field("offset_y", &FleetFormation::offset_y),
+            field("offset_z", &FleetFormation::offset_z),
+            field("spacing_modifier", &FleetFormation::spacing_modifier)}));
+        r.push_back(columns<MineralDeposit>("mineral_deposit", {
+            field("mineral_type", &MineralDeposit::mineral_type),
+            field("quantity_remaining", &MineralDeposit::quantity_remaining),
+            field("max_quantity", &MineralDeposit::max_quantity),
+            field("yield_rate", &MineralDeposit::yield_rate),
+            field("volume_per_unit", &MineralDeposit::volume_per_unit)}));
+        r.push_back(columns<AnomalyVisualCue>("anomaly_visual_cue", {
+            field("anomaly_id", &AnomalyVisualCue::anomaly_id),
+            field("cue_type", &AnomalyVisualCue::cue_type),
+            field("intensity", &AnomalyVisualCue::intensity),
+            field("radius", &AnomalyVisualCue::radius),
+            field("pulse_frequency", &AnomalyVisualCue::pulse_frequency),
+            field("r", &AnomalyVisualCue::r), field("g", &AnomalyVisualCue::g),
+            field("b", &AnomalyVisualCue::b),
+            field("distortion_strength", &AnomalyVisualCue::distortion_strength),
+            field("active", &AnomalyVisualCue::active)}));
+        r.push_back(columns<LODPriority>("lod_priority", {
+            field("priority", &LODPriority::priority),
+            field("force_visible", &LODPriority::force_visible),
+            field("impostor_distance", &LODPriority::impostor_distance)}));
+        r.push_back(columns<WarpProfile>("warp_profile", {
+            field("warp_speed", &WarpProfile::warp_speed),
+            field("mass_norm", &WarpProfile::mass_norm),
+            field("intensity", &WarpProfile::intensity),
+            field("comfort_scale", &WarpProfile::comfort_scale)}));
+        r.push_back(columns<WarpVisual>("warp_visual", {
+            field("distortion_strength", &WarpVisual::distortion_strength),
+            field("tunnel_noise_scale", &WarpVisual::tunnel_noise_scale),
+            field("vignette_amount", &WarpVisual::vignette_amount),
+            field("bloom_strength", &WarpVisual::bloom_strength),
+            field("starfield_speed", &WarpVisual::starfield_speed)}));
+        r.push_back(columns<WarpEvent>("warp_event", {
+            field("current_event", &WarpEvent::current_event),
+            field("event_timer", &WarpEvent::event_timer),
+            field("severity", &WarpEvent::severity)}));
+        r.push_back(columns<TacticalProjection>("tactical_projection", {
+            field("projected_x", &TacticalProjection::projected_x),
+            field("projected_y", &TacticalProjection::projected_y),
+            field("vertical_offset", &TacticalProjection::vertical_offset),
+            field("visible", &TacticalProjection::visible)}));
+        r.push_back(columns<PlayerPresence>("player_presence", {
+            field("time_since_last_command", &PlayerPresence::time_since_last_command),
+            field("time_since_last_speech", &PlayerPresence::time_since_last_speech)}));
+        r.push_back(columns<FactionCulture>("faction_culture", {
+            field("faction", &FactionCulture::faction),
+            field("chatter_frequency_mod", &FactionCulture::chatter_frequency_mod),
+            field("formation_tightness_mod", &FactionCulture::formation_tightness_mod),
+            field("morale_sensitivity", &FactionCulture::morale_sensitivity),
+            field("risk_tolerance", &FactionCulture::risk_tolerance)}));
+        return r;
+    }();
+    return registry;
+}
+
+const char* const kNestedBlockKey = "nested";
+
+uint64_t fnv1a(const std::string& bytes) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// Row kind for a block key, or codecs().size() for the nested row
+bool kindForKey(const std::string& key, uint32_t& kind) {
+    const auto& all = codecs();
+    for (size_t i = 0; i < all.size(); ++i) {
+        if (all[i]->key() == key) {
+            kind = static_cast<uint32_t>(i);
+            return true;
+        }
+    }
+    if (key == kNestedBlockKey) {
+        kind = static_cast<uint32_t>(all.size());
+        return true;
+    }
+    return false;
+}
+
+const std::string& keyForKind(uint32_t kind) {
+    static const std::string nested = kNestedBlockKey;
+    return kind < codecs().size() ? codecs()[kind]->key() : nested;
+}
+
+// Read-only view of a save file: mmap where available, a buffer otherwise
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                map_ = p;
+                size_ = static_cast<size_t>(st.st_size);
+                data_ = static_cast<const uint8_t*>(p);
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return;
+        buffer_.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        if (file && !buffer_.empty()) {
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (map_) ::munmap(map_, size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifndef _WIN32
+    void* map_ = nullptr;
+#else
+    std::vector<uint8_t> buffer_;
+#endif
+};
+
+} // namespace
+
+
+// ---------------------------------------------------------------------------
+// Serialization
+// ---------------------------------------------------------------------------
+
+std::string WorldPersistence::nestedJsonRow(const ecs::Entity* entity) const {
+    std::ostringstream json;
+    serializeNestedComponents(entity, json);
+    std::string s = json.str();
+    if (s.empty()) return s;
+    s[0] = '{';   // drop the leading comma
+    s += '}';
+    return s;
+}
+
+std::string WorldPersistence::writeBinaryImage(const std::vector<const ecs::Entity*>& entities,
+                                               const BinaryDelta* delta) const {
+    std::string image;
+    ByteWriter out(image);
+    out.pod(kMagic);
+    out.pod(kFormatVersion);
+    out.pod(kByteOrderMark);
+    out.pod(static_cast<uint64_t>(entities.size()));
+    size_t block_count_at = out.size();
+    out.pod(uint32_t{0});
+    out.pod(delta ? kFlagDelta : uint32_t{0});
+
+    out.stringColumn(entities.size(), [&](size_t i) -> const std::string& { return entities[i]->getId(); });
+
+    // A delta writes each kind only for the entities that list it
+    const size_t kinds = binaryRowKinds();
+    std::vector<std::vector<uint32_t>> candidates;
+    if (delta) {
+        candidates.resize(kinds);
+        for (size_t i = 0; i < delta->kinds.size(); ++i) {
+            for (uint32_t kind : delta->kinds[i]) {
+                if (kind < kinds) candidates[kind].push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+
+    uint32_t blocks = 0;
+    const auto& all = codecs();
+    for (size_t k = 0; k < all.size(); ++k) {
+        if (delta && candidates[k].empty()) continue;
+        if (all[k]->save(entities, delta ? &candidates[k] : nullptr, out)) ++blocks;
+    }
+
+    // Nested components: one JSON object per entity that has any
+    std::vector<uint32_t> nested_rows;
+    std::vector<std::string> nested_json;
+    auto addNested = [&](uint32_t i) {
+        std::string row = nestedJsonRow(entities[i]);
+        if (row.empty()) return;
+        nested_rows.push_back(i);
+        nested_json.push_back(std::move(row));
+    };
+    if (delta) {
+        for (uint32_t i : candidates[all.size()]) addNested(i);
+    } else {
+        for (size_t i = 0; i < entities.size(); ++i) addNested(static_cast<uint32_t>(i));
+    }
+    if (!nested_rows.empty()) {
+        writeBlockHeader(out, kNestedBlockKey, BlockEncoding::Json,
+                         {{"json", FieldType::String}}, nested_rows.size());
+        size_t size_at = out.size();
+        out.pod(uint64_t{0});
+        size_t start = out.size();
+        for (uint32_t row : nested_rows) out.pod(row);
+        out.stringColumn(nested_json.size(), [&](size_t i) -> const std::string& { return nested_json[i]; });
+        out.patch(size_at, out.size() - start);
+        ++blocks;
+    }
+    out.patch32(block_count_at, blocks);
+
+    if (delta) {
+        out.pod(static_cast<uint64_t>(delta->destroyed.size()));
+        out.stringColumn(delta->destroyed.size(),
+                         [&](size_t i) -> const std::string& { return delta->destroyed[i]; });
+        out.pod(static_cast<uint64_t>(delta->removed.size()));
+        out.stringColumn(delta->removed.size(),
+                         [&](size_t i) -> const std::string& { return delta->removed[i].first; });
+        out.stringColumn(delta->removed.size(),
+                         [&](size_t i) -> const std::string& { return keyForKind(delta->removed[i].second); });
+    }
+    return image;
+}
+
+std::string WorldPersistence::serializeWorldBinary(const ecs::World* world) const {
+    auto all = const_cast<ecs::World*>(world)->getAllEntities();
+    std::vector<const ecs::Entity*> entities(all.begin(), all.end());
+    return writeBinaryImage(entities, nullptr);
+}
+
+std::string WorldPersistence::serializeDeltaBinary(const BinaryDelta& delta) const {
+    return writeBinaryImage(delta.entities, &delta);
+}
+
+size_t WorldPersistence::binaryRowKinds() {
+    return codecs().size() + 1;
+}
+
+void WorldPersistence::hashBinaryRows(const ecs::Entity* entity,
+                                      std::vector<std::pair<uint32_t, uint64_t>>& rows) const {
+    rows.clear();
+    std::string scratch;
+    const auto& all = codecs();
+    for (size_t k = 0; k < all.size(); ++k) {
+        if (all[k]->encodeRow(entity, scratch)) {
+            rows.emplace_back(static_cast<uint32_t>(k), fnv1a(scratch));
+        }
+    }
+    std::string nested = nestedJsonRow(entity);
+    if (!nested.empty()) {
+        rows.emplace_back(static_cast<uint32_t>(all.size()), fnv1a(nested));
+    }
+}
+
+bool WorldPersistence::saveWorldBinary(const ecs::World* world,
+                                       const std::string& filepath) {
+    if (!writeSaveFile(serializeWorldBinary(world), filepath, false)) return false;
+
+    atlas::utils::Logger::instance().info("[WorldPersistence] World saved (binary) to " + filepath);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Deserialization
+// ---------------------------------------------------------------------------
+
+bool WorldPersistence::readBinaryImage(ecs::World* world, const void* data,
+                                       size_t size, bool delta) const {
+    auto& log = atlas::utils::Logger::instance();
+    ByteReader in(static_cast<const uint8_t*>(data), size);
+
+    const uint8_t* magic = in.take(sizeof(kMagic));
+    if (!magic || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        log.error("[WorldPersistence] Not a binary world save");
+        return false;
+    }
+    uint32_t version = in.pod<uint32_t>();
+    uint32_t bom = in.pod<uint32_t>();
+    uint64_t entity_count = in.pod<uint64_t>();
+    uint32_t block_count = in.pod<uint32_t>();
+    uint32_t flags = in.pod<uint32_t>();
+    if (!in.ok() || bom != kByteOrderMark) {
+        log.error("[WorldPersistence] Binary save header is truncated or from a foreign byte order");
+        return false;
+    }
+    if (version == 0 || version > kFormatVersion) {
+        log.error("[WorldPersistence] Unsupported binary save version " + std::to_string(version));
+        return false;
+    }
+    if (((flags & kFlagDelta) != 0) != delta) {
+        log.error(delta ? "[WorldPersistence] Expected a delta image, got a full save"
+                        : "[WorldPersistence] Expected a full save, got a delta image");
+        return false;
+    }
+
+    ColumnView ids;
+    ids.type = FieldType::String;
+    ids.rows = static_cast<size_t>(entity_count);
+    if (entity_count > in.remaining() || !readColumn(in, ids)) {
+        log.error("[WorldPersistence] Binary save entity table is corrupt");
+        return false;
+    }
+    std::vector<std::string> names;
+    names.reserve(ids.rows);
+    std::unordered_set<std::string_view> seen;
+    seen.reserve(ids.rows);
+    for (size_t i = 0; i < ids.rows; ++i) {
+        // A repeated ID would replace (and free) the entity created for it first
+        if (!seen.insert(ids.text(i)).second) {
+            log.error("[WorldPersistence] Binary save repeats entity ID '" + std::string(ids.text(i)) + "'");
+            return false;
+        }
+        names.emplace_back(ids.text(i));
+    }
+
+    std::vector<ecs::Entity*> entities;
+    if (delta) {
+        // Rows replace components on the live entity
+        entities.reserve(names.size());
+        for (const auto& name : names) {
+            ecs::Entity* e = world->getEntity(name);
+            entities.push_back(e ? e : world->createEntity(name));
+        }
+    } else {
+        entities = world->createEntities(names);
+    }
+
+    for (uint32_t b = 0; b < block_count; ++b) {
+        std::string key = in.str();
+        auto encoding = static_cast<BlockEncoding>(in.pod<uint8_t>());
+        uint32_t field_count = in.pod<uint32_t>();
+        uint64_t row_count = in.pod<uint64_t>();
+        std::vector<ColumnView> cols;
+        for (uint32_t f = 0; f < field_count && in.ok(); ++f) {
+            ColumnView col;
+            col.type = static_cast<FieldType>(in.pod<uint8_t>());
+            col.name = in.str();
+            col.rows = static_cast<size_t>(row_count);
+            cols.push_back(std::move(col));
+        }
+        uint64_t payload_size = in.pod<uint64_t>();
+        const uint8_t* payload = in.take(static_cast<size_t>(payload_size));
+        if (!payload || row_count > payload_size / 4) {
+            log.error("[WorldPersistence] Binary save block '" + key + "' is truncated");
+            return false;
+        }
+
+        ByteReader body(payload, static_cast<size_t>(payload_size));
+        const uint8_t* rows = body.take(static_cast<size_t>(row_count) * 4);
+        for (size_t i = 0; i < row_count; ++i) {
+            uint32_t row;
+            std::memcpy(&row, rows + i * 4, 4);
+            if (row >= entities.size()) {
+                log.error("[WorldPersistence] Binary save block '" + key + "' references a missing entity");
+                return false;
+            }
+        }
+        for (auto& col : cols) {
+            if (!readColumn(body, col)) {
+                log.error("[WorldPersistence] Binary save column '" + key + "." + col.name + "' is corrupt");
+                return false;
+            }
+        }
+
+        if (encoding == BlockEncoding::Json) {
+            if (cols.size() != 1 || cols[0].type != FieldType::String) continue;
+            try {
+                for (size_t i = 0; i < row_count; ++i) {
+                    uint32_t row;
+                    std::memcpy(&row, rows + i * 4, 4);
+                    if (delta) removeNestedComponents(entities[row]);
+                    deserializeNestedComponents(entities[row], std::string(cols[0].text(i)));
+                }
+            } catch (const std::exception& e) {
+                log.error("[WorldPersistence] Binary save nested component data is corrupt: " +
+                          std::string(e.what()));
+                return false;
+            }
+            continue;
+        }
+
+        uint32_t kind;
+        if (!kindForKey(key, kind) || kind >= codecs().size()) {
+            log.warn("[WorldPersistence] Skipping unknown component block '" + key + "'");
+            continue;
+        }
+        codecs()[kind]->load(world, entities, rows, static_cast<size_t>(row_count), cols);
+    }
+
+    if (delta) {
+        ColumnView destroyed;
+        destroyed.type = FieldType::String;
+        destroyed.rows = static_cast<size_t>(in.pod<uint64_t>());
+        if (!in.ok() || destroyed.rows > in.remaining() || !readColumn(in, destroyed)) {
+            log.error("[WorldPersistence] Delta image destroyed list is corrupt");
+            return false;
+        }
+        ColumnView removed_ids, removed_keys;
+        removed_ids.type = removed_keys.type = FieldType::String;
+        removed_ids.rows = removed_keys.rows = static_cast<size_t>(in.pod<uint64_t>());
+        if (!in.ok() || removed_ids.rows > in.remaining() ||
+            !readColumn(in, removed_ids) || !readColumn(in, removed_keys)) {
+            log.error("[WorldPersistence] Delta image removal list is corrupt");
+            return false;
+        }
+
+        // Row pointers above may be freed from here on
+        for (size_t i = 0; i < destroyed.rows; ++i) {
+            world->destroyEntity(std::string(destroyed.text(i)));
+        }
+        for (size_t i = 0; i < removed_ids.rows; ++i) {
+            ecs::Entity* e = world->getEntity(std::string(removed_ids.text(i)));
+            uint32_t kind;
+            if (!e || !kindForKey(std::string(removed_keys.text(i)), kind)) continue;
+            if (kind < codecs().size()) codecs()[kind]->remove(e);
+            else removeNestedComponents(e);
+        }
+        return true;
+    }
+
+    log.info("[WorldPersistence] Loaded " + std::to_string(entities.size()) + " entities (binary)");
+    return true;
+}
+
+bool WorldPersistence::deserializeWorldBinary(ecs::World* world,
+                                              const void* data, size_t size) const {
+    return readBinaryImage(world, data, size, false);
+}
+
+bool WorldPersistence::applyDeltaBinary(ecs::World* world,
+                                        const void* data, size_t size) const {
+    return readBinaryImage(world, data, size, true);
+}
+
+bool WorldPersistence::loadWorldBinary(ecs::World* world,
+                                       const std::string& filepath) {
+    MappedFile file(filepath);
+    if (!file.data()) {
+        atlas::utils::Logger::instance().error("[WorldPersistence] Cannot open file for reading: " + filepath);
+        return false;
+    }
+    return deserializeWorldBinary(world, file.data(), file.size());
+}
+
+} // namespace data
+} // namespace atlas
@@ -140,128 +140,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         entity->addComponent(std::move(fac));
     }
 
-    // Standings
-    std::string standings_json = extractObject(json, "standings");
-    if (!standings_json.empty()) {
-        auto standings = std::make_unique<components::Standings>();
-        
-        // Deserialize personal standings
-        std::string personal_json = extractObject(standings_json, "personal");
-        if (!personal_json.empty()) {
-            // Parse the personal standings map
-            // Format: {"entity_id": standing_value, ...}
-            size_t pos = 0;
-            while (pos < personal_json.size()) {
-                // Find next key
-                size_t key_start = personal_json.find("\"", pos);
-                if (key_start == std::string::npos) break;
-                key_start++;
-                size_t key_end = personal_json.find("\"", key_start);
-                if (key_end == std::string::npos) break;
-                
-                std::string entity_id = personal_json.substr(key_start, key_end - key_start);
-                
-                // Find value after colon
-                size_t colon = personal_json.find(":", key_end);
-                if (colon == std::string::npos) break;
-                
-                // Extract number
-                size_t val_start = colon + 1;
-                while (val_start < personal_json.size() && 
-                       (personal_json[val_start] == ' ' || personal_json[val_start] == '\t')) {
-                    val_start++;
-                }
-                size_t val_end = val_start;
-                while (val_end < personal_json.size() && 
-                       (std::isdigit(personal_json[val_end]) || personal_json[val_end] == '.' || 
-                        personal_json[val_end] == '-' || personal_json[val_end] == '+')) {
-                    val_end++;
-                }
-                
-                if (val_end > val_start) {
-                    float standing = std::stof(personal_json.substr(val_start, val_end - val_start));
-                    standings->personal_standings[entity_id] = standing;
-                }
-                
-                pos = val_end + 1;
-            }
-        }
-        
-        // Deserialize corporation standings
-        std::string corp_json = extractObject(standings_json, "corporation");
-        if (!corp_json.empty()) {
-            size_t pos = 0;
-            while (pos < corp_json.size()) {
-                size_t key_start = corp_json.find("\"", pos);
-                if (key_start == std::string::npos) break;
-                key_start++;
-                size_t key_end = corp_json.find("\"", key_start);
-                if (key_end == std::string::npos) break;
-                
-                std::string corp_name = corp_json.substr(key_start, key_end - key_start);
-                size_t colon = corp_json.find(":", key_end);
-                if (colon == std::string::npos) break;
-                
-                size_t val_start = colon + 1;
-                while (val_start < corp_json.size() && 
-                       (corp_json[val_start] == ' ' || corp_json[val_start] == '\t')) {
-                    val_start++;
-                }
-                size_t val_end = val_start;
-                while (val_end < corp_json.size() && 
-                       (std::isdigit(corp_json[val_end]) || corp_json[val_end] == '.' || 
-                        corp_json[val_end] == '-' || corp_json[val_end] == '+')) {
-                    val_end++;
-                }
-                
-                if (val_end > val_start) {
-                    float standing = std::stof(corp_json.substr(val_start, val_end - val_start));
-                    standings->corporation_standings[corp_name] = standing;
-                }
-                
-                pos = val_end + 1;
-            }
-        }
-        
-        // Deserialize faction standings
-        std::string faction_json = extractObject(standings_json, "faction");
-        if (!faction_json.empty()) {
-            size_t pos = 0;
-            while (pos < faction_json.size()) {
-                size_t key_start = faction_json.find("\"", pos);
-                if (key_start == std::string::npos) break;
-                key_start++;
-                size_t key_end = faction_json.find("\"", key_start);
-                if (key_end == std::string::npos) break;
-                
-                std::string faction_name = faction_json.substr(key_start, key_end - key_start);
-                size_t colon = faction_json.find(":", key_end);
-                if (colon == std::string::npos) break;
-                
-                size_t val_start = colon + 1;
-                while (val_start < faction_json.size() && 
-                       (faction_json[val_start] == ' ' || faction_json[val_start] == '\t')) {
-                    val_start++;
-                }
-                size_t val_end = val_start;
-                while (val_end < faction_json.size() && 
-                       (std::isdigit(faction_json[val_end]) || faction_json[val_end] == '.' || 
-                        faction_json[val_end] == '-' || faction_json[val_end] == '+')) {
-                    val_end++;
-                }
-                
-                if (val_end > val_start) {
-                    float standing = std::stof(faction_json.substr(val_start, val_end - val_start));
-                    standings->faction_standings[faction_name] = standing;
-                }
-                
-                pos = val_end + 1;
-            }
-        }
-        
-        entity->addComponent(std::move(standings));
-    }
-
     // AI
     std::string ai_json = extractObject(json, "ai");
     if (!ai_json.empty()) {
@@ -342,7 +220,332 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         fm->wing_id  = extractString(fm_json, "wing_id");
         entity->addComponent(std::move(fm));
     }
-
+
+    // Station
+    std::string sta_json = extractObject(json, "station");
+    if (!sta_json.empty()) {
+        auto sta = std::make_unique<components::Station>();
+        sta->station_name      = extractString(sta_json, "station_name");
+        sta->docking_range     = extractFloat(sta_json, "docking_range", 2500.0f);
+        sta->repair_cost_per_hp = extractFloat(sta_json, "repair_cost_per_hp", 1.0f);
+        sta->docked_count      = extractInt(sta_json, "docked_count");
+        entity->addComponent(std::move(sta));
+    }
+
+    // Docked
+    std::string dck_json = extractObject(json, "docked");
+    if (!dck_json.empty()) {
+        auto dck = std::make_unique<components::Docked>();
+        dck->station_id = extractString(dck_json, "station_id");
+        entity->addComponent(std::move(dck));
+    }
+
+    // Wreck
+    std::string wrk_json = extractObject(json, "wreck");
+    if (!wrk_json.empty()) {
+        auto wrk = std::make_unique<components::Wreck>();
+        wrk->source_entity_id   = extractString(wrk_json, "source_entity_id");
+        wrk->lifetime_remaining = extractFloat(wrk_json, "lifetime_remaining", 1800.0f);
+        wrk->salvaged           = extractBool(wrk_json, "salvaged", false);
+        entity->addComponent(std::move(wrk));
+    }
+
+    // CaptainPersonality
+    std::string cp_json = extractObject(json, "captain_personality");
+    if (!cp_json.empty()) {
+        auto cp = std::make_unique<components::CaptainPersonality>();
+        cp->aggression       = extractFloat(cp_json, "aggression", 0.5f);
+        cp->sociability      = extractFloat(cp_json, "sociability", 0.5f);
+        cp->optimism         = extractFloat(cp_json, "optimism", 0.5f);
+        cp->professionalism  = extractFloat(cp_json, "professionalism", 0.5f);
+        cp->loyalty          = extractFloat(cp_json, "loyalty", 0.5f);
+        cp->paranoia         = extractFloat(cp_json, "paranoia", 0.5f);
+        cp->ambition         = extractFloat(cp_json, "ambition", 0.5f);
+        cp->adaptability     = extractFloat(cp_json, "adaptability", 0.5f);
+        cp->captain_name     = extractString(cp_json, "captain_name");
+        cp->faction          = extractString(cp_json, "faction");
+        entity->addComponent(std::move(cp));
+    }
+
+    // FleetMorale
+    std::string fmor_json = extractObject(json, "fleet_morale");
+    if (!fmor_json.empty()) {
+        auto fmor = std::make_unique<components::FleetMorale>();
+        fmor->morale_score          = extractFloat(fmor_json, "morale_score", 0.0f);
+        fmor->wins                  = extractInt(fmor_json, "wins");
+        fmor->losses                = extractInt(fmor_json, "losses");
+        fmor->ships_lost            = extractInt(fmor_json, "ships_lost");
+        fmor->times_saved_by_player = extractInt(fmor_json, "times_saved_by_player");
+        fmor->times_player_saved    = extractInt(fmor_json, "times_player_saved");
+        fmor->missions_together     = extractInt(fmor_json, "missions_together");
+        fmor->morale_state          = extractString(fmor_json, "morale_state");
+        if (fmor->morale_state.empty()) fmor->morale_state = "Steady";
+        entity->addComponent(std::move(fmor));
+    }
+
+    // EmotionalState
+    std::string es_json = extractObject(json, "emotional_state");
+    if (!es_json.empty()) {
+        auto es = std::make_unique<components::EmotionalState>();
+        es->confidence      = extractFloat(es_json, "confidence", 50.0f);
+        es->trust_in_player = extractFloat(es_json, "trust_in_player", 50.0f);
+        es->fatigue         = extractFloat(es_json, "fatigue", 0.0f);
+        es->hope            = extractFloat(es_json, "hope", 50.0f);
+        entity->addComponent(std::move(es));
+    }
+
+    // FleetFormation
+    std::string ff_json = extractObject(json, "fleet_formation");
+    if (!ff_json.empty()) {
+        auto ff = std::make_unique<components::FleetFormation>();
+        int ft = extractInt(ff_json, "formation");
+        ff->formation  = static_cast<components::FleetFormation::FormationType>(ft);
+        ff->slot_index = extractInt(ff_json, "slot_index");
+        ff->offset_x   = extractFloat(ff_json, "offset_x", 0.0f);
+        ff->offset_y   = extractFloat(ff_json, "offset_y", 0.0f);
+        ff->offset_z   = extractFloat(ff_json, "offset_z", 0.0f);
+        ff->spacing_modifier = extractFloat(ff_json, "spacing_modifier", 1.0f);
+        entity->addComponent(std::move(ff));
+    }
+
+    // MineralDeposit
+    std::string md_json = extractObject(json, "mineral_deposit");
+    if (!md_json.empty()) {
+        auto md = std::make_unique<components::MineralDeposit>();
+        md->mineral_type       = extractString(md_json, "mineral_type");
+        if (md->mineral_type.empty()) md->mineral_type = "Ferrite";
+        md->quantity_remaining = extractFloat(md_json, "quantity_remaining", 10000.0f);
+        md->max_quantity       = extractFloat(md_json, "max_quantity", 10000.0f);
+        md->yield_rate         = extractFloat(md_json, "yield_rate", 1.0f);
+        md->volume_per_unit    = extractFloat(md_json, "volume_per_unit", 0.1f);
+        entity->addComponent(std::move(md));
+    }
+
+    // AnomalyVisualCue
+    std::string avc_json = extractObject(json, "anomaly_visual_cue");
+    if (!avc_json.empty()) {
+        auto avc = std::make_unique<components::AnomalyVisualCue>();
+        avc->anomaly_id = extractString(avc_json, "anomaly_id");
+        avc->cue_type = static_cast<components::AnomalyVisualCue::CueType>(
+            extractInt(avc_json, "cue_type", 5));
+        avc->intensity = extractFloat(avc_json, "intensity");
+        avc->radius = extractFloat(avc_json, "radius");
+        avc->pulse_frequency = extractFloat(avc_json, "pulse_frequency");
+        avc->r = extractFloat(avc_json, "r");
+        avc->g = extractFloat(avc_json, "g");
+        avc->b = extractFloat(avc_json, "b");
+        avc->distortion_strength = extractFloat(avc_json, "distortion_strength");
+        avc->active = extractBool(avc_json, "active", true);
+        entity->addComponent(std::move(avc));
+    }
+
+    // LODPriority
+    std::string lod_json = extractObject(json, "lod_priority");
+    if (!lod_json.empty()) {
+        auto lod = std::make_unique<components::LODPriority>();
+        lod->priority = extractFloat(lod_json, "priority");
+        lod->force_visible = extractBool(lod_json, "force_visible", false);
+        lod->impostor_distance = extractFloat(lod_json, "impostor_distance");
+        entity->addComponent(std::move(lod));
+    }
+
+    // WarpProfile
+    std::string wp_json = extractObject(json, "warp_profile");
+    if (!wp_json.empty()) {
+        auto wp = std::make_unique<components::WarpProfile>();
+        wp->warp_speed = extractFloat(wp_json, "warp_speed");
+        wp->mass_norm = extractFloat(wp_json, "mass_norm");
+        wp->intensity = extractFloat(wp_json, "intensity");
+        wp->comfort_scale = extractFloat(wp_json, "comfort_scale");
+        entity->addComponent(std::move(wp));
+    }
+
+    // WarpVisual
+    std::string wv_json = extractObject(json, "warp_visual");
+    if (!wv_json.empty()) {
+        auto wv = std::make_unique<components::WarpVisual>();
+        wv->distortion_strength = extractFloat(wv_json, "distortion_strength");
+        wv->tunnel_noise_scale = extractFloat(wv_json, "tunnel_noise_scale");
+        wv->vignette_amount = extractFloat(wv_json, "vignette_amount");
+        wv->bloom_strength = extractFloat(wv_json, "bloom_strength");
+        wv->starfield_speed = extractFloat(wv_json, "starfield_speed");
+        entity->addComponent(std::move(wv));
+    }
+
+    // WarpEvent
+    std::string we_json = extractObject(json, "warp_event");
+    if (!we_json.empty()) {
+        auto we = std::make_unique<components::WarpEvent>();
+        we->current_event = extractString(we_json, "current_event");
+        we->event_timer = extractFloat(we_json, "event_timer");
+        we->severity = extractInt(we_json, "severity", 0);
+        entity->addComponent(std::move(we));
+    }
+
+    // TacticalProjection
+    std::string tp_json = extractObject(json, "tactical_projection");
+    if (!tp_json.empty()) {
+        auto tp = std::make_unique<components::TacticalProjection>();
+        tp->projected_x = extractFloat(tp_json, "projected_x");
+        tp->projected_y = extractFloat(tp_json, "projected_y");
+        tp->vertical_offset = extractFloat(tp_json, "vertical_offset");
+        tp->visible = extractBool(tp_json, "visible", true);
+        entity->addComponent(std::move(tp));
+    }
+
+    // PlayerPresence
+    std::string pp_json = extractObject(json, "player_presence");
+    if (!pp_json.empty()) {
+        auto pp = std::make_unique<components::PlayerPresence>();
+        pp->time_since_last_command = extractFloat(pp_json, "time_since_last_command");
+        pp->time_since_last_speech = extractFloat(pp_json, "time_since_last_speech");
+        entity->addComponent(std::move(pp));
+    }
+
+    // FactionCulture
+    std::string fc_json = extractObject(json, "faction_culture");
+    if (!fc_json.empty()) {
+        auto fc = std::make_unique<components::FactionCulture>();
+        fc->faction = extractString(fc_json, "faction");
+        fc->chatter_frequency_mod = extractFloat(fc_json, "chatter_frequency_mod");
+        fc->formation_tightness_mod = extractFloat(fc_json, "formation_tightness_mod");
+        fc->morale_sensitivity = extractFloat(fc_json, "morale_sensitivity");
+        fc->risk_tolerance = extractFloat(fc_json, "risk_tolerance");
+        entity->addComponent(std::move(fc));
+    }
+
+    deserializeNestedComponents(entity, json);
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Components with nested containers (kept as JSON in binary saves too)
+// ---------------------------------------------------------------------------
+
+void WorldPersistence::deserializeNestedComponents(ecs::Entity* entity,
+                                                   const std::string& json) const {
+    // Standings
+    std::string standings_json = extractObject(json, "standings");
+    if (!standings_json.empty()) {
+        auto standings = std::make_unique<components::Standings>();
+        
+        // Deserialize personal standings
+        std::string personal_json = extractObject(standings_json, "personal");
+        if (!personal_json.empty()) {
+            // Parse the personal standings map
+            // Format: {"entity_id": standing_value, ...}
+            size_t pos = 0;
+            while (pos < personal_json.size()) {
+                // Find next key
+                size_t key_start = personal_json.find("\"", pos);
+                if (key_start == std::string::npos) break;
+                key_start++;
+                size_t key_end = personal_json.find("\"", key_start);
+                if (key_end == std::string::npos) break;
+                
+                std::string entity_id = personal_json.substr(key_start, key_end - key_start);
+                
+                // Find value after colon
+                size_t colon = personal_json.find(":", key_end);
+                if (colon == std::string::npos) break;
+                
+                // Extract number
+                size_t val_start = colon + 1;
+                while (val_start < personal_json.size() && 
+                       (personal_json[val_start] == ' ' || personal_json[val_start] == '\t')) {
+                    val_start++;
+                }
+                size_t val_end = val_start;
+                while (val_end < personal_json.size() && 
+                       (std::isdigit(personal_json[val_end]) || personal_json[val_end] == '.' || 
+                        personal_json[val_end] == '-' || personal_json[val_end] == '+')) {
+                    val_end++;
+                }
+                
+                if (val_end > val_start) {
+                    float standing = std::stof(personal_json.substr(val_start, val_end - val_start));
+                    standings->personal_standings[entity_id] = standing;
+                }
+                
+                pos = val_end + 1;
+            }
+        }
+        
+        // Deserialize corporation standings
+        std::string corp_json = extractObject(standings_json, "corporation");
+        if (!corp_json.empty()) {
+            size_t pos = 0;
+            while (pos < corp_json.size()) {
+                size_t key_start = corp_json.find("\"", pos);
+                if (key_start == std::string::npos) break;
+                key_start++;
+                size_t key_end = corp_json.find("\"", key_start);
+                if (key_end == std::string::npos) break;
+                
+                std::string corp_name = corp_json.substr(key_start, key_end - key_start);
+                size_t colon = corp_json.find(":", key_end);
+                if (colon == std::string::npos) break;
+                
+                size_t val_start = colon + 1;
+                while (val_start < corp_json.size() && 
+                       (corp_json[val_start] == ' ' || corp_json[val_start] == '\t')) {
+                    val_start++;
+                }
+                size_t val_end = val_start;
+                while (val_end < corp_json.size() && 
+                       (std::isdigit(corp_json[val_end]) || corp_json[val_end] == '.' || 
+                        corp_json[val_end] == '-' || corp_json[val_end] == '+')) {
+                    val_end++;
+                }
+                
+                if (val_end > val_start) {
+                    float standing = std::stof(corp_json.substr(val_start, val_end - val_start));
+                    standings->corporation_standings[corp_name] = standing;
+                }
+                
+                pos = val_end + 1;
+            }
+        }
+        
+        // Deserialize faction standings
+        std::string faction_json = extractObject(standings_json, "faction");
+        if (!faction_json.empty()) {
+            size_t pos = 0;
+            while (pos < faction_json.size()) {
+                size_t key_start = faction_json.find("\"", pos);
+                if (key_start == std::string::npos) break;
+                key_start++;
+                size_t key_end = faction_json.find("\"", key_start);
+                if (key_end == std::string::npos) break;
+                
+                std::string faction_name = faction_json.substr(key_start, key_end - key_start);
+                size_t colon = faction_json.find(":", key_end);
+                if (colon == std::string::npos) break;
+                
+                size_t val_start = colon + 1;
+                while (val_start < faction_json.size() && 
+                       (faction_json[val_start] == ' ' || faction_json[val_start] == '\t')) {
+                    val_start++;
+                }
+                size_t val_end = val_start;
+                while (val_end < faction_json.size() && 
+                       (std::isdigit(faction_json[val_end]) || faction_json[val_end] == '.' || 
+                        faction_json[val_end] == '-' || faction_json[val_end] == '+')) {
+                    val_end++;
+                }
+                
+                if (val_end > val_start) {
+                    float standing = std::stof(faction_json.substr(val_start, val_end - val_start));
+                    standings->faction_standings[faction_name] = standing;
+                }
+                
+                pos = val_end + 1;
+            }
+        }
+        
+        entity->addComponent(std::move(standings));
+    }
     // Inventory
     std::string inv_json = extractObject(json, "inventory");
     if (!inv_json.empty()) {
@@ -378,7 +581,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         }
         entity->addComponent(std::move(inv));
     }
-
     // LootTable
     std::string lt_json = extractObject(json, "loot_table");
     if (!lt_json.empty()) {
@@ -416,7 +618,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         }
         entity->addComponent(std::move(lt));
     }
-
     // Corporation
     std::string corp_json = extractObject(json, "corporation_data");
     if (!corp_json.empty()) {
@@ -488,7 +689,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
 
         entity->addComponent(std::move(corp));
     }
-
     // DroneBay
     std::string db_json = extractObject(json, "drone_bay");
     if (!db_json.empty()) {
@@ -549,7 +749,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
 
         entity->addComponent(std::move(db));
     }
-
     // ContractBoard
     std::string cb_json = extractObject(json, "contract_board");
     if (!cb_json.empty()) {
@@ -642,69 +841,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
 
         entity->addComponent(std::move(cb));
     }
-
-    // Station
-    std::string sta_json = extractObject(json, "station");
-    if (!sta_json.empty()) {
-        auto sta = std::make_unique<components::Station>();
-        sta->station_name      = extractString(sta_json, "station_name");
-        sta->docking_range     = extractFloat(sta_json, "docking_range", 2500.0f);
-        sta->repair_cost_per_hp = extractFloat(sta_json, "repair_cost_per_hp", 1.0f);
-        sta->docked_count      = extractInt(sta_json, "docked_count");
-        entity->addComponent(std::move(sta));
-    }
-
-    // Docked
-    std::string dck_json = extractObject(json, "docked");
-    if (!dck_json.empty()) {
-        auto dck = std::make_unique<components::Docked>();
-        dck->station_id = extractString(dck_json, "station_id");
-        entity->addComponent(std::move(dck));
-    }
-
-    // Wreck
-    std::string wrk_json = extractObject(json, "wreck");
-    if (!wrk_json.empty()) {
-        auto wrk = std::make_unique<components::Wreck>();
-        wrk->source_entity_id   = extractString(wrk_json, "source_entity_id");
-        wrk->lifetime_remaining = extractFloat(wrk_json, "lifetime_remaining", 1800.0f);
-        wrk->salvaged           = extractBool(wrk_json, "salvaged", false);
-        entity->addComponent(std::move(wrk));
-    }
-
-    // CaptainPersonality
-    std::string cp_json = extractObject(json, "captain_personality");
-    if (!cp_json.empty()) {
-        auto cp = std::make_unique<components::CaptainPersonality>();
-        cp->aggression       = extractFloat(cp_json, "aggression", 0.5f);
-        cp->sociability      = extractFloat(cp_json, "sociability", 0.5f);
-        cp->optimism         = extractFloat(cp_json, "optimism", 0.5f);
-        cp->professionalism  = extractFloat(cp_json, "professionalism", 0.5f);
-        cp->loyalty          = extractFloat(cp_json, "loyalty", 0.5f);
-        cp->paranoia         = extractFloat(cp_json, "paranoia", 0.5f);
-        cp->ambition         = extractFloat(cp_json, "ambition", 0.5f);
-        cp->adaptability     = extractFloat(cp_json, "adaptability", 0.5f);
-        cp->captain_name     = extractString(cp_json, "captain_name");
-        cp->faction          = extractString(cp_json, "faction");
-        entity->addComponent(std::move(cp));
-    }
-
-    // FleetMorale
-    std::string fmor_json = extractObject(json, "fleet_morale");
-    if (!fmor_json.empty()) {
-        auto fmor = std::make_unique<components::FleetMorale>();
-        fmor->morale_score          = extractFloat(fmor_json, "morale_score", 0.0f);
-        fmor->wins                  = extractInt(fmor_json, "wins");
-        fmor->losses                = extractInt(fmor_json, "losses");
-        fmor->ships_lost            = extractInt(fmor_json, "ships_lost");
-        fmor->times_saved_by_player = extractInt(fmor_json, "times_saved_by_player");
-        fmor->times_player_saved    = extractInt(fmor_json, "times_player_saved");
-        fmor->missions_together     = extractInt(fmor_json, "missions_together");
-        fmor->morale_state          = extractString(fmor_json, "morale_state");
-        if (fmor->morale_state.empty()) fmor->morale_state = "Steady";
-        entity->addComponent(std::move(fmor));
-    }
-
     // CaptainRelationship
     std::string cr_json = extractObject(json, "captain_relationship");
     if (!cr_json.empty()) {
@@ -746,18 +882,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         }
         entity->addComponent(std::move(cr));
     }
-
-    // EmotionalState
-    std::string es_json = extractObject(json, "emotional_state");
-    if (!es_json.empty()) {
-        auto es = std::make_unique<components::EmotionalState>();
-        es->confidence      = extractFloat(es_json, "confidence", 50.0f);
-        es->trust_in_player = extractFloat(es_json, "trust_in_player", 50.0f);
-        es->fatigue         = extractFloat(es_json, "fatigue", 0.0f);
-        es->hope            = extractFloat(es_json, "hope", 50.0f);
-        entity->addComponent(std::move(es));
-    }
-
     // CaptainMemory
     std::string cm_json = extractObject(json, "captain_memory");
     if (!cm_json.empty()) {
@@ -802,21 +926,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         }
         entity->addComponent(std::move(cm));
     }
-
-    // FleetFormation
-    std::string ff_json = extractObject(json, "fleet_formation");
-    if (!ff_json.empty()) {
-        auto ff = std::make_unique<components::FleetFormation>();
-        int ft = extractInt(ff_json, "formation");
-        ff->formation  = static_cast<components::FleetFormation::FormationType>(ft);
-        ff->slot_index = extractInt(ff_json, "slot_index");
-        ff->offset_x   = extractFloat(ff_json, "offset_x", 0.0f);
-        ff->offset_y   = extractFloat(ff_json, "offset_y", 0.0f);
-        ff->offset_z   = extractFloat(ff_json, "offset_z", 0.0f);
-        ff->spacing_modifier = extractFloat(ff_json, "spacing_modifier", 1.0f);
-        entity->addComponent(std::move(ff));
-    }
-
     // FleetCargoPool
     std::string fcp_json = extractObject(json, "fleet_cargo_pool");
     if (!fcp_json.empty()) {
@@ -866,7 +975,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
 
         entity->addComponent(std::move(fcp));
     }
-
     // RumorLog
     std::string rl_json = extractObject(json, "rumor_log");
     if (!rl_json.empty()) {
@@ -911,20 +1019,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         }
         entity->addComponent(std::move(rl));
     }
-
-    // MineralDeposit
-    std::string md_json = extractObject(json, "mineral_deposit");
-    if (!md_json.empty()) {
-        auto md = std::make_unique<components::MineralDeposit>();
-        md->mineral_type       = extractString(md_json, "mineral_type");
-        if (md->mineral_type.empty()) md->mineral_type = "Ferrite";
-        md->quantity_remaining = extractFloat(md_json, "quantity_remaining", 10000.0f);
-        md->max_quantity       = extractFloat(md_json, "max_quantity", 10000.0f);
-        md->yield_rate         = extractFloat(md_json, "yield_rate", 1.0f);
-        md->volume_per_unit    = extractFloat(md_json, "volume_per_unit", 0.1f);
-        entity->addComponent(std::move(md));
-    }
-
     // SystemResources
     std::string sr_json = extractObject(json, "system_resources");
     if (!sr_json.empty()) {
@@ -967,7 +1061,6 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
         }
         entity->addComponent(std::move(sr));
     }
-
     // MarketHub
     std::string mh_json = extractObject(json, "market_hub");
     if (!mh_json.empty()) {
@@ -1022,101 +1115,21 @@ bool WorldPersistence::deserializeEntity(ecs::World* world,
 
         entity->addComponent(std::move(mh));
     }
+}
 
-    // AnomalyVisualCue
-    std::string avc_json = extractObject(json, "anomaly_visual_cue");
-    if (!avc_json.empty()) {
-        auto avc = std::make_unique<components::AnomalyVisualCue>();
-        avc->anomaly_id = extractString(avc_json, "anomaly_id");
-        avc->cue_type = static_cast<components::AnomalyVisualCue::CueType>(
-            extractInt(avc_json, "cue_type", 5));
-        avc->intensity = extractFloat(avc_json, "intensity");
-        avc->radius = extractFloat(avc_json, "radius");
-        avc->pulse_frequency = extractFloat(avc_json, "pulse_frequency");
-        avc->r = extractFloat(avc_json, "r");
-        avc->g = extractFloat(avc_json, "g");
-        avc->b = extractFloat(avc_json, "b");
-        avc->distortion_strength = extractFloat(avc_json, "distortion_strength");
-        avc->active = extractBool(avc_json, "active", true);
-        entity->addComponent(std::move(avc));
-    }
-
-    // LODPriority
-    std::string lod_json = extractObject(json, "lod_priority");
-    if (!lod_json.empty()) {
-        auto lod = std::make_unique<components::LODPriority>();
-        lod->priority = extractFloat(lod_json, "priority");
-        lod->force_visible = extractBool(lod_json, "force_visible", false);
-        lod->impostor_distance = extractFloat(lod_json, "impostor_distance");
-        entity->addComponent(std::move(lod));
-    }
-
-    // WarpProfile
-    std::string wp_json = extractObject(json, "warp_profile");
-    if (!wp_json.empty()) {
-        auto wp = std::make_unique<components::WarpProfile>();
-        wp->warp_speed = extractFloat(wp_json, "warp_speed");
-        wp->mass_norm = extractFloat(wp_json, "mass_norm");
-        wp->intensity = extractFloat(wp_json, "intensity");
-        wp->comfort_scale = extractFloat(wp_json, "comfort_scale");
-        entity->addComponent(std::move(wp));
-    }
-
-    // WarpVisual
-    std::string wv_json = extractObject(json, "warp_visual");
-    if (!wv_json.empty()) {
-        auto wv = std::make_unique<components::WarpVisual>();
-        wv->distortion_strength = extractFloat(wv_json, "distortion_strength");
-        wv->tunnel_noise_scale = extractFloat(wv_json, "tunnel_noise_scale");
-        wv->vignette_amount = extractFloat(wv_json, "vignette_amount");
-        wv->bloom_strength = extractFloat(wv_json, "bloom_strength");
-        wv->starfield_speed = extractFloat(wv_json, "starfield_speed");
-        entity->addComponent(std::move(wv));
-    }
-
-    // WarpEvent
-    std::string we_json = extractObject(json, "warp_event");
-    if (!we_json.empty()) {
-        auto we = std::make_unique<components::WarpEvent>();
-        we->current_event = extractString(we_json, "current_event");
-        we->event_timer = extractFloat(we_json, "event_timer");
-        we->severity = extractInt(we_json, "severity", 0);
-        entity->addComponent(std::move(we));
-    }
-
-    // TacticalProjection
-    std::string tp_json = extractObject(json, "tactical_projection");
-    if (!tp_json.empty()) {
-        auto tp = std::make_unique<components::TacticalProjection>();
-        tp->projected_x = extractFloat(tp_json, "projected_x");
-        tp->projected_y = extractFloat(tp_json, "projected_y");
-        tp->vertical_offset = extractFloat(tp_json, "vertical_offset");
-        tp->visible = extractBool(tp_json, "visible", true);
-        entity->addComponent(std::move(tp));
-    }
-
-    // PlayerPresence
-    std::string pp_json = extractObject(json, "player_presence");
-    if (!pp_json.empty()) {
-        auto pp = std::make_unique<components::PlayerPresence>();
-        pp->time_since_last_command = extractFloat(pp_json, "time_since_last_command");
-        pp->time_since_last_speech = extractFloat(pp_json, "time_since_last_speech");
-        entity->addComponent(std::move(pp));
-    }
-
-    // FactionCulture
-    std::string fc_json = extractObject(json, "faction_culture");
-    if (!fc_json.empty()) {
-        auto fc = std::make_unique<components::FactionCulture>();
-        fc->faction = extractString(fc_json, "faction");
-        fc->chatter_frequency_mod = extractFloat(fc_json, "chatter_frequency_mod");
-        fc->formation_tightness_mod = extractFloat(fc_json, "formation_tightness_mod");
-        fc->morale_sensitivity = extractFloat(fc_json, "morale_sensitivity");
-        fc->risk_tolerance = extractFloat(fc_json, "risk_tolerance");
-        entity->addComponent(std::move(fc));
-    }
-
-    return true;
+void WorldPersistence::removeNestedComponents(ecs::Entity* entity) const {
+    entity->removeComponent<components::Standings>();
+    entity->removeComponent<components::Inventory>();
+    entity->removeComponent<components::LootTable>();
+    entity->removeComponent<components::Corporation>();
+    entity->removeComponent<components::DroneBay>();
+    entity->removeComponent<components::ContractBoard>();
+    entity->removeComponent<components::CaptainRelationship>();
+    entity->removeComponent<components::CaptainMemory>();
+    entity->removeComponent<components::FleetCargoPool>();
+    entity->removeComponent<components::RumorLog>();
+    entity->removeComponent<components::SystemResources>();
+    entity->removeComponent<components::MarketHub>();
 }
 
 } // namespace data
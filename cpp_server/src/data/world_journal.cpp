@@ -0,0 +1,315 @@
+#include "data/world_journal.h"
+#include "utils/logger.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <zlib.h>
+
+namespace atlas {
+namespace data {
+
+// ---------------------------------------------------------------------------
+// Record framing (native little-endian, like the binary save)
+//
+//   u32 magic "NFJR" | u32 image_size | u64 sequence | image | u32 crc
+//
+// The CRC covers the sequence and the image.  A record with a bad magic,
+// size, CRC or a sequence that does not increase ends the replay.
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr uint32_t kRecordMagic = 0x524A464E;   // "NFJR"
+constexpr size_t kRecordOverhead = 4 + 4 + 8 + 4;
+
+uint32_t recordCrc(uint64_t sequence, const void* image, size_t size) {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(&sequence), sizeof(sequence));
+    crc = crc32(crc, static_cast<const Bytef*>(image), static_cast<uInt>(size));
+    return static_cast<uint32_t>(crc);
+}
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+int applyRecords(const WorldPersistence& persistence, ecs::World* world,
+                 const std::string& bytes, size_t& valid, uint64_t& last_sequence) {
+    int applied = 0;
+    size_t pos = 0;
+    valid = 0;
+    while (bytes.size() - pos >= kRecordOverhead) {
+        uint32_t magic, size;
+        uint64_t sequence;
+        std::memcpy(&magic, bytes.data() + pos, 4);
+        std::memcpy(&size, bytes.data() + pos + 4, 4);
+        std::memcpy(&sequence, bytes.data() + pos + 8, 8);
+        if (magic != kRecordMagic || size > bytes.size() - pos - kRecordOverhead) break;
+        if (applied > 0 && sequence <= last_sequence) break;
+
+        const char* image = bytes.data() + pos + 16;
+        uint32_t crc;
+        std::memcpy(&crc, image + size, 4);
+        if (crc != recordCrc(sequence, image, size)) break;
+        if (!persistence.applyDeltaBinary(world, image, size)) break;
+
+        last_sequence = sequence;
+        ++applied;
+        pos += kRecordOverhead + size;
+        valid = pos;
+    }
+    return applied;
+}
+
+} // namespace
+
+WorldJournal::~WorldJournal() {
+    close();
+}
+
+bool WorldJournal::open(ecs::World* world, const std::string& path) {
+    close();
+    auto& log = atlas::utils::Logger::instance();
+    std::string prev_path = path + ".prev";
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    path_ = path;
+    sequence_ = 0;
+    has_prev_ = false;
+    prev_last_sequence_ = 0;
+    current_bytes_ = 0;
+    prev_bytes_ = 0;
+
+    std::string bytes;
+    size_t valid = 0;
+    int replayed = 0;
+    if (readFile(prev_path, bytes)) {
+        replayed += applyRecords(persistence_, world, bytes, valid, sequence_);
+        if (valid < bytes.size()) {
+            log.warn("[WorldJournal] " + prev_path + " is damaged after " +
+                     std::to_string(valid) + " bytes; later records were skipped");
+        }
+        has_prev_ = true;
+        prev_last_sequence_ = sequence_;
+        prev_bytes_ = bytes.size();
+    }
+    if (readFile(path, bytes)) {
+        replayed += applyRecords(persistence_, world, bytes, valid, sequence_);
+        if (valid < bytes.size()) {
+            // Torn tail from a crash mid-write: drop it so appends stay readable
+            log.warn("[WorldJournal] Dropping " + std::to_string(bytes.size() - valid) +
+                     " damaged bytes at the end of " + path);
+            bytes.resize(valid);
+            WorldPersistence::writeSaveFile(bytes, path, false);
+        }
+        current_bytes_ = valid;
+    }
+    if (replayed > 0) {
+        log.info("[WorldJournal] Replayed " + std::to_string(replayed) +
+                 " journal records (last sequence " + std::to_string(sequence_) + ")");
+    }
+
+    if (!openForAppend()) return false;
+
+    // The recovered world is the baseline for the first flush
+    shadow_.clear();
+    WorldPersistence::BinaryDelta baseline;
+    size_t rows = 0;
+    collectChanges(world, baseline, rows);
+    commitChanges(baseline);
+    return true;
+}
+
+bool WorldJournal::openForAppend() {
+    file_ = std::fopen(path_.c_str(), "ab");
+    if (!file_) {
+        atlas::utils::Logger::instance().error("[WorldJournal] Cannot open " + path_ + " for appending");
+        return false;
+    }
+    return true;
+}
+
+void WorldJournal::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool WorldJournal::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_ != nullptr;
+}
+
+void WorldJournal::collectChanges(const ecs::World* world,
+                                  WorldPersistence::BinaryDelta& delta,
+                                  size_t& rows) {
+    ++stamp_;
+    pending_.clear();
+    for (ecs::Entity* entity : const_cast<ecs::World*>(world)->getAllEntities()) {
+        persistence_.hashBinaryRows(entity, scratch_);
+
+        auto it = shadow_.find(entity->getId());
+        std::vector<uint32_t> changed;
+        if (it == shadow_.end()) {
+            // New entity: listed even without rows so replay creates it
+            for (const auto& row : scratch_) changed.push_back(row.first);
+        } else {
+            it->second.stamp = stamp_;
+            // Both lists are in kind order
+            const auto& old_rows = it->second.rows;
+            size_t a = 0, b = 0;
+            while (a < old_rows.size() || b < scratch_.size()) {
+                if (b == scratch_.size() ||
+                    (a < old_rows.size() && old_rows[a].first < scratch_[b].first)) {
+                    delta.removed.emplace_back(entity->getId(), old_rows[a].first);
+                    ++a;
+                } else if (a == old_rows.size() || scratch_[b].first < old_rows[a].first) {
+                    changed.push_back(scratch_[b].first);
+                    ++b;
+                } else {
+                    if (old_rows[a].second != scratch_[b].second) changed.push_back(scratch_[b].first);
+                    ++a;
+                    ++b;
+                }
+            }
+            if (changed.empty()) continue;
+        }
+        pending_.push_back(std::move(scratch_));
+        rows += changed.size();
+        delta.entities.push_back(entity);
+        delta.kinds.push_back(std::move(changed));
+    }
+
+    for (const auto& entry : shadow_) {
+        if (entry.second.stamp != stamp_) delta.destroyed.push_back(entry.first);
+    }
+}
+
+void WorldJournal::commitChanges(const WorldPersistence::BinaryDelta& delta) {
+    for (size_t i = 0; i < delta.entities.size(); ++i) {
+        Shadow& shadow = shadow_[delta.entities[i]->getId()];
+        shadow.rows = std::move(pending_[i]);
+        shadow.stamp = stamp_;
+    }
+    for (const auto& id : delta.destroyed) shadow_.erase(id);
+    pending_.clear();
+}
+
+bool WorldJournal::flush(const ecs::World* world) {
+    if (!isOpen()) return false;
+    auto start = std::chrono::steady_clock::now();
+
+    WorldPersistence::BinaryDelta delta;
+    FlushStats stats;
+    collectChanges(world, delta, stats.rows);
+    stats.entities = delta.entities.size();
+    stats.destroyed = delta.destroyed.size();
+    stats.removed = delta.removed.size();
+
+    bool ok = true;
+    if (!delta.entities.empty() || !delta.destroyed.empty() || !delta.removed.empty()) {
+        std::string image = persistence_.serializeDeltaBinary(delta);
+        ok = appendRecord(image);
+        if (ok) {
+            stats.bytes = image.size() + kRecordOverhead;
+            ++records_;
+        }
+    }
+    // After a failed write the baseline stays put, so the next flush
+    // writes these changes again
+    if (ok) commitChanges(delta);
+
+    stats.duration_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    last_flush_ = stats;
+    return ok;
+}
+
+bool WorldJournal::appendRecord(const std::string& image) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) return false;
+
+    uint64_t sequence = sequence_ + 1;
+    uint32_t size = static_cast<uint32_t>(image.size());
+    uint32_t crc = recordCrc(sequence, image.data(), image.size());
+
+    std::string record;
+    record.reserve(image.size() + kRecordOverhead);
+    record.append(reinterpret_cast<const char*>(&kRecordMagic), 4);
+    record.append(reinterpret_cast<const char*>(&size), 4);
+    record.append(reinterpret_cast<const char*>(&sequence), 8);
+    record.append(image);
+    record.append(reinterpret_cast<const char*>(&crc), 4);
+
+    if (std::fwrite(record.data(), 1, record.size(), file_) != record.size() ||
+        std::fflush(file_) != 0) {
+        atlas::utils::Logger::instance().error("[WorldJournal] Write to " + path_ + " failed");
+        return false;
+    }
+    sequence_ = sequence;
+    current_bytes_ += record.size();
+    return true;
+}
+
+uint64_t WorldJournal::beginSnapshot(const ecs::World* world) {
+    flush(world);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // If an earlier snapshot never committed, .prev is still needed: keep
+    // appending to the current file until a snapshot does
+    if (file_ && !has_prev_) {
+        std::fclose(file_);
+        file_ = nullptr;
+        std::string prev_path = path_ + ".prev";
+        if (std::rename(path_.c_str(), prev_path.c_str()) == 0) {
+            has_prev_ = true;
+            prev_last_sequence_ = sequence_;
+            prev_bytes_ = current_bytes_;
+            current_bytes_ = 0;
+        } else {
+            atlas::utils::Logger::instance().warn("[WorldJournal] Could not rotate " + path_);
+        }
+        openForAppend();
+    }
+    return sequence_;
+}
+
+void WorldJournal::commitSnapshot(uint64_t mark) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!has_prev_ || prev_last_sequence_ > mark) return;
+
+    std::string prev_path = path_ + ".prev";
+    std::remove(prev_path.c_str());
+    has_prev_ = false;
+    prev_bytes_ = 0;
+}
+
+int WorldJournal::replay(ecs::World* world, const std::string& path,
+                         size_t* valid_bytes, uint64_t* last_sequence) {
+    std::string bytes;
+    if (!readFile(path, bytes)) return -1;
+
+    WorldPersistence persistence;
+    size_t valid = 0;
+    uint64_t last = 0;
+    int applied = applyRecords(persistence, world, bytes, valid, last);
+    if (valid_bytes) *valid_bytes = valid;
+    if (last_sequence) *last_sequence = last;
+    return applied;
+}
+
+uint64_t WorldJournal::getJournalBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_bytes_ + prev_bytes_;
+}
+
+} // namespace data
+} // namespace atlas
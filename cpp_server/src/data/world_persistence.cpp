@@ -1,4 +1,5 @@
 #include "data/world_persistence.h"
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include "utils/logger.h"
@@ -12,18 +13,45 @@ namespace data {
 
 bool WorldPersistence::saveWorld(const ecs::World* world,
                                  const std::string& filepath) {
-    std::string json = serializeWorld(world);
+    if (!writeSaveFile(serializeWorld(world), filepath, false)) return false;
 
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
-        atlas::utils::Logger::instance().error("[WorldPersistence] Cannot open file for writing: " + filepath);
-        return false;
-    }
+    atlas::utils::Logger::instance().info("[WorldPersistence] World saved to " + filepath);
+    return true;
+}
 
-    file << json;
-    file.close();
+bool WorldPersistence::writeSaveFile(const std::string& data,
+                                     const std::string& filepath,
+                                     bool compressed) {
+    std::string tmp = filepath + ".tmp";
+    if (compressed) {
+        if (!writeCompressed(data, tmp)) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+    } else {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            atlas::utils::Logger::instance().error("[WorldPersistence] Cannot open file for writing: " + tmp);
+            return false;
+        }
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        file.close();
+        if (!file) {
+            atlas::utils::Logger::instance().error("[WorldPersistence] Write failed: " + tmp);
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
 
-    atlas::utils::Logger::instance().info("[WorldPersistence] World saved to " + filepath);
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    std::remove(filepath.c_str());
+#endif
+    if (std::rename(tmp.c_str(), filepath.c_str()) != 0) {
+        atlas::utils::Logger::instance().error("[WorldPersistence] Cannot replace " + filepath);
+        std::remove(tmp.c_str());
+        return false;
+    }
     return true;
 }
 
@@ -42,5 +70,43 @@ bool WorldPersistence::loadWorld(ecs::World* world,
     return deserializeWorld(world, ss.str());
 }
 
+bool WorldPersistence::saveWorldAs(const ecs::World* world,
+                                   const std::string& filepath,
+                                   SaveFormat format) {
+    switch (format) {
+        case SaveFormat::Binary:         return saveWorldBinary(world, filepath);
+        case SaveFormat::CompressedJson: return saveWorldCompressed(world, filepath);
+        case SaveFormat::Json:           break;
+    }
+    return saveWorld(world, filepath);
+}
+
+std::string WorldPersistence::serializeAs(const ecs::World* world,
+                                          SaveFormat format) const {
+    return format == SaveFormat::Binary ? serializeWorldBinary(world)
+                                        : serializeWorld(world);
+}
+
+bool WorldPersistence::loadWorldFile(ecs::World* world,
+                                     const std::string& filepath) {
+    unsigned char magic[2] = {0, 0};
+    {
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file.is_open()) {
+            atlas::utils::Logger::instance().error("[WorldPersistence] Cannot open file for reading: " + filepath);
+            return false;
+        }
+        file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    }
+
+    if (magic[0] == 0x1f && magic[1] == 0x8b) {   // gzip
+        return loadWorldCompressed(world, filepath);
+    }
+    if (magic[0] == 'N' && magic[1] == 'F') {     // binary save magic
+        return loadWorldBinary(world, filepath);
+    }
+    return loadWorld(world, filepath);
+}
+
 } // namespace data
 } // namespace atlas
@@ -15,21 +15,27 @@ bool WorldPersistence::saveWorldCompressed(const ecs::World* world,
         return false;
     }
 
+    if (!writeSaveFile(json, filepath, true)) return false;
+
+    atlas::utils::Logger::instance().info("[WorldPersistence] World saved (compressed) to " + filepath + " (" + std::to_string(json.size()) + " bytes source, compressed on disk)");
+    return true;
+}
+
+bool WorldPersistence::writeCompressed(const std::string& json,
+                                       const std::string& filepath) {
     gzFile gz = gzopen(filepath.c_str(), "wb9");  // max compression
     if (!gz) {
         atlas::utils::Logger::instance().error("[WorldPersistence] Cannot open compressed file for writing: " + filepath);
         return false;
     }
 
-    int written = gzwrite(gz, json.data(), static_cast<unsigned>(json.size()));
-    gzclose(gz);
+    int written = json.empty() ? 0 : gzwrite(gz, json.data(), static_cast<unsigned>(json.size()));
+    int closed = gzclose(gz);
 
-    if (written <= 0) {
+    if (written <= 0 || closed != Z_OK) {
         atlas::utils::Logger::instance().error("[WorldPersistence] Compressed write failed");
         return false;
     }
-
-    atlas::utils::Logger::instance().info("[WorldPersistence] World saved (compressed) to " + filepath + " (" + std::to_string(written) + " bytes source, compressed on disk)");
     return true;
 }
 
@@ -141,54 +141,6 @@ std::string WorldPersistence::serializeEntity(
              << "}";
     }
 
-    // Standings
-    auto* standings = entity->getComponent<components::Standings>();
-    if (standings) {
-        json << ",\"standings\":{";
-        
-        // Serialize personal standings
-        if (!standings->personal_standings.empty()) {
-            json << "\"personal\":{";
-            bool first = true;
-            for (const auto& [entity_id, standing] : standings->personal_standings) {
-                if (!first) json << ",";
-                json << "\"" << escapeJson(entity_id) << "\":" << standing;
-                first = false;
-            }
-            json << "}";
-        }
-        
-        // Serialize corporation standings
-        if (!standings->corporation_standings.empty()) {
-            if (!standings->personal_standings.empty()) json << ",";
-            json << "\"corporation\":{";
-            bool first = true;
-            for (const auto& [corp_name, standing] : standings->corporation_standings) {
-                if (!first) json << ",";
-                json << "\"" << escapeJson(corp_name) << "\":" << standing;
-                first = false;
-            }
-            json << "}";
-        }
-        
-        // Serialize faction standings
-        if (!standings->faction_standings.empty()) {
-            if (!standings->personal_standings.empty() || !standings->corporation_standings.empty()) {
-                json << ",";
-            }
-            json << "\"faction\":{";
-            bool first = true;
-            for (const auto& [faction_name, standing] : standings->faction_standings) {
-                if (!first) json << ",";
-                json << "\"" << escapeJson(faction_name) << "\":" << standing;
-                first = false;
-            }
-            json << "}";
-        }
-        
-        json << "}";
-    }
-
     // AI
     auto* ai = entity->getComponent<components::AI>();
     if (ai) {
@@ -268,6 +220,246 @@ std::string WorldPersistence::serializeEntity(
              << "}";
     }
 
+    // Station
+    auto* sta = entity->getComponent<components::Station>();
+    if (sta) {
+        json << ",\"station\":{"
+             << "\"station_name\":\"" << escapeJson(sta->station_name) << "\""
+             << ",\"docking_range\":" << sta->docking_range
+             << ",\"repair_cost_per_hp\":" << sta->repair_cost_per_hp
+             << ",\"docked_count\":" << sta->docked_count
+             << "}";
+    }
+
+    // Docked
+    auto* dck = entity->getComponent<components::Docked>();
+    if (dck) {
+        json << ",\"docked\":{"
+             << "\"station_id\":\"" << escapeJson(dck->station_id) << "\""
+             << "}";
+    }
+
+    // Wreck
+    auto* wrk = entity->getComponent<components::Wreck>();
+    if (wrk) {
+        json << ",\"wreck\":{"
+             << "\"source_entity_id\":\"" << escapeJson(wrk->source_entity_id) << "\""
+             << ",\"lifetime_remaining\":" << wrk->lifetime_remaining
+             << ",\"salvaged\":" << (wrk->salvaged ? "true" : "false")
+             << "}";
+    }
+
+    // CaptainPersonality
+    auto* cp = entity->getComponent<components::CaptainPersonality>();
+    if (cp) {
+        json << ",\"captain_personality\":{"
+             << "\"aggression\":" << cp->aggression
+             << ",\"sociability\":" << cp->sociability
+             << ",\"optimism\":" << cp->optimism
+             << ",\"professionalism\":" << cp->professionalism
+             << ",\"loyalty\":" << cp->loyalty
+             << ",\"paranoia\":" << cp->paranoia
+             << ",\"ambition\":" << cp->ambition
+             << ",\"adaptability\":" << cp->adaptability
+             << ",\"captain_name\":\"" << escapeJson(cp->captain_name) << "\""
+             << ",\"faction\":\"" << escapeJson(cp->faction) << "\""
+             << "}";
+    }
+
+    // FleetMorale
+    auto* fmor = entity->getComponent<components::FleetMorale>();
+    if (fmor) {
+        json << ",\"fleet_morale\":{"
+             << "\"morale_score\":" << fmor->morale_score
+             << ",\"wins\":" << fmor->wins
+             << ",\"losses\":" << fmor->losses
+             << ",\"ships_lost\":" << fmor->ships_lost
+             << ",\"times_saved_by_player\":" << fmor->times_saved_by_player
+             << ",\"times_player_saved\":" << fmor->times_player_saved
+             << ",\"missions_together\":" << fmor->missions_together
+             << ",\"morale_state\":\"" << escapeJson(fmor->morale_state) << "\""
+             << "}";
+    }
+
+    // EmotionalState
+    auto* es = entity->getComponent<components::EmotionalState>();
+    if (es) {
+        json << ",\"emotional_state\":{"
+             << "\"confidence\":" << es->confidence
+             << ",\"trust_in_player\":" << es->trust_in_player
+             << ",\"fatigue\":" << es->fatigue
+             << ",\"hope\":" << es->hope
+             << "}";
+    }
+
+    // FleetFormation
+    auto* ff = entity->getComponent<components::FleetFormation>();
+    if (ff) {
+        json << ",\"fleet_formation\":{"
+             << "\"formation\":" << static_cast<int>(ff->formation)
+             << ",\"slot_index\":" << ff->slot_index
+             << ",\"offset_x\":" << ff->offset_x
+             << ",\"offset_y\":" << ff->offset_y
+             << ",\"offset_z\":" << ff->offset_z
+             << ",\"spacing_modifier\":" << ff->spacing_modifier
+             << "}";
+    }
+
+    // MineralDeposit
+    auto* md = entity->getComponent<components::MineralDeposit>();
+    if (md) {
+        json << ",\"mineral_deposit\":{"
+             << "\"mineral_type\":\"" << escapeJson(md->mineral_type) << "\""
+             << ",\"quantity_remaining\":" << md->quantity_remaining
+             << ",\"max_quantity\":" << md->max_quantity
+             << ",\"yield_rate\":" << md->yield_rate
+             << ",\"volume_per_unit\":" << md->volume_per_unit
+             << "}";
+    }
+
+    // AnomalyVisualCue
+    auto* avc = entity->getComponent<components::AnomalyVisualCue>();
+    if (avc) {
+        json << ",\"anomaly_visual_cue\":{"
+             << "\"anomaly_id\":\"" << escapeJson(avc->anomaly_id) << "\""
+             << ",\"cue_type\":" << static_cast<int>(avc->cue_type)
+             << ",\"intensity\":" << avc->intensity
+             << ",\"radius\":" << avc->radius
+             << ",\"pulse_frequency\":" << avc->pulse_frequency
+             << ",\"r\":" << avc->r
+             << ",\"g\":" << avc->g
+             << ",\"b\":" << avc->b
+             << ",\"distortion_strength\":" << avc->distortion_strength
+             << ",\"active\":" << (avc->active ? "true" : "false") << "}";
+    }
+
+    // LODPriority
+    auto* lod = entity->getComponent<components::LODPriority>();
+    if (lod) {
+        json << ",\"lod_priority\":{"
+             << "\"priority\":" << lod->priority
+             << ",\"force_visible\":" << (lod->force_visible ? "true" : "false")
+             << ",\"impostor_distance\":" << lod->impostor_distance << "}";
+    }
+
+    // WarpProfile
+    auto* wp = entity->getComponent<components::WarpProfile>();
+    if (wp) {
+        json << ",\"warp_profile\":{"
+             << "\"warp_speed\":" << wp->warp_speed
+             << ",\"mass_norm\":" << wp->mass_norm
+             << ",\"intensity\":" << wp->intensity
+             << ",\"comfort_scale\":" << wp->comfort_scale << "}";
+    }
+
+    // WarpVisual
+    auto* wv = entity->getComponent<components::WarpVisual>();
+    if (wv) {
+        json << ",\"warp_visual\":{"
+             << "\"distortion_strength\":" << wv->distortion_strength
+             << ",\"tunnel_noise_scale\":" << wv->tunnel_noise_scale
+             << ",\"vignette_amount\":" << wv->vignette_amount
+             << ",\"bloom_strength\":" << wv->bloom_strength
+             << ",\"starfield_speed\":" << wv->starfield_speed << "}";
+    }
+
+    // WarpEvent
+    auto* we = entity->getComponent<components::WarpEvent>();
+    if (we) {
+        json << ",\"warp_event\":{"
+             << "\"current_event\":\"" << we->current_event << "\""
+             << ",\"event_timer\":" << we->event_timer
+             << ",\"severity\":" << we->severity << "}";
+    }
+
+    // TacticalProjection
+    auto* tp = entity->getComponent<components::TacticalProjection>();
+    if (tp) {
+        json << ",\"tactical_projection\":{"
+             << "\"projected_x\":" << tp->projected_x
+             << ",\"projected_y\":" << tp->projected_y
+             << ",\"vertical_offset\":" << tp->vertical_offset
+             << ",\"visible\":" << (tp->visible ? "true" : "false") << "}";
+    }
+
+    // PlayerPresence
+    auto* pp = entity->getComponent<components::PlayerPresence>();
+    if (pp) {
+        json << ",\"player_presence\":{"
+             << "\"time_since_last_command\":" << pp->time_since_last_command
+             << ",\"time_since_last_speech\":" << pp->time_since_last_speech << "}";
+    }
+
+    // FactionCulture
+    auto* fc = entity->getComponent<components::FactionCulture>();
+    if (fc) {
+        json << ",\"faction_culture\":{"
+             << "\"faction\":\"" << fc->faction << "\""
+             << ",\"chatter_frequency_mod\":" << fc->chatter_frequency_mod
+             << ",\"formation_tightness_mod\":" << fc->formation_tightness_mod
+             << ",\"morale_sensitivity\":" << fc->morale_sensitivity
+             << ",\"risk_tolerance\":" << fc->risk_tolerance << "}";
+    }
+
+    serializeNestedComponents(entity, json);
+
+    json << "}";
+    return json.str();
+}
+
+// ---------------------------------------------------------------------------
+// Components with nested containers (kept as JSON in binary saves too)
+// ---------------------------------------------------------------------------
+
+void WorldPersistence::serializeNestedComponents(const ecs::Entity* entity,
+                                                 std::ostringstream& json) const {
+    // Standings
+    auto* standings = entity->getComponent<components::Standings>();
+    if (standings) {
+        json << ",\"standings\":{";
+        
+        // Serialize personal standings
+        if (!standings->personal_standings.empty()) {
+            json << "\"personal\":{";
+            bool first = true;
+            for (const auto& [entity_id, standing] : standings->personal_standings) {
+                if (!first) json << ",";
+                json << "\"" << escapeJson(entity_id) << "\":" << standing;
+                first = false;
+            }
+            json << "}";
+        }
+        
+        // Serialize corporation standings
+        if (!standings->corporation_standings.empty()) {
+            if (!standings->personal_standings.empty()) json << ",";
+            json << "\"corporation\":{";
+            bool first = true;
+            for (const auto& [corp_name, standing] : standings->corporation_standings) {
+                if (!first) json << ",";
+                json << "\"" << escapeJson(corp_name) << "\":" << standing;
+                first = false;
+            }
+            json << "}";
+        }
+        
+        // Serialize faction standings
+        if (!standings->faction_standings.empty()) {
+            if (!standings->personal_standings.empty() || !standings->corporation_standings.empty()) {
+                json << ",";
+            }
+            json << "\"faction\":{";
+            bool first = true;
+            for (const auto& [faction_name, standing] : standings->faction_standings) {
+                if (!first) json << ",";
+                json << "\"" << escapeJson(faction_name) << "\":" << standing;
+                first = false;
+            }
+            json << "}";
+        }
+        
+        json << "}";
+    }
     // Inventory
     auto* inv = entity->getComponent<components::Inventory>();
     if (inv) {
@@ -286,7 +478,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
     // LootTable
     auto* lt = entity->getComponent<components::LootTable>();
     if (lt) {
@@ -307,7 +498,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
     // Corporation
     auto* corp = entity->getComponent<components::Corporation>();
     if (corp) {
@@ -338,7 +528,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
     // DroneBay
     auto* db = entity->getComponent<components::DroneBay>();
     if (db) {
@@ -381,7 +570,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
     // ContractBoard
     auto* cb = entity->getComponent<components::ContractBoard>();
     if (cb) {
@@ -423,68 +611,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
-    // Station
-    auto* sta = entity->getComponent<components::Station>();
-    if (sta) {
-        json << ",\"station\":{"
-             << "\"station_name\":\"" << escapeJson(sta->station_name) << "\""
-             << ",\"docking_range\":" << sta->docking_range
-             << ",\"repair_cost_per_hp\":" << sta->repair_cost_per_hp
-             << ",\"docked_count\":" << sta->docked_count
-             << "}";
-    }
-
-    // Docked
-    auto* dck = entity->getComponent<components::Docked>();
-    if (dck) {
-        json << ",\"docked\":{"
-             << "\"station_id\":\"" << escapeJson(dck->station_id) << "\""
-             << "}";
-    }
-
-    // Wreck
-    auto* wrk = entity->getComponent<components::Wreck>();
-    if (wrk) {
-        json << ",\"wreck\":{"
-             << "\"source_entity_id\":\"" << escapeJson(wrk->source_entity_id) << "\""
-             << ",\"lifetime_remaining\":" << wrk->lifetime_remaining
-             << ",\"salvaged\":" << (wrk->salvaged ? "true" : "false")
-             << "}";
-    }
-
-    // CaptainPersonality
-    auto* cp = entity->getComponent<components::CaptainPersonality>();
-    if (cp) {
-        json << ",\"captain_personality\":{"
-             << "\"aggression\":" << cp->aggression
-             << ",\"sociability\":" << cp->sociability
-             << ",\"optimism\":" << cp->optimism
-             << ",\"professionalism\":" << cp->professionalism
-             << ",\"loyalty\":" << cp->loyalty
-             << ",\"paranoia\":" << cp->paranoia
-             << ",\"ambition\":" << cp->ambition
-             << ",\"adaptability\":" << cp->adaptability
-             << ",\"captain_name\":\"" << escapeJson(cp->captain_name) << "\""
-             << ",\"faction\":\"" << escapeJson(cp->faction) << "\""
-             << "}";
-    }
-
-    // FleetMorale
-    auto* fmor = entity->getComponent<components::FleetMorale>();
-    if (fmor) {
-        json << ",\"fleet_morale\":{"
-             << "\"morale_score\":" << fmor->morale_score
-             << ",\"wins\":" << fmor->wins
-             << ",\"losses\":" << fmor->losses
-             << ",\"ships_lost\":" << fmor->ships_lost
-             << ",\"times_saved_by_player\":" << fmor->times_saved_by_player
-             << ",\"times_player_saved\":" << fmor->times_player_saved
-             << ",\"missions_together\":" << fmor->missions_together
-             << ",\"morale_state\":\"" << escapeJson(fmor->morale_state) << "\""
-             << "}";
-    }
-
     // CaptainRelationship
     auto* cr = entity->getComponent<components::CaptainRelationship>();
     if (cr) {
@@ -498,18 +624,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
-    // EmotionalState
-    auto* es = entity->getComponent<components::EmotionalState>();
-    if (es) {
-        json << ",\"emotional_state\":{"
-             << "\"confidence\":" << es->confidence
-             << ",\"trust_in_player\":" << es->trust_in_player
-             << ",\"fatigue\":" << es->fatigue
-             << ",\"hope\":" << es->hope
-             << "}";
-    }
-
     // CaptainMemory
     auto* cm = entity->getComponent<components::CaptainMemory>();
     if (cm) {
@@ -526,20 +640,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
-    // FleetFormation
-    auto* ff = entity->getComponent<components::FleetFormation>();
-    if (ff) {
-        json << ",\"fleet_formation\":{"
-             << "\"formation\":" << static_cast<int>(ff->formation)
-             << ",\"slot_index\":" << ff->slot_index
-             << ",\"offset_x\":" << ff->offset_x
-             << ",\"offset_y\":" << ff->offset_y
-             << ",\"offset_z\":" << ff->offset_z
-             << ",\"spacing_modifier\":" << ff->spacing_modifier
-             << "}";
-    }
-
     // FleetCargoPool
     auto* fcp = entity->getComponent<components::FleetCargoPool>();
     if (fcp) {
@@ -562,7 +662,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
     // RumorLog
     auto* rl = entity->getComponent<components::RumorLog>();
     if (rl) {
@@ -579,19 +678,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
-    // MineralDeposit
-    auto* md = entity->getComponent<components::MineralDeposit>();
-    if (md) {
-        json << ",\"mineral_deposit\":{"
-             << "\"mineral_type\":\"" << escapeJson(md->mineral_type) << "\""
-             << ",\"quantity_remaining\":" << md->quantity_remaining
-             << ",\"max_quantity\":" << md->max_quantity
-             << ",\"yield_rate\":" << md->yield_rate
-             << ",\"volume_per_unit\":" << md->volume_per_unit
-             << "}";
-    }
-
     // SystemResources
     auto* sr = entity->getComponent<components::SystemResources>();
     if (sr) {
@@ -606,7 +692,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
     // MarketHub
     auto* mh = entity->getComponent<components::MarketHub>();
     if (mh) {
@@ -632,93 +717,6 @@ std::string WorldPersistence::serializeEntity(
         }
         json << "]}";
     }
-
-    // AnomalyVisualCue
-    auto* avc = entity->getComponent<components::AnomalyVisualCue>();
-    if (avc) {
-        json << ",\"anomaly_visual_cue\":{"
-             << "\"anomaly_id\":\"" << escapeJson(avc->anomaly_id) << "\""
-             << ",\"cue_type\":" << static_cast<int>(avc->cue_type)
-             << ",\"intensity\":" << avc->intensity
-             << ",\"radius\":" << avc->radius
-             << ",\"pulse_frequency\":" << avc->pulse_frequency
-             << ",\"r\":" << avc->r
-             << ",\"g\":" << avc->g
-             << ",\"b\":" << avc->b
-             << ",\"distortion_strength\":" << avc->distortion_strength
-             << ",\"active\":" << (avc->active ? "true" : "false") << "}";
-    }
-
-    // LODPriority
-    auto* lod = entity->getComponent<components::LODPriority>();
-    if (lod) {
-        json << ",\"lod_priority\":{"
-             << "\"priority\":" << lod->priority
-             << ",\"force_visible\":" << (lod->force_visible ? "true" : "false")
-             << ",\"impostor_distance\":" << lod->impostor_distance << "}";
-    }
-
-    // WarpProfile
-    auto* wp = entity->getComponent<components::WarpProfile>();
-    if (wp) {
-        json << ",\"warp_profile\":{"
-             << "\"warp_speed\":" << wp->warp_speed
-             << ",\"mass_norm\":" << wp->mass_norm
-             << ",\"intensity\":" << wp->intensity
-             << ",\"comfort_scale\":" << wp->comfort_scale << "}";
-    }
-
-    // WarpVisual
-    auto* wv = entity->getComponent<components::WarpVisual>();
-    if (wv) {
-        json << ",\"warp_visual\":{"
-             << "\"distortion_strength\":" << wv->distortion_strength
-             << ",\"tunnel_noise_scale\":" << wv->tunnel_noise_scale
-             << ",\"vignette_amount\":" << wv->vignette_amount
-             << ",\"bloom_strength\":" << wv->bloom_strength
-             << ",\"starfield_speed\":" << wv->starfield_speed << "}";
-    }
-
-    // WarpEvent
-    auto* we = entity->getComponent<components::WarpEvent>();
-    if (we) {
-        json << ",\"warp_event\":{"
-             << "\"current_event\":\"" << we->current_event << "\""
-             << ",\"event_timer\":" << we->event_timer
-             << ",\"severity\":" << we->severity << "}";
-    }
-
-    // TacticalProjection
-    auto* tp = entity->getComponent<components::TacticalProjection>();
-    if (tp) {
-        json << ",\"tactical_projection\":{"
-             << "\"projected_x\":" << tp->projected_x
-             << ",\"projected_y\":" << tp->projected_y
-             << ",\"vertical_offset\":" << tp->vertical_offset
-             << ",\"visible\":" << (tp->visible ? "true" : "false") << "}";
-    }
-
-    // PlayerPresence
-    auto* pp = entity->getComponent<components::PlayerPresence>();
-    if (pp) {
-        json << ",\"player_presence\":{"
-             << "\"time_since_last_command\":" << pp->time_since_last_command
-             << ",\"time_since_last_speech\":" << pp->time_since_last_speech << "}";
-    }
-
-    // FactionCulture
-    auto* fc = entity->getComponent<components::FactionCulture>();
-    if (fc) {
-        json << ",\"faction_culture\":{"
-             << "\"faction\":\"" << fc->faction << "\""
-             << ",\"chatter_frequency_mod\":" << fc->chatter_frequency_mod
-             << ",\"formation_tightness_mod\":" << fc->formation_tightness_mod
-             << ",\"morale_sensitivity\":" << fc->morale_sensitivity
-             << ",\"risk_tolerance\":" << fc->risk_tolerance << "}";
-    }
-
-    json << "}";
-    return json.str();
 }
 
 } // namespace data
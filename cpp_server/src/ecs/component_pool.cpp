@@ -0,0 +1,200 @@
+#include "ecs/component_pool.h"
+#include "ecs/entity_query.h"
+#include "ecs/entity.h"
+#include <algorithm>
+#include <atomic>
+
+namespace atlas {
+namespace ecs {
+
+namespace detail {
+ComponentTypeId nextComponentTypeId() {
+    static std::atomic<ComponentTypeId> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+QuerySignatureId nextQuerySignatureId() {
+    static std::atomic<QuerySignatureId> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace detail
+
+void ComponentPool::insert(uint32_t slot, Entity* entity, std::unique_ptr<Component> component) {
+    if (contains(slot)) {
+        components_[sparse_[slot]] = std::move(component);
+        return;
+    }
+    if (slot >= sparse_.size()) {
+        sparse_.resize(slot + 1, npos);
+    }
+    sparse_[slot] = static_cast<uint32_t>(entities_.size());
+    slots_.push_back(slot);
+    entities_.push_back(entity);
+    components_.push_back(std::move(component));
+}
+
+bool ComponentPool::remove(uint32_t slot) {
+    if (!contains(slot)) return false;
+
+    uint32_t hole = sparse_[slot];
+    uint32_t last = static_cast<uint32_t>(entities_.size() - 1);
+    if (hole != last) {
+        slots_[hole] = slots_[last];
+        entities_[hole] = entities_[last];
+        components_[hole] = std::move(components_[last]);
+        sparse_[slots_[hole]] = hole;
+    }
+    slots_.pop_back();
+    entities_.pop_back();
+    components_.pop_back();
+    sparse_[slot] = npos;
+    return true;
+}
+
+void EntityQuery::add(uint32_t slot, Entity* entity) {
+    if (contains(slot)) return;
+    if (slot >= sparse_.size()) {
+        sparse_.resize(slot + 1, ComponentPool::npos);
+    }
+    sparse_[slot] = static_cast<uint32_t>(entities_.size());
+    slots_.push_back(slot);
+    entities_.push_back(entity);
+}
+
+void EntityQuery::remove(uint32_t slot) {
+    if (!contains(slot)) return;
+
+    uint32_t hole = sparse_[slot];
+    uint32_t last = static_cast<uint32_t>(entities_.size() - 1);
+    if (hole != last) {
+        slots_[hole] = slots_[last];
+        entities_[hole] = entities_[last];
+        sparse_[slots_[hole]] = hole;
+    }
+    slots_.pop_back();
+    entities_.pop_back();
+    sparse_[slot] = ComponentPool::npos;
+}
+
+ComponentStorage::ComponentStorage() = default;
+ComponentStorage::~ComponentStorage() = default;
+
+ComponentPool* ComponentStorage::find(const std::type_index& type) const {
+    auto it = type_ids_.find(type);
+    if (it == type_ids_.end()) return nullptr;
+    return find(it->second);
+}
+
+ComponentPool& ComponentStorage::acquire(ComponentTypeId id, const std::type_index& type) {
+    if (id >= pools_.size()) {
+        pools_.resize(id + 1);
+    }
+    if (!pools_[id]) {
+        pools_[id] = std::make_unique<ComponentPool>();
+        type_ids_.emplace(type, id);
+    }
+    return *pools_[id];
+}
+
+void ComponentStorage::insert(ComponentTypeId id, const std::type_index& type,
+                              uint32_t slot, Entity* entity,
+                              std::unique_ptr<Component> component) {
+    ComponentPool& pool = acquire(id, type);
+    bool added = !pool.contains(slot);
+    pool.insert(slot, entity, std::move(component));
+    if (!added || id >= queries_by_component_.size()) return;
+
+    for (EntityQuery* query : queries_by_component_[id]) {
+        if (matches(*query, slot)) query->add(slot, entity);
+    }
+}
+
+void ComponentStorage::remove(ComponentTypeId id, uint32_t slot) {
+    ComponentPool* pool = find(id);
+    if (!pool || !pool->remove(slot)) return;
+    if (id >= queries_by_component_.size()) return;
+
+    for (EntityQuery* query : queries_by_component_[id]) {
+        query->remove(slot);
+    }
+}
+
+void ComponentStorage::removeAll(uint32_t slot) {
+    for (auto& query : queries_) {
+        query->remove(slot);
+    }
+    for (auto& pool : pools_) {
+        if (pool) pool->remove(slot);
+    }
+}
+
+bool ComponentStorage::matches(const EntityQuery& query, uint32_t slot) const {
+    for (ComponentTypeId id : query.types()) {
+        ComponentPool* pool = find(id);
+        if (!pool || !pool->contains(slot)) return false;
+    }
+    return true;
+}
+
+EntityQuery& ComponentStorage::query(QuerySignatureId signature,
+                                     const std::vector<ComponentTypeId>& types,
+                                     const std::string& label) {
+    std::lock_guard<std::mutex> lock(query_mutex_);
+    if (signature < queries_by_signature_.size() && queries_by_signature_[signature]) {
+        return *queries_by_signature_[signature];
+    }
+
+    std::vector<ComponentTypeId> key = types;
+    std::sort(key.begin(), key.end());
+    key.erase(std::unique(key.begin(), key.end()), key.end());
+
+    EntityQuery* query = nullptr;
+    auto it = queries_by_types_.find(key);
+    if (it != queries_by_types_.end()) {
+        query = it->second;
+    } else {
+        queries_.push_back(std::make_unique<EntityQuery>(key, label));
+        query = queries_.back().get();
+        queries_by_types_.emplace(key, query);
+
+        for (ComponentTypeId id : key) {
+            if (id >= queries_by_component_.size()) {
+                queries_by_component_.resize(id + 1);
+            }
+            queries_by_component_[id].push_back(query);
+        }
+
+        // Seed from the smallest pool; afterwards updates are incremental
+        const ComponentPool* driver = nullptr;
+        for (ComponentTypeId id : key) {
+            const ComponentPool* pool = find(id);
+            if (!pool || pool->empty()) { driver = nullptr; break; }
+            if (!driver || pool->size() < driver->size()) driver = pool;
+        }
+        if (driver) {
+            for (Entity* entity : driver->entities()) {
+                uint32_t slot = entity->getSlot();
+                if (matches(*query, slot)) query->add(slot, entity);
+            }
+        }
+    }
+
+    if (signature >= queries_by_signature_.size()) {
+        queries_by_signature_.resize(signature + 1, nullptr);
+    }
+    queries_by_signature_[signature] = query;
+    return *query;
+}
+
+std::vector<const EntityQuery*> ComponentStorage::queries() const {
+    std::lock_guard<std::mutex> lock(query_mutex_);
+    std::vector<const EntityQuery*> result;
+    result.reserve(queries_.size());
+    for (const auto& query : queries_) {
+        result.push_back(query.get());
+    }
+    return result;
+}
+
+} // namespace ecs
+} // namespace atlas
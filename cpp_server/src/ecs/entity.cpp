@@ -3,12 +3,14 @@
 namespace atlas {
 namespace ecs {
 
-Entity::Entity(const std::string& id) : id_(id) {
+Entity::Entity(const std::string& id, EntityHandle handle, ComponentStorage* storage)
+    : id_(id), slot_(handle.index), generation_(handle.generation), storage_(storage) {
 }
 
 bool Entity::hasComponents(const std::vector<std::type_index>& types) const {
     for (const auto& type : types) {
-        if (components_.find(type) == components_.end()) {
+        auto* pool = storage_->find(type);
+        if (!pool || !pool->contains(slot_)) {
             return false;
         }
     }
@@ -0,0 +1,84 @@
+#include "ecs/entity_command_buffer.h"
+#include "ecs/world.h"
+
+namespace atlas {
+namespace ecs {
+
+void EntityCommandBuffer::push(Command command) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_.push_back(std::move(command));
+}
+
+void EntityCommandBuffer::createEntity(const std::string& id, InitFn init) {
+    Command command(Kind::Create);
+    command.id = id;
+    command.init = std::move(init);
+    push(std::move(command));
+}
+
+void EntityCommandBuffer::destroyEntity(const std::string& id) {
+    Command command(Kind::Destroy);
+    command.id = id;
+    push(std::move(command));
+}
+
+void EntityCommandBuffer::run(std::function<void(World&)> fn) {
+    Command command(Kind::Run);
+    command.fn = std::move(fn);
+    push(std::move(command));
+}
+
+size_t EntityCommandBuffer::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commands_.size();
+}
+
+void EntityCommandBuffer::playback(World& world) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (commands_.empty()) return;
+        playing_.swap(commands_);
+    }
+
+    // Commands may record further commands (e.g. an init callback); those
+    // land in commands_ and are applied at the next sync point.
+    for (Command& command : playing_) {
+        switch (command.kind) {
+            case Kind::Create: {
+                Entity* entity = world.createEntity(command.id);
+                if (command.init) command.init(entity);
+                break;
+            }
+            case Kind::SpawnBatch: {
+                world.reserveComponents(command.reserve, command.ids.size());
+                std::vector<Entity*> entities = world.createEntities(command.ids);
+                if (command.batch_init) {
+                    for (size_t i = 0; i < entities.size(); ++i) {
+                        command.batch_init(entities[i], i);
+                    }
+                }
+                break;
+            }
+            case Kind::Destroy:
+                world.destroyEntity(command.id);
+                break;
+            case Kind::AddComponent:
+                if (Entity* entity = world.getEntity(command.id)) {
+                    command.add(entity, std::move(command.component));
+                }
+                break;
+            case Kind::RemoveComponent:
+                if (Entity* entity = world.getEntity(command.id)) {
+                    command.remove(entity);
+                }
+                break;
+            case Kind::Run:
+                command.fn(world);
+                break;
+        }
+    }
+    playing_.clear();
+}
+
+} // namespace ecs
+} // namespace atlas
@@ -0,0 +1,116 @@
+#include "ecs/system_scheduler.h"
+#include <algorithm>
+
+namespace atlas {
+namespace ecs {
+
+namespace {
+bool intersects(const std::vector<ComponentTypeId>& a, const std::vector<ComponentTypeId>& b) {
+    for (ComponentTypeId id : a) {
+        if (std::find(b.begin(), b.end(), id) != b.end()) return true;
+    }
+    return false;
+}
+} // namespace
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const {
+    if (exclusive() || other.exclusive()) return true;
+    return intersects(writes, other.writes) ||
+           intersects(writes, other.reads) ||
+           intersects(reads, other.writes);
+}
+
+void SystemScheduler::build(const std::vector<System*>& systems) {
+    size_t n = systems.size();
+    systems_ = systems;
+    dependencies_.assign(n, {});
+    dependents_.assign(n, {});
+    roots_.clear();
+    remaining_.reset(new std::atomic<size_t>[n]);
+    critical_path_ = 0;
+
+    // ancestors[j][i]: system i is already ordered before j through some
+    // chain, so a direct edge would be redundant
+    std::vector<std::vector<bool>> ancestors(n, std::vector<bool>(n, false));
+    std::vector<size_t> depth(n, 1);
+
+    for (size_t j = 0; j < n; ++j) {
+        const SystemAccess& access = systems_[j]->getAccess();
+        // Nearest conflicting system first so its ancestors prune the rest
+        for (size_t i = j; i-- > 0;) {
+            if (ancestors[j][i] || !access.conflictsWith(systems_[i]->getAccess())) continue;
+            dependencies_[j].push_back(i);
+            dependents_[i].push_back(j);
+            ancestors[j][i] = true;
+            for (size_t k = 0; k < i; ++k) {
+                if (ancestors[i][k]) ancestors[j][k] = true;
+            }
+            depth[j] = std::max(depth[j], depth[i] + 1);
+        }
+        if (dependencies_[j].empty()) roots_.push_back(j);
+        critical_path_ = std::max(critical_path_, depth[j]);
+    }
+    internZoneNames();
+}
+
+void SystemScheduler::setProfiler(utils::TickProfiler* profiler) {
+    profiler_ = profiler;
+    internZoneNames();
+}
+
+void SystemScheduler::internZoneNames() {
+    zone_names_.clear();
+    if (!profiler_) return;
+    zone_names_.reserve(systems_.size());
+    for (System* system : systems_) {
+        zone_names_.push_back(profiler_->intern(system->getName()));
+    }
+}
+
+void SystemScheduler::runSystem(size_t index, float delta_time) {
+    utils::ProfileScope zone(profiler_, profiler_ ? zone_names_[index] : nullptr,
+                             utils::ProfileCategory::System);
+    systems_[index]->update(delta_time);
+}
+
+void SystemScheduler::run(ThreadPool& pool, float delta_time) {
+    if (systems_.empty()) return;
+    for (size_t i = 0; i < systems_.size(); ++i) {
+        remaining_[i].store(dependencies_[i].size(), std::memory_order_relaxed);
+    }
+
+    TaskGroup group(pool);
+    for (size_t root : roots_) {
+        group.run([this, &pool, &group, root, delta_time] {
+            runNode(pool, group, root, delta_time);
+        });
+    }
+    group.wait();
+}
+
+void SystemScheduler::runNode(ThreadPool& pool, TaskGroup& group, size_t index, float delta_time) {
+    runSystem(index, delta_time);
+
+    // Release dependents; keep the first ready one on this thread
+    size_t next = systems_.size();
+    for (size_t dependent : dependents_[index]) {
+        if (remaining_[dependent].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+        if (next == systems_.size()) {
+            next = dependent;
+        } else {
+            group.run([this, &pool, &group, dependent, delta_time] {
+                runNode(pool, group, dependent, delta_time);
+            });
+        }
+    }
+    if (next != systems_.size()) runNode(pool, group, next, delta_time);
+}
+
+void SystemScheduler::runSerial(float delta_time) {
+    for (size_t i = 0; i < systems_.size(); ++i) {
+        runSystem(i, delta_time);
+    }
+}
+
+} // namespace ecs
+} // namespace atlas
@@ -0,0 +1,134 @@
+#include "ecs/thread_pool.h"
+#include <chrono>
+
+namespace atlas {
+namespace ecs {
+
+namespace {
+// Worker identity, so submissions from inside a task stay on the
+// submitting worker's deque
+thread_local const ThreadPool* tl_pool = nullptr;
+thread_local size_t tl_index = 0;
+} // namespace
+
+ThreadPool::ThreadPool(size_t worker_count) {
+    size_t queue_count = worker_count > 0 ? worker_count : 1;
+    queues_.reserve(queue_count);
+    for (size_t i = 0; i < queue_count; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    size_t index = tl_pool == this
+                       ? tl_index
+                       : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Publish under the wake mutex so a worker about to sleep cannot
+        // miss the notification
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        pending_.fetch_add(1, std::memory_order_release);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::popTask(size_t preferred, Task& out) {
+    if (pending_.load(std::memory_order_acquire) == 0) return false;
+
+    // Own queue first, newest task (LIFO keeps fan-out cache-warm)
+    {
+        Queue& own = *queues_[preferred];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            out = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    // Then steal the oldest task from the others
+    for (size_t k = 1; k < queues_.size(); ++k) {
+        Queue& victim = *queues_[(preferred + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            out = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::tryRunOne() {
+    size_t preferred = tl_pool == this ? tl_index : 0;
+    Task task;
+    if (!popTask(preferred, task)) return false;
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    tl_pool = this;
+    tl_index = index;
+    for (;;) {
+        Task task;
+        if (popTask(index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this] {
+            return stopping_ || pending_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_ && pending_.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+void TaskGroup::run(ThreadPool::Task task) {
+    outstanding_.fetch_add(1, std::memory_order_relaxed);
+    pool_.submit([this, task = std::move(task)] {
+        task();
+        // Decrement under the lock: once wait() observes zero and takes the
+        // lock, this task no longer touches the group
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done_.notify_all();
+        }
+    });
+}
+
+void TaskGroup::wait() {
+    while (outstanding_.load(std::memory_order_acquire) > 0) {
+        if (pool_.tryRunOne()) continue;
+        std::unique_lock<std::mutex> lock(mutex_);
+        // Short timeout: tasks spawned by running tasks may become
+        // available for this thread to help with
+        done_.wait_for(lock, std::chrono::microseconds(200), [this] {
+            return outstanding_.load(std::memory_order_acquire) == 0;
+        });
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+}
+
+} // namespace ecs
+} // namespace atlas
@@ -4,15 +4,95 @@
 namespace atlas {
 namespace ecs {
 
+uint32_t World::allocateSlot() {
+    if (!free_slots_.empty()) {
+        uint32_t slot = free_slots_.back();
+        free_slots_.pop_back();
+        return slot;
+    }
+    slots_.push_back(nullptr);
+    generations_.push_back(1);
+    return static_cast<uint32_t>(slots_.size() - 1);
+}
+
 Entity* World::createEntity(const std::string& id) {
-    auto entity = std::make_unique<Entity>(id);
+    // Re-creating an existing ID replaces the old entity and its components
+    destroyEntity(id);
+
+    uint32_t slot = allocateSlot();
+    EntityHandle handle{slot, generations_[slot]};
+    auto entity = std::make_unique<Entity>(id, handle, &storage_);
     Entity* ptr = entity.get();
+    slots_[slot] = ptr;
     entities_[id] = std::move(entity);
     return ptr;
 }
 
 void World::destroyEntity(const std::string& id) {
-    entities_.erase(id);
+    auto it = entities_.find(id);
+    if (it == entities_.end()) return;
+
+    uint32_t slot = it->second->getSlot();
+    storage_.removeAll(slot);
+    slots_[slot] = nullptr;
+    // Invalidate outstanding handles; generation 0 is reserved for null
+    if (++generations_[slot] == 0) generations_[slot] = 1;
+    free_slots_.push_back(slot);
+    entities_.erase(it);
+}
+
+std::vector<Entity*> World::createEntities(const std::vector<std::string>& ids) {
+    size_t fresh = ids.size() > free_slots_.size() ? ids.size() - free_slots_.size() : 0;
+    slots_.reserve(slots_.size() + fresh);
+    generations_.reserve(generations_.size() + fresh);
+    entities_.reserve(entities_.size() + ids.size());
+
+    std::vector<Entity*> result;
+    result.reserve(ids.size());
+    for (const auto& id : ids) {
+        result.push_back(createEntity(id));
+    }
+    return result;
+}
+
+void World::reserveComponents(const std::vector<std::pair<ComponentTypeId, std::type_index>>& types,
+                              size_t count) {
+    for (const auto& type : types) {
+        storage_.acquire(type.first, type.second).reserve(count);
+    }
+}
+
+EntityCommandBuffer& World::commands() {
+    std::thread::id self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(command_mutex_);
+    for (auto& entry : thread_commands_) {
+        if (entry.first == self) return *entry.second;
+    }
+    thread_commands_.emplace_back(self, std::make_unique<EntityCommandBuffer>());
+    return *thread_commands_.back().second;
+}
+
+void World::flushCommands() {
+    flushSystemCommands();
+
+    // Snapshot under the lock: playback may call commands() from init callbacks
+    std::vector<EntityCommandBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(command_mutex_);
+        buffers.reserve(thread_commands_.size());
+        for (auto& entry : thread_commands_) {
+            buffers.push_back(entry.second.get());
+        }
+    }
+    for (EntityCommandBuffer* buffer : buffers) {
+        buffer->playback(*this);
+    }
+}
+
+void World::flushSystemCommands() {
+    for (auto& system : systems_) {
+        system->commands_.playback(*this);
+    }
 }
 
 Entity* World::getEntity(const std::string& id) {
@@ -31,25 +111,103 @@ const Entity* World::getEntity(const std::string& id) const {
     return nullptr;
 }
 
+Entity* World::resolve(EntityHandle& cache, const std::string& id) const {
+    Entity* entity = resolve(cache);
+    if (entity && entity->getId() == id) return entity;
+
+    auto it = id.empty() ? entities_.end() : entities_.find(id);
+    if (it == entities_.end()) {
+        cache = EntityHandle{};
+        return nullptr;
+    }
+    cache = it->second->getHandle();
+    return it->second.get();
+}
+
 std::vector<Entity*> World::getAllEntities() {
     std::vector<Entity*> result;
     result.reserve(entities_.size());
     
-    for (auto& pair : entities_) {
-        result.push_back(pair.second.get());
+    for (Entity* entity : slots_) {
+        if (entity) result.push_back(entity);
     }
     
     return result;
 }
 
+std::unique_ptr<World> World::clone() const {
+    auto copy = std::make_unique<World>();
+    copy->slots_.reserve(entities_.size());
+    copy->generations_.reserve(entities_.size());
+    copy->entities_.reserve(entities_.size());
+
+    // slot in this World → entity in the copy
+    std::vector<Entity*> mapped(slots_.size(), nullptr);
+    for (size_t slot = 0; slot < slots_.size(); ++slot) {
+        if (slots_[slot]) mapped[slot] = copy->createEntity(slots_[slot]->getId());
+    }
+
+    const auto& pools = storage_.pools();
+    for (ComponentTypeId id = 0; id < pools.size(); ++id) {
+        const ComponentPool* pool = pools[id].get();
+        if (!pool || pool->empty()) continue;
+        const auto& entities = pool->entities();
+        const auto& components = pool->components();
+        std::type_index type = components.front()->getTypeIndex();
+        copy->storage_.acquire(id, type).reserve(pool->size());
+        for (size_t i = 0; i < entities.size(); ++i) {
+            Entity* target = mapped[entities[i]->getSlot()];
+            copy->storage_.insert(id, type, target->getSlot(), target, components[i]->clone());
+        }
+    }
+    return copy;
+}
+
 void World::addSystem(std::unique_ptr<System> system) {
     systems_.push_back(std::move(system));
+    schedule_dirty_ = true;
+}
+
+const SystemScheduler& World::getScheduler() {
+    if (schedule_dirty_) {
+        std::vector<System*> systems;
+        systems.reserve(systems_.size());
+        for (auto& system : systems_) {
+            systems.push_back(system.get());
+        }
+        scheduler_.build(systems);
+        schedule_dirty_ = false;
+    }
+    return scheduler_;
+}
+
+void World::setWorkerThreads(size_t count) {
+    if (count == getWorkerThreads()) return;
+    pool_ = count > 0 ? std::make_unique<ThreadPool>(count) : nullptr;
+}
+
+void World::setProfiler(utils::TickProfiler* profiler) {
+    profiler_ = profiler;
+    scheduler_.setProfiler(profiler);
 }
 
 void World::update(float delta_time) {
-    for (auto& system : systems_) {
-        system->update(delta_time);
+    // Sync point: changes recorded since the last tick (e.g. network threads)
+    {
+        utils::ProfileScope zone(profiler_, "World::flushCommands", utils::ProfileCategory::Other);
+        flushCommands();
     }
+
+    getScheduler();
+    if (pool_) {
+        scheduler_.run(*pool_, delta_time);
+    } else {
+        scheduler_.runSerial(delta_time);
+    }
+
+    // Sync point: systems' own buffers in registration order, then threads
+    utils::ProfileScope zone(profiler_, "World::flushCommands", utils::ProfileCategory::Other);
+    flushCommands();
 }
 
 } // namespace ecs
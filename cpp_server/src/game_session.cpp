@@ -49,7 +49,17 @@ void GameSession::update(float /*delta_time*/) {
             int client_fd = kv.first;
             uint64_t seq = snapshot_sequence_++;
             std::string state_msg =
-                snapshot_replication_->buildDeltaUpdate(client_fd, seq);
+                kv.second.encoding == network::WireEncoding::BINARY
+                    ? snapshot_replication_->buildDeltaUpdateBinary(client_fd, seq)
+                    : snapshot_replication_->buildDeltaUpdate(client_fd, seq);
+
+            // Entities entering / leaving this client's relevance set
+            for (const auto& id : snapshot_replication_->getLastSpawned()) {
+                tcp_server_->sendToClient(kv.second.connection, buildSpawnEntity(id));
+            }
+            for (const auto& id : snapshot_replication_->getLastDespawned()) {
+                tcp_server_->sendToClient(kv.second.connection, buildDestroyEntity(id));
+            }
             tcp_server_->sendToClient(kv.second.connection, state_msg);
         }
     } else {
@@ -106,6 +116,9 @@ void GameSession::onClientMessage(const network::ClientConnection& client,
         return;
     }
 
+    utils::ProfileScope zone(profiler_, profiler_ ? handlerZone(type) : nullptr,
+                             utils::ProfileCategory::Network);
+
     switch (type) {
         case network::MessageType::CONNECT:
             handleConnect(client, data);
@@ -178,4 +191,13 @@ void GameSession::onClientMessage(const network::ClientConnection& client,
     }
 }
 
+const char* GameSession::handlerZone(network::MessageType type) {
+    auto it = handler_zones_.find(type);
+    if (it == handler_zones_.end()) {
+        const char* name = profiler_->intern("net:" + protocol_.messageTypeToString(type));
+        it = handler_zones_.emplace(type, name).first;
+    }
+    return it->second;
+}
+
 } // namespace atlas
@@ -146,6 +146,13 @@ std::string GameSession::buildSpawnEntity(const std::string& entity_id) const {
     return json.str();
 }
 
+std::string GameSession::buildDestroyEntity(const std::string& entity_id) const {
+    std::ostringstream json;
+    json << "{\"type\":\"destroy_entity\","
+         << "\"data\":{\"entity_id\":\"" << entity_id << "\"}}";
+    return json.str();
+}
+
 // ---------------------------------------------------------------------------
 // Player entity creation
 // ---------------------------------------------------------------------------
@@ -27,6 +27,8 @@ void GameSession::handleConnect(const network::ClientConnection& client,
 
     std::string player_id   = extractJsonString(data, "player_id");
     std::string char_name   = extractJsonString(data, "character_name");
+    // Clients opt into binary state updates; everything else stays JSON
+    bool binary = extractJsonString(data, "encoding") == "binary";
 
     if (player_id.empty()) {
         player_id = "player_" + std::to_string(client.socket);
@@ -51,6 +53,8 @@ void GameSession::handleConnect(const network::ClientConnection& client,
         info.entity_id      = entity_id;
         info.character_name  = char_name;
         info.connection      = client;
+        info.encoding        = binary ? network::WireEncoding::BINARY
+                                      : network::WireEncoding::JSON;
         players_[static_cast<int>(client.socket)] = info;
 
         for (const auto& kv : players_) {
@@ -68,26 +72,34 @@ void GameSession::handleConnect(const network::ClientConnection& client,
     ack << "{\"type\":\"connect_ack\","
         << "\"data\":{"
         << "\"success\":true,"
-        << "\"player_entity_id\":\"" << entity_id << "\","
-        << "\"message\":\"Welcome, " << safe_name << "!\""
+        << "\"player_entity_id\":\"" << entity_id << "\",";
+    if (binary) {
+        ack << "\"encoding\":\"binary\","
+            << "\"wire_version\":" << static_cast<int>(network::kWireVersion) << ",";
+    }
+    ack << "\"message\":\"Welcome, " << safe_name << "!\""
         << "}}";
     tcp_server_->sendToClient(client, ack.str());
 
-    // Send spawn_entity messages for every existing entity
-    for (auto* entity : world_->getAllEntities()) {
-        std::string spawn_msg = buildSpawnEntity(entity->getId());
-        tcp_server_->sendToClient(client, spawn_msg);
+    // With interest management, replication spawns entities as they
+    // come into range; otherwise every client sees every entity
+    if (!replicatesByInterest()) {
+        // Send spawn_entity messages for every existing entity
+        for (auto* entity : world_->getAllEntities()) {
+            std::string spawn_msg = buildSpawnEntity(entity->getId());
+            tcp_server_->sendToClient(client, spawn_msg);
+        }
+
+        // Notify other clients about the new player entity
+        std::string new_spawn = buildSpawnEntity(entity_id);
+        for (const auto& other : others) {
+            tcp_server_->sendToClient(other.connection, new_spawn);
+        }
     }
 
     atlas::utils::Logger::instance().info(
         "[GameSession] Player connected: " + char_name + " (entity " + entity_id + ")");
 
-    // Notify other clients about the new player entity
-    std::string new_spawn = buildSpawnEntity(entity_id);
-    for (const auto& other : others) {
-        tcp_server_->sendToClient(other.connection, new_spawn);
-    }
-
     // Register with interest management / snapshot replication
     int fd = static_cast<int>(client.socket);
     if (interest_management_) {
@@ -122,13 +134,15 @@ void GameSession::handleDisconnect(const network::ClientConnection& client) {
     }
 
     if (!entity_id.empty()) {
-        world_->destroyEntity(entity_id);
+        // Network handlers record structural changes; they are applied
+        // at the next tick's sync point
+        world_->commands().destroyEntity(entity_id);
+
+        // Replication despawns it for clients that could see it
+        if (replicatesByInterest()) return;
 
         // Tell remaining clients to remove the entity
-        std::ostringstream msg;
-        msg << "{\"type\":\"destroy_entity\","
-            << "\"data\":{\"entity_id\":\"" << entity_id << "\"}}";
-        std::string destroy_msg = msg.str();
+        std::string destroy_msg = buildDestroyEntity(entity_id);
 
         std::lock_guard<std::mutex> lock(players_mutex_);
         for (const auto& kv : players_) {
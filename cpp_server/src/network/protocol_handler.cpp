@@ -1,4 +1,5 @@
 #include "network/protocol_handler.h"
+#include "network/wire_format.h"
 #include <sstream>
 
 namespace atlas {
@@ -108,6 +109,10 @@ std::string ProtocolHandler::messageTypeToString(MessageType type) {
 }
 
 bool ProtocolHandler::parseMessage(const std::string& json, MessageType& type, std::string& data) {
+    if (isBinaryFrame(json)) {
+        return parseFrame(json, type, data);
+    }
+
     // Simple JSON parsing (in production, use a library like nlohmann/json or rapidjson)
     // This is a simplified version compatible with both the Python and C++ client protocols
     
@@ -150,6 +155,17 @@ bool ProtocolHandler::parseMessage(const std::string& json, MessageType& type, s
     return true;
 }
 
+bool ProtocolHandler::parseFrame(const std::string& raw, MessageType& type, std::string& data) {
+    WireFrame frame;
+    size_t consumed = 0;
+    if (decodeFrame(raw.data(), raw.size(), frame, consumed) != FrameStatus::OK) {
+        return false;
+    }
+    type = frame.type;
+    data = std::move(frame.payload);
+    return true;
+}
+
 std::string ProtocolHandler::createConnectAck(bool success, const std::string& message) {
     std::ostringstream json;
     json << "{";
@@ -1,14 +1,69 @@
 #include "network/tcp_server.h"
+#include "network/wire_format.h"
 #include "utils/logger.h"
+#include <cerrno>
 #include <cstring>
+#include <ctime>
 
 #ifdef _WIN32
 #pragma comment(lib, "ws2_32.lib")
 #endif
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
 namespace atlas {
 namespace network {
 
+namespace {
+
+constexpr size_t kReadChunk = 64 * 1024;
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// JSON messages are newline-terminated on the wire; binary frames carry
+// their own length
+void appendOutbound(std::string& out, const std::string& data) {
+    out.append(data);
+    if (!isBinaryFrame(data) && (data.empty() || data.back() != '\n')) {
+        out.push_back('\n');
+    }
+}
+
+bool wouldBlock() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+bool interrupted() {
+#ifdef _WIN32
+    return false;
+#else
+    return errno == EINTR;
+#endif
+}
+
+void shutdownSocket(socket_t socket) {
+#ifdef _WIN32
+    shutdown(socket, SD_BOTH);
+#else
+    shutdown(socket, SHUT_RDWR);
+#endif
+}
+
+} // namespace
+
 TCPServer::TCPServer(const std::string& host, uint16_t port, int max_connections)
     : host_(host)
     , port_(port)
@@ -25,7 +80,7 @@ bool TCPServer::initialize() {
     if (!initializeSockets()) {
         return false;
     }
-    
+
     // Create socket
     server_socket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (server_socket_ == INVALID_SOCKET) {
@@ -33,7 +88,7 @@ bool TCPServer::initialize() {
         cleanupSockets();
         return false;
     }
-    
+
     // Set socket options
     int opt = 1;
 #ifdef _WIN32
@@ -41,18 +96,18 @@ bool TCPServer::initialize() {
 #else
     setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
 #endif
-    
+
     // Bind socket
     sockaddr_in server_addr{};
     server_addr.sin_family = AF_INET;
     server_addr.sin_port = htons(port_);
-    
+
     if (host_ == "0.0.0.0" || host_ == "") {
         server_addr.sin_addr.s_addr = INADDR_ANY;
     } else {
         inet_pton(AF_INET, host_.c_str(), &server_addr.sin_addr);
     }
-    
+
     if (bind(server_socket_, (sockaddr*)&server_addr, sizeof(server_addr)) == SOCKET_ERROR) {
         atlas::utils::Logger::instance().error(
             "Failed to bind socket to " + host_ + ":" + std::to_string(port_));
@@ -60,7 +115,15 @@ bool TCPServer::initialize() {
         cleanupSockets();
         return false;
     }
-    
+
+    if (port_ == 0) {
+        sockaddr_in bound{};
+        socklen_t bound_len = sizeof(bound);
+        if (getsockname(server_socket_, (sockaddr*)&bound, &bound_len) == 0) {
+            port_ = ntohs(bound.sin_port);
+        }
+    }
+
     // Listen
     if (listen(server_socket_, max_connections_) == SOCKET_ERROR) {
         atlas::utils::Logger::instance().error("Failed to listen on socket");
@@ -68,15 +131,385 @@ bool TCPServer::initialize() {
         cleanupSockets();
         return false;
     }
-    
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Connection bookkeeping (all platforms)
+// ---------------------------------------------------------------------------
+
+std::shared_ptr<TCPServer::Connection> TCPServer::findConnection(socket_t socket) const {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    auto it = connections_.find(socket);
+    return it != connections_.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<TCPServer::Connection> TCPServer::addConnection(socket_t socket,
+                                                                const sockaddr_in& addr) {
+    char client_ip[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &addr.sin_addr, client_ip, INET_ADDRSTRLEN);
+
+    auto conn = std::make_shared<Connection>();
+    conn->info.socket = socket;
+    conn->info.address = client_ip;
+    conn->info.port = ntohs(addr.sin_port);
+    conn->info.authenticated = false;
+    conn->info.connect_time = std::time(nullptr);
+
+    atlas::utils::Logger::instance().info(
+        "[TCPServer] New connection from " + conn->info.address + ":" +
+        std::to_string(conn->info.port));
+
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    connections_[socket] = conn;
+    return conn;
+}
+
+void TCPServer::removeConnection(Connection& conn) {
+    // Unpublish first: once the socket is closed its number can be reused
+    // by the next accept, which must not find (or be erased as) this entry
+    std::shared_ptr<Connection> keep;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        auto it = connections_.find(conn.info.socket);
+        if (it != connections_.end() && it->second.get() == &conn) {
+            keep = it->second;
+            connections_.erase(it);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(conn.out_mutex);
+        if (conn.closed) return;
+        conn.closed = true;
+#ifdef __linux__
+        if (conn.loop < static_cast<int>(loops_.size())) {
+            epoll_ctl(loops_[conn.loop]->epoll_fd, EPOLL_CTL_DEL, conn.info.socket, nullptr);
+        }
+#endif
+        closeSocket(conn.info.socket);
+    }
+    atlas::utils::Logger::instance().info(
+        "[TCPServer] Client disconnected: " + conn.info.address + ":" +
+        std::to_string(conn.info.port));
+}
+
+bool TCPServer::receive(Connection& conn, const char* data, size_t size) {
+    thread_local std::vector<std::string> messages;
+    messages.clear();
+    conn.inbound.append(data, size);
+    bool ok = extractMessages(conn.inbound, messages, kMaxInboundMessageBytes);
+    for (auto& message : messages) {
+        inbound_.push({conn.info, std::move(message)});
+    }
+    return ok;
+}
+
+bool TCPServer::enqueue(Connection& conn, const std::string& data) {
+    std::lock_guard<std::mutex> lock(conn.out_mutex);
+    if (conn.closed || conn.dropped) return false;
+
+    size_t queued = conn.outbound.size() - conn.out_offset;
+    if (queued + data.size() > max_outbound_bytes_) {
+        // Dropping a message would desync the client's delta baseline, so
+        // a client that cannot keep up is disconnected instead
+        dropLocked(conn, "outbound queue full");
+        return false;
+    }
+    appendOutbound(conn.outbound, data);
+    if (!flushLocked(conn)) {
+        dropLocked(conn, "send failed");
+        return false;
+    }
     return true;
 }
 
+bool TCPServer::flushLocked(Connection& conn) {
+    while (conn.out_offset < conn.outbound.size()) {
+        const char* data = conn.outbound.data() + conn.out_offset;
+        size_t left = conn.outbound.size() - conn.out_offset;
+        auto sent = send(conn.info.socket, data, static_cast<int>(left), kSendFlags);
+        if (sent > 0) {
+            conn.out_offset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && interrupted()) continue;
+        if (sent < 0 && wouldBlock()) break;
+        return false;
+    }
+
+    if (conn.out_offset == conn.outbound.size()) {
+        conn.outbound.clear();
+        conn.out_offset = 0;
+    } else if (conn.out_offset > conn.outbound.size() / 2) {
+        conn.outbound.erase(0, conn.out_offset);
+        conn.out_offset = 0;
+    }
+#ifdef __linux__
+    bool pending = !conn.outbound.empty();
+    if (pending != conn.want_write) setWriteInterest(conn, pending);
+#endif
+    return true;
+}
+
+void TCPServer::dropLocked(Connection& conn, const char* reason) {
+    conn.dropped = true;
+    conn.outbound.clear();
+    conn.out_offset = 0;
+    // The reading side sees EOF and closes the socket
+    shutdownSocket(conn.info.socket);
+    atlas::utils::Logger::instance().warn(
+        "[TCPServer] Dropping " + conn.info.address + ":" +
+        std::to_string(conn.info.port) + " (" + reason + ")");
+}
+
+int TCPServer::getClientCount() const {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    return static_cast<int>(connections_.size());
+}
+
+std::vector<ClientConnection> TCPServer::getClients() const {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    std::vector<ClientConnection> clients;
+    clients.reserve(connections_.size());
+    for (const auto& kv : connections_) {
+        clients.push_back(kv.second->info);
+    }
+    return clients;
+}
+
+void TCPServer::setMessageHandler(MessageHandler handler) {
+    message_handler_ = handler;
+}
+
+size_t TCPServer::dispatchMessages() {
+    size_t delivered = 0;
+    InboundMessage message;
+    while (inbound_.pop(message)) {
+        if (message_handler_) {
+            message_handler_(message.client, message.data);
+        }
+        ++delivered;
+    }
+    return delivered;
+}
+
+bool TCPServer::sendToClient(const ClientConnection& client, const std::string& data) {
+    auto conn = findConnection(client.socket);
+    return conn && enqueue(*conn, data);
+}
+
+void TCPServer::broadcastToAll(const std::string& data) {
+    std::vector<std::shared_ptr<Connection>> targets;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        targets.reserve(connections_.size());
+        for (const auto& kv : connections_) {
+            targets.push_back(kv.second);
+        }
+    }
+    for (const auto& conn : targets) {
+        enqueue(*conn, data);
+    }
+}
+
+#ifdef __linux__
+
+// ---------------------------------------------------------------------------
+// epoll reactor
+// ---------------------------------------------------------------------------
+//
+// Event tags: data.ptr == nullptr is the listening socket (loop 0 only),
+// data.ptr == &loop is that loop's wake-up eventfd, anything else is the
+// Connection the socket belongs to.  A connection is only ever read,
+// flushed for EPOLLOUT and closed by the loop that owns it.
+
+void TCPServer::start() {
+    if (running_) {
+        return;
+    }
+
+    running_ = true;
+
+    int flags = fcntl(server_socket_, F_GETFL, 0);
+    fcntl(server_socket_, F_SETFL, flags | O_NONBLOCK);
+
+    for (int i = 0; i < io_thread_count_; ++i) {
+        auto loop = std::make_unique<IoLoop>();
+        loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        loop->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = loop.get();
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &ev);
+        if (i == 0) {
+            ev.data.ptr = nullptr;
+            epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, server_socket_, &ev);
+        }
+        loops_.push_back(std::move(loop));
+    }
+    for (auto& loop : loops_) {
+        loop->thread = std::thread(&TCPServer::ioLoop, this, std::ref(*loop));
+    }
+}
+
+void TCPServer::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+
+    for (auto& loop : loops_) {
+        uint64_t one = 1;
+        ssize_t ignored = write(loop->wake_fd, &one, sizeof(one));
+        (void)ignored;
+    }
+    for (auto& loop : loops_) {
+        if (loop->thread.joinable()) {
+            loop->thread.join();
+        }
+    }
+
+    // Reactor threads are gone; close whatever is still open
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        for (auto& kv : connections_) {
+            std::lock_guard<std::mutex> out_lock(kv.second->out_mutex);
+            if (!kv.second->closed) {
+                kv.second->closed = true;
+                closeSocket(kv.first);
+            }
+        }
+        connections_.clear();
+    }
+    for (auto& loop : loops_) {
+        close(loop->wake_fd);
+        close(loop->epoll_fd);
+    }
+    loops_.clear();
+
+    if (server_socket_ != INVALID_SOCKET) {
+        closeSocket(server_socket_);
+        server_socket_ = INVALID_SOCKET;
+    }
+
+    cleanupSockets();
+}
+
+void TCPServer::ioLoop(IoLoop& loop) {
+    epoll_event events[64];
+    while (running_) {
+        int count = epoll_wait(loop.epoll_fd, events, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            atlas::utils::Logger::instance().error("[TCPServer] epoll_wait failed");
+            break;
+        }
+        for (int i = 0; i < count && running_; ++i) {
+            void* tag = events[i].data.ptr;
+            if (tag == nullptr) {
+                acceptPending();
+                continue;
+            }
+            if (tag == &loop) {
+                uint64_t value;
+                ssize_t ignored = read(loop.wake_fd, &value, sizeof(value));
+                (void)ignored;
+                continue;
+            }
+
+            Connection& conn = *static_cast<Connection*>(tag);
+            uint32_t flags = events[i].events;
+            bool alive = true;
+            if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                alive = readConnection(conn);
+            }
+            if (alive && (flags & EPOLLOUT)) {
+                std::lock_guard<std::mutex> lock(conn.out_mutex);
+                alive = !conn.dropped && flushLocked(conn);
+            }
+            if (!alive) {
+                removeConnection(conn);
+            }
+        }
+    }
+}
+
+void TCPServer::acceptPending() {
+    for (;;) {
+        sockaddr_in client_addr{};
+        socklen_t client_addr_len = sizeof(client_addr);
+        int client_socket = accept4(server_socket_, (sockaddr*)&client_addr, &client_addr_len,
+                                    SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client_socket < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK && running_) {
+                atlas::utils::Logger::instance().error("Accept failed");
+            }
+            return;
+        }
+
+        if (getClientCount() >= max_connections_) {
+            atlas::utils::Logger::instance().warn(
+                "[TCPServer] Connection limit reached, rejecting client");
+            closeSocket(client_socket);
+            continue;
+        }
+
+        int one = 1;
+        setsockopt(client_socket, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        auto conn = addConnection(client_socket, client_addr);
+        conn->loop = static_cast<int>(next_loop_++ % loops_.size());
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.ptr = conn.get();
+        epoll_ctl(loops_[conn->loop]->epoll_fd, EPOLL_CTL_ADD, client_socket, &ev);
+    }
+}
+
+bool TCPServer::readConnection(Connection& conn) {
+    thread_local char buffer[kReadChunk];
+    for (;;) {
+        ssize_t received = recv(conn.info.socket, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            if (!receive(conn, buffer, static_cast<size_t>(received))) {
+                atlas::utils::Logger::instance().warn(
+                    "[TCPServer] Malformed or oversized message from " + conn.info.address);
+                return false;
+            }
+            // Level-triggered: anything left is reported again
+            if (static_cast<size_t>(received) < sizeof(buffer)) return true;
+            continue;
+        }
+        if (received == 0) return false;
+        if (errno == EINTR) continue;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+void TCPServer::setWriteInterest(Connection& conn, bool enable) {
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLRDHUP | (enable ? EPOLLOUT : 0u);
+    ev.data.ptr = &conn;
+    epoll_ctl(loops_[conn.loop]->epoll_fd, EPOLL_CTL_MOD, conn.info.socket, &ev);
+    conn.want_write = enable;
+}
+
+#else
+
+// ---------------------------------------------------------------------------
+// Thread-per-client fallback (non-Linux)
+// ---------------------------------------------------------------------------
+
 void TCPServer::start() {
     if (running_) {
         return;
     }
-    
+
     running_ = true;
     accept_thread_ = std::thread(&TCPServer::acceptLoop, this);
 }
@@ -85,29 +518,29 @@ void TCPServer::stop() {
     if (!running_) {
         return;
     }
-    
+
     running_ = false;
-    
+
     // Close server socket to unblock accept
     if (server_socket_ != INVALID_SOCKET) {
         closeSocket(server_socket_);
         server_socket_ = INVALID_SOCKET;
     }
-    
+
     // Wait for accept thread
     if (accept_thread_.joinable()) {
         accept_thread_.join();
     }
-    
-    // Close all client connections
+
+    // Unblock every client thread; each closes its own socket
     {
         std::lock_guard<std::mutex> lock(clients_mutex_);
-        for (auto& client : clients_) {
-            closeSocket(client.socket);
+        for (auto& kv : connections_) {
+            std::lock_guard<std::mutex> out_lock(kv.second->out_mutex);
+            if (!kv.second->closed) shutdownSocket(kv.first);
         }
-        clients_.clear();
     }
-    
+
     // Wait for client threads
     for (auto& thread : client_threads_) {
         if (thread.joinable()) {
@@ -115,7 +548,7 @@ void TCPServer::stop() {
         }
     }
     client_threads_.clear();
-    
+
     cleanupSockets();
 }
 
@@ -123,102 +556,43 @@ void TCPServer::acceptLoop() {
     while (running_) {
         sockaddr_in client_addr{};
         socklen_t client_addr_len = sizeof(client_addr);
-        
+
         socket_t client_socket = accept(server_socket_, (sockaddr*)&client_addr, &client_addr_len);
-        
+
         if (client_socket == INVALID_SOCKET) {
             if (running_) {
                 atlas::utils::Logger::instance().error("Accept failed");
             }
             break;
         }
-        
-        // Get client address
-        char client_ip[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, INET_ADDRSTRLEN);
-        uint16_t client_port = ntohs(client_addr.sin_port);
-        
-        ClientConnection client;
-        client.socket = client_socket;
-        client.address = client_ip;
-        client.port = client_port;
-        client.authenticated = false;
-        client.connect_time = std::time(nullptr);
-        
-        atlas::utils::Logger::instance().info(
-            "[TCPServer] New connection from " + std::string(client_ip) + ":" + std::to_string(client_port));
-        
-        // Add to clients list
-        {
-            std::lock_guard<std::mutex> lock(clients_mutex_);
-            clients_.push_back(client);
-        }
-        
-        // Start client handler thread
-        client_threads_.push_back(std::thread(&TCPServer::handleClient, this, client));
-    }
-}
-
-void TCPServer::handleClient(ClientConnection client) {
+
+        auto conn = addConnection(client_socket, client_addr);
+        client_threads_.push_back(std::thread(&TCPServer::handleClient, this, conn));
+    }
+}
+
+void TCPServer::handleClient(std::shared_ptr<Connection> conn) {
     char buffer[4096];
-    
+
     while (running_) {
-        int bytes_received = recv(client.socket, buffer, sizeof(buffer) - 1, 0);
-        
+        int bytes_received = recv(conn->info.socket, buffer, sizeof(buffer), 0);
+
         if (bytes_received <= 0) {
             // Connection closed or error
             break;
         }
-        
-        buffer[bytes_received] = '\0';
-        std::string message(buffer, bytes_received);
-        
-        // Call message handler if set
-        if (message_handler_) {
-            message_handler_(client, message);
+
+        if (!receive(*conn, buffer, static_cast<size_t>(bytes_received))) {
+            atlas::utils::Logger::instance().warn(
+                "[TCPServer] Malformed or oversized message from " + conn->info.address);
+            break;
         }
     }
-    
-    // Remove client from list
-    {
-        std::lock_guard<std::mutex> lock(clients_mutex_);
-        clients_.erase(
-            std::remove_if(clients_.begin(), clients_.end(),
-                [&](const ClientConnection& c) { return c.socket == client.socket; }),
-            clients_.end()
-        );
-    }
-    
-    atlas::utils::Logger::instance().info(
-        "[TCPServer] Client disconnected: " + client.address + ":" + std::to_string(client.port));
-    closeSocket(client.socket);
-}
-
-int TCPServer::getClientCount() const {
-    std::lock_guard<std::mutex> lock(clients_mutex_);
-    return static_cast<int>(clients_.size());
-}
 
-std::vector<ClientConnection> TCPServer::getClients() const {
-    std::lock_guard<std::mutex> lock(clients_mutex_);
-    return clients_;
-}
-
-void TCPServer::setMessageHandler(MessageHandler handler) {
-    message_handler_ = handler;
-}
-
-bool TCPServer::sendToClient(const ClientConnection& client, const std::string& data) {
-    int bytes_sent = send(client.socket, data.c_str(), static_cast<int>(data.size()), 0);
-    return bytes_sent > 0;
+    removeConnection(*conn);
 }
 
-void TCPServer::broadcastToAll(const std::string& data) {
-    std::lock_guard<std::mutex> lock(clients_mutex_);
-    for (const auto& client : clients_) {
-        send(client.socket, data.c_str(), static_cast<int>(data.size()), 0);
-    }
-}
+#endif
 
 void TCPServer::closeSocket(socket_t socket) {
     if (socket != INVALID_SOCKET) {
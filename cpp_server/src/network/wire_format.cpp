@@ -0,0 +1,190 @@
+#include "network/wire_format.h"
+#include <cmath>
+#include <cstring>
+
+namespace atlas {
+namespace network {
+
+namespace {
+// Largest quantised magnitude we emit; keeps llround well-defined
+constexpr double kMaxQuantized = 4.0e18;
+}
+
+// ---------------------------------------------------------------------------
+// WireWriter
+// ---------------------------------------------------------------------------
+
+void WireWriter::writeVarUInt(uint64_t v) {
+    while (v >= 0x80) {
+        buffer_.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    buffer_.push_back(static_cast<char>(v));
+}
+
+void WireWriter::writeVarInt(int64_t v) {
+    // Zig-zag so small negative numbers stay short
+    writeVarUInt((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+void WireWriter::writeFloat(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    for (int i = 0; i < 4; ++i) {
+        buffer_.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+    }
+}
+
+void WireWriter::writeQuantized(float v, float step) {
+    double q = std::isfinite(v) ? static_cast<double>(v) / step : 0.0;
+    if (q > kMaxQuantized) q = kMaxQuantized;
+    if (q < -kMaxQuantized) q = -kMaxQuantized;
+    writeVarInt(std::llround(q));
+}
+
+void WireWriter::writeString(const std::string& s) {
+    writeVarUInt(s.size());
+    buffer_.append(s);
+}
+
+// ---------------------------------------------------------------------------
+// WireReader
+// ---------------------------------------------------------------------------
+
+bool WireReader::readU8(uint8_t& v) {
+    if (failed_ || pos_ >= size_) return fail();
+    v = static_cast<uint8_t>(data_[pos_++]);
+    return true;
+}
+
+bool WireReader::readVarUInt(uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!readU8(byte)) return false;
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return fail();   // more than 10 bytes
+}
+
+bool WireReader::readVarInt(int64_t& v) {
+    uint64_t u;
+    if (!readVarUInt(u)) return false;
+    v = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+    return true;
+}
+
+bool WireReader::readFloat(float& v) {
+    if (failed_ || size_ - pos_ < 4) return fail();
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; ++i) {
+        bits |= static_cast<uint32_t>(static_cast<uint8_t>(data_[pos_ + i])) << (8 * i);
+    }
+    pos_ += 4;
+    std::memcpy(&v, &bits, sizeof(v));
+    return true;
+}
+
+bool WireReader::readQuantized(float& v, float step) {
+    int64_t q;
+    if (!readVarInt(q)) return false;
+    v = static_cast<float>(static_cast<double>(q) * step);
+    return true;
+}
+
+bool WireReader::readString(std::string& s) {
+    uint64_t len;
+    if (!readVarUInt(len)) return false;
+    if (len > size_ - pos_) return fail();
+    s.assign(data_ + pos_, static_cast<size_t>(len));
+    pos_ += static_cast<size_t>(len);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Framing
+// ---------------------------------------------------------------------------
+
+void appendFrame(std::string& out, MessageType type, const char* payload, size_t size) {
+    WireWriter header;
+    header.writeU8(kWireMagic);
+    header.writeU8(kWireVersion);
+    header.writeVarUInt(static_cast<uint64_t>(type));
+    header.writeVarUInt(size);
+    out.reserve(out.size() + header.size() + size);
+    out.append(header.data());
+    out.append(payload, size);
+}
+
+std::string encodeFrame(MessageType type, const std::string& payload) {
+    std::string out;
+    appendFrame(out, type, payload.data(), payload.size());
+    return out;
+}
+
+FrameStatus decodeFrame(const char* data, size_t size, WireFrame& frame, size_t& consumed) {
+    consumed = 0;
+    WireReader reader(data, size);
+    uint8_t magic, version;
+    uint64_t type, length;
+    if (!reader.readU8(magic)) return FrameStatus::INCOMPLETE;
+    if (magic != kWireMagic) return FrameStatus::INVALID;
+    if (!reader.readU8(version)) return FrameStatus::INCOMPLETE;
+    if (version != kWireVersion) return FrameStatus::INVALID;
+    if (!reader.readVarUInt(type) || !reader.readVarUInt(length)) {
+        // A varint can only be cut short by the end of the buffer unless
+        // it is over-long, which no writer produces
+        return reader.position() >= size ? FrameStatus::INCOMPLETE : FrameStatus::INVALID;
+    }
+    // ERROR is the last enumerator
+    if (type > static_cast<uint64_t>(MessageType::ERROR)) return FrameStatus::INVALID;
+    if (length > reader.remaining()) return FrameStatus::INCOMPLETE;
+
+    frame.version = version;
+    frame.type = static_cast<MessageType>(type);
+    frame.payload.assign(data + reader.position(), static_cast<size_t>(length));
+    consumed = reader.position() + static_cast<size_t>(length);
+    return FrameStatus::OK;
+}
+
+bool extractMessages(std::string& buffer, std::vector<std::string>& out,
+                     size_t max_message_bytes) {
+    size_t pos = 0;
+    bool ok = true;
+    while (pos < buffer.size()) {
+        const char* start = buffer.data() + pos;
+        size_t available = buffer.size() - pos;
+
+        if (static_cast<uint8_t>(*start) == kWireMagic) {
+            WireFrame frame;
+            size_t consumed = 0;
+            FrameStatus status = decodeFrame(start, available, frame, consumed);
+            if (status == FrameStatus::INVALID) { ok = false; break; }
+            if (status == FrameStatus::INCOMPLETE) {
+                if (available > max_message_bytes) ok = false;
+                break;
+            }
+            if (consumed > max_message_bytes) { ok = false; break; }
+            out.emplace_back(start, consumed);
+            pos += consumed;
+            continue;
+        }
+
+        size_t newline = buffer.find('\n', pos);
+        if (newline == std::string::npos) {
+            if (available > max_message_bytes) ok = false;
+            break;
+        }
+        size_t end = newline;
+        if (end > pos && buffer[end - 1] == '\r') --end;
+        if (end - pos > max_message_bytes) { ok = false; break; }
+        if (end > pos) out.emplace_back(start, end - pos);
+        pos = newline + 1;
+    }
+    buffer.erase(0, pos);
+    return ok;
+}
+
+} // namespace network
+} // namespace atlas
@@ -1,14 +1,8 @@
 #include "server.h"
 #include "game_session.h"
-#include "systems/movement_system.h"
-#include "systems/combat_system.h"
-#include "systems/ai_system.h"
-#include "systems/targeting_system.h"
-#include "systems/capacitor_system.h"
-#include "systems/shield_recharge_system.h"
-#include "systems/weapon_system.h"
-#include "systems/station_system.h"
+#include "systems/server_system_set.h"
 #include "utils/logger.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <thread>
@@ -31,6 +25,18 @@ Server::Server(const std::string& config_path)
     
     // Initialize game world
     game_world_ = std::make_unique<ecs::World>();
+
+    world_saver_.setCompletionHandler([this](const data::AsyncWorldSaver::Result& result) {
+        metrics_.recordSaveCompleted(result.duration_ms, result.success);
+        if (profiler_.isEnabled()) {
+            // On the saver's thread, so it shows as its own track in traces
+            int64_t end_ns = utils::TickProfiler::nowNs();
+            profiler_.record("Persistence::writeSave", utils::ProfileCategory::Persistence,
+                             end_ns - static_cast<int64_t>(result.duration_ms * 1.0e6), end_ns);
+        }
+        // The journal records this save covers can go
+        if (result.success) world_journal_.commitSnapshot(result.tag);
+    });
 }
 
 Server::~Server() {
@@ -39,30 +45,18 @@ Server::~Server() {
 
 void Server::initializeGameWorld() {
     // Initialize game systems in order
-    game_world_->addSystem(std::make_unique<systems::CapacitorSystem>(game_world_.get()));
-    game_world_->addSystem(std::make_unique<systems::ShieldRechargeSystem>(game_world_.get()));
-    game_world_->addSystem(std::make_unique<systems::AISystem>(game_world_.get()));
-
-    auto targeting = std::make_unique<systems::TargetingSystem>(game_world_.get());
-    targeting_system_ = targeting.get();
-    game_world_->addSystem(std::move(targeting));
-
-    auto station = std::make_unique<systems::StationSystem>(game_world_.get());
-    station_system_ = station.get();
-    game_world_->addSystem(std::move(station));
-
-    auto movement = std::make_unique<systems::MovementSystem>(game_world_.get());
-    movement_system_ = movement.get();
-    game_world_->addSystem(std::move(movement));
-    game_world_->addSystem(std::make_unique<systems::WeaponSystem>(game_world_.get()));
-    auto combat = std::make_unique<systems::CombatSystem>(game_world_.get());
-    combat_system_ = combat.get();
-    game_world_->addSystem(std::move(combat));
+    systems::ServerSystems set = systems::addServerSystems(game_world_.get());
+    targeting_system_ = set.targeting;
+    station_system_ = set.station;
+    movement_system_ = set.movement;
+    combat_system_ = set.combat;
+    interest_system_ = set.interest;
+    replication_system_ = set.replication;
     
     auto& log = utils::Logger::instance();
     log.info("Game world initialized with " +
              std::to_string(game_world_->getEntityCount()) + " entities");
-    log.info("Systems: Capacitor, ShieldRecharge, AI, Targeting, Station, Movement, Weapon, Combat");
+    log.info(std::string("Systems: ") + systems::serverSystemNames());
 
     // Initialize PCG manager with deterministic universe seed.
     // This seed anchors all procedural generation (ships, stations,
@@ -90,6 +84,9 @@ bool Server::initialize() {
         config_->port, 
         config_->max_connections
     );
+    tcp_server_->setIoThreads(config_->network_io_threads);
+    tcp_server_->setMaxOutboundBytes(
+        static_cast<size_t>(config_->max_send_queue_kb) * 1024);
     
     if (!tcp_server_->initialize()) {
         log.error("Failed to initialize TCP server");
@@ -142,6 +139,9 @@ bool Server::initialize() {
     
     // Initialize game world and systems
     initializeGameWorld();
+    profiler_.setEnabled(config_->tick_profiler);
+    profiler_.setWindowTicks(static_cast<size_t>(std::max(config_->profiler_window_ticks, 1)));
+    game_world_->setProfiler(&profiler_);
     
     // Initialize game session (bridges networking ↔ ECS world)
     game_session_ = std::make_unique<GameSession>(
@@ -150,15 +150,16 @@ bool Server::initialize() {
     game_session_->setStationSystem(station_system_);
     game_session_->setMovementSystem(movement_system_);
     game_session_->setCombatSystem(combat_system_);
+    game_session_->setInterestManagementSystem(interest_system_);
+    game_session_->setSnapshotReplicationSystem(replication_system_);
     game_session_->setPCGManager(&pcg_manager_);
+    game_session_->setProfiler(&profiler_);
     game_session_->initialize();
     
     // Load persisted world state if enabled
     if (config_->persistent_world) {
-        std::string filepath = config_->save_path + "/world_state.json";
-        std::ifstream check(filepath);
-        if (check.good()) {
-            check.close();
+        std::string filepath = findSaveFile();
+        if (!filepath.empty()) {
             log.info("Loading persistent world from " + filepath + "...");
             if (loadWorld()) {
                 log.info("Persistent world loaded successfully (" +
@@ -169,6 +170,13 @@ bool Server::initialize() {
         } else {
             log.info("No saved world found, starting fresh");
         }
+
+        // Replays changes made since that save, then keeps journaling
+        if (config_->journal_interval_seconds > 0 && ensureSaveDirectory() &&
+            world_journal_.open(game_world_.get(), journalFilePath())) {
+            log.info("Change journal: " + journalFilePath() + " every " +
+                     std::to_string(config_->journal_interval_seconds) + "s");
+        }
     }
 
     // Initialize server console
@@ -202,6 +210,7 @@ void Server::stop() {
     running_ = false;
     
     // Save world state on shutdown if persistent world is enabled
+    // (saveWorld waits for a background save still in flight)
     if (config_->persistent_world) {
         log.info("Saving world state before shutdown...");
         if (saveWorld()) {
@@ -209,6 +218,7 @@ void Server::stop() {
         } else {
             log.error("Failed to save world state on shutdown");
         }
+        world_journal_.close();
     }
     
     console_.shutdown();
@@ -236,37 +246,75 @@ void Server::mainLoop() {
     
     auto last_save_time = std::chrono::steady_clock::now();
     const auto save_interval = std::chrono::seconds(config_->save_interval_seconds);
+    auto last_journal_time = last_save_time;
+    const auto journal_interval = std::chrono::seconds(config_->journal_interval_seconds);
+    const uint64_t journal_max_bytes = static_cast<uint64_t>(config_->journal_max_mb) * 1024 * 1024;
+    profiler_.setThreadName("tick");
     
     while (running_) {
         auto frame_start = std::chrono::steady_clock::now();
+        int64_t tick_start_ns = utils::TickProfiler::nowNs();
         metrics_.recordTickStart();
         
+        // Apply client messages received since the last tick
+        {
+            utils::ProfileScope zone(&profiler_, "Network::dispatchMessages",
+                                     utils::ProfileCategory::Network);
+            tcp_server_->dispatchMessages();
+        }
+        
         // Update game world (ECS systems)
         game_world_->update(tick_duration);
         
         // Broadcast state to all connected clients
         if (game_session_) {
+            utils::ProfileScope zone(&profiler_, "GameSession::update",
+                                     utils::ProfileCategory::Network);
             game_session_->update(tick_duration);
         }
         
         // Update Steam callbacks
         if (config_->use_steam && steam_auth_) {
+            utils::ProfileScope zone(&profiler_, "Steam::update", utils::ProfileCategory::Other);
             updateSteam();
         }
         
         // Update console (process user input)
         console_.update();
         
-        // Auto-save check
+        // Auto-save check: capture here, write in the background.
+        // A journal past its size limit brings the next save forward.
         if (config_->auto_save && config_->persistent_world) {
             auto now = std::chrono::steady_clock::now();
-            if (now - last_save_time >= save_interval) {
-                saveWorld();
+            bool journal_full = world_journal_.isOpen() &&
+                                world_journal_.getJournalBytes() >= journal_max_bytes &&
+                                !world_saver_.isBusy();
+            if (now - last_save_time >= save_interval || journal_full) {
+                utils::ProfileScope zone(&profiler_, "Persistence::captureSave",
+                                         utils::ProfileCategory::Persistence);
+                saveWorldAsync();
                 last_save_time = now;
+                last_journal_time = now;
+            }
+        }
+
+        // Between saves, journal what changed
+        if (world_journal_.isOpen()) {
+            auto now = std::chrono::steady_clock::now();
+            if (now - last_journal_time >= journal_interval) {
+                utils::ProfileScope zone(&profiler_, "Persistence::flushJournal",
+                                         utils::ProfileCategory::Persistence);
+                flushJournal();
+                last_journal_time = now;
             }
         }
 
         metrics_.recordTickEnd();
+        if (profiler_.isEnabled()) {
+            profiler_.record("Server::tick", utils::ProfileCategory::Tick,
+                             tick_start_ns, utils::TickProfiler::nowNs());
+        }
+        profiler_.endTick();
 
         // Update entity / player counters and emit periodic stats
         metrics_.setEntityCount(static_cast<int>(game_world_->getEntityCount()));
@@ -315,8 +363,7 @@ bool Server::kickPlayer(const std::string& character_name) {
     return false;
 }
 
-bool Server::saveWorld() {
-    // Ensure save directory exists
+bool Server::ensureSaveDirectory() {
     struct stat st;
     if (stat(config_->save_path.c_str(), &st) != 0) {
         int ret;
@@ -331,15 +378,85 @@ bool Server::saveWorld() {
             return false;
         }
     }
+    return true;
+}
+
+data::SaveFormat Server::saveFormat() const {
+    if (config_->save_format == "json") {
+        return config_->compress_saves ? data::SaveFormat::CompressedJson
+                                       : data::SaveFormat::Json;
+    }
+    return data::SaveFormat::Binary;
+}
+
+std::string Server::saveFilePath() const {
+    switch (saveFormat()) {
+        case data::SaveFormat::Binary:         return config_->save_path + "/world_state.bin";
+        case data::SaveFormat::CompressedJson: return config_->save_path + "/world_state.json.gz";
+        case data::SaveFormat::Json:           break;
+    }
+    return config_->save_path + "/world_state.json";
+}
+
+std::string Server::journalFilePath() const {
+    return config_->save_path + "/world_state.journal";
+}
+
+void Server::flushJournal() {
+    if (!world_journal_.flush(game_world_.get())) {
+        utils::Logger::instance().error("[Journal] Flush failed; changes will be retried");
+    }
+    const auto& stats = world_journal_.getLastFlush();
+    metrics_.recordJournalFlush(stats.duration_ms, stats.bytes);
+}
+
+std::string Server::findSaveFile() const {
+    // Older servers wrote JSON; loading it and saving again migrates the world
+    const std::string candidates[] = {
+        saveFilePath(),
+        config_->save_path + "/world_state.bin",
+        config_->save_path + "/world_state.json.gz",
+        config_->save_path + "/world_state.json",
+    };
+    for (const auto& path : candidates) {
+        std::ifstream check(path);
+        if (check.good()) return path;
+    }
+    return "";
+}
+
+bool Server::saveWorld() {
+    // Never race the background saver for the same file
+    world_saver_.waitIdle();
+    if (!ensureSaveDirectory()) return false;
 
-    std::string filepath = config_->save_path + "/world_state.json";
     utils::Logger::instance().info("[AutoSave] Saving world state...");
-    return world_persistence_.saveWorld(game_world_.get(), filepath);
+    auto start = std::chrono::steady_clock::now();
+    uint64_t mark = world_journal_.isOpen() ? world_journal_.beginSnapshot(game_world_.get()) : 0;
+    bool ok = world_persistence_.saveWorldAs(game_world_.get(), saveFilePath(), saveFormat());
+    if (ok) world_journal_.commitSnapshot(mark);
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    // The whole save ran on this thread
+    metrics_.recordSaveStall(ms);
+    metrics_.recordSaveCompleted(ms, ok);
+    return ok;
+}
+
+bool Server::saveWorldAsync() {
+    if (!ensureSaveDirectory()) return false;
+
+    uint64_t mark = world_journal_.isOpen() ? world_journal_.beginSnapshot(game_world_.get()) : 0;
+    double stall_ms = world_saver_.requestSave(game_world_.get(), saveFilePath(),
+                                               saveFormat(), mark);
+    metrics_.recordSaveStall(stall_ms);
+    return true;
 }
 
 bool Server::loadWorld() {
-    std::string filepath = config_->save_path + "/world_state.json";
-    return world_persistence_.loadWorld(game_world_.get(), filepath);
+    std::string filepath = findSaveFile();
+    if (filepath.empty()) return false;
+    return world_persistence_.loadWorldFile(game_world_.get(), filepath);
 }
 
 } // namespace atlas
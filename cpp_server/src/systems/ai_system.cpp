@@ -1,5 +1,6 @@
 #include "systems/ai_system.h"
 #include "systems/combat_system.h"
+#include "systems/spatial_hash_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
 #include <cmath>
@@ -13,6 +14,35 @@ AISystem::AISystem(ecs::World* world)
     : System(world) {
 }
 
+template<typename... Required, typename Fn>
+void AISystem::forEachNearby(const components::Position& pos, float range, Fn&& fn) {
+    if (spatial_index_) {
+        spatial_index_->forEachInRadius(pos.x, pos.y, pos.z, range,
+            [&](ecs::Entity* candidate, float dist_sq) {
+                if ((candidate->hasComponent<Required>() && ...)) {
+                    fn(candidate, std::sqrt(dist_sq));
+                }
+            });
+        return;
+    }
+
+    for (ecs::Entity* candidate : world_->query<components::Position, Required...>()) {
+        auto* other = candidate->getComponent<components::Position>();
+        float dx = other->x - pos.x;
+        float dy = other->y - pos.y;
+        float dz = other->z - pos.z;
+        float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (distance <= range) fn(candidate, distance);
+    }
+}
+
+namespace {
+// Deterministic winner for equal scores, independent of search order
+bool preferOnTie(const ecs::Entity* candidate, const ecs::Entity* best) {
+    return !best || candidate->getSlot() < best->getSlot();
+}
+} // namespace
+
 void AISystem::update(float delta_time) {
     // Get all entities with AI component
     auto entities = world_->getEntities<components::AI, components::Position, components::Velocity>();
@@ -117,7 +147,7 @@ void AISystem::approachBehavior(ecs::Entity* entity) {
         return;
     }
     
-    auto* target = world_->getEntity(ai->target_entity_id);
+    auto* target = world_->resolve(ai->target_handle, ai->target_entity_id);
     if (!target) {
         ai->state = components::AI::State::Idle;
         ai->target_entity_id.clear();
@@ -175,7 +205,7 @@ void AISystem::orbitBehavior(ecs::Entity* entity) {
         return;
     }
     
-    auto* target = world_->getEntity(ai->target_entity_id);
+    auto* target = world_->resolve(ai->target_handle, ai->target_entity_id);
     if (!target) {
         ai->state = components::AI::State::Idle;
         ai->target_entity_id.clear();
@@ -240,7 +270,7 @@ void AISystem::fleeBehavior(ecs::Entity* entity) {
         return;
     }
     
-    auto* target = world_->getEntity(ai->target_entity_id);
+    auto* target = world_->resolve(ai->target_handle, ai->target_entity_id);
     if (!target) {
         ai->state = components::AI::State::Idle;
         ai->target_entity_id.clear();
@@ -278,18 +308,16 @@ ecs::Entity* AISystem::selectTarget(ecs::Entity* entity) {
     auto* pos = entity->getComponent<components::Position>();
     if (!ai || !pos) return nullptr;
     
-    auto all_entities = world_->getEntities<components::Position>();
-    
     ecs::Entity* best_target = nullptr;
     float best_score = std::numeric_limits<float>::max();
     
     // Get our faction for standing checks
     auto* our_faction = entity->getComponent<components::Faction>();
     
-    for (auto* candidate : all_entities) {
-        if (candidate == entity) continue;
+    forEachNearby(*pos, ai->awareness_range, [&](ecs::Entity* candidate, float distance) {
+        if (candidate == entity) return;
         if (!candidate->hasComponent<components::Player>() &&
-            !candidate->hasComponent<components::AI>()) continue;
+            !candidate->hasComponent<components::AI>()) return;
         
         // Skip entities with positive faction standing (friendly)
         if (our_faction) {
@@ -299,24 +327,14 @@ ecs::Entity* AISystem::selectTarget(ecs::Entity* entity) {
                 float standing = their_standings->getStandingWith(
                     entity->getId(), "",
                     our_faction->faction_name);
-                if (standing > 0.0f) continue;  // friendly — do not target
+                if (standing > 0.0f) return;  // friendly — do not target
             } else if (their_faction) {
                 // Check faction-to-faction standing
                 auto it = our_faction->standings.find(their_faction->faction_name);
-                if (it != our_faction->standings.end() && it->second > 0.0f) continue;
+                if (it != our_faction->standings.end() && it->second > 0.0f) return;
             }
         }
         
-        auto* target_pos = candidate->getComponent<components::Position>();
-        if (!target_pos) continue;
-        
-        float dx = target_pos->x - pos->x;
-        float dy = target_pos->y - pos->y;
-        float dz = target_pos->z - pos->z;
-        float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
-        
-        if (distance > ai->awareness_range) continue;
-        
         float score = 0.0f;
         
         switch (ai->target_selection) {
@@ -352,11 +370,12 @@ ecs::Entity* AISystem::selectTarget(ecs::Entity* entity) {
             }
         }
         
-        if (score < best_score) {
+        if (score < best_score ||
+            (score == best_score && preferOnTie(candidate, best_target))) {
             best_score = score;
             best_target = candidate;
         }
-    }
+    });
     
     return best_target;
 }
@@ -393,7 +412,7 @@ void AISystem::miningBehavior(ecs::Entity* entity) {
         return;
     }
     
-    auto* target = world_->getEntity(ai->target_entity_id);
+    auto* target = world_->resolve(ai->target_handle, ai->target_entity_id);
     if (!target) {
         ai->state = components::AI::State::Idle;
         ai->target_entity_id.clear();
@@ -439,30 +458,19 @@ ecs::Entity* AISystem::findNearestDeposit(ecs::Entity* entity) {
     auto* pos = entity->getComponent<components::Position>();
     if (!ai || !pos) return nullptr;
     
-    auto all_entities = world_->getEntities<components::Position, components::MineralDeposit>();
-    
     ecs::Entity* nearest = nullptr;
     float best_dist = std::numeric_limits<float>::max();
     
-    for (auto* candidate : all_entities) {
+    forEachNearby<components::MineralDeposit>(*pos, ai->awareness_range,
+            [&](ecs::Entity* candidate, float dist) {
         auto* dep = candidate->getComponent<components::MineralDeposit>();
-        if (!dep || dep->isDepleted()) continue;
-        
-        auto* dep_pos = candidate->getComponent<components::Position>();
-        if (!dep_pos) continue;
+        if (dep->isDepleted()) return;
         
-        float dx = dep_pos->x - pos->x;
-        float dy = dep_pos->y - pos->y;
-        float dz = dep_pos->z - pos->z;
-        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
-        
-        if (dist > ai->awareness_range) continue;
-        
-        if (dist < best_dist) {
+        if (dist < best_dist || (dist == best_dist && preferOnTie(candidate, nearest))) {
             best_dist = dist;
             nearest = candidate;
         }
-    }
+    });
     
     return nearest;
 }
@@ -473,7 +481,7 @@ ecs::Entity* AISystem::findMostProfitableDeposit(ecs::Entity* entity) {
     if (!ai || !pos) return nullptr;
 
     // Look for a SupplyDemand entity to get market prices
-    auto sd_entities = world_->getEntities<components::SupplyDemand>();
+    const auto& sd_entities = world_->query<components::SupplyDemand>();
     components::SupplyDemand* sd = nullptr;
     for (auto* e : sd_entities) {
         sd = e->getComponent<components::SupplyDemand>();
@@ -485,24 +493,14 @@ ecs::Entity* AISystem::findMostProfitableDeposit(ecs::Entity* entity) {
         return findNearestDeposit(entity);
     }
 
-    auto all_entities = world_->getEntities<components::Position, components::MineralDeposit>();
-
     ecs::Entity* best = nullptr;
     float best_score = -1.0f;
 
-    for (auto* candidate : all_entities) {
+    forEachNearby<components::MineralDeposit>(*pos, ai->awareness_range,
+            [&](ecs::Entity* candidate, float dist) {
         auto* dep = candidate->getComponent<components::MineralDeposit>();
-        if (!dep || dep->isDepleted()) continue;
-
-        auto* dep_pos = candidate->getComponent<components::Position>();
-        if (!dep_pos) continue;
+        if (dep->isDepleted()) return;
 
-        float dx = dep_pos->x - pos->x;
-        float dy = dep_pos->y - pos->y;
-        float dz = dep_pos->z - pos->z;
-        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
-
-        if (dist > ai->awareness_range) continue;
         if (dist < 1.0f) dist = 1.0f;  // avoid division by zero
 
         // Look up market price for this mineral type
@@ -514,11 +512,11 @@ ecs::Entity* AISystem::findMostProfitableDeposit(ecs::Entity* entity) {
 
         // Score = price / distance  (higher is better)
         float score = price / dist;
-        if (score > best_score) {
+        if (score > best_score || (score == best_score && preferOnTie(candidate, best))) {
             best_score = score;
             best = candidate;
         }
-    }
+    });
 
     // If no scored deposits found (all prices zero), fall back to nearest
     if (!best) {
@@ -540,7 +538,7 @@ void AISystem::haulingBehavior(ecs::Entity* entity) {
         return;
     }
 
-    auto* station = world_->getEntity(ai->haul_station_id);
+    auto* station = world_->resolve(ai->haul_station_handle, ai->haul_station_id);
     if (!station) {
         ai->state = components::AI::State::Idle;
         ai->haul_station_id.clear();
@@ -577,7 +575,7 @@ void AISystem::haulingBehavior(ecs::Entity* entity) {
     auto* intent = entity->getComponent<components::SimNPCIntent>();
     if (inv && !inv->items.empty()) {
         // Look for SupplyDemand to price the ore
-        auto sd_entities = world_->getEntities<components::SupplyDemand>();
+        const auto& sd_entities = world_->query<components::SupplyDemand>();
         components::SupplyDemand* sd = nullptr;
         for (auto* e : sd_entities) {
             sd = e->getComponent<components::SupplyDemand>();
@@ -619,19 +617,11 @@ ecs::Entity* AISystem::findAttackerOfFriendly(ecs::Entity* entity) {
     auto* our_faction = entity->getComponent<components::Faction>();
     if (!ai || !pos || !our_faction) return nullptr;
 
-    auto candidates = world_->getEntities<components::Position, components::DamageEvent>();
-
-    for (auto* friendly : candidates) {
-        if (friendly == entity) continue;
-
-        auto* f_pos = friendly->getComponent<components::Position>();
-        if (!f_pos) continue;
-
-        float dx = f_pos->x - pos->x;
-        float dy = f_pos->y - pos->y;
-        float dz = f_pos->z - pos->z;
-        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
-        if (dist > ai->awareness_range) continue;
+    // Friendlies under attack within awareness range, in deterministic order
+    std::vector<ecs::Entity*> friendlies;
+    forEachNearby<components::DamageEvent>(*pos, ai->awareness_range,
+            [&](ecs::Entity* friendly, float) {
+        if (friendly == entity) return;
 
         // Check if this entity is friendly to us
         auto* their_standings = friendly->getComponent<components::Standings>();
@@ -648,16 +638,21 @@ ecs::Entity* AISystem::findAttackerOfFriendly(ecs::Entity* entity) {
             }
         }
 
-        if (!is_friendly) continue;
+        if (!is_friendly) return;
 
-        // This entity is friendly and has damage events — find who is attacking them
+        // This entity is friendly and has damage events
         auto* dmg = friendly->getComponent<components::DamageEvent>();
-        if (!dmg || dmg->recent_hits.empty()) continue;
+        if (dmg->recent_hits.empty()) return;
+        friendlies.push_back(friendly);
+    });
+    std::sort(friendlies.begin(), friendlies.end(),
+              [](const ecs::Entity* a, const ecs::Entity* b) { return a->getSlot() < b->getSlot(); });
 
+    for (auto* friendly : friendlies) {
         // The most recent hit's source is the attacker
         // DamageEvent doesn't store attacker id, so look for nearby hostiles
         // targeting this friendly entity
-        auto all_ai = world_->getEntities<components::AI, components::Position>();
+        const auto& all_ai = world_->query<components::AI, components::Position>();
         for (auto* potential_attacker : all_ai) {
             if (potential_attacker == entity) continue;
             auto* atk_ai = potential_attacker->getComponent<components::AI>();
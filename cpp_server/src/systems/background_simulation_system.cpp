@@ -8,6 +8,7 @@ namespace systems {
 
 BackgroundSimulationSystem::BackgroundSimulationSystem(ecs::World* world)
     : System(world) {
+    writes<components::SimStarSystemState>();
 }
 
 void BackgroundSimulationSystem::update(float delta_time) {
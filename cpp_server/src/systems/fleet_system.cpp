@@ -432,7 +432,7 @@ void FleetSystem::applyFleetBonuses(const std::string& fleet_id) {
     for (const auto& [booster_type, booster_eid] : it->second.active_boosters) {
         auto bonuses = getBonusesForType(booster_type);
         for (auto& [eid, info] : it->second.members) {
-            auto* entity = world_->getEntity(eid);
+            auto* entity = world_->resolve(info.handle, eid);
             if (!entity) continue;
 
             auto* fm = entity->getComponent<components::FleetMembership>();
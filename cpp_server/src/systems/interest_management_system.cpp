@@ -1,4 +1,5 @@
 #include "systems/interest_management_system.h"
+#include "systems/spatial_hash_system.h"
 #include "ecs/world.h"
 #include "ecs/entity.h"
 #include "components/game_components.h"
@@ -23,6 +24,7 @@ void InterestManagementSystem::registerClient(int client_id,
     auto& cd = client_data_[client_id];
     cd.player_entity_id = entity_id;
     cd.relevant_entities.clear();
+    cd.relevant_list.clear();
     cd.force_visible.clear();
     // The player's own entity is always force-visible
     cd.force_visible.insert(entity_id);
@@ -52,14 +54,33 @@ void InterestManagementSystem::removeForceVisible(int client_id,
 // Per-tick update
 // ------------------------------------------------------------------
 
+void InterestManagementSystem::addRelevant(ClientData& cd, const ecs::Entity* entity,
+                                           RelevanceTier tier) {
+    if (cd.relevant_entities.insert(entity->getId()).second) {
+        cd.relevant_list.push_back({entity->getHandle(), tier});
+    }
+}
+
+RelevanceTier InterestManagementSystem::tierFor(float dist_sq) const {
+    if (dist_sq < near_range_ * near_range_) return RelevanceTier::Near;
+    if (dist_sq < mid_range_ * mid_range_) return RelevanceTier::Mid;
+    return RelevanceTier::Far;
+}
+
 void InterestManagementSystem::update(float /*delta_time*/) {
     const float far_sq = far_range_ * far_range_;
 
+    if (spatial_index_) {
+        updateWithIndex();
+        return;
+    }
+
     auto all_entities = world_->getAllEntities();
 
     for (auto& kv : client_data_) {
         ClientData& cd = kv.second;
         cd.relevant_entities.clear();
+        cd.relevant_list.clear();
 
         // Look up the player entity position
         const auto* player = world_->getEntity(cd.player_entity_id);
@@ -77,7 +98,7 @@ void InterestManagementSystem::update(float /*delta_time*/) {
 
             // Force-visible entities always included
             if (cd.force_visible.count(eid)) {
-                cd.relevant_entities.insert(eid);
+                addRelevant(cd, entity, RelevanceTier::Near);
                 continue;
             }
 
@@ -85,7 +106,7 @@ void InterestManagementSystem::update(float /*delta_time*/) {
             const auto* pos = entity->getComponent<components::Position>();
             if (!pos) {
                 // Entities without position are always included (e.g. system-level entities)
-                cd.relevant_entities.insert(eid);
+                addRelevant(cd, entity, RelevanceTier::Near);
                 continue;
             }
 
@@ -95,12 +116,49 @@ void InterestManagementSystem::update(float /*delta_time*/) {
             float dist_sq = dx * dx + dy * dy + dz * dz;
 
             if (dist_sq < far_sq) {
-                cd.relevant_entities.insert(eid);
+                addRelevant(cd, entity, tierFor(dist_sq));
             }
         }
     }
 }
 
+void InterestManagementSystem::updateWithIndex() {
+    // Entities without position are always included (e.g. system-level
+    // entities); find them once rather than once per client.
+    positionless_.clear();
+    for (const auto* entity : world_->getAllEntities()) {
+        if (!entity->hasComponent<components::Position>()) {
+            positionless_.push_back(entity);
+        }
+    }
+
+    const float far_sq = far_range_ * far_range_;
+    for (auto& kv : client_data_) {
+        ClientData& cd = kv.second;
+        cd.relevant_entities.clear();
+        cd.relevant_list.clear();
+
+        const auto* player = world_->getEntity(cd.player_entity_id);
+        if (!player) continue;
+        const auto* player_pos = player->getComponent<components::Position>();
+        if (!player_pos) continue;
+
+        // Force-visible entities always included
+        for (const auto& eid : cd.force_visible) {
+            if (const auto* entity = world_->getEntity(eid)) {
+                addRelevant(cd, entity, RelevanceTier::Near);
+            }
+        }
+        for (const auto* entity : positionless_) {
+            addRelevant(cd, entity, RelevanceTier::Near);
+        }
+        spatial_index_->forEachInRadius(player_pos->x, player_pos->y, player_pos->z, far_range_,
+            [&](ecs::Entity* entity, float dist_sq) {
+                if (dist_sq < far_sq) addRelevant(cd, entity, tierFor(dist_sq));
+            });
+    }
+}
+
 // ------------------------------------------------------------------
 // Queries
 // ------------------------------------------------------------------
@@ -112,6 +170,12 @@ InterestManagementSystem::getRelevantEntities(int client_id) const {
     return it->second.relevant_entities;
 }
 
+const std::vector<RelevantEntity>*
+InterestManagementSystem::getRelevantList(int client_id) const {
+    auto it = client_data_.find(client_id);
+    return it != client_data_.end() ? &it->second.relevant_list : nullptr;
+}
+
 bool InterestManagementSystem::isRelevant(int client_id,
                                            const std::string& entity_id) const {
     auto it = client_data_.find(client_id);
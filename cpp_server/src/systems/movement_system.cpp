@@ -26,7 +26,7 @@ void MovementSystem::setCollisionZones(const std::vector<CollisionZone>& zones)
 void MovementSystem::update(float delta_time) {
     // Process movement commands (orbit, approach, warp)
     for (auto it = movement_commands_.begin(); it != movement_commands_.end(); ) {
-        auto* entity = world_->getEntity(it->first);
+        auto* entity = world_->resolve(it->second.entity_handle, it->first);
         if (!entity) {
             it = movement_commands_.erase(it);
             continue;
@@ -42,7 +42,7 @@ void MovementSystem::update(float delta_time) {
         auto& cmd = it->second;
 
         if (cmd.type == MovementCommand::Type::Approach) {
-            auto* target = world_->getEntity(cmd.target_id);
+            auto* target = world_->resolve(cmd.target_handle, cmd.target_id);
             if (target) {
                 auto* tpos = target->getComponent<components::Position>();
                 if (tpos) {
@@ -66,7 +66,7 @@ void MovementSystem::update(float delta_time) {
                 }
             }
         } else if (cmd.type == MovementCommand::Type::Orbit) {
-            auto* target = world_->getEntity(cmd.target_id);
+            auto* target = world_->resolve(cmd.target_handle, cmd.target_id);
             if (target) {
                 auto* tpos = target->getComponent<components::Position>();
                 if (tpos) {
@@ -13,10 +13,29 @@ ServerPerformanceMonitorSystem::ServerPerformanceMonitorSystem(ecs::World* world
 
 void ServerPerformanceMonitorSystem::update(float delta_time) {
     auto entities = world_->getEntities<components::ServerPerformanceMetrics>();
+
+    // Samples of the last tick the profiler closed, consumed once
+    const std::vector<utils::ProfileTickSample>* samples = nullptr;
+    if (profiler_ && profiler_->getTickCount() != profiled_tick_) {
+        profiled_tick_ = profiler_->getTickCount();
+        samples = &profiler_->getLastTick();
+    }
+
     for (auto* entity : entities) {
         auto* metrics = entity->getComponent<components::ServerPerformanceMetrics>();
         if (!metrics) continue;
 
+        if (samples) {
+            for (const auto& sample : *samples) {
+                float ms = static_cast<float>(sample.ms);
+                if (sample.category == utils::ProfileCategory::System) {
+                    applySystemTiming(*metrics, sample.name, ms);
+                } else if (sample.category == utils::ProfileCategory::Tick) {
+                    applyTickComplete(*metrics, ms, static_cast<int>(world_->getEntityCount()));
+                }
+            }
+        }
+
         // Recompute budget utilization
         if (metrics->tick_budget_ms > 0.0f && metrics->total_ticks > 0) {
             metrics->budget_utilization = metrics->avg_tick_time_ms / metrics->tick_budget_ms;
@@ -69,7 +88,14 @@ bool ServerPerformanceMonitorSystem::recordSystemTiming(const std::string& entit
     auto* metrics = entity->getComponent<components::ServerPerformanceMetrics>();
     if (!metrics) return false;
 
-    auto* timing = metrics->findTiming(system_name);
+    applySystemTiming(*metrics, system_name, time_ms);
+    return true;
+}
+
+void ServerPerformanceMonitorSystem::applySystemTiming(components::ServerPerformanceMetrics& metrics,
+                                                       const std::string& system_name,
+                                                       float time_ms) {
+    auto* timing = metrics.findTiming(system_name);
     if (!timing) {
         components::ServerPerformanceMetrics::SystemTiming st;
         st.system_name = system_name;
@@ -77,7 +103,7 @@ bool ServerPerformanceMonitorSystem::recordSystemTiming(const std::string& entit
         st.avg_time_ms = time_ms;
         st.max_time_ms = time_ms;
         st.sample_count = 1;
-        metrics->system_timings.push_back(st);
+        metrics.system_timings.push_back(st);
     } else {
         timing->last_time_ms = time_ms;
         timing->max_time_ms = std::max(timing->max_time_ms, time_ms);
@@ -86,7 +112,6 @@ bool ServerPerformanceMonitorSystem::recordSystemTiming(const std::string& entit
         float n = static_cast<float>(timing->sample_count);
         timing->avg_time_ms = timing->avg_time_ms * ((n - 1.0f) / n) + time_ms / n;
     }
-    return true;
 }
 
 bool ServerPerformanceMonitorSystem::recordTickComplete(const std::string& entity_id,
@@ -98,25 +123,29 @@ bool ServerPerformanceMonitorSystem::recordTickComplete(const std::string& entit
     auto* metrics = entity->getComponent<components::ServerPerformanceMetrics>();
     if (!metrics) return false;
 
-    metrics->total_ticks++;
-    metrics->total_tick_time_ms = total_time_ms;
-    metrics->entity_count = entity_count;
-    metrics->max_tick_time_ms = std::max(metrics->max_tick_time_ms, total_time_ms);
+    applyTickComplete(*metrics, total_time_ms, entity_count);
+    return true;
+}
+
+void ServerPerformanceMonitorSystem::applyTickComplete(components::ServerPerformanceMetrics& metrics,
+                                                       float total_time_ms, int entity_count) {
+    metrics.total_ticks++;
+    metrics.total_tick_time_ms = total_time_ms;
+    metrics.entity_count = entity_count;
+    metrics.max_tick_time_ms = std::max(metrics.max_tick_time_ms, total_time_ms);
 
     // Running average
-    float n = static_cast<float>(metrics->total_ticks);
-    metrics->avg_tick_time_ms = metrics->avg_tick_time_ms * ((n - 1.0f) / n) + total_time_ms / n;
+    float n = static_cast<float>(metrics.total_ticks);
+    metrics.avg_tick_time_ms = metrics.avg_tick_time_ms * ((n - 1.0f) / n) + total_time_ms / n;
 
-    if (total_time_ms > metrics->tick_budget_ms) {
-        metrics->ticks_over_budget++;
+    if (total_time_ms > metrics.tick_budget_ms) {
+        metrics.ticks_over_budget++;
     }
 
     // Update budget utilization
-    if (metrics->tick_budget_ms > 0.0f) {
-        metrics->budget_utilization = metrics->avg_tick_time_ms / metrics->tick_budget_ms;
+    if (metrics.tick_budget_ms > 0.0f) {
+        metrics.budget_utilization = metrics.avg_tick_time_ms / metrics.tick_budget_ms;
     }
-
-    return true;
 }
 
 float ServerPerformanceMonitorSystem::getAverageTickTime(const std::string& entity_id) const {
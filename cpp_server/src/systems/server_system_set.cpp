@@ -0,0 +1,68 @@
+#include "systems/server_system_set.h"
+#include "systems/spatial_hash_system.h"
+#include "systems/capacitor_system.h"
+#include "systems/shield_recharge_system.h"
+#include "systems/ai_system.h"
+#include "systems/targeting_system.h"
+#include "systems/station_system.h"
+#include "systems/movement_system.h"
+#include "systems/weapon_system.h"
+#include "systems/combat_system.h"
+#include "systems/interest_management_system.h"
+#include "systems/snapshot_replication_system.h"
+#include <memory>
+
+namespace atlas {
+namespace systems {
+
+ServerSystems addServerSystems(ecs::World* world) {
+    ServerSystems set;
+
+    // Shared broadphase first so every consumer sees this tick's positions
+    auto spatial = std::make_unique<SpatialHashSystem>(world);
+    set.spatial_hash = spatial.get();
+    world->addSystem(std::move(spatial));
+
+    world->addSystem(std::make_unique<CapacitorSystem>(world));
+    world->addSystem(std::make_unique<ShieldRechargeSystem>(world));
+    auto ai = std::make_unique<AISystem>(world);
+    ai->setSpatialIndex(set.spatial_hash);
+    world->addSystem(std::move(ai));
+
+    auto targeting = std::make_unique<TargetingSystem>(world);
+    targeting->setSpatialIndex(set.spatial_hash);
+    set.targeting = targeting.get();
+    world->addSystem(std::move(targeting));
+
+    auto station = std::make_unique<StationSystem>(world);
+    set.station = station.get();
+    world->addSystem(std::move(station));
+
+    auto movement = std::make_unique<MovementSystem>(world);
+    set.movement = movement.get();
+    world->addSystem(std::move(movement));
+    world->addSystem(std::make_unique<WeaponSystem>(world));
+    auto combat = std::make_unique<CombatSystem>(world);
+    set.combat = combat.get();
+    world->addSystem(std::move(combat));
+
+    // Replication last: relevance sets, then this tick's snapshot
+    auto interest = std::make_unique<InterestManagementSystem>(world);
+    interest->setSpatialIndex(set.spatial_hash);
+    set.interest = interest.get();
+    world->addSystem(std::move(interest));
+    auto replication = std::make_unique<SnapshotReplicationSystem>(world);
+    replication->setInterestManagement(set.interest);
+    set.replication = replication.get();
+    world->addSystem(std::move(replication));
+
+    return set;
+}
+
+const char* serverSystemNames() {
+    return "SpatialHash, Capacitor, ShieldRecharge, AI, Targeting, Station, Movement, Weapon, "
+           "Combat, InterestManagement, SnapshotReplication";
+}
+
+} // namespace systems
+} // namespace atlas
@@ -1,21 +1,35 @@
 #include "systems/snapshot_replication_system.h"
+#include "systems/interest_management_system.h"
 #include "ecs/world.h"
 #include "ecs/entity.h"
 #include "components/game_components.h"
-#include <sstream>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <iterator>
 
 namespace atlas {
 namespace systems {
 
 SnapshotReplicationSystem::SnapshotReplicationSystem(ecs::World* world)
     : System(world) {
+    reads<components::Position>();
+    reads<components::Velocity>();
+    reads<components::Health>();
+    reads<components::Capacitor>();
+    reads<components::Ship>();
+    reads<components::Faction>();
+    history_.resize(64);
 }
 
 void SnapshotReplicationSystem::update(float /*delta_time*/) {
-    // No per-tick work needed; deltas are computed on demand in
-    // buildDeltaUpdate / buildFullUpdate.
+    captureSnapshot();
+}
+
+void SnapshotReplicationSystem::setHistorySize(size_t frames) {
+    // Ring positions depend on the size; clients whose baselines are no
+    // longer covered fall back to a full scan
+    history_.assign(frames > 0 ? frames : 1, Frame{});
 }
 
 // ------------------------------------------------------------------
@@ -59,152 +73,446 @@ bool SnapshotReplicationSystem::hasCapacitorChanged(
 }
 
 // ------------------------------------------------------------------
-// buildDeltaUpdate
+// Shared change detection
 // ------------------------------------------------------------------
 
-std::string SnapshotReplicationSystem::buildDeltaUpdate(int client_id,
-                                                         uint64_t sequence) {
-    auto& snap_map = client_snapshots_[client_id];
+uint32_t SnapshotReplicationSystem::diffEntity(const ecs::Entity* entity,
+                                               const EntitySnapshot& prev) const {
+    auto* pos  = entity->getComponent<components::Position>();
+    auto* vel  = entity->getComponent<components::Velocity>();
+    auto* hp   = entity->getComponent<components::Health>();
+    auto* cap  = entity->getComponent<components::Capacitor>();
+    auto* ship = entity->getComponent<components::Ship>();
+    auto* fac  = entity->getComponent<components::Faction>();
 
-    std::ostringstream json;
-    json << "{\"type\":\"state_update\",\"data\":{"
-         << "\"sequence\":" << sequence << ","
-         << "\"timestamp\":"
-         << std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::steady_clock::now().time_since_epoch()).count()
-         << ",\"delta\":true,\"entities\":[";
+    // First capture of this entity → full state
+    bool full = !prev.has_data;
+    uint32_t mask = 0;
 
-    auto entities = world_->getAllEntities();
-    bool first = true;
-
-    for (const auto* entity : entities) {
-        const std::string& eid = entity->getId();
-        auto& prev = snap_map[eid];  // inserts default if missing
+    if (pos && (full || hasPositionChanged(prev, pos->x, pos->y,
+                                           pos->z, pos->rotation))) {
+        mask |= kFieldPosition;
+    }
+    if (vel && (full || hasVelocityChanged(prev, vel->vx, vel->vy, vel->vz))) {
+        mask |= kFieldVelocity;
+    }
+    if (hp && (full || hasHealthChanged(prev, hp->shield_hp,
+                                        hp->armor_hp, hp->hull_hp,
+                                        hp->shield_max,
+                                        hp->armor_max,
+                                        hp->hull_max))) {
+        mask |= kFieldHealth;
+    }
+    if (cap && (full || hasCapacitorChanged(prev, cap->capacitor,
+                                            cap->capacitor_max))) {
+        mask |= kFieldCapacitor;
+    }
+    if (ship && (full || prev.ship_type != ship->ship_type
+                      || prev.ship_name != ship->ship_name)) {
+        mask |= kFieldShip;
+    }
+    if (fac && (full || prev.faction_name != fac->faction_name)) {
+        mask |= kFieldFaction;
+    }
+    return mask;
+}
 
-        auto* pos  = entity->getComponent<components::Position>();
-        auto* vel  = entity->getComponent<components::Velocity>();
-        auto* hp   = entity->getComponent<components::Health>();
-        auto* cap  = entity->getComponent<components::Capacitor>();
+void SnapshotReplicationSystem::commitEntity(const ecs::Entity* entity, uint32_t mask,
+                                             EntitySnapshot& prev) const {
+    if (mask & kFieldPosition) {
+        auto* pos = entity->getComponent<components::Position>();
+        prev.x = pos->x;
+        prev.y = pos->y;
+        prev.z = pos->z;
+        prev.rotation = pos->rotation;
+    }
+    if (mask & kFieldVelocity) {
+        auto* vel = entity->getComponent<components::Velocity>();
+        prev.vx = vel->vx;
+        prev.vy = vel->vy;
+        prev.vz = vel->vz;
+    }
+    if (mask & kFieldHealth) {
+        auto* hp = entity->getComponent<components::Health>();
+        prev.shield_hp  = hp->shield_hp;
+        prev.armor_hp   = hp->armor_hp;
+        prev.hull_hp    = hp->hull_hp;
+        prev.shield_max = hp->shield_max;
+        prev.armor_max  = hp->armor_max;
+        prev.hull_max   = hp->hull_max;
+    }
+    if (mask & kFieldCapacitor) {
+        auto* cap = entity->getComponent<components::Capacitor>();
+        prev.capacitor     = cap->capacitor;
+        prev.capacitor_max = cap->capacitor_max;
+    }
+    if (mask & kFieldShip) {
         auto* ship = entity->getComponent<components::Ship>();
-        auto* fac  = entity->getComponent<components::Faction>();
-
-        // First time this entity is seen by this client → full state
-        bool full = !prev.has_data;
-
-        // Detect field-level changes
-        bool pos_changed = false;
-        bool vel_changed = false;
-        bool hp_changed  = false;
-        bool cap_changed = false;
-        bool ship_changed = false;
-        bool fac_changed  = false;
-
-        if (pos) {
-            pos_changed = full || hasPositionChanged(prev, pos->x, pos->y,
-                                                     pos->z, pos->rotation);
-        }
-        if (vel) {
-            vel_changed = full || hasVelocityChanged(prev, vel->vx, vel->vy,
-                                                     vel->vz);
-        }
-        if (hp) {
-            hp_changed = full || hasHealthChanged(prev, hp->shield_hp,
-                                                  hp->armor_hp, hp->hull_hp,
-                                                  hp->shield_max,
-                                                  hp->armor_max,
-                                                  hp->hull_max);
-        }
-        if (cap) {
-            cap_changed = full || hasCapacitorChanged(prev, cap->capacitor,
-                                                      cap->capacitor_max);
+        prev.ship_type = ship->ship_type;
+        prev.ship_name = ship->ship_name;
+    }
+    if (mask & kFieldFaction) {
+        prev.faction_name = entity->getComponent<components::Faction>()->faction_name;
+    }
+    prev.has_data = true;
+}
+
+// ------------------------------------------------------------------
+// Snapshot capture
+// ------------------------------------------------------------------
+
+uint32_t SnapshotReplicationSystem::captureSnapshot() {
+    const uint32_t id = ++latest_id_;
+    Frame& frame = history_[id % history_.size()];
+    frame.id = id;
+    frame.changed.clear();
+
+    for (const auto* entity : world_->getAllEntities()) {
+        const ecs::EntityHandle handle = entity->getHandle();
+        if (handle.index >= slots_.size()) slots_.resize(handle.index + 1);
+        Slot& slot = slots_[handle.index];
+
+        if (!slot.live || slot.generation != handle.generation) {
+            // New entity (or a new occupant of a reused slot)
+            slot.state = EntitySnapshot{};
+            slot.entity_id = entity->getId();
+            slot.generation = handle.generation;
+            slot.live = true;
+            slot.present = 0;
+            slot.spawned_at = id;
+            std::fill(std::begin(slot.changed_at), std::end(slot.changed_at), 0u);
         }
-        if (ship) {
-            ship_changed = full || (prev.ship_type != ship->ship_type)
-                                || (prev.ship_name != ship->ship_name);
+        slot.seen = id;
+
+        uint32_t present = 0;
+        if (entity->getComponent<components::Position>())  present |= kFieldPosition;
+        if (entity->getComponent<components::Velocity>())  present |= kFieldVelocity;
+        if (entity->getComponent<components::Health>())    present |= kFieldHealth;
+        if (entity->getComponent<components::Capacitor>()) present |= kFieldCapacitor;
+        if (entity->getComponent<components::Ship>())      present |= kFieldShip;
+        if (entity->getComponent<components::Faction>())   present |= kFieldFaction;
+
+        // A component that was just added counts as changed
+        uint32_t mask = diffEntity(entity, slot.state) | (present & ~slot.present);
+        slot.present = present;
+        if (mask != 0) {
+            commitEntity(entity, mask, slot.state);
+            for (int f = 0; f < kFieldGroups; ++f) {
+                if (mask & (1u << f)) slot.changed_at[f] = id;
+            }
         }
-        if (fac) {
-            fac_changed = full || (prev.faction_name != fac->faction_name);
+        if (mask != 0 || slot.spawned_at == id) {
+            frame.changed.push_back(handle.index);
         }
+    }
 
-        // Skip entity entirely if nothing changed
-        if (!pos_changed && !vel_changed && !hp_changed &&
-            !cap_changed && !ship_changed && !fac_changed) {
-            continue;
-        }
+    for (auto& slot : slots_) {
+        if (slot.live && slot.seen != id) slot.live = false;
+    }
+    return id;
+}
 
-        if (!first) json << ",";
-        first = false;
+uint32_t SnapshotReplicationSystem::changedSince(const Slot& slot, uint32_t baseline) const {
+    uint32_t mask = 0;
+    for (int f = 0; f < kFieldGroups; ++f) {
+        if (slot.changed_at[f] > baseline) mask |= 1u << f;
+    }
+    return mask & slot.present;
+}
 
-        json << "{\"id\":\"" << eid << "\"";
+template<typename Fn>
+void SnapshotReplicationSystem::forEachChangedSlot(uint32_t baseline, Fn&& fn) {
+    // The ring must still hold every snapshot after the baseline
+    bool covered = baseline != 0 && latest_id_ - baseline <= history_.size();
+    for (uint32_t id = baseline + 1; covered && id <= latest_id_; ++id) {
+        covered = history_[id % history_.size()].id == id;
+    }
 
-        if (pos_changed && pos) {
-            json << ",\"pos\":{\"x\":" << pos->x
-                 << ",\"y\":" << pos->y
-                 << ",\"z\":" << pos->z
-                 << ",\"rot\":" << pos->rotation << "}";
-            prev.x = pos->x;
-            prev.y = pos->y;
-            prev.z = pos->z;
-            prev.rotation = pos->rotation;
+    if (!covered) {
+        for (uint32_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].live) fn(i);
         }
-        if (vel_changed && vel) {
-            json << ",\"vel\":{\"vx\":" << vel->vx
-                 << ",\"vy\":" << vel->vy
-                 << ",\"vz\":" << vel->vz << "}";
-            prev.vx = vel->vx;
-            prev.vy = vel->vy;
-            prev.vz = vel->vz;
+    } else if (latest_id_ - baseline == 1) {
+        for (uint32_t i : history_[latest_id_ % history_.size()].changed) fn(i);
+    } else {
+        // Lagging client: union of the missed change lists
+        ++visit_stamp_;
+        for (uint32_t id = baseline + 1; id <= latest_id_; ++id) {
+            for (uint32_t i : history_[id % history_.size()].changed) {
+                if (slots_[i].visit == visit_stamp_) continue;
+                slots_[i].visit = visit_stamp_;
+                fn(i);
+            }
         }
-        if (hp_changed && hp) {
-            json << ",\"health\":{"
-                 << "\"shield\":" << hp->shield_hp
-                 << ",\"armor\":" << hp->armor_hp
-                 << ",\"hull\":" << hp->hull_hp
-                 << ",\"max_shield\":" << hp->shield_max
-                 << ",\"max_armor\":" << hp->armor_max
-                 << ",\"max_hull\":" << hp->hull_max << "}";
-            prev.shield_hp  = hp->shield_hp;
-            prev.armor_hp   = hp->armor_hp;
-            prev.hull_hp    = hp->hull_hp;
-            prev.shield_max = hp->shield_max;
-            prev.armor_max  = hp->armor_max;
-            prev.hull_max   = hp->hull_max;
-        }
-        if (cap_changed && cap) {
-            json << ",\"capacitor\":{"
-                 << "\"current\":" << cap->capacitor
-                 << ",\"max\":" << cap->capacitor_max << "}";
-            prev.capacitor     = cap->capacitor;
-            prev.capacitor_max = cap->capacitor_max;
-        }
-        if (ship_changed && ship) {
-            json << ",\"ship_type\":\"" << ship->ship_type << "\"";
-            json << ",\"ship_name\":\"" << ship->ship_name << "\"";
-            prev.ship_type = ship->ship_type;
-            prev.ship_name = ship->ship_name;
+    }
+}
+
+uint32_t SnapshotReplicationSystem::beginClientUpdate(ClientState& client, bool reset) {
+    if (reset) client.baseline = 0;
+
+    // A client that already has the latest snapshot is asking for the
+    // next tick's state
+    if (latest_id_ == 0 || client.baseline == latest_id_) captureSnapshot();
+
+    uint32_t previous = client.baseline;
+    client.baseline = latest_id_;
+    return previous;
+}
+
+template<typename Emit>
+void SnapshotReplicationSystem::collectClientUpdate(int client_id, bool reset, Emit&& emit) {
+    ClientState& client = clients_[client_id];
+    const uint32_t baseline = beginClientUpdate(client, reset);
+    last_spawned_.clear();
+    last_despawned_.clear();
+
+    const std::vector<RelevantEntity>* relevant =
+        interest_ ? interest_->getRelevantList(client_id) : nullptr;
+    if (!relevant) {
+        // Every entity, from the shared change lists
+        client.known.clear();
+        forEachChangedSlot(baseline, [&](uint32_t i) {
+            Slot& slot = slots_[i];
+            if (!slot.live) return;
+            bool introduce = baseline < slot.spawned_at;
+            uint32_t mask = introduce ? slot.present : changedSince(slot, baseline);
+            if (mask != 0) emit(slot, i, mask, introduce);
+        });
+        return;
+    }
+
+    if (reset) client.known.clear();
+    const uint32_t build = ++client.builds;
+    // Stagger the slow tiers so clients don't all refresh on the same tick
+    const uint32_t phase = build + static_cast<uint32_t>(client_id);
+    const bool mid_due = phase % mid_interval_ == 0;
+    const bool far_due = phase % far_interval_ == 0;
+
+    for (const RelevantEntity& rel : *relevant) {
+        const uint32_t i = rel.handle.index;
+        if (i >= slots_.size()) continue;
+        Slot& slot = slots_[i];
+        // Created after the last capture: picked up next time
+        if (!slot.live || slot.generation != rel.handle.generation) continue;
+
+        KnownEntity& known = client.known[i];
+        if (known.generation != slot.generation) {
+            // Slot reused since the client last saw it: the old entity is gone
+            if (known.generation != 0) last_despawned_.push_back(known.entity_id);
+            known.entity_id = slot.entity_id;
+            known.generation = slot.generation;
+            known.sent_at = latest_id_;
+            known.seen = build;
+            last_spawned_.push_back(slot.entity_id);
+            if (slot.present != 0) emit(slot, i, slot.present, true);
+            continue;
         }
-        if (fac_changed && fac) {
-            json << ",\"faction\":\"" << fac->faction_name << "\"";
-            prev.faction_name = fac->faction_name;
+
+        known.seen = build;
+        bool due = rel.tier == RelevanceTier::Near ||
+                   (rel.tier == RelevanceTier::Mid ? mid_due : far_due);
+        if (!due) continue;
+        uint32_t mask = changedSince(slot, known.sent_at);
+        known.sent_at = latest_id_;
+        if (mask != 0) emit(slot, i, mask, false);
+    }
+
+    // Out of range, or destroyed
+    for (auto it = client.known.begin(); it != client.known.end();) {
+        if (it->second.seen != build) {
+            last_despawned_.push_back(std::move(it->second.entity_id));
+            it = client.known.erase(it);
+        } else {
+            ++it;
         }
+    }
+}
+
+void SnapshotReplicationSystem::setTierIntervals(uint32_t mid, uint32_t far) {
+    mid_interval_ = mid > 0 ? mid : 1;
+    far_interval_ = far > 0 ? far : 1;
+}
 
-        json << "}";
-        prev.has_data = true;
+// ------------------------------------------------------------------
+// Per-entity blocks (shared across clients)
+// ------------------------------------------------------------------
+
+const std::string& SnapshotReplicationSystem::jsonBlock(Slot& slot, uint32_t mask,
+                                                        bool introduce) {
+    // Cacheable: the full state, or exactly what changed in the latest snapshot
+    CachedBlock* cache = introduce ? &slot.json_full
+                       : mask == changedSince(slot, latest_id_ - 1) ? &slot.json_delta
+                       : nullptr;
+    if (cache && cache->snapshot == latest_id_) return cache->bytes;
+
+    const EntitySnapshot& st = slot.state;
+    json_block_.str(std::string());
+    json_block_.clear();
+    json_block_ << "{\"id\":\"" << slot.entity_id << "\"";
+
+    if (mask & kFieldPosition) {
+        json_block_ << ",\"pos\":{\"x\":" << st.x
+                    << ",\"y\":" << st.y
+                    << ",\"z\":" << st.z
+                    << ",\"rot\":" << st.rotation << "}";
+    }
+    if (mask & kFieldVelocity) {
+        json_block_ << ",\"vel\":{\"vx\":" << st.vx
+                    << ",\"vy\":" << st.vy
+                    << ",\"vz\":" << st.vz << "}";
+    }
+    if (mask & kFieldHealth) {
+        json_block_ << ",\"health\":{"
+                    << "\"shield\":" << st.shield_hp
+                    << ",\"armor\":" << st.armor_hp
+                    << ",\"hull\":" << st.hull_hp
+                    << ",\"max_shield\":" << st.shield_max
+                    << ",\"max_armor\":" << st.armor_max
+                    << ",\"max_hull\":" << st.hull_max << "}";
     }
+    if (mask & kFieldCapacitor) {
+        json_block_ << ",\"capacitor\":{"
+                    << "\"current\":" << st.capacitor
+                    << ",\"max\":" << st.capacitor_max << "}";
+    }
+    if (mask & kFieldShip) {
+        json_block_ << ",\"ship_type\":\"" << st.ship_type << "\"";
+        json_block_ << ",\"ship_name\":\"" << st.ship_name << "\"";
+    }
+    if (mask & kFieldFaction) {
+        json_block_ << ",\"faction\":\"" << st.faction_name << "\"";
+    }
+    json_block_ << "}";
+    ++blocks_encoded_;
 
-    json << "]}}";
-    return json.str();
+    std::string& out = cache ? cache->bytes : json_scratch_;
+    out = json_block_.str();
+    if (cache) cache->snapshot = latest_id_;
+    return out;
+}
+
+const std::string& SnapshotReplicationSystem::binaryBlock(Slot& slot, uint32_t index,
+                                                          uint32_t mask, bool introduce) {
+    CachedBlock* cache = introduce ? &slot.binary_full
+                       : mask == changedSince(slot, latest_id_ - 1) ? &slot.binary_delta
+                       : nullptr;
+    if (cache && cache->snapshot == latest_id_) return cache->bytes;
+
+    const EntitySnapshot& st = slot.state;
+    network::WireWriter& block = binary_block_;
+    block.clear();
+    block.writeVarUInt(index + 1);
+    block.writeU8(static_cast<uint8_t>(mask | (introduce ? static_cast<uint32_t>(kWireNewEntity) : 0u)));
+    if (introduce) block.writeString(slot.entity_id);
+
+    if (mask & kFieldPosition) {
+        block.writeQuantized(st.x, network::kWirePositionStep);
+        block.writeQuantized(st.y, network::kWirePositionStep);
+        block.writeQuantized(st.z, network::kWirePositionStep);
+        block.writeQuantized(st.rotation, network::kWireRotationStep);
+    }
+    if (mask & kFieldVelocity) {
+        block.writeQuantized(st.vx, network::kWireVelocityStep);
+        block.writeQuantized(st.vy, network::kWireVelocityStep);
+        block.writeQuantized(st.vz, network::kWireVelocityStep);
+    }
+    if (mask & kFieldHealth) {
+        block.writeQuantized(st.shield_hp, network::kWireStatStep);
+        block.writeQuantized(st.armor_hp, network::kWireStatStep);
+        block.writeQuantized(st.hull_hp, network::kWireStatStep);
+        block.writeQuantized(st.shield_max, network::kWireStatStep);
+        block.writeQuantized(st.armor_max, network::kWireStatStep);
+        block.writeQuantized(st.hull_max, network::kWireStatStep);
+    }
+    if (mask & kFieldCapacitor) {
+        block.writeQuantized(st.capacitor, network::kWireStatStep);
+        block.writeQuantized(st.capacitor_max, network::kWireStatStep);
+    }
+    if (mask & kFieldShip) {
+        block.writeString(st.ship_type);
+        block.writeString(st.ship_name);
+    }
+    if (mask & kFieldFaction) {
+        block.writeString(st.faction_name);
+    }
+    ++blocks_encoded_;
+
+    if (!cache) return block.data();
+    cache->bytes = block.data();
+    cache->snapshot = latest_id_;
+    return cache->bytes;
 }
 
 // ------------------------------------------------------------------
-// buildFullUpdate
+// Per-client updates
 // ------------------------------------------------------------------
 
+std::string SnapshotReplicationSystem::buildJson(int client_id, uint64_t sequence,
+                                                 bool reset) {
+    json_body_.clear();
+    collectClientUpdate(client_id, reset,
+        [&](Slot& slot, uint32_t /*index*/, uint32_t mask, bool introduce) {
+            if (!json_body_.empty()) json_body_ += ',';
+            json_body_ += jsonBlock(slot, mask, introduce);
+        });
+
+    std::ostringstream json;
+    json << "{\"type\":\"state_update\",\"data\":{"
+         << "\"sequence\":" << sequence << ","
+         << "\"timestamp\":"
+         << std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count()
+         << ",\"delta\":true,\"entities\":[" << json_body_ << "]}}";
+    return json.str();
+}
+
+std::string SnapshotReplicationSystem::buildBinary(int client_id, uint64_t sequence,
+                                                   bool reset) {
+    // Entities go into their own buffer first so the count can lead
+    network::WireWriter& body = binary_body_;
+    body.clear();
+    uint64_t count = 0;
+
+    collectClientUpdate(client_id, reset,
+        [&](Slot& slot, uint32_t index, uint32_t mask, bool introduce) {
+            const std::string& block = binaryBlock(slot, index, mask, introduce);
+            body.writeBytes(block.data(), block.size());
+            ++count;
+        });
+
+    network::WireWriter& payload = binary_payload_;
+    payload.clear();
+    payload.writeVarUInt(sequence);
+    payload.writeVarUInt(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count()));
+    payload.writeU8(static_cast<uint8_t>(kWireDelta | (reset ? kWireReset : 0)));
+    payload.writeVarUInt(count);
+    payload.writeBytes(body.data().data(), body.size());
+
+    return network::encodeFrame(network::MessageType::STATE_UPDATE, payload.data());
+}
+
+std::string SnapshotReplicationSystem::buildDeltaUpdate(int client_id,
+                                                         uint64_t sequence) {
+    return buildJson(client_id, sequence, false);
+}
+
 std::string SnapshotReplicationSystem::buildFullUpdate(int client_id,
                                                         uint64_t sequence) {
-    // Clear tracked state so everything is treated as new
-    client_snapshots_[client_id].clear();
-    return buildDeltaUpdate(client_id, sequence);
+    // Forget the baseline so everything is treated as new
+    return buildJson(client_id, sequence, true);
+}
+
+std::string SnapshotReplicationSystem::buildDeltaUpdateBinary(int client_id,
+                                                               uint64_t sequence) {
+    return buildBinary(client_id, sequence, false);
+}
+
+std::string SnapshotReplicationSystem::buildFullUpdateBinary(int client_id,
+                                                              uint64_t sequence) {
+    // The client drops its net-id table when it sees the reset flag
+    return buildBinary(client_id, sequence, true);
 }
 
 // ------------------------------------------------------------------
@@ -212,13 +520,26 @@ std::string SnapshotReplicationSystem::buildFullUpdate(int client_id,
 // ------------------------------------------------------------------
 
 void SnapshotReplicationSystem::clearClient(int client_id) {
-    client_snapshots_.erase(client_id);
+    clients_.erase(client_id);
+}
+
+uint32_t SnapshotReplicationSystem::getClientBaseline(int client_id) const {
+    auto it = clients_.find(client_id);
+    return it != clients_.end() ? it->second.baseline : 0;
 }
 
 size_t SnapshotReplicationSystem::getTrackedEntityCount(int client_id) const {
-    auto it = client_snapshots_.find(client_id);
-    if (it == client_snapshots_.end()) return 0;
-    return it->second.size();
+    auto it = clients_.find(client_id);
+    if (it == clients_.end()) return 0;
+    if (interest_ && interest_->getRelevantList(client_id)) return it->second.known.size();
+
+    uint32_t baseline = it->second.baseline;
+    if (baseline == 0) return 0;
+    size_t count = 0;
+    for (const auto& slot : slots_) {
+        if (slot.live && slot.present != 0 && slot.spawned_at <= baseline) ++count;
+    }
+    return count;
 }
 
 } // namespace systems
@@ -2,80 +2,224 @@
 #include "ecs/world.h"
 #include "ecs/entity.h"
 #include "components/game_components.h"
+#include <chrono>
 #include <cmath>
 
 namespace atlas {
 namespace systems {
 
+namespace {
+constexpr uint32_t kNoEntry = 0xFFFFFFFFu;
+
+int32_t floorDiv(int32_t v, int32_t d) {
+    int32_t q = v / d;
+    return (v % d != 0 && v < 0) ? q - 1 : q;
+}
+}
+
 SpatialHashSystem::SpatialHashSystem(ecs::World* world)
     : System(world) {
 }
 
 void SpatialHashSystem::setCellSize(float size) {
-    if (size > 0.0f) cell_size_ = size;
+    if (size > 0.0f && size != cell_size_) {
+        cell_size_ = size;
+        rebuild_ = true;
+    }
 }
 
-SpatialHashSystem::CellKey SpatialHashSystem::cellKeyFor(float x, float y, float z) const {
-    return {
-        static_cast<int32_t>(std::floor(x / cell_size_)),
-        static_cast<int32_t>(std::floor(y / cell_size_)),
-        static_cast<int32_t>(std::floor(z / cell_size_))
-    };
+void SpatialHashSystem::setLevelCount(int count) {
+    count = std::max(1, std::min(count, kMaxLevels));
+    if (count != level_count_) {
+        level_count_ = count;
+        rebuild_ = true;
+    }
 }
 
-void SpatialHashSystem::update(float /*delta_time*/) {
-    grid_.clear();
-    entity_cells_.clear();
-    indexed_count_ = 0;
+float SpatialHashSystem::getLevelCellSize(int level) const {
+    float size = cell_size_;
+    for (int i = 0; i < level; ++i) size *= static_cast<float>(kLevelRatio);
+    return size;
+}
 
-    auto entities = world_->getEntities();
-    for (auto* entity : entities) {
-        auto* pos = entity->getComponent<components::Position>();
-        if (!pos) continue;
+int SpatialHashSystem::getOccupiedCellCount(int level) const {
+    if (level < 0 || level >= level_count_) return 0;
+    return static_cast<int>(levels_[level].size());
+}
 
-        CellKey key = cellKeyFor(pos->x, pos->y, pos->z);
-        const std::string& id = entity->getId();
-        grid_[key].push_back(id);
-        entity_cells_[id] = key;
-        ++indexed_count_;
+int32_t SpatialHashSystem::coordFor(float v, int level) const {
+    // Coarser levels are derived from level-0 coordinates so an entity's
+    // cells on every level always nest.
+    double c = std::floor(static_cast<double>(v) / cell_size_);
+    c = std::max(c, static_cast<double>(std::numeric_limits<int32_t>::min()));
+    c = std::min(c, static_cast<double>(std::numeric_limits<int32_t>::max()));
+    int32_t coord = static_cast<int32_t>(c);
+    for (int i = 0; i < level; ++i) coord = floorDiv(coord, kLevelRatio);
+    return coord;
+}
+
+SpatialHashSystem::CellKey SpatialHashSystem::cellKeyFor(float x, float y, float z,
+                                                         int level) const {
+    return {coordFor(x, level), coordFor(y, level), coordFor(z, level)};
+}
+
+SpatialHashSystem::CellKey SpatialHashSystem::coarsen(const CellKey& key, int level) {
+    CellKey out = key;
+    for (int i = 0; i < level; ++i) {
+        out = {floorDiv(out.cx, kLevelRatio), floorDiv(out.cy, kLevelRatio),
+               floorDiv(out.cz, kLevelRatio)};
     }
+    return out;
 }
 
-std::vector<std::string> SpatialHashSystem::queryNear(
-    float x, float y, float z, float radius) const {
+void SpatialHashSystem::link(int level, const CellKey& key, uint32_t index) {
+    std::vector<uint32_t>& cell = levels_[level][key];
+    entries_[index].cell[level] = key;
+    entries_[index].cell_pos[level] = static_cast<uint32_t>(cell.size());
+    cell.push_back(index);
+}
 
-    std::vector<std::string> result;
-    const float radiusSq = radius * radius;
+void SpatialHashSystem::unlink(int level, const CellKey& key, uint32_t pos) {
+    auto it = levels_[level].find(key);
+    std::vector<uint32_t>& cell = it->second;
+    uint32_t moved = cell.back();
+    cell[pos] = moved;
+    entries_[moved].cell_pos[level] = pos;
+    cell.pop_back();
+    if (cell.empty()) levels_[level].erase(it);
+}
 
-    // How many cells does the radius span?
-    int span = static_cast<int>(std::ceil(radius / cell_size_));
+void SpatialHashSystem::insertEntry(ecs::Entity* entity, float x, float y, float z) {
+    uint32_t index = static_cast<uint32_t>(entries_.size());
+    Entry entry;
+    entry.handle = entity->getHandle();
+    entry.x = x;
+    entry.y = y;
+    entry.z = z;
+    entry.seen = stamp_;
+    entries_.push_back(entry);
 
-    CellKey centre = cellKeyFor(x, y, z);
+    CellKey key = cellKeyFor(x, y, z);
+    for (int level = 0; level < level_count_; ++level) {
+        link(level, coarsen(key, level), index);
+    }
 
-    for (int dx = -span; dx <= span; ++dx) {
-        for (int dy = -span; dy <= span; ++dy) {
-            for (int dz = -span; dz <= span; ++dz) {
-                CellKey probe{centre.cx + dx, centre.cy + dy, centre.cz + dz};
-                auto it = grid_.find(probe);
-                if (it == grid_.end()) continue;
-
-                for (const auto& id : it->second) {
-                    auto* entity = world_->getEntity(id);
-                    if (!entity) continue;
-                    auto* pos = entity->getComponent<components::Position>();
-                    if (!pos) continue;
-
-                    float ex = pos->x - x;
-                    float ey = pos->y - y;
-                    float ez = pos->z - z;
-                    if (ex * ex + ey * ey + ez * ez <= radiusSq) {
-                        result.push_back(id);
-                    }
-                }
-            }
+    uint32_t slot = entity->getSlot();
+    if (slot >= slot_entries_.size()) slot_entries_.resize(slot + 1, kNoEntry);
+    slot_entries_[slot] = index;
+}
+
+void SpatialHashSystem::removeEntry(uint32_t index) {
+    for (int level = 0; level < level_count_; ++level) {
+        unlink(level, entries_[index].cell[level], entries_[index].cell_pos[level]);
+    }
+    slot_entries_[entries_[index].handle.index] = kNoEntry;
+
+    // Swap the last entry into the hole and repoint its cells at it
+    uint32_t last = static_cast<uint32_t>(entries_.size() - 1);
+    if (index != last) {
+        entries_[index] = entries_[last];
+        const Entry& moved = entries_[index];
+        for (int level = 0; level < level_count_; ++level) {
+            levels_[level][moved.cell[level]][moved.cell_pos[level]] = index;
         }
+        slot_entries_[moved.handle.index] = index;
     }
+    entries_.pop_back();
+}
 
+void SpatialHashSystem::relinkEntry(uint32_t index, const CellKey& key) {
+    for (int level = 0; level < level_count_; ++level) {
+        CellKey target = coarsen(key, level);
+        // Cells nest, so once a level is unchanged every coarser one is too
+        if (target == entries_[index].cell[level]) break;
+        unlink(level, entries_[index].cell[level], entries_[index].cell_pos[level]);
+        link(level, target, index);
+    }
+}
+
+void SpatialHashSystem::clearIndex() {
+    for (CellMap& level : levels_) level.clear();
+    entries_.clear();
+    std::fill(slot_entries_.begin(), slot_entries_.end(), kNoEntry);
+}
+
+void SpatialHashSystem::update(float /*delta_time*/) {
+    auto start = std::chrono::steady_clock::now();
+
+    ++stamp_;
+    ++stats_.updates;
+    stats_.inserted = 0;
+    stats_.removed = 0;
+    stats_.cell_changes = 0;
+    if (rebuild_) {
+        clearIndex();
+        rebuild_ = false;
+        ++stats_.full_rebuilds;
+    }
+
+    world_->each<components::Position>([this](ecs::Entity* entity, components::Position* pos) {
+        uint32_t slot = entity->getSlot();
+        uint32_t index = slot < slot_entries_.size() ? slot_entries_[slot] : kNoEntry;
+        if (index != kNoEntry && entries_[index].handle != entity->getHandle()) {
+            // The slot was freed and reused since the last update
+            removeEntry(index);
+            ++stats_.removed;
+            index = kNoEntry;
+        }
+        if (index == kNoEntry) {
+            insertEntry(entity, pos->x, pos->y, pos->z);
+            ++stats_.inserted;
+            return;
+        }
+
+        Entry& entry = entries_[index];
+        entry.x = pos->x;
+        entry.y = pos->y;
+        entry.z = pos->z;
+        entry.seen = stamp_;
+        CellKey key = cellKeyFor(pos->x, pos->y, pos->z);
+        if (!(key == entry.cell[0])) {
+            relinkEntry(index, key);
+            ++stats_.cell_changes;
+        }
+    });
+
+    // Entities destroyed or stripped of Position since the last update.
+    // Walking backwards means the entry swapped into a hole was already seen.
+    for (size_t i = entries_.size(); i-- > 0;) {
+        if (entries_[i].seen != stamp_) {
+            removeEntry(static_cast<uint32_t>(i));
+            ++stats_.removed;
+        }
+    }
+
+    stats_.entities = entries_.size();
+    stats_.last_update_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+SpatialHashStats SpatialHashSystem::getStats() const {
+    SpatialHashStats stats = stats_;
+    stats.queries = query_count_.load(std::memory_order_relaxed);
+    stats.cells_probed = cells_probed_.load(std::memory_order_relaxed);
+    stats.candidates_tested = candidates_tested_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SpatialHashSystem::resetQueryStats() {
+    query_count_.store(0, std::memory_order_relaxed);
+    cells_probed_.store(0, std::memory_order_relaxed);
+    candidates_tested_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<std::string> SpatialHashSystem::queryNear(
+    float x, float y, float z, float radius) const {
+
+    std::vector<std::string> result;
+    forEachInRadius(x, y, z, radius, [&](ecs::Entity* entity, float) {
+        result.push_back(entity->getId());
+    });
     return result;
 }
 
@@ -83,19 +227,22 @@ std::vector<std::string> SpatialHashSystem::queryNeighbours(
     const std::string& entity_id) const {
 
     std::vector<std::string> result;
-    auto it = entity_cells_.find(entity_id);
-    if (it == entity_cells_.end()) return result;
+    const ecs::Entity* self = world_->getEntity(entity_id);
+    if (!self) return result;
+    uint32_t slot = self->getSlot();
+    if (slot >= slot_entries_.size() || slot_entries_[slot] == kNoEntry) return result;
 
-    const CellKey& centre = it->second;
+    const CellKey& centre = entries_[slot_entries_[slot]].cell[0];
     for (int dx = -1; dx <= 1; ++dx) {
         for (int dy = -1; dy <= 1; ++dy) {
             for (int dz = -1; dz <= 1; ++dz) {
                 CellKey probe{centre.cx + dx, centre.cy + dy, centre.cz + dz};
-                auto git = grid_.find(probe);
-                if (git == grid_.end()) continue;
-                for (const auto& id : git->second) {
-                    if (id != entity_id) {
-                        result.push_back(id);
+                auto git = levels_[0].find(probe);
+                if (git == levels_[0].end()) continue;
+                for (uint32_t index : git->second) {
+                    const ecs::Entity* entity = world_->resolve(entries_[index].handle);
+                    if (entity && entity != self) {
+                        result.push_back(entity->getId());
                     }
                 }
             }
@@ -112,7 +112,7 @@ bool StationSystem::undockFromStation(const std::string& entity_id) {
     if (!docked) return false;
 
     // Decrement station count
-    auto* station_entity = world_->getEntity(docked->station_id);
+    auto* station_entity = world_->resolve(docked->station_handle, docked->station_id);
     if (station_entity) {
         auto* station = station_entity->getComponent<components::Station>();
         if (station && station->docked_count > 0) {
@@ -140,7 +140,7 @@ double StationSystem::repairShip(const std::string& entity_id) {
 
     // Find station repair cost
     float cost_per_hp = 1.0f;
-    auto* station_entity = world_->getEntity(docked->station_id);
+    auto* station_entity = world_->resolve(docked->station_handle, docked->station_id);
     if (station_entity) {
         auto* station = station_entity->getComponent<components::Station>();
         if (station) cost_per_hp = station->repair_cost_per_hp;
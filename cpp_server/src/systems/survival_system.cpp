@@ -6,19 +6,16 @@ namespace atlas {
 namespace systems {
 
 SurvivalSystem::SurvivalSystem(ecs::World* world)
-    : System(world) {
+    : SingleComponentSystem(world) {
+    writes<components::SurvivalNeeds>();
+    enableParallel();
 }
 
-void SurvivalSystem::update(float delta_time) {
-    auto entities = world_->getEntities<components::SurvivalNeeds>();
-    for (auto* entity : entities) {
-        auto* needs = entity->getComponent<components::SurvivalNeeds>();
-        if (!needs) continue;
-
-        needs->oxygen = std::max(0.0f, needs->oxygen - needs->oxygen_drain_rate * delta_time);
-        needs->hunger = std::min(100.0f, needs->hunger + needs->hunger_rate * delta_time);
-        needs->fatigue = std::min(100.0f, needs->fatigue + needs->fatigue_rate * delta_time);
-    }
+void SurvivalSystem::processEntity(ecs::Entity* /*entity*/,
+                                   components::SurvivalNeeds* needs, float dt) {
+    needs->oxygen = std::max(0.0f, needs->oxygen - needs->oxygen_drain_rate * dt);
+    needs->hunger = std::min(100.0f, needs->hunger + needs->hunger_rate * dt);
+    needs->fatigue = std::min(100.0f, needs->fatigue + needs->fatigue_rate * dt);
 }
 
 float SurvivalSystem::refillOxygen(const std::string& entity_id, float amount) {
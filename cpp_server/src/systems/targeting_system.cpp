@@ -1,7 +1,9 @@
 #include "systems/targeting_system.h"
+#include "systems/spatial_hash_system.h"
 #include "ecs/world.h"
 #include "components/game_components.h"
 #include <algorithm>
+#include <limits>
 
 namespace atlas {
 namespace systems {
@@ -116,5 +118,39 @@ bool TargetingSystem::isTargetLocked(const std::string& entity_id, const std::st
     return it != target_comp->locked_targets.end();
 }
 
+size_t TargetingSystem::getLockableTargets(const std::string& entity_id,
+                                           std::vector<ecs::EntityHandle>& out) const {
+    out.clear();
+    auto* entity = world_->getEntity(entity_id);
+    if (!entity) return 0;
+    auto* pos = entity->getComponent<components::Position>();
+    auto* ship = entity->getComponent<components::Ship>();
+    if (!pos || !ship) return 0;
+
+    const float range = ship->max_targeting_range;
+    if (spatial_index_) {
+        spatial_index_->queryNearest<components::Health>(
+            pos->x, pos->y, pos->z, std::numeric_limits<size_t>::max(), range, out);
+    } else {
+        thread_local std::vector<std::pair<float, ecs::EntityHandle>> scratch;
+        scratch.clear();
+        for (auto* candidate : world_->query<components::Position, components::Health>()) {
+            auto* other = candidate->getComponent<components::Position>();
+            float dx = other->x - pos->x;
+            float dy = other->y - pos->y;
+            float dz = other->z - pos->z;
+            float dist_sq = dx * dx + dy * dy + dz * dz;
+            if (dist_sq <= range * range) scratch.emplace_back(dist_sq, candidate->getHandle());
+        }
+        std::sort(scratch.begin(), scratch.end(), [](const auto& a, const auto& b) {
+            return a.first != b.first ? a.first < b.first : a.second.index < b.second.index;
+        });
+        for (const auto& hit : scratch) out.push_back(hit.second);
+    }
+
+    out.erase(std::remove(out.begin(), out.end(), entity->getHandle()), out.end());
+    return out.size();
+}
+
 } // namespace systems
 } // namespace atlas
@@ -32,16 +32,17 @@ void WeaponSystem::update(float delta_time) {
         if (ai && ai->state == components::AI::State::Attacking 
             && !ai->target_entity_id.empty()) {
             if (weapon->cooldown <= 0.0f) {
-                fireWeapon(entity->getId(), ai->target_entity_id);
+                fireWeapon(entity, world_->resolve(ai->target_handle, ai->target_entity_id));
             }
         }
     }
 }
 
 bool WeaponSystem::fireWeapon(const std::string& shooter_id, const std::string& target_id) {
-    auto* shooter = world_->getEntity(shooter_id);
-    auto* target = world_->getEntity(target_id);
-    
+    return fireWeapon(world_->getEntity(shooter_id), world_->getEntity(target_id));
+}
+
+bool WeaponSystem::fireWeapon(ecs::Entity* shooter, ecs::Entity* target) {
     if (!shooter || !target) return false;
     
     auto* weapon = shooter->getComponent<components::Weapon>();
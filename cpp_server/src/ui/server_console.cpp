@@ -6,6 +6,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cstdlib>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -214,6 +215,13 @@ std::string ServerConsole::executeCommand(const std::string& command) {
         return handleSaveCommand();
     } else if (base_cmd == "load") {
         return handleLoadCommand();
+    } else if (base_cmd == "queries") {
+        return handleQueriesCommand();
+    } else if (base_cmd == "profile") {
+        std::vector<std::string> args;
+        std::string arg;
+        while (iss >> arg) args.push_back(arg);
+        return handleProfileCommand(args);
     } else {
         return "Unknown command: '" + base_cmd + "'. Type 'help' for available commands.";
     }
@@ -229,6 +237,10 @@ std::string ServerConsole::handleHelpCommand() {
     oss << "  metrics         - Show detailed performance metrics\n";
     oss << "  save            - Save world state\n";
     oss << "  load            - Load world state\n";
+    oss << "  queries         - Show ECS query hit counts\n";
+    oss << "  profile [n]     - Slowest systems/handlers by p99 tick time\n";
+    oss << "  profile export [file] - Write a Chrome/Perfetto trace\n";
+    oss << "  profile on|off|window <ticks> - Control the tick profiler\n";
     oss << "  stop            - Gracefully stop the server";
     return oss.str();
 }
@@ -303,4 +315,58 @@ std::string ServerConsole::handleLoadCommand() {
     }
 }
 
+std::string ServerConsole::handleQueriesCommand() {
+    auto* world = server_->getWorld();
+    if (!world) return "No world loaded";
+
+    auto queries = world->getQueries();
+    std::sort(queries.begin(), queries.end(),
+              [](const ecs::EntityQuery* a, const ecs::EntityQuery* b) {
+                  return a->hits() > b->hits();
+              });
+
+    std::ostringstream oss;
+    oss << "ECS queries (" << queries.size() << "), by hits:";
+    for (const auto* query : queries) {
+        oss << "\n  " << query->hits() << " hits, " << query->size()
+            << " entities  [" << query->label() << "]";
+    }
+    return oss.str();
+}
+
+std::string ServerConsole::handleProfileCommand(const std::vector<std::string>& args) {
+    auto& profiler = server_->getProfiler();
+    const std::string sub = args.empty() ? "" : args[0];
+
+    if (sub == "on" || sub == "off") {
+        profiler.setEnabled(sub == "on");
+        return std::string("Tick profiler ") + (sub == "on" ? "enabled" : "disabled");
+    }
+    if (sub == "window") {
+        if (args.size() < 2) return "Usage: profile window <ticks>";
+        int ticks = std::atoi(args[1].c_str());
+        if (ticks <= 0) return "Usage: profile window <ticks>";
+        profiler.setWindowTicks(static_cast<size_t>(ticks));
+        return "Profiler window set to " + std::to_string(ticks) + " ticks (statistics cleared)";
+    }
+    if (sub == "export") {
+        std::string path = args.size() > 1 ? args[1]
+                         : (config_ ? config_->log_path : std::string(".")) + "/tick_trace.json";
+        if (!profiler.exportChromeTrace(path)) return "Failed to write trace to " + path;
+        return "Trace written to " + path + " (open in chrome://tracing or ui.perfetto.dev)";
+    }
+
+    size_t top_n = 20;
+    if (!sub.empty()) {
+        int n = std::atoi(sub.c_str());
+        if (n <= 0) return "Usage: profile [n] | export [file] | on | off | window <ticks>";
+        top_n = static_cast<size_t>(n);
+    }
+    std::string report = profiler.statsReport(top_n);
+    if (!profiler.isEnabled()) {
+        report = "Tick profiler is disabled ('profile on' to enable)\n" + report;
+    }
+    return report;
+}
+
 } // namespace atlas
@@ -72,6 +72,77 @@ int ServerMetrics::getPlayerCount() const {
     return player_count_;
 }
 
+void ServerMetrics::recordSaveStall(double ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_save_stall_ms_ = ms;
+    max_save_stall_ms_ = std::max(max_save_stall_ms_, ms);
+    save_recorded_ = true;
+}
+
+void ServerMetrics::recordSaveCompleted(double duration_ms, bool success) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (success) ++save_count_;
+    else ++save_failures_;
+    last_save_ms_ = duration_ms;
+    max_save_ms_ = std::max(max_save_ms_, duration_ms);
+    save_recorded_ = true;
+}
+
+uint64_t ServerMetrics::getSaveCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return save_count_;
+}
+
+uint64_t ServerMetrics::getSaveFailures() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return save_failures_;
+}
+
+double ServerMetrics::getLastSaveMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_save_ms_;
+}
+
+double ServerMetrics::getMaxSaveMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_save_ms_;
+}
+
+double ServerMetrics::getLastSaveStallMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_save_stall_ms_;
+}
+
+double ServerMetrics::getMaxSaveStallMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_save_stall_ms_;
+}
+
+void ServerMetrics::recordJournalFlush(double duration_ms, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++journal_flushes_;
+    if (bytes > 0) {
+        ++journal_records_;
+        journal_bytes_ += bytes;
+    }
+    last_journal_flush_ms_ = duration_ms;
+}
+
+uint64_t ServerMetrics::getJournalRecords() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return journal_records_;
+}
+
+uint64_t ServerMetrics::getJournalBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return journal_bytes_;
+}
+
+double ServerMetrics::getLastJournalFlushMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_journal_flush_ms_;
+}
+
 double ServerMetrics::getUptimeSeconds() const {
     auto now = std::chrono::steady_clock::now();
     return std::chrono::duration<double>(now - server_start_).count();
@@ -120,6 +191,18 @@ std::string ServerMetrics::summary() const {
     }
 
     oss << " | ticks=" << tick_count_total_;
+
+    if (save_recorded_) {
+        oss << " | saves=" << save_count_
+            << " failed=" << save_failures_
+            << " last=" << last_save_ms_ << "ms"
+            << " stall=" << last_save_stall_ms_ << "ms";
+    }
+    if (journal_flushes_ > 0) {
+        oss << " | journal=" << journal_records_ << " records "
+            << (journal_bytes_ / (1024.0 * 1024.0)) << "MB"
+            << " flush=" << last_journal_flush_ms_ << "ms";
+    }
     return oss.str();
 }
 
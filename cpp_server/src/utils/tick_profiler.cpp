@@ -0,0 +1,299 @@
+#include "utils/tick_profiler.h"
+#include "utils/json_helpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace atlas {
+namespace utils {
+
+namespace {
+
+std::atomic<uint64_t> next_profiler_id{1};
+
+// Ring of the last profiler this thread recorded into
+struct RingCache {
+    uint64_t profiler = 0;
+    void* ring = nullptr;
+};
+thread_local RingCache t_ring_cache;
+
+size_t ringCapacity(size_t requested) {
+    size_t capacity = 16;
+    while (capacity < requested) capacity <<= 1;
+    return capacity;
+}
+
+// Nearest-rank percentile of sorted, non-empty `values`
+double percentile(const std::vector<float>& values, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(values.size())));
+    return values[rank > 0 ? rank - 1 : 0];
+}
+
+} // namespace
+
+const char* profileCategoryName(ProfileCategory category) {
+    switch (category) {
+        case ProfileCategory::Tick:        return "tick";
+        case ProfileCategory::System:      return "system";
+        case ProfileCategory::Network:     return "network";
+        case ProfileCategory::Persistence: return "persistence";
+        case ProfileCategory::Other:       break;
+    }
+    return "other";
+}
+
+TickProfiler::TickProfiler(size_t ring_events, size_t window_ticks)
+    : id_(next_profiler_id.fetch_add(1, std::memory_order_relaxed))
+    , ring_mask_(ringCapacity(ring_events) - 1)
+    , window_ticks_(std::max<size_t>(window_ticks, 1))
+    , epoch_ns_(nowNs()) {}
+
+TickProfiler::~TickProfiler() = default;
+
+int64_t TickProfiler::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TickProfiler::setWindowTicks(size_t window_ticks) {
+    window_ticks_ = std::max<size_t>(window_ticks, 1);
+    for (auto& zone : zones_) {
+        zone.samples.assign(window_ticks_, 0.0f);
+        zone.next = 0;
+        zone.count = 0;
+    }
+}
+
+const char* TickProfiler::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(names_mutex_);
+    return names_.insert(name).first->c_str();
+}
+
+void TickProfiler::setThreadName(const std::string& name) {
+    ThreadRing* ring = ringForThisThread();
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    ring->label = name;
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+TickProfiler::ThreadRing* TickProfiler::ringForThisThread() {
+    if (t_ring_cache.profiler == id_) {
+        return static_cast<ThreadRing*>(t_ring_cache.ring);
+    }
+    ThreadRing* ring = findOrCreateRing();
+    t_ring_cache.profiler = id_;
+    t_ring_cache.ring = ring;
+    return ring;
+}
+
+TickProfiler::ThreadRing* TickProfiler::findOrCreateRing() {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    auto self = std::this_thread::get_id();
+    for (auto& ring : rings_) {
+        if (ring->owner == self) return ring.get();
+    }
+    auto ring = std::make_unique<ThreadRing>();
+    ring->owner = self;
+    ring->tid = static_cast<uint32_t>(rings_.size() + 1);
+    ring->label = "thread " + std::to_string(ring->tid);
+    ring->events = std::make_unique<Event[]>(ring_mask_ + 1);
+    rings_.push_back(std::move(ring));
+    return rings_.back().get();
+}
+
+void TickProfiler::record(const char* name, ProfileCategory category,
+                          int64_t start_ns, int64_t end_ns) {
+    ThreadRing* ring = ringForThisThread();
+    uint64_t n = ring->head.load(std::memory_order_relaxed);
+    Event& event = ring->events[n & ring_mask_];
+
+    event.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name.store(name, std::memory_order_relaxed);
+    event.start_ns.store(start_ns, std::memory_order_relaxed);
+    event.end_ns.store(end_ns, std::memory_order_relaxed);
+    event.category.store(static_cast<uint8_t>(category), std::memory_order_relaxed);
+    event.seq.store(2 * n + 2, std::memory_order_release);
+
+    ring->head.store(n + 1, std::memory_order_release);
+}
+
+bool TickProfiler::readEvent(const ThreadRing& ring, uint64_t n, EventCopy& out) const {
+    const Event& event = ring.events[n & ring_mask_];
+    uint64_t before = event.seq.load(std::memory_order_acquire);
+    if (before != 2 * n + 2) return false;   // being written, or already reused
+
+    out.name = event.name.load(std::memory_order_relaxed);
+    out.category = static_cast<ProfileCategory>(event.category.load(std::memory_order_relaxed));
+    out.start_ns = event.start_ns.load(std::memory_order_relaxed);
+    out.end_ns = event.end_ns.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return event.seq.load(std::memory_order_relaxed) == before;
+}
+
+// ---------------------------------------------------------------------------
+// Per-tick aggregation
+// ---------------------------------------------------------------------------
+
+size_t TickProfiler::zoneFor(const char* name, ProfileCategory category) {
+    auto it = zone_by_ptr_.find(name);
+    if (it != zone_by_ptr_.end()) return it->second;
+
+    // Equal literals in different translation units may not share storage
+    auto [named, inserted] = zone_by_name_.emplace(name, zones_.size());
+    if (inserted) {
+        Zone zone;
+        zone.name = name;
+        zone.category = category;
+        zone.samples.assign(window_ticks_, 0.0f);
+        zones_.push_back(std::move(zone));
+    }
+    zone_by_ptr_.emplace(name, named->second);
+    return named->second;
+}
+
+void TickProfiler::endTick() {
+    const uint64_t capacity = ring_mask_ + 1;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (auto& ring : rings_) {
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            uint64_t first = ring->read_cursor;
+            if (head - first > capacity) {
+                dropped_events_ += head - capacity - first;
+                first = head - capacity;
+            }
+            EventCopy event;
+            for (uint64_t n = first; n < head; ++n) {
+                if (!readEvent(*ring, n, event)) {
+                    ++dropped_events_;
+                    continue;
+                }
+                size_t index = zoneFor(event.name, event.category);
+                Zone& zone = zones_[index];
+                zone.tick_ms += static_cast<double>(event.end_ns - event.start_ns) / 1.0e6;
+                if (!zone.ran) {
+                    zone.ran = true;
+                    ran_this_tick_.push_back(index);
+                }
+            }
+            ring->read_cursor = head;
+        }
+    }
+
+    last_tick_.clear();
+    for (size_t index : ran_this_tick_) {
+        Zone& zone = zones_[index];
+        zone.samples[zone.next] = static_cast<float>(zone.tick_ms);
+        zone.next = (zone.next + 1) % window_ticks_;
+        zone.count = std::min(zone.count + 1, window_ticks_);
+        last_tick_.push_back({zone.name, zone.category, zone.tick_ms});
+        zone.tick_ms = 0.0;
+        zone.ran = false;
+    }
+    ran_this_tick_.clear();
+    ++tick_count_;
+}
+
+std::vector<ProfileZoneStats> TickProfiler::getStats() const {
+    std::vector<ProfileZoneStats> stats;
+    std::vector<float> sorted;
+    for (const auto& zone : zones_) {
+        if (zone.count == 0) continue;
+        ProfileZoneStats s;
+        s.name = zone.name;
+        s.category = zone.category;
+        s.samples = zone.count;
+        s.last_ms = zone.samples[(zone.next + window_ticks_ - 1) % window_ticks_];
+
+        sorted.assign(zone.samples.begin(), zone.samples.begin() + zone.count);
+        std::sort(sorted.begin(), sorted.end());
+        s.p50_ms = percentile(sorted, 0.50);
+        s.p99_ms = percentile(sorted, 0.99);
+        s.max_ms = sorted.back();
+        stats.push_back(std::move(s));
+    }
+    std::sort(stats.begin(), stats.end(),
+              [](const ProfileZoneStats& a, const ProfileZoneStats& b) {
+                  return a.p99_ms > b.p99_ms;
+              });
+    return stats;
+}
+
+std::string TickProfiler::statsReport(size_t top_n) const {
+    auto stats = getStats();
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << "Tick profile: " << stats.size() << " zones, window " << window_ticks_
+        << " ticks, " << tick_count_ << " ticks profiled";
+    if (dropped_events_ > 0) oss << ", " << dropped_events_ << " events dropped";
+    oss << "\n  " << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms"
+        << std::setw(10) << "max ms" << std::setw(8) << "ticks" << "  zone";
+    size_t shown = std::min(top_n, stats.size());
+    for (size_t i = 0; i < shown; ++i) {
+        const auto& s = stats[i];
+        oss << "\n  " << std::setw(10) << s.p50_ms << std::setw(10) << s.p99_ms
+            << std::setw(10) << s.max_ms << std::setw(8) << s.samples
+            << "  " << s.name << " [" << profileCategoryName(s.category) << "]";
+    }
+    return oss.str();
+}
+
+// ---------------------------------------------------------------------------
+// Trace export
+// ---------------------------------------------------------------------------
+
+void TickProfiler::writeChromeTrace(std::ostream& out) const {
+    const uint64_t capacity = ring_mask_ + 1;
+    std::unordered_map<const char*, std::string> escaped;
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        return out;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (const auto& ring : rings_) {
+        separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->tid
+                    << ",\"args\":{\"name\":\"" << json::escapeString(ring->label) << "\"}}";
+
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = head > capacity ? head - capacity : 0;
+        EventCopy event;
+        for (uint64_t n = begin; n < head; ++n) {
+            if (!readEvent(*ring, n, event)) continue;
+            auto it = escaped.find(event.name);
+            if (it == escaped.end()) {
+                it = escaped.emplace(event.name, json::escapeString(event.name)).first;
+            }
+            // Microseconds since the profiler was created
+            double ts = static_cast<double>(event.start_ns - epoch_ns_) / 1000.0;
+            double dur = static_cast<double>(event.end_ns - event.start_ns) / 1000.0;
+            separator() << std::fixed << std::setprecision(3)
+                        << "{\"name\":\"" << it->second << "\",\"cat\":\""
+                        << profileCategoryName(event.category) << "\",\"ph\":\"X\",\"ts\":" << ts
+                        << ",\"dur\":" << dur << ",\"pid\":1,\"tid\":" << ring->tid << "}";
+        }
+    }
+    out << "\n]}\n";
+}
+
+bool TickProfiler::exportChromeTrace(const std::string& filepath) const {
+    std::ofstream file(filepath);
+    if (!file.is_open()) return false;
+    writeChromeTrace(file);
+    return file.good();
+}
+
+} // namespace utils
+} // namespace atlas
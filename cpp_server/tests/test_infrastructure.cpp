@@ -109,9 +109,13 @@
 #include "systems/scan_probe_system.h"
 #include "systems/autopilot_system.h"
 #include "network/protocol_handler.h"
+#include "network/wire_format.h"
+#include "network/mpsc_queue.h"
+#include "network/tcp_server.h"
 #include "ui/server_console.h"
 #include "utils/logger.h"
 #include "utils/server_metrics.h"
+#include "utils/tick_profiler.h"
 #include "pcg/deterministic_rng.h"
 #include "pcg/hash_utils.h"
 #include "pcg/pcg_context.h"
@@ -235,7 +239,9 @@
 #include "systems/incursion_system.h"
 #include "systems/clone_bay_system.h"
 #include "systems/loyalty_point_store_system.h"
+#include <atomic>
 #include <fstream>
+#include <sstream>
 #include <thread>
 #include <sys/stat.h>
 
@@ -461,6 +467,47 @@ void testMetricsResetWindow() {
     assertTrue(metrics.getMinTickMs() == 0.0, "Min reset to 0 after window reset");
 }
 
+void testMetricsSaveTimings() {
+    std::cout << "\n=== Metrics Save Timings ===" << std::endl;
+
+    utils::ServerMetrics metrics;
+    assertTrue(metrics.summary().find("saves=") == std::string::npos,
+               "No save section before any save");
+
+    metrics.recordSaveStall(1.5);
+    metrics.recordSaveCompleted(120.0, true);
+    metrics.recordSaveStall(0.5);
+    metrics.recordSaveCompleted(80.0, false);
+
+    assertTrue(metrics.getSaveCount() == 1, "One successful save");
+    assertTrue(metrics.getSaveFailures() == 1, "One failed save");
+    assertTrue(metrics.getLastSaveMs() == 80.0, "Last save duration");
+    assertTrue(metrics.getMaxSaveMs() == 120.0, "Max save duration");
+    assertTrue(metrics.getLastSaveStallMs() == 0.5, "Last save stall");
+    assertTrue(metrics.getMaxSaveStallMs() == 1.5, "Max save stall");
+
+    std::string s = metrics.summary();
+    assertTrue(s.find("saves=1 failed=1") != std::string::npos, "Summary contains save counts");
+    assertTrue(s.find("stall=0.50ms") != std::string::npos, "Summary contains save stall");
+}
+
+void testMetricsJournalFlush() {
+    std::cout << "\n=== Metrics Journal Flush ===" << std::endl;
+
+    utils::ServerMetrics metrics;
+    assertTrue(metrics.summary().find("journal=") == std::string::npos,
+               "No journal section before any flush");
+
+    metrics.recordJournalFlush(1.25, 2048);
+    metrics.recordJournalFlush(0.5, 0);   // nothing changed: no record
+
+    assertTrue(metrics.getJournalRecords() == 1, "Only non-empty flushes count as records");
+    assertTrue(metrics.getJournalBytes() == 2048, "Journal bytes accumulated");
+    assertTrue(metrics.getLastJournalFlushMs() == 0.5, "Last flush duration");
+    assertTrue(metrics.summary().find("journal=1 records") != std::string::npos,
+               "Summary contains journal records");
+}
+
 // ==================== ServerConsole Tests ====================
 
 void testConsoleInit() {
@@ -778,6 +825,187 @@ void testProtocolMiningResultParse() {
     assertTrue(type == atlas::network::MessageType::MINING_RESULT, "Type is MINING_RESULT");
 }
 
+// ==================== Binary Wire Format Tests ====================
+
+void testWireFieldRoundTrip() {
+    std::cout << "\n=== Wire: Field Round Trip ===" << std::endl;
+
+    atlas::network::WireWriter w;
+    w.writeVarUInt(0);
+    w.writeVarUInt(300);
+    w.writeVarInt(-1);
+    w.writeVarInt(-1234567);
+    w.writeQuantized(1234.53f, atlas::network::kWirePositionStep);
+    w.writeFloat(-0.25f);
+    w.writeString("ship_42");
+    assertTrue(w.size() == 1 + 2 + 1 + 4 + 3 + 4 + 8, "Small values encode compactly");
+
+    atlas::network::WireReader r(w.data());
+    uint64_t u0 = 1, u1 = 0;
+    int64_t i0 = 0, i1 = 0;
+    float q = 0.0f, f = 0.0f;
+    std::string s;
+    bool ok = r.readVarUInt(u0) && r.readVarUInt(u1) && r.readVarInt(i0) &&
+              r.readVarInt(i1) && r.readQuantized(q, atlas::network::kWirePositionStep) &&
+              r.readFloat(f) && r.readString(s);
+    assertTrue(ok && r.atEnd(), "Every field reads back");
+    assertTrue(u0 == 0 && u1 == 300 && i0 == -1 && i1 == -1234567, "Varints round trip");
+    assertTrue(approxEqual(q, 1234.53f, atlas::network::kWirePositionStep), "Quantized float within one step");
+    assertTrue(f == -0.25f && s == "ship_42", "Raw float and string round trip");
+
+    std::string truncated = w.data().substr(0, w.size() - 3);
+    atlas::network::WireReader t(truncated);
+    ok = t.readVarUInt(u0) && t.readVarUInt(u1) && t.readVarInt(i0) && t.readVarInt(i1) &&
+         t.readQuantized(q, 1.0f) && t.readFloat(f) && t.readString(s);
+    assertTrue(!ok && t.failed(), "Truncated string fails instead of over-reading");
+}
+
+void testWireFrameDecode() {
+    std::cout << "\n=== Wire: Frame Decode ===" << std::endl;
+    using namespace atlas::network;
+
+    std::string frame = encodeFrame(MessageType::CHAT, "{\"message\":\"o7\"}");
+    assertTrue(isBinaryFrame(frame), "Frame starts with the magic byte");
+
+    WireFrame decoded;
+    size_t consumed = 0;
+    std::string stream = frame + frame;
+    assertTrue(decodeFrame(stream.data(), stream.size(), decoded, consumed) == FrameStatus::OK &&
+               consumed == frame.size(), "First of two back-to-back frames decodes");
+    assertTrue(decoded.type == MessageType::CHAT && decoded.payload == "{\"message\":\"o7\"}",
+               "Type and payload survive");
+    assertTrue(decodeFrame(frame.data(), frame.size() - 1, decoded, consumed) == FrameStatus::INCOMPLETE,
+               "Partial frame asks for more bytes");
+
+    std::string bad_version = frame;
+    bad_version[1] = static_cast<char>(kWireVersion + 1);
+    assertTrue(decodeFrame(bad_version.data(), bad_version.size(), decoded, consumed) == FrameStatus::INVALID,
+               "Unknown version is rejected");
+
+    ProtocolHandler proto;
+    MessageType type;
+    std::string data;
+    assertTrue(proto.parseMessage(frame, type, data) && type == MessageType::CHAT &&
+               data == "{\"message\":\"o7\"}", "ProtocolHandler accepts binary frames");
+    assertTrue(!proto.parseMessage(frame.substr(0, 3), type, data), "Truncated frame is rejected");
+}
+
+void testWireExtractMessages() {
+    std::cout << "\n=== Wire: Extract Messages ===" << std::endl;
+    using namespace atlas::network;
+
+    std::string frame = encodeFrame(MessageType::CHAT, "{\"message\":\"o7\"}");
+    std::string buffer = "{\"type\":\"ping\"}\r\n\n" + frame + "{\"type\":\"pi";
+    std::vector<std::string> out;
+    assertTrue(extractMessages(buffer, out, 1024), "Coalesced stream is well formed");
+    assertTrue(out.size() == 2 && out[0] == "{\"type\":\"ping\"}" && out[1] == frame,
+               "JSON line and binary frame split apart, blank line skipped");
+    assertTrue(buffer == "{\"type\":\"pi", "Partial message stays buffered");
+
+    buffer += "ng\"}\n";
+    out.clear();
+    assertTrue(extractMessages(buffer, out, 1024) && out.size() == 1 &&
+               out[0] == "{\"type\":\"ping\"}" && buffer.empty(),
+               "Partial message completes on the next read");
+
+    buffer = std::string(2048, 'x');
+    out.clear();
+    assertTrue(!extractMessages(buffer, out, 1024), "Oversized message without newline is rejected");
+}
+
+void testMpscQueueMultiProducer() {
+    std::cout << "\n=== MpscQueue: Multiple Producers ===" << std::endl;
+
+    atlas::network::MpscQueue<std::pair<int, int>> queue;
+    const int producers = 4;
+    const int per_producer = 5000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < per_producer; ++i) queue.push({p, i});
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    int received = 0;
+    bool ordered = true;
+    std::pair<int, int> item;
+    while (received < producers * per_producer) {
+        if (!queue.pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (item.second != next[item.first]) ordered = false;
+        next[item.first] = item.second + 1;
+        ++received;
+    }
+    for (auto& t : threads) t.join();
+
+    assertTrue(received == producers * per_producer, "Every item is delivered once");
+    assertTrue(ordered, "Items from one producer keep their order");
+    assertTrue(!queue.pop(item), "Queue is empty afterwards");
+}
+
+void testTcpServerLoopback() {
+    std::cout << "\n=== TCPServer: Loopback Dispatch ===" << std::endl;
+    using namespace atlas::network;
+
+    TCPServer server("127.0.0.1", 0, 8);
+    server.setMaxOutboundBytes(64 * 1024);
+    assertTrue(server.initialize() && server.getPort() != 0, "Server binds an ephemeral port");
+    server.start();
+
+    socket_t client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(server.getPort());
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    assertTrue(connect(client, (sockaddr*)&addr, sizeof(addr)) == 0, "Client connects");
+
+    std::vector<std::string> received;
+    std::vector<ClientConnection> senders;
+    server.setMessageHandler([&](const ClientConnection& c, const std::string& msg) {
+        senders.push_back(c);
+        received.push_back(msg);
+    });
+
+    // Two messages in one write, the second split across two writes
+    std::string part1 = "{\"type\":\"a\"}\n{\"type\":";
+    std::string part2 = "\"b\"}\n";
+    send(client, part1.data(), part1.size(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    send(client, part2.data(), part2.size(), 0);
+
+    for (int i = 0; i < 200 && received.size() < 2; ++i) {
+        server.dispatchMessages();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    assertTrue(received.size() == 2 && received[0] == "{\"type\":\"a\"}" &&
+               received[1] == "{\"type\":\"b\"}", "Messages are reassembled in order");
+
+    assertTrue(!senders.empty() && server.sendToClient(senders[0], "{\"type\":\"pong\"}"),
+               "Reply is queued");
+    char buf[64] = {};
+    ssize_t n = recv(client, buf, sizeof(buf) - 1, 0);
+    assertTrue(n > 0 && std::string(buf, static_cast<size_t>(n)) == "{\"type\":\"pong\"}\n",
+               "Reply arrives newline-terminated");
+
+    // A client that never reads is dropped once its queue passes the limit
+    std::string big(16 * 1024, 'x');
+    bool dropped = false;
+    for (int i = 0; i < 1000 && !dropped; ++i) {
+        dropped = !server.sendToClient(senders[0], big);
+    }
+    assertTrue(dropped, "Slow consumer is disconnected instead of blocking the sender");
+    for (int i = 0; i < 200 && server.getClientCount() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    assertTrue(server.getClientCount() == 0, "Dropped client is removed");
+
+    close(client);
+    server.stop();
+}
+
 // ==================== AI Mining State Test ====================
 
 void testAIMiningState() {
@@ -2588,6 +2816,115 @@ void testInterestEntityNoPosition() {
                "Entity without position is always relevant");
 }
 
+void testInterestSpatialIndexMatchesScan() {
+    std::cout << "\n=== Interest: Spatial Index Matches Full Scan ===" << std::endl;
+
+    ecs::World world;
+    systems::SpatialHashSystem spatial(&world);
+    systems::InterestManagementSystem scan(&world);
+    systems::InterestManagementSystem indexed(&world);
+    indexed.setSpatialIndex(&spatial);
+    scan.setFarRange(10000.0f);
+    indexed.setFarRange(10000.0f);
+
+    for (int i = 0; i < 200; ++i) {
+        auto* e = world.createEntity("ims_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>((i * 7919) % 40000) - 20000.0f;
+        pos->y = static_cast<float>((i * 104729) % 40000) - 20000.0f;
+    }
+    world.createEntity("ims_system");  // no position
+    addComp<components::Position>(world.createEntity("ims_far"))->x = 1.0e6f;
+
+    for (auto* ims : {&scan, &indexed}) {
+        ims->registerClient(1, "ims_0");
+        ims->registerClient(2, "ims_17");
+        ims->addForceVisible(1, "ims_far");
+    }
+    spatial.update(0.0f);
+    scan.update(0.0f);
+    indexed.update(0.0f);
+
+    assertTrue(scan.getRelevantEntities(1) == indexed.getRelevantEntities(1),
+               "Client 1 relevance identical with spatial index");
+    assertTrue(scan.getRelevantEntities(2) == indexed.getRelevantEntities(2),
+               "Client 2 relevance identical with spatial index");
+    assertTrue(indexed.isRelevant(1, "ims_far") && indexed.isRelevant(1, "ims_system"),
+               "Force-visible and positionless entities still included");
+}
+
+void testInterestTiers() {
+    std::cout << "\n=== Interest: Relevance Tiers ===" << std::endl;
+
+    ecs::World world;
+    systems::InterestManagementSystem ims(&world);
+    ims.setNearRange(100.0f);
+    ims.setMidRange(1000.0f);
+    ims.setFarRange(5000.0f);
+
+    addComp<components::Position>(world.createEntity("tier_player"));
+    addComp<components::Position>(world.createEntity("tier_near"))->x = 50.0f;
+    addComp<components::Position>(world.createEntity("tier_mid"))->x = 500.0f;
+    addComp<components::Position>(world.createEntity("tier_far"))->x = 3000.0f;
+    addComp<components::Position>(world.createEntity("tier_out"))->x = 9000.0f;
+    addComp<components::Position>(world.createEntity("tier_pinned"))->x = 9500.0f;
+
+    ims.registerClient(1, "tier_player");
+    ims.addForceVisible(1, "tier_pinned");
+    ims.update(0.0f);
+
+    const auto* list = ims.getRelevantList(1);
+    assertTrue(list && list->size() == ims.getRelevantCount(1) && list->size() == 5,
+               "Tiered list matches the relevance set");
+    auto tierOf = [&](const std::string& id) {
+        auto handle = world.findHandle(id);
+        for (const auto& rel : *list) {
+            if (rel.handle == handle) return static_cast<int>(rel.tier);
+        }
+        return -1;
+    };
+    assertTrue(tierOf("tier_near") == static_cast<int>(systems::RelevanceTier::Near) &&
+               tierOf("tier_mid") == static_cast<int>(systems::RelevanceTier::Mid) &&
+               tierOf("tier_far") == static_cast<int>(systems::RelevanceTier::Far),
+               "Distance bands map to near / mid / far");
+    assertTrue(tierOf("tier_pinned") == static_cast<int>(systems::RelevanceTier::Near) &&
+               tierOf("tier_out") == -1, "Force-visible is near; out of range is absent");
+    assertTrue(ims.getRelevantList(2) == nullptr, "Unknown client has no list");
+}
+
+void testTargetingLockableTargets() {
+    std::cout << "\n=== Targeting: Lockable Targets In Range ===" << std::endl;
+
+    ecs::World world;
+    systems::SpatialHashSystem spatial(&world);
+    systems::TargetingSystem targeting(&world);
+
+    auto* ship = world.createEntity("lock_ship");
+    addComp<components::Position>(ship);
+    addComp<components::Health>(ship);
+    addComp<components::Ship>(ship)->max_targeting_range = 5000.0f;
+
+    const float xs[] = {4000.0f, 1000.0f, 6000.0f};
+    for (int i = 0; i < 3; ++i) {
+        auto* e = world.createEntity("lock_t" + std::to_string(i));
+        addComp<components::Position>(e)->x = xs[i];
+        addComp<components::Health>(e);
+    }
+    addComp<components::Position>(world.createEntity("lock_rock"))->x = 100.0f;  // no Health
+
+    std::vector<ecs::EntityHandle> scan_result;
+    std::vector<ecs::EntityHandle> index_result;
+    targeting.getLockableTargets("lock_ship", scan_result);
+    spatial.update(0.0f);
+    targeting.setSpatialIndex(&spatial);
+    targeting.getLockableTargets("lock_ship", index_result);
+
+    assertTrue(scan_result.size() == 2, "Two targets with Health inside targeting range");
+    assertTrue(scan_result.size() == 2 && *world.getEntityName(scan_result[0]) == "lock_t1",
+               "Closest lockable target first");
+    assertTrue(scan_result == index_result, "Spatial index gives the same lockable targets");
+}
+
 // ==================== NPC Rerouting System Tests ====================
 
 void testNPCReroutingNoDanger() {
@@ -3186,6 +3523,606 @@ void testInterestPriorityMissing() {
 }
 
 
+// ==================== ECS Storage Tests ====================
+
+void testEcsPoolQueryIntersection() {
+    std::cout << "\n=== ECS Pool Query Intersection ===" << std::endl;
+
+    ecs::World world;
+    for (int i = 0; i < 10; ++i) {
+        auto* e = world.createEntity("e" + std::to_string(i));
+        addComp<components::Position>(e);
+        if (i % 2 == 0) addComp<components::Velocity>(e);
+        if (i % 3 == 0) addComp<components::Health>(e);
+    }
+
+    assertTrue(world.getEntities<components::Position>().size() == 10, "All entities have Position");
+    assertTrue(world.getEntities<components::Position, components::Velocity>().size() == 5, "Half have Velocity");
+    assertTrue(world.getEntities<components::Velocity, components::Health>().size() == 2, "Velocity+Health intersection (0, 6)");
+    assertTrue(world.getEntities<components::Capacitor>().empty(), "Unused component type yields no entities");
+
+    int visited = 0;
+    world.each<components::Position, components::Health>(
+        [&](ecs::Entity* e, components::Position* pos, components::Health* hp) {
+            if (e && pos && hp) ++visited;
+        });
+    assertTrue(visited == 4, "each() visits Position+Health entities (0, 3, 6, 9)");
+}
+
+void testEcsPoolRemoveAndReuse() {
+    std::cout << "\n=== ECS Pool Remove And Reuse ===" << std::endl;
+
+    ecs::World world;
+    auto* a = world.createEntity("a");
+    auto* b = world.createEntity("b");
+    auto* c = world.createEntity("c");
+    auto* capA = addComp<components::Capacitor>(a);
+    addComp<components::Capacitor>(b);
+    auto* capC = addComp<components::Capacitor>(c);
+    capA->capacitor = 1.0f;
+    capC->capacitor = 3.0f;
+
+    b->removeComponent<components::Capacitor>();
+    assertTrue(!b->hasComponent<components::Capacitor>(), "Removed component is gone");
+    assertTrue(a->getComponent<components::Capacitor>() == capA, "Component address stable after swap-remove");
+    assertTrue(approxEqual(c->getComponent<components::Capacitor>()->capacitor, 3.0f), "Swapped component keeps its data");
+
+    world.destroyEntity("a");
+    assertTrue(world.getEntities<components::Capacitor>().size() == 1, "Destroying entity removes its components");
+
+    auto* d = world.createEntity("d");
+    assertTrue(!d->hasComponent<components::Capacitor>(), "Reused slot starts without components");
+
+    auto* c2 = world.createEntity("c");
+    assertTrue(!c2->hasComponent<components::Capacitor>(), "Re-creating an ID replaces the old entity");
+    assertTrue(world.getEntityCount() == 3, "Entity count after replace");
+}
+
+void testEcsPoolRemoveDriverTail() {
+    std::cout << "\n=== ECS Pool Remove Driver Tail ===" << std::endl;
+
+    ecs::World world;
+    for (int i = 0; i < 4; ++i) {
+        auto* e = world.createEntity("ship" + std::to_string(i));
+        addComp<components::Position>(e);
+    }
+    // Health is the smaller pool, so it drives the Position+Health query
+    auto* a = world.getEntity("ship1");
+    auto* b = world.getEntity("ship3");
+    addComp<components::Health>(a);
+    addComp<components::Health>(b)->hull_hp = 42.0f;
+
+    b->removeComponent<components::Health>();
+    auto result = world.getEntities<components::Position, components::Health>();
+    assertTrue(result.size() == 1 && result[0] == a, "Removing driver pool tail leaves only remaining match");
+
+    int visited = 0;
+    world.each<components::Health, components::Position>(
+        [&](ecs::Entity* e, components::Health* hp, components::Position* pos) {
+            if (e == a && hp == a->getComponent<components::Health>() && pos) ++visited;
+        });
+    assertTrue(visited == 1, "each() after driver tail removal yields the surviving component");
+
+    a->removeComponent<components::Health>();
+    assertTrue(world.getEntities<components::Position, components::Health>().empty(), "Emptied driver pool yields no matches");
+    assertTrue(world.getEntities<components::Position>().size() == 4, "Other pool unaffected by driver removals");
+}
+
+
+
+void testEcsCachedQueryIncremental() {
+    std::cout << "\n=== ECS Cached Query Incremental ===" << std::endl;
+
+    ecs::World world;
+    auto* a = world.createEntity("a");
+    addComp<components::Position>(a);
+    addComp<components::Velocity>(a);
+
+    auto& q = world.query<components::Position, components::Velocity>();
+    assertTrue(q.size() == 1, "Query seeded from existing entities");
+
+    auto* b = world.createEntity("b");
+    addComp<components::Position>(b);
+    assertTrue(q.size() == 1, "Partial match not added");
+    addComp<components::Velocity>(b);
+    assertTrue(q.size() == 2 && q.contains(b->getSlot()), "Completing the match adds entity");
+
+    a->removeComponent<components::Velocity>();
+    assertTrue(q.size() == 1 && !q.contains(a->getSlot()), "Removing a component drops entity");
+
+    world.destroyEntity("b");
+    assertTrue(q.empty(), "Destroying entity drops it from query");
+
+    auto& reordered = world.query<components::Velocity, components::Position>();
+    assertTrue(&reordered == &q, "Same component set shares one query");
+}
+
+void testEcsCachedQueryHits() {
+    std::cout << "\n=== ECS Cached Query Hits ===" << std::endl;
+
+    ecs::World world;
+    addComp<components::Health>(world.createEntity("h"));
+
+    world.getEntities<components::Health>();
+    world.getEntities<components::Health>();
+    world.query<components::Health>();
+
+    auto queries = world.getQueries();
+    assertTrue(queries.size() == 1, "One query registered for Health");
+    assertTrue(queries[0]->hits() == 3, "getEntities and query() both count hits");
+    assertTrue(!queries[0]->label().empty(), "Query has a diagnostic label");
+}
+
+void testEcsEntityHandleGenerations() {
+    std::cout << "\n=== ECS Entity Handle Generations ===" << std::endl;
+
+    ecs::World world;
+    auto* a = world.createEntity("a");
+    ecs::EntityHandle ha = a->getHandle();
+    assertTrue(!ha.isNull() && world.resolve(ha) == a, "Live handle resolves");
+    assertTrue(world.findHandle("a") == ha, "Name to handle lookup");
+    assertTrue(*world.getEntityName(ha) == "a", "Handle to name side table");
+
+    world.destroyEntity("a");
+    auto* b = world.createEntity("b");
+    assertTrue(b->getSlot() == ha.index, "Freed slot is reused");
+    assertTrue(world.resolve(ha) == nullptr, "Stale handle does not resolve to slot's new occupant");
+    assertTrue(world.getEntityName(ha) == nullptr, "Stale handle has no name");
+    assertTrue(ecs::EntityHandle::fromValue(b->getHandle().value()) == b->getHandle(), "Handle packs into 64 bits");
+    assertTrue(world.resolve(ecs::EntityHandle{}) == nullptr, "Null handle never resolves");
+}
+
+void testEcsEntityHandleCache() {
+    std::cout << "\n=== ECS Entity Handle Cache ===" << std::endl;
+
+    ecs::World world;
+    auto* t1 = world.createEntity("t1");
+    auto* npc = world.createEntity("npc");
+    auto* ai = addComp<components::AI>(npc);
+    ai->target_entity_id = "t1";
+
+    assertTrue(world.resolve(ai->target_handle, ai->target_entity_id) == t1, "Cache filled on first resolve");
+    assertTrue(ai->target_handle == t1->getHandle(), "Cached handle matches target");
+
+    auto* t2 = world.createEntity("t2");
+    ai->target_entity_id = "t2";
+    assertTrue(world.resolve(ai->target_handle, ai->target_entity_id) == t2, "Retargeting by string refreshes cache");
+
+    world.destroyEntity("t2");
+    assertTrue(world.resolve(ai->target_handle, ai->target_entity_id) == nullptr, "Destroyed target resolves to null");
+    assertTrue(ai->target_handle.isNull(), "Cache cleared for missing target");
+}
+
+namespace {
+// Declared-access probe systems for the scheduler tests
+class ReadCapacitorWriteHealth : public ecs::System {
+public:
+    explicit ReadCapacitorWriteHealth(ecs::World* world) : System(world) {
+        reads<components::Capacitor>();
+        writes<components::Health>();
+    }
+    void update(float) override {
+        world_->each<components::Capacitor, components::Health>(
+            [](ecs::Entity*, components::Capacitor* cap, components::Health* hp) {
+                hp->armor_hp += cap->capacitor * 0.01f;
+            });
+    }
+    std::string getName() const override { return "ReadCapacitorWriteHealth"; }
+};
+
+class UndeclaredSystem : public ecs::System {
+public:
+    using System::System;
+    void update(float) override { ++runs; }
+    std::string getName() const override { return "UndeclaredSystem"; }
+    int runs = 0;
+};
+} // namespace
+
+void testEcsSchedulerDependencies() {
+    std::cout << "\n=== ECS Scheduler Dependencies ===" << std::endl;
+
+    ecs::World world;
+    world.addSystem(std::make_unique<systems::CapacitorSystem>(&world));      // 0: W Capacitor
+    world.addSystem(std::make_unique<systems::ShieldRechargeSystem>(&world)); // 1: W Health
+    world.addSystem(std::make_unique<ReadCapacitorWriteHealth>(&world));      // 2: R Capacitor, W Health
+    world.addSystem(std::make_unique<UndeclaredSystem>(&world));              // 3: exclusive
+    world.addSystem(std::make_unique<systems::CapacitorSystem>(&world));      // 4: W Capacitor
+
+    const auto& scheduler = world.getScheduler();
+    assertTrue(scheduler.getSystemCount() == 5, "Scheduler sees every system");
+    assertTrue(scheduler.getDependencies(0).empty(), "First system is a root");
+    assertTrue(scheduler.getDependencies(1).empty(), "Disjoint writers do not depend on each other");
+    assertTrue(scheduler.getDependencies(2).size() == 2, "Reader/writer depends on both conflicting systems");
+    assertTrue(scheduler.getDependencies(3).size() == 1 && scheduler.getDependencies(3)[0] == 2,
+               "Exclusive system waits on the chain, redundant edges pruned");
+    assertTrue(scheduler.getDependencies(4).size() == 1 && scheduler.getDependencies(4)[0] == 3,
+               "System after a barrier depends only on the barrier");
+    assertTrue(scheduler.getCriticalPathLength() == 4, "Critical path counts sequential stages");
+}
+
+void testEcsSchedulerParallelMatchesSerial() {
+    std::cout << "\n=== ECS Scheduler Parallel Matches Serial ===" << std::endl;
+
+    auto populate = [](ecs::World& world) {
+        for (int i = 0; i < 500; ++i) {
+            auto* e = world.createEntity("ship_" + std::to_string(i));
+            auto* cap = addComp<components::Capacitor>(e);
+            cap->capacitor = static_cast<float>(i % 50);
+            cap->capacitor_max = 100.0f;
+            cap->recharge_rate = 3.0f;
+            auto* hp = addComp<components::Health>(e);
+            hp->shield_hp = static_cast<float>(i % 30);
+            hp->shield_max = 100.0f;
+            hp->shield_recharge_rate = 2.0f;
+            hp->armor_hp = 0.0f;
+        }
+        world.addSystem(std::make_unique<systems::CapacitorSystem>(&world));
+        world.addSystem(std::make_unique<systems::ShieldRechargeSystem>(&world));
+        world.addSystem(std::make_unique<ReadCapacitorWriteHealth>(&world));
+        world.addSystem(std::make_unique<UndeclaredSystem>(&world));
+    };
+
+    ecs::World serial;
+    ecs::World parallel;
+    populate(serial);
+    populate(parallel);
+    parallel.setWorkerThreads(3);
+    assertTrue(parallel.getWorkerThreads() == 3, "Worker count applied");
+
+    for (int tick = 0; tick < 20; ++tick) {
+        serial.update(0.1f);
+        parallel.update(0.1f);
+    }
+
+    bool identical = true;
+    for (int i = 0; i < 500; ++i) {
+        std::string id = "ship_" + std::to_string(i);
+        auto* a = serial.getEntity(id);
+        auto* b = parallel.getEntity(id);
+        auto* cap_a = a->getComponent<components::Capacitor>();
+        auto* cap_b = b->getComponent<components::Capacitor>();
+        auto* hp_a = a->getComponent<components::Health>();
+        auto* hp_b = b->getComponent<components::Health>();
+        if (cap_a->capacitor != cap_b->capacitor || hp_a->shield_hp != hp_b->shield_hp ||
+            hp_a->armor_hp != hp_b->armor_hp) {
+            identical = false;
+        }
+    }
+    assertTrue(identical, "Parallel update matches serial update bit-for-bit");
+
+    parallel.setWorkerThreads(0);
+    parallel.update(0.1f);
+    assertTrue(parallel.getWorkerThreads() == 0, "Workers can be turned off again");
+}
+
+void testEcsThreadPoolNestedTasks() {
+    std::cout << "\n=== ECS Thread Pool Nested Tasks ===" << std::endl;
+
+    for (size_t workers : {0u, 1u, 4u}) {
+        ecs::ThreadPool pool(workers);
+        std::atomic<int> count{0};
+        ecs::TaskGroup outer(pool);
+        for (int i = 0; i < 16; ++i) {
+            outer.run([&pool, &count] {
+                ecs::TaskGroup inner(pool);
+                for (int k = 0; k < 16; ++k) {
+                    inner.run([&count] { count.fetch_add(1); });
+                }
+                inner.wait();
+            });
+        }
+        outer.wait();
+        assertTrue(count.load() == 256, "All nested tasks ran with " + std::to_string(workers) + " workers");
+    }
+}
+
+namespace {
+// Drains capacitor per chunk and defers destruction of empty entities
+class DrainCapacitorSystem : public ecs::SingleComponentSystem<components::Capacitor> {
+public:
+    explicit DrainCapacitorSystem(ecs::World* world) : SingleComponentSystem(world) {
+        enableParallel(16);
+    }
+    std::string getName() const override { return "DrainCapacitorSystem"; }
+    std::vector<std::string> destroyed;
+
+protected:
+    void processEntity(ecs::Entity* entity, components::Capacitor* cap, float dt) override {
+        cap->capacitor = std::max(0.0f, cap->capacitor - cap->recharge_rate * dt);
+        if (cap->capacitor <= 0.0f) {
+            std::string id = entity->getId();
+            defer([this, id] {
+                destroyed.push_back(id);
+                world_->destroyEntity(id);
+            });
+        }
+    }
+};
+} // namespace
+
+void testEcsSingleComponentParallelFor() {
+    std::cout << "\n=== ECS SingleComponentSystem Parallel For ===" << std::endl;
+
+    auto populate = [](ecs::World& world) {
+        for (int i = 0; i < 300; ++i) {
+            auto* e = world.createEntity("drain_" + std::to_string(i));
+            auto* cap = addComp<components::Capacitor>(e);
+            cap->capacitor = static_cast<float>(i % 10);
+            cap->recharge_rate = 10.0f;
+        }
+        auto system = std::make_unique<DrainCapacitorSystem>(&world);
+        auto* raw = system.get();
+        world.addSystem(std::move(system));
+        return raw;
+    };
+
+    ecs::World serial;
+    ecs::World parallel;
+    auto* serial_system = populate(serial);
+    auto* parallel_system = populate(parallel);
+    parallel.setWorkerThreads(4);
+
+    for (int tick = 0; tick < 5; ++tick) {
+        serial.update(0.25f);
+        parallel.update(0.25f);
+    }
+
+    assertTrue(serial.getEntityCount() == parallel.getEntityCount(), "Same survivors in parallel mode");
+    assertTrue(serial_system->destroyed == parallel_system->destroyed,
+               "Deferred effects applied in serial entity order");
+    assertTrue(parallel.getEntityCount() == 0, "Every drained entity destroyed at the sync point");
+}
+
+void testEcsCommandBufferDeferred() {
+    std::cout << "\n=== ECS Command Buffer Deferred ===" << std::endl;
+
+    ecs::World world;
+    world.createEntity("doomed");
+    auto* keeper = world.createEntity("keeper");
+    addComp<components::Capacitor>(keeper);
+
+    auto& cmd = world.commands();
+    cmd.createEntity("spawned", [](ecs::Entity* e) {
+        e->addComponent(std::make_unique<components::Capacitor>());
+    });
+    cmd.addComponent("spawned", std::make_unique<components::Health>());
+    cmd.removeComponent<components::Capacitor>("keeper");
+    cmd.destroyEntity("doomed");
+    cmd.addComponent("missing", std::make_unique<components::Health>());
+
+    assertTrue(cmd.size() == 5, "Commands recorded");
+    assertTrue(world.getEntity("doomed") != nullptr, "Nothing applied before the sync point");
+    assertTrue(world.getEntity("spawned") == nullptr, "Spawn not applied before the sync point");
+
+    world.update(0.1f);
+    auto* spawned = world.getEntity("spawned");
+    assertTrue(spawned != nullptr, "Deferred create applied");
+    assertTrue(spawned && spawned->hasComponent<components::Capacitor>() &&
+               spawned->hasComponent<components::Health>(),
+               "Init callback and later addComponent applied in order");
+    assertTrue(!keeper->hasComponent<components::Capacitor>(), "Deferred removeComponent applied");
+    assertTrue(world.getEntity("doomed") == nullptr, "Deferred destroy applied");
+    assertTrue(world.getEntity("missing") == nullptr, "Command on unknown entity dropped");
+    assertTrue(cmd.empty(), "Buffer cleared by playback");
+}
+
+void testEcsCommandBufferThreads() {
+    std::cout << "\n=== ECS Command Buffer Threads ===" << std::endl;
+
+    ecs::World world;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&world, t] {
+            for (int i = 0; i < 100; ++i) {
+                world.commands().createEntity("t" + std::to_string(t) + "_" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    assertTrue(world.getEntityCount() == 0, "Cross-thread creates deferred");
+    world.flushCommands();
+    assertTrue(world.getEntityCount() == 400, "All per-thread buffers played back");
+}
+
+void testEcsCommandBufferSpawnBatch() {
+    std::cout << "\n=== ECS Command Buffer Spawn Batch ===" << std::endl;
+
+    ecs::World world;
+    std::vector<std::string> ids;
+    for (int i = 0; i < 1000; ++i) ids.push_back("npc_" + std::to_string(i));
+
+    world.commands().spawnBatch<components::Position>(ids, [](ecs::Entity* e, size_t i) {
+        auto pos = std::make_unique<components::Position>();
+        pos->x = static_cast<float>(i);
+        e->addComponent(std::move(pos));
+    });
+    world.flushCommands();
+
+    assertTrue(world.getEntityCount() == 1000, "Batch spawned every entity");
+    assertTrue(world.query<components::Position>().size() == 1000, "Batch components visible to queries");
+    auto* last = world.getEntity("npc_999");
+    assertTrue(last && approxEqual(last->getComponent<components::Position>()->x, 999.0f),
+               "Batch init receives the entity index");
+}
+
+namespace {
+// Declared system that records a structural change through its own buffer
+class RecordingSystem : public ecs::System {
+public:
+    RecordingSystem(ecs::World* world, std::string tag, std::vector<std::string>* log)
+        : System(world), tag_(std::move(tag)), log_(log) {
+        writes<components::Position>();
+    }
+    void update(float) override {
+        commands().run([this](ecs::World&) { log_->push_back(tag_); });
+        commands().createEntity("spawned_by_" + tag_);
+    }
+    std::string getName() const override { return "RecordingSystem"; }
+
+private:
+    std::string tag_;
+    std::vector<std::string>* log_;
+};
+} // namespace
+
+void testEcsCommandBufferSystemOrder() {
+    std::cout << "\n=== ECS Command Buffer System Order ===" << std::endl;
+
+    ecs::World world;
+    std::vector<std::string> log;
+    world.addSystem(std::make_unique<RecordingSystem>(&world, "a", &log));
+    world.addSystem(std::make_unique<RecordingSystem>(&world, "b", &log));
+    world.addSystem(std::make_unique<RecordingSystem>(&world, "c", &log));
+    world.setWorkerThreads(3);
+
+    bool ordered = true;
+    for (int tick = 0; tick < 50; ++tick) {
+        log.clear();
+        world.update(0.1f);
+        ordered = ordered && log == std::vector<std::string>{"a", "b", "c"};
+    }
+    assertTrue(ordered, "System buffers play back in registration order");
+    assertTrue(world.getEntity("spawned_by_b") != nullptr, "System-recorded create applied after the tick");
+}
+
+// ==================== Tick Profiler Tests ====================
+
+namespace {
+constexpr int64_t kMs = 1000000;   // ns
+} // namespace
+
+void testTickProfilerPercentiles() {
+    std::cout << "\n=== Tick Profiler Percentiles ===" << std::endl;
+
+    utils::TickProfiler profiler(1024, 100);
+    int64_t t = 0;
+    for (int tick = 1; tick <= 100; ++tick) {
+        // Two runs in one tick count as their sum
+        profiler.record("ZoneA", utils::ProfileCategory::System, t, t + (tick - 1) * kMs);
+        profiler.record("ZoneA", utils::ProfileCategory::System, t, t + kMs);
+        if (tick % 10 == 0) {
+            profiler.record("ZoneB", utils::ProfileCategory::Network, t, t + 2 * kMs);
+        }
+        profiler.endTick();
+        t += 50 * kMs;
+    }
+
+    auto stats = profiler.getStats();
+    assertTrue(stats.size() == 2, "One entry per zone");
+    assertTrue(stats[0].name == "ZoneA", "Slowest p99 first");
+    assertTrue(stats[0].samples == 100, "One sample per tick");
+    assertTrue(approxEqual(static_cast<float>(stats[0].p50_ms), 50.0f), "p50 over the window");
+    assertTrue(approxEqual(static_cast<float>(stats[0].p99_ms), 99.0f), "p99 over the window");
+    assertTrue(approxEqual(static_cast<float>(stats[0].max_ms), 100.0f), "max over the window");
+    assertTrue(stats[1].samples == 10, "Sparse zone only samples ticks it ran in");
+    assertTrue(profiler.getLastTick().size() == 2, "Last tick lists the zones that ran");
+
+    // The window rolls: 100 more cheap ticks push the old samples out
+    for (int tick = 0; tick < 100; ++tick) {
+        profiler.record("ZoneA", utils::ProfileCategory::System, t, t + kMs);
+        profiler.endTick();
+    }
+    // ZoneB did not run, so its samples stay and it now sorts first
+    stats = profiler.getStats();
+    assertTrue(stats.size() == 2 && stats[1].name == "ZoneA", "Idle zone keeps its samples");
+    assertTrue(approxEqual(static_cast<float>(stats[1].max_ms), 1.0f), "Old samples leave the window");
+    assertTrue(profiler.statsReport(5).find("ZoneA") != std::string::npos, "Report names the zone");
+}
+
+void testTickProfilerRingOverflow() {
+    std::cout << "\n=== Tick Profiler Ring Overflow ===" << std::endl;
+
+    utils::TickProfiler profiler(16);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&profiler] {
+            for (int n = 0; n < 1000; ++n) {
+                profiler.record("Worker", utils::ProfileCategory::Other, 0, kMs);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    profiler.endTick();
+
+    assertTrue(profiler.getDroppedEvents() == 4 * (1000 - 16), "Overwritten events are counted");
+    assertTrue(profiler.getLastTick().size() == 1 &&
+               approxEqual(static_cast<float>(profiler.getLastTick()[0].ms), 64.0f),
+               "Each thread's ring keeps its newest events");
+
+    profiler.setEnabled(false);
+    {
+        utils::ProfileScope zone(&profiler, "Disabled", utils::ProfileCategory::Other);
+    }
+    profiler.endTick();
+    assertTrue(profiler.getLastTick().empty(), "Disabled profiler records nothing");
+}
+
+void testTickProfilerWorldSystems() {
+    std::cout << "\n=== Tick Profiler World Systems ===" << std::endl;
+
+    utils::TickProfiler profiler;
+    ecs::World world;
+    addComp<components::Capacitor>(world.createEntity("ship"));
+    world.addSystem(std::make_unique<systems::CapacitorSystem>(&world));
+    world.addSystem(std::make_unique<UndeclaredSystem>(&world));
+    world.setWorkerThreads(2);
+    world.setProfiler(&profiler);
+
+    for (int tick = 0; tick < 5; ++tick) {
+        world.update(0.1f);
+        profiler.endTick();
+    }
+
+    bool capacitor = false, undeclared = false, sync = false;
+    for (const auto& s : profiler.getStats()) {
+        if (s.name == "CapacitorSystem" && s.samples == 5) capacitor = true;
+        if (s.name == "UndeclaredSystem" && s.samples == 5) undeclared = true;
+        if (s.name == "World::flushCommands" && s.samples == 5) sync = true;
+    }
+    assertTrue(capacitor && undeclared, "Every System::update is timed each tick");
+    assertTrue(sync, "Command sync points are timed");
+
+    std::ostringstream trace;
+    profiler.writeChromeTrace(trace);
+    std::string json = trace.str();
+    assertTrue(json.find("\"traceEvents\"") != std::string::npos, "Trace is in Chrome format");
+    assertTrue(json.find("\"name\":\"UndeclaredSystem\",\"cat\":\"system\",\"ph\":\"X\"")
+               != std::string::npos, "Systems are complete events");
+    assertTrue(json.find("\"thread_name\"") != std::string::npos, "Threads are labelled");
+
+    world.setProfiler(nullptr);
+    world.update(0.1f);
+    profiler.endTick();
+    assertTrue(profiler.getLastTick().empty(), "Unset profiler is no longer fed");
+}
+
+void testPerfMonitorFromProfiler() {
+    std::cout << "\n=== PerfMonitor: From Profiler ===" << std::endl;
+
+    utils::TickProfiler profiler;
+    ecs::World world;
+    systems::ServerPerformanceMonitorSystem sys(&world);
+    world.createEntity("mon_1");
+    sys.initializeMonitor("mon_1", "server_1", 50.0f);
+    sys.setProfiler(&profiler);
+
+    profiler.record("PhysicsSystem", utils::ProfileCategory::System, 0, 10 * kMs);
+    profiler.record("AISystem", utils::ProfileCategory::System, 0, 4 * kMs);
+    profiler.record("net:chat", utils::ProfileCategory::Network, 0, 30 * kMs);
+    profiler.record("Server::tick", utils::ProfileCategory::Tick, 0, 25 * kMs);
+    profiler.endTick();
+
+    sys.update(0.016f);
+    sys.update(0.016f);   // same closed tick: not counted twice
+    auto* metrics = world.getEntity("mon_1")->getComponent<components::ServerPerformanceMetrics>();
+    assertTrue(sys.getSlowestSystem("mon_1") == "PhysicsSystem", "Slowest system from the profiler");
+    assertTrue(metrics->system_timings.size() == 2, "Only system zones become system timings");
+    assertTrue(metrics->total_ticks == 1, "Each closed tick is recorded once");
+    assertTrue(approxEqual(sys.getAverageTickTime("mon_1"), 25.0f), "Tick time from the tick zone");
+}
+
 void run_infrastructure_tests() {
     testLoggerLevels();
     testLoggerFileOutput();
@@ -3195,6 +4132,8 @@ void run_infrastructure_tests() {
     testMetricsUptime();
     testMetricsSummary();
     testMetricsResetWindow();
+    testMetricsSaveTimings();
+    testMetricsJournalFlush();
     testConsoleInit();
     testConsoleHelpCommand();
     testConsoleStatusCommand();
@@ -3218,6 +4157,11 @@ void run_infrastructure_tests() {
     testProtocolScanResultParse();
     testProtocolLootResultParse();
     testProtocolMiningResultParse();
+    testWireFieldRoundTrip();
+    testWireFrameDecode();
+    testWireExtractMessages();
+    testMpscQueueMultiProducer();
+    testTcpServerLoopback();
     testAIMiningState();
     testAIMiningBehaviorActivatesLaser();
     testAIMiningIdleFindsDeposit();
@@ -3291,6 +4235,9 @@ void run_infrastructure_tests() {
     testInterestUnregisterClient();
     testInterestMultipleClients();
     testInterestEntityNoPosition();
+    testInterestSpatialIndexMatchesScan();
+    testInterestTiers();
+    testTargetingLockableTargets();
     testNPCReroutingNoDanger();
     testNPCReroutingDangerousSystem();
     testNPCReroutingCooldown();
@@ -3334,4 +4281,23 @@ void run_infrastructure_tests() {
     testInterestPriorityBandwidth();
     testInterestPriorityInactive();
     testInterestPriorityMissing();
+    testEcsPoolQueryIntersection();
+    testEcsPoolRemoveAndReuse();
+    testEcsPoolRemoveDriverTail();
+    testEcsCachedQueryIncremental();
+    testEcsCachedQueryHits();
+    testEcsEntityHandleGenerations();
+    testEcsEntityHandleCache();
+    testEcsSchedulerDependencies();
+    testEcsSchedulerParallelMatchesSerial();
+    testEcsThreadPoolNestedTasks();
+    testEcsSingleComponentParallelFor();
+    testEcsCommandBufferDeferred();
+    testEcsCommandBufferThreads();
+    testEcsCommandBufferSpawnBatch();
+    testEcsCommandBufferSystemOrder();
+    testTickProfilerPercentiles();
+    testTickProfilerRingOverflow();
+    testTickProfilerWorldSystems();
+    testPerfMonitorFromProfiler();
 }
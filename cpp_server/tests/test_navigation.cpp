@@ -1950,6 +1950,213 @@ void testSpatialHashCellSizeConfig() {
     assertTrue(approxEqual(spatial.getCellSize(), 500.0f), "Negative cell size rejected");
 }
 
+void testSpatialHashRadiusHandles() {
+    std::cout << "\n=== Spatial Hash: Filtered Radius Handles ===" << std::endl;
+    ecs::World world;
+    systems::SpatialHashSystem spatial(&world);
+    spatial.setCellSize(1000.0f);
+
+    for (int i = 0; i < 10; ++i) {
+        auto* e = world.createEntity("rh_" + std::to_string(i));
+        auto* p = addComp<components::Position>(e);
+        p->x = static_cast<float>(i) * 400.0f;
+        if (i % 2 == 0) addComp<components::AI>(e);
+    }
+    spatial.update(0.0f);
+
+    std::vector<ecs::EntityHandle> hits;
+    assertTrue(spatial.queryRadius(0.0f, 0.0f, 0.0f, 2000.0f, hits) == 6,
+               "Unfiltered radius query finds 6 entities within 2 km");
+    assertTrue(spatial.queryRadius<components::AI>(0.0f, 0.0f, 0.0f, 2000.0f, hits) == 3,
+               "Component filter keeps only AI entities");
+    bool all_ai = true;
+    for (auto h : hits) {
+        auto* e = world.resolve(h);
+        if (!e || !e->hasComponent<components::AI>()) all_ai = false;
+    }
+    assertTrue(all_ai, "Returned handles resolve to AI entities");
+
+    world.destroyEntity("rh_0");
+    assertTrue(spatial.queryRadius<components::AI>(0.0f, 0.0f, 0.0f, 2000.0f, hits) == 2,
+               "Entities destroyed since the rebuild are skipped");
+}
+
+void testSpatialHashNearest() {
+    std::cout << "\n=== Spatial Hash: K Nearest ===" << std::endl;
+    ecs::World world;
+    systems::SpatialHashSystem spatial(&world);
+    spatial.setCellSize(1000.0f);
+
+    const float xs[] = {9000.0f, 150.0f, -3000.0f, 400.0f, 150.0f};
+    for (int i = 0; i < 5; ++i) {
+        auto* e = world.createEntity("kn_" + std::to_string(i));
+        addComp<components::Position>(e)->x = xs[i];
+    }
+    spatial.update(0.0f);
+
+    std::vector<ecs::EntityHandle> nearest;
+    assertTrue(spatial.queryNearest(0.0f, 0.0f, 0.0f, 3, 100000.0f, nearest) == 3, "Three nearest returned");
+    assertTrue(nearest.size() == 3 &&
+               *world.getEntityName(nearest[0]) == "kn_1" &&
+               *world.getEntityName(nearest[1]) == "kn_4" &&
+               *world.getEntityName(nearest[2]) == "kn_3",
+               "Closest first, ties broken by creation order");
+    assertTrue(spatial.queryNearest(0.0f, 0.0f, 0.0f, 10, 1000.0f, nearest) == 3,
+               "Max radius caps the search");
+}
+
+void testSpatialHashAITargetSelection() {
+    std::cout << "\n=== Spatial Hash: AI Target Selection ===" << std::endl;
+    ecs::World world;
+    systems::SpatialHashSystem spatial(&world);
+    systems::AISystem ai_sys(&world);
+
+    auto* npc = world.createEntity("sh_npc");
+    addComp<components::Position>(npc);
+    auto* ai = addComp<components::AI>(npc);
+    ai->awareness_range = 20000.0f;
+
+    for (int i = 0; i < 50; ++i) {
+        auto* p = world.createEntity("sh_player_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(p);
+        pos->x = 1500.0f + static_cast<float>((i * 7919) % 60000);
+        pos->y = static_cast<float>((i * 104729) % 3000);
+        addComp<components::Player>(p);
+    }
+    spatial.update(0.0f);
+
+    ecs::Entity* brute = ai_sys.selectTarget(npc);
+    ai_sys.setSpatialIndex(&spatial);
+    ecs::Entity* indexed = ai_sys.selectTarget(npc);
+    assertTrue(brute != nullptr, "Brute-force search finds a target");
+    assertTrue(brute == indexed, "Indexed search picks the same target");
+}
+
+void testSpatialHashIncrementalUpdate() {
+    std::cout << "\n=== Spatial Hash: Incremental Update ===" << std::endl;
+    ecs::World world;
+    systems::SpatialHashSystem spatial(&world);
+    spatial.setCellSize(1000.0f);
+
+    std::vector<components::Position*> positions;
+    for (int i = 0; i < 4; ++i) {
+        auto* e = world.createEntity("inc_" + std::to_string(i));
+        auto* p = addComp<components::Position>(e);
+        p->x = static_cast<float>(i) * 100.0f + 50.0f;
+        positions.push_back(p);
+    }
+    spatial.update(0.0f);
+    auto stats = spatial.getStats();
+    assertTrue(stats.full_rebuilds == 1 && stats.inserted == 4, "First update inserts every entity");
+
+    positions[0]->x += 10.0f;   // stays in its cell
+    spatial.update(0.0f);
+    stats = spatial.getStats();
+    assertTrue(stats.inserted == 0 && stats.cell_changes == 0 && stats.full_rebuilds == 1,
+               "Motion inside a cell relinks nothing");
+
+    positions[1]->x = 5500.0f;  // crosses level-0 cells
+    world.destroyEntity("inc_2");
+    spatial.update(0.0f);
+    stats = spatial.getStats();
+    assertTrue(stats.cell_changes == 1, "Only the entity that crossed a boundary is relinked");
+    assertTrue(stats.removed == 1 && stats.entities == 3, "Destroyed entity is dropped");
+
+    std::vector<ecs::EntityHandle> hits;
+    assertTrue(spatial.queryRadius(5500.0f, 0.0f, 0.0f, 100.0f, hits) == 1 &&
+               *world.getEntityName(hits[0]) == "inc_1",
+               "Moved entity is found at its new position");
+    assertTrue(spatial.queryRadius(150.0f, 0.0f, 0.0f, 10.0f, hits) == 0,
+               "Moved entity is gone from its old cell");
+
+    spatial.setCellSize(2000.0f);
+    spatial.update(0.0f);
+    assertTrue(spatial.getStats().full_rebuilds == 2, "Changing the cell size rebuilds once");
+    assertTrue(spatial.getStats().queries > 0, "Queries are counted");
+}
+
+void testSpatialHashMultiLevelMatchesScan() {
+    std::cout << "\n=== Spatial Hash: Multi-Level Matches Full Scan ===" << std::endl;
+    ecs::World world;
+    systems::SpatialHashSystem spatial(&world);
+    spatial.setCellSize(100.0f);
+    spatial.setLevelCount(4);
+
+    std::vector<components::Position*> positions;
+    for (int i = 0; i < 300; ++i) {
+        auto* e = world.createEntity("ml_" + std::to_string(i));
+        auto* p = addComp<components::Position>(e);
+        p->x = static_cast<float>((i * 7919) % 200000) - 100000.0f;
+        p->y = static_cast<float>((i * 104729) % 20000) - 10000.0f;
+        p->z = static_cast<float>((i * 1299709) % 2000) - 1000.0f;
+        positions.push_back(p);
+    }
+
+    bool all_match = true;
+    std::vector<ecs::EntityHandle> hits;
+    const float radii[] = {50.0f, 900.0f, 12000.0f, 150000.0f};
+    for (int tick = 0; tick < 5; ++tick) {
+        for (size_t i = 0; i < positions.size(); ++i) {
+            positions[i]->x += static_cast<float>(((i + tick) * 31) % 700) - 350.0f;
+            positions[i]->z -= static_cast<float>(((i * tick) * 17) % 90);
+        }
+        spatial.update(0.0f);
+        for (float radius : radii) {
+            size_t expected = 0;
+            world.each<components::Position>([&](ecs::Entity*, components::Position* p) {
+                float d = p->x * p->x + p->y * p->y + p->z * p->z;
+                if (d <= radius * radius) ++expected;
+            });
+            if (spatial.queryRadius(0.0f, 0.0f, 0.0f, radius, hits) != expected) all_match = false;
+        }
+    }
+    assertTrue(all_match, "Radius queries on every level match a full scan after movement");
+    assertTrue(spatial.getOccupiedCellCount(3) <= spatial.getOccupiedCellCount(0),
+               "Coarse levels hold fewer cells");
+}
+
+void testSpatialHashBoxAndRay() {
+    std::cout << "\n=== Spatial Hash: Box And Ray Queries ===" << std::endl;
+    ecs::World world;
+    systems::SpatialHashSystem spatial(&world);
+    spatial.setCellSize(1000.0f);
+
+    const float xs[] = {-500.0f, 2000.0f, 6000.0f, 6000.0f, 30000.0f};
+    const float ys[] = {0.0f, 20.0f, -30.0f, 30.0f, 0.0f};
+    for (int i = 0; i < 5; ++i) {
+        auto* e = world.createEntity("br_" + std::to_string(i));
+        auto* p = addComp<components::Position>(e);
+        p->x = xs[i];
+        p->y = ys[i];
+        if (i != 1) addComp<components::Health>(e);
+    }
+    spatial.update(0.0f);
+
+    std::vector<ecs::EntityHandle> hits;
+    assertTrue(spatial.queryBox(0.0f, -100.0f, -100.0f, 7000.0f, 100.0f, 100.0f, hits) == 3,
+               "Box query finds the three entities inside it");
+    assertTrue(spatial.queryBox<components::Health>(0.0f, -100.0f, -100.0f,
+                                                    7000.0f, 100.0f, 100.0f, hits) == 2,
+               "Box query honours the component filter");
+
+    systems::SpatialHashSystem::RayHit hit;
+    ecs::EntityHandle shooter = world.findHandle("br_0");
+    assertTrue(spatial.raycast(-500.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 50000.0f, 50.0f, hit, shooter) &&
+               *world.getEntityName(hit.handle) == "br_1",
+               "Ray hits the first entity along it, skipping the shooter");
+    assertTrue(approxEqual(hit.distance, 2500.0f - std::sqrt(50.0f * 50.0f - 20.0f * 20.0f), 0.5f),
+               "Hit distance is to the sphere surface");
+    assertTrue(spatial.raycast<components::Health>(-500.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                                                   50000.0f, 50.0f, hit, shooter) &&
+               *world.getEntityName(hit.handle) == "br_2",
+               "Filtered ray skips entities without Health; ties go to the lower slot");
+    assertTrue(!spatial.raycast(-500.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 50000.0f, 50.0f, hit, shooter),
+               "Ray into empty space misses");
+    assertTrue(!spatial.raycast<components::Health>(7000.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                                                    10000.0f, 50.0f, hit),
+               "Max distance limits the ray");
+}
+
 // ==================== WarpHUDTravelMode Tests ====================
 
 void testWarpHUDTravelModeDefaults() {
@@ -3207,6 +3414,12 @@ void run_navigation_tests() {
     testSpatialHashQueryNeighbours();
     testSpatialHashEmptyWorld();
     testSpatialHashCellSizeConfig();
+    testSpatialHashRadiusHandles();
+    testSpatialHashNearest();
+    testSpatialHashAITargetSelection();
+    testSpatialHashIncrementalUpdate();
+    testSpatialHashMultiLevelMatchesScan();
+    testSpatialHashBoxAndRay();
     testWarpHUDTravelModeDefaults();
     testHUDTargetsNonePhase();
     testHUDTargetsCruisePhase();
@@ -30,6 +30,8 @@
 #include "systems/tournament_system.h"
 #include "systems/leaderboard_system.h"
 #include "data/world_persistence.h"
+#include "data/async_world_saver.h"
+#include "data/world_journal.h"
 #include "data/npc_database.h"
 #include "systems/movement_system.h"
 #include "systems/station_system.h"
@@ -109,6 +111,7 @@
 #include "systems/scan_probe_system.h"
 #include "systems/autopilot_system.h"
 #include "network/protocol_handler.h"
+#include "network/wire_format.h"
 #include "ui/server_console.h"
 #include "utils/logger.h"
 #include "utils/server_metrics.h"
@@ -1207,6 +1210,431 @@ void testPersistenceCompressedSmaller() {
     std::remove(gzPath.c_str());
 }
 
+// ==================== Background Saves ====================
+
+void testWorldCloneForSave() {
+    std::cout << "\n=== World Clone For Save ===" << std::endl;
+    ecs::World world;
+    for (int i = 0; i < 20; ++i) {
+        auto* e = world.createEntity("clone_ship_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i);
+        if (i % 2 == 0) {
+            auto* hp = addComp<components::Health>(e);
+            hp->hull_hp = 50.0f + static_cast<float>(i);
+        }
+    }
+    world.destroyEntity("clone_ship_3");   // leave a hole in the slots
+
+    data::WorldPersistence persistence;
+    auto copy = world.clone();
+    assertTrue(copy->getEntityCount() == world.getEntityCount(), "Clone has every entity");
+    assertTrue(persistence.serializeWorld(copy.get()) == persistence.serializeWorld(&world),
+               "Clone serializes identically");
+
+    auto* original = world.getEntity("clone_ship_4");
+    auto* cloned = copy->getEntity("clone_ship_4");
+    assertTrue(cloned != nullptr, "Cloned entity found by ID");
+    assertTrue(cloned->getComponent<components::Position>() !=
+               original->getComponent<components::Position>(), "Clone owns its components");
+    original->getComponent<components::Position>()->x = 999.0f;
+    assertTrue(approxEqual(cloned->getComponent<components::Position>()->x, 4.0f),
+               "Clone unaffected by later changes");
+    assertTrue(!copy->getEntity("clone_ship_5")->hasComponent<components::Health>(),
+               "Clone keeps component membership");
+}
+
+void testAsyncWorldSaverWritesCapturedState() {
+    std::cout << "\n=== Async World Saver ===" << std::endl;
+    ecs::World world;
+    for (int i = 0; i < 50; ++i) {
+        auto* e = world.createEntity("async_ship_" + std::to_string(i));
+        addComp<components::Position>(e)->x = static_cast<float>(i * 10);
+    }
+
+    std::string filepath = "/tmp/eve_async_save_test.json";
+    std::remove(filepath.c_str());
+
+    data::AsyncWorldSaver saver;
+    data::AsyncWorldSaver::Result last;
+    int callbacks = 0;
+    saver.setCompletionHandler([&](const data::AsyncWorldSaver::Result& r) {
+        last = r;
+        ++callbacks;
+    });
+
+    double stall = saver.requestSave(&world, filepath);
+    assertTrue(stall >= 0.0, "Capture time reported");
+    // Changes after the request must not reach this save
+    world.getEntity("async_ship_7")->getComponent<components::Position>()->x = -1.0f;
+    world.destroyEntity("async_ship_8");
+    saver.waitIdle();
+
+    assertTrue(!saver.isBusy(), "Saver idle after waitIdle");
+    assertTrue(saver.getCompletedCount() == 1, "One save completed");
+    assertTrue(callbacks == 1 && last.success, "Completion handler reported success");
+    assertTrue(last.bytes > 0 && last.duration_ms >= 0.0, "Result carries size and duration");
+
+    std::ifstream tmp(filepath + ".tmp");
+    assertTrue(!tmp.good(), "Temporary file renamed away");
+
+    data::WorldPersistence persistence;
+    ecs::World loaded;
+    assertTrue(persistence.loadWorld(&loaded, filepath), "Saved file loads");
+    assertTrue(loaded.getEntityCount() == 50, "Saved state predates the destroy");
+    assertTrue(approxEqual(loaded.getEntity("async_ship_7")->getComponent<components::Position>()->x, 70.0f),
+               "Saved state predates the edit");
+
+    // Compressed saves go through the same path
+    std::string gzPath = "/tmp/eve_async_save_test.json.gz";
+    saver.requestSave(&world, gzPath, data::SaveFormat::CompressedJson);
+    saver.waitIdle();
+    ecs::World loadedGz;
+    assertTrue(persistence.loadWorldCompressed(&loadedGz, gzPath), "Compressed async save loads");
+    assertTrue(loadedGz.getEntityCount() == 49, "Compressed save has current state");
+
+    // Unwritable target fails cleanly
+    saver.requestSave(&world, "/nonexistent_dir/world.json");
+    saver.waitIdle();
+    assertTrue(saver.getFailedCount() == 1 && !last.success, "Failed save reported");
+
+    std::remove(filepath.c_str());
+    std::remove(gzPath.c_str());
+}
+
+// ==================== Binary Save Format ====================
+
+void testBinarySaveRoundTrip() {
+    std::cout << "\n=== Binary Save: Round Trip ===" << std::endl;
+    ecs::World world;
+
+    auto* ship = world.createEntity("bin_ship");
+    auto* pos = addComp<components::Position>(ship);
+    pos->x = 1500.5f; pos->y = -20.0f; pos->z = 7.25f; pos->rotation = 1.5f;
+    auto* hp = addComp<components::Health>(ship);
+    hp->shield_hp = 321.0f;
+    hp->armor_em_resist = 0.6f;
+    auto* s = addComp<components::Ship>(ship);
+    s->ship_name = "Rifter";
+    s->max_locked_targets = 4;
+    auto* player = addComp<components::Player>(ship);
+    player->character_name = "Binary Pilot";
+    player->credits = 123456789.25;
+    auto* formation = addComp<components::FleetFormation>(ship);
+    formation->formation = components::FleetFormation::FormationType::Wedge;
+    formation->slot_index = 3;
+    auto* standings = addComp<components::Standings>(ship);
+    standings->faction_standings["Keldari"] = 2.5f;
+
+    auto* wh = world.createEntity("bin_wormhole");
+    auto* conn = addComp<components::WormholeConnection>(wh);
+    conn->max_mass = 2000000000.0;
+    conn->collapsed = true;
+    world.createEntity("bin_empty");
+
+    data::WorldPersistence persistence;
+    std::string image = persistence.serializeWorldBinary(&world);
+
+    ecs::World loaded;
+    assertTrue(persistence.deserializeWorldBinary(&loaded, image.data(), image.size()),
+               "Binary image loads");
+    assertTrue(loaded.getEntityCount() == 3, "All entities restored, including empty ones");
+
+    auto* lship = loaded.getEntity("bin_ship");
+    assertTrue(lship != nullptr, "Ship restored");
+    auto* lpos = lship->getComponent<components::Position>();
+    assertTrue(lpos && approxEqual(lpos->x, 1500.5f) && approxEqual(lpos->rotation, 1.5f),
+               "Position columns restored");
+    auto* lhp = lship->getComponent<components::Health>();
+    assertTrue(lhp && approxEqual(lhp->shield_hp, 321.0f) && approxEqual(lhp->armor_em_resist, 0.6f),
+               "Health columns restored");
+    auto* ls = lship->getComponent<components::Ship>();
+    assertTrue(ls && ls->ship_name == "Rifter" && ls->max_locked_targets == 4,
+               "String and int columns restored");
+    auto* lplayer = lship->getComponent<components::Player>();
+    assertTrue(lplayer && lplayer->character_name == "Binary Pilot" &&
+               lplayer->credits == 123456789.25, "Double column keeps full precision");
+    auto* lform = lship->getComponent<components::FleetFormation>();
+    assertTrue(lform && lform->formation == components::FleetFormation::FormationType::Wedge &&
+               lform->slot_index == 3, "Enum column restored");
+    auto* lst = lship->getComponent<components::Standings>();
+    assertTrue(lst && approxEqual(lst->faction_standings["Keldari"], 2.5f),
+               "Nested component restored from JSON column");
+    assertTrue(lship->getComponent<components::Velocity>() == nullptr,
+               "Absent component stays absent");
+
+    auto* lconn = loaded.getEntity("bin_wormhole")->getComponent<components::WormholeConnection>();
+    assertTrue(lconn && lconn->max_mass == 2000000000.0 && lconn->collapsed,
+               "Wormhole mass and flag restored");
+}
+
+void testBinarySaveSchemaMigration() {
+    std::cout << "\n=== Binary Save: Schema Migration ===" << std::endl;
+    ecs::World world;
+    auto* e = world.createEntity("mig_ship");
+    auto* pos = addComp<components::Position>(e);
+    pos->x = 42.0f;
+    pos->rotation = 3.0f;
+    auto* vel = addComp<components::Velocity>(e);
+    vel->vx = 9.0f;
+
+    data::WorldPersistence persistence;
+    std::string image = persistence.serializeWorldBinary(&world);
+
+    // Simulate a save from another version: a renamed column and an
+    // unknown component block (same-length renames keep offsets valid)
+    auto rename = [&](const std::string& from, const std::string& to) {
+        size_t at = image.find(from);
+        assertTrue(at != std::string::npos, "Found '" + from + "' in image");
+        image.replace(at, from.size(), to);
+    };
+    rename("rotation", "rotatiox");
+    rename("velocity", "velocitx");
+
+    ecs::World loaded;
+    assertTrue(persistence.deserializeWorldBinary(&loaded, image.data(), image.size()),
+               "Older schema still loads");
+    auto* lpos = loaded.getEntity("mig_ship")->getComponent<components::Position>();
+    assertTrue(lpos && approxEqual(lpos->x, 42.0f), "Known column restored");
+    assertTrue(approxEqual(lpos->rotation, components::Position().rotation),
+               "Field missing from the save keeps its default");
+    assertTrue(loaded.getEntity("mig_ship")->getComponent<components::Velocity>() == nullptr,
+               "Unknown block skipped");
+}
+
+void testBinarySaveRejectsBadInput() {
+    std::cout << "\n=== Binary Save: Rejects Bad Input ===" << std::endl;
+    ecs::World world;
+    for (int i = 0; i < 10; ++i) {
+        auto* e = world.createEntity("bad_" + std::to_string(i));
+        addComp<components::Position>(e)->x = static_cast<float>(i);
+    }
+    data::WorldPersistence persistence;
+    std::string image = persistence.serializeWorldBinary(&world);
+
+    ecs::World w1;
+    assertTrue(!persistence.deserializeWorldBinary(&w1, image.data(), image.size() - 7),
+               "Truncated image rejected");
+    ecs::World w2;
+    std::string json = persistence.serializeWorld(&world);
+    assertTrue(!persistence.deserializeWorldBinary(&w2, json.data(), json.size()),
+               "JSON is not accepted as binary");
+    ecs::World w3;
+    std::string swapped = image;
+    std::swap(swapped[12], swapped[15]);
+    assertTrue(!persistence.deserializeWorldBinary(&w3, swapped.data(), swapped.size()),
+               "Foreign byte order rejected");
+    ecs::World w4;
+    assertTrue(!persistence.loadWorldBinary(&w4, "/tmp/nonexistent_world_save.bin"),
+               "Missing file rejected");
+}
+
+void testLoadWorldFileDetectsFormat() {
+    std::cout << "\n=== Persistence: Load Detects Format ===" << std::endl;
+    ecs::World world;
+    for (int i = 0; i < 100; ++i) {
+        auto* e = world.createEntity("fmt_ship_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i * 1000);
+        auto* ship = addComp<components::Ship>(e);
+        ship->ship_type = "Cruiser";
+    }
+
+    data::WorldPersistence persistence;
+    const std::string paths[] = {"/tmp/eve_fmt_test.json", "/tmp/eve_fmt_test.json.gz",
+                                 "/tmp/eve_fmt_test.bin"};
+    const data::SaveFormat formats[] = {data::SaveFormat::Json, data::SaveFormat::CompressedJson,
+                                        data::SaveFormat::Binary};
+    for (int f = 0; f < 3; ++f) {
+        assertTrue(persistence.saveWorldAs(&world, paths[f], formats[f]), "Saved " + paths[f]);
+        ecs::World loaded;
+        assertTrue(persistence.loadWorldFile(&loaded, paths[f]), "Loaded " + paths[f]);
+        assertTrue(loaded.getEntityCount() == 100, "Entity count matches for " + paths[f]);
+        auto* pos = loaded.getEntity("fmt_ship_99")->getComponent<components::Position>();
+        assertTrue(pos && approxEqual(pos->x, 99000.0f), "Position matches for " + paths[f]);
+    }
+
+    struct stat jsonStat, binStat;
+    stat(paths[0].c_str(), &jsonStat);
+    stat(paths[2].c_str(), &binStat);
+    assertTrue(binStat.st_size < jsonStat.st_size, "Binary save is smaller than JSON");
+
+    for (const auto& p : paths) std::remove(p.c_str());
+}
+
+// ==================== Change Journal ====================
+
+static void makeJournalFleet(ecs::World& world, int count) {
+    for (int i = 0; i < count; ++i) {
+        auto* e = world.createEntity("jrnl_ship_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i * 100);
+        auto* hp = addComp<components::Health>(e);
+        hp->shield_hp = 500.0f;
+        addComp<components::Ship>(e)->ship_name = "Hauler " + std::to_string(i);
+    }
+}
+
+static void removeJournalFiles(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + ".prev").c_str());
+}
+
+void testJournalWritesOnlyChanges() {
+    std::cout << "\n=== Journal: Writes Only Changes ===" << std::endl;
+    std::string path = "/tmp/eve_journal_changes.journal";
+    removeJournalFiles(path);
+
+    ecs::World world;
+    makeJournalFleet(world, 500);
+
+    data::WorldJournal journal;
+    assertTrue(journal.open(&world, path), "Journal opens");
+    assertTrue(journal.flush(&world), "Idle flush succeeds");
+    assertTrue(journal.getLastFlush().bytes == 0 && journal.getRecordCount() == 0,
+               "Nothing changed, nothing written");
+
+    for (int i = 0; i < 3; ++i) {
+        world.getEntity("jrnl_ship_" + std::to_string(i))->getComponent<components::Position>()->x += 5.0f;
+    }
+    assertTrue(journal.flush(&world), "Flush succeeds");
+    const auto& stats = journal.getLastFlush();
+    assertTrue(stats.entities == 3 && stats.rows == 3, "Only the three moved positions written");
+
+    data::WorldPersistence persistence;
+    size_t full = persistence.serializeWorldBinary(&world).size();
+    assertTrue(stats.bytes > 0 && stats.bytes * 20 < full, "Record is a small fraction of a full save");
+    assertTrue(journal.getJournalBytes() == stats.bytes, "Journal size tracks records");
+
+    journal.close();
+    removeJournalFiles(path);
+}
+
+void testJournalReplayRecoversState() {
+    std::cout << "\n=== Journal: Replay Recovers State ===" << std::endl;
+    std::string path = "/tmp/eve_journal_replay.journal";
+    std::string snapshot = "/tmp/eve_journal_replay.bin";
+    removeJournalFiles(path);
+
+    data::WorldPersistence persistence;
+    {
+        ecs::World world;
+        makeJournalFleet(world, 20);
+        addComp<components::Velocity>(world.getEntity("jrnl_ship_4"))->vx = 3.0f;
+        persistence.saveWorldBinary(&world, snapshot);
+
+        data::WorldJournal journal;
+        journal.open(&world, path);
+
+        world.getEntity("jrnl_ship_1")->getComponent<components::Health>()->shield_hp = 12.0f;
+        auto* fresh = world.createEntity("jrnl_new");
+        addComp<components::Position>(fresh)->y = 77.0f;
+        journal.flush(&world);
+
+        world.destroyEntity("jrnl_ship_2");
+        world.getEntity("jrnl_ship_4")->removeComponent<components::Velocity>();
+        addComp<components::Standings>(world.getEntity("jrnl_ship_5"))->faction_standings["Solari"] = 4.0f;
+        world.createEntity("jrnl_bare");   // no components at all
+        journal.flush(&world);
+        assertTrue(journal.getRecordCount() == 2, "Two records written");
+        // Crash: no snapshot, journal not closed cleanly
+    }
+
+    ecs::World recovered;
+    assertTrue(persistence.loadWorldBinary(&recovered, snapshot), "Snapshot loads");
+    data::WorldJournal journal;
+    assertTrue(journal.open(&recovered, path), "Journal replays on open");
+
+    assertTrue(recovered.getEntityCount() == 21, "Entity count after replay");
+    assertTrue(approxEqual(recovered.getEntity("jrnl_ship_1")->getComponent<components::Health>()->shield_hp, 12.0f),
+               "Changed row replayed");
+    assertTrue(approxEqual(recovered.getEntity("jrnl_ship_1")->getComponent<components::Position>()->x, 100.0f),
+               "Unchanged rows come from the snapshot");
+    assertTrue(recovered.getEntity("jrnl_new") &&
+               approxEqual(recovered.getEntity("jrnl_new")->getComponent<components::Position>()->y, 77.0f),
+               "Created entity replayed");
+    assertTrue(recovered.getEntity("jrnl_bare") != nullptr, "Entity without components replayed");
+    assertTrue(recovered.getEntity("jrnl_ship_2") == nullptr, "Destroyed entity stays destroyed");
+    assertTrue(recovered.getEntity("jrnl_ship_4")->getComponent<components::Velocity>() == nullptr,
+               "Removed component stays removed");
+    auto* standings = recovered.getEntity("jrnl_ship_5")->getComponent<components::Standings>();
+    assertTrue(standings && approxEqual(standings->faction_standings["Solari"], 4.0f),
+               "Nested component replayed");
+
+    // The recovered state is the new baseline
+    assertTrue(journal.flush(&recovered) && journal.getLastFlush().bytes == 0,
+               "No changes right after recovery");
+
+    journal.close();
+    removeJournalFiles(path);
+    std::remove(snapshot.c_str());
+}
+
+void testJournalCompactionAndTornTail() {
+    std::cout << "\n=== Journal: Compaction and Torn Tail ===" << std::endl;
+    std::string path = "/tmp/eve_journal_compact.journal";
+    removeJournalFiles(path);
+    auto exists = [](const std::string& p) { std::ifstream f(p); return f.good(); };
+
+    ecs::World world;
+    makeJournalFleet(world, 10);
+    data::WorldJournal journal;
+    journal.open(&world, path);
+
+    auto move = [&](int i) {
+        world.getEntity("jrnl_ship_" + std::to_string(i))->getComponent<components::Position>()->x += 1.0f;
+    };
+    move(0);
+    journal.flush(&world);
+
+    move(1);
+    uint64_t first = journal.beginSnapshot(&world);
+    assertTrue(first == 2 && exists(path + ".prev"), "Snapshot flushes and rotates");
+
+    move(2);
+    journal.flush(&world);
+    // That snapshot failed: the next one finds .prev still there and keeps appending
+    move(3);
+    uint64_t second = journal.beginSnapshot(&world);
+    assertTrue(second == 4, "Second snapshot mark");
+    journal.commitSnapshot(second);
+    assertTrue(!exists(path + ".prev"), "Committed snapshot drops .prev");
+
+    move(4);
+    uint64_t third = journal.beginSnapshot(&world);
+    journal.commitSnapshot(second);   // a late commit for an older snapshot
+    assertTrue(exists(path + ".prev"), "Older commit keeps newer .prev");
+    journal.commitSnapshot(third);
+    assertTrue(!exists(path + ".prev"), "Matching commit drops .prev");
+
+    move(5);
+    journal.flush(&world);
+    uint64_t bytes = journal.getJournalBytes();
+    journal.close();
+
+    // Crash mid-append: a partial record at the end
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << "NFJR\x40partial";
+    }
+    ecs::World fresh;
+    makeJournalFleet(fresh, 10);
+    data::WorldJournal reopened;
+    assertTrue(reopened.open(&fresh, path), "Journal with torn tail opens");
+    assertTrue(approxEqual(fresh.getEntity("jrnl_ship_5")->getComponent<components::Position>()->x, 501.0f),
+               "Records before the tear replayed");
+    assertTrue(reopened.getJournalBytes() == bytes, "Torn tail dropped");
+    fresh.getEntity("jrnl_ship_6")->getComponent<components::Position>()->x += 1.0f;
+    assertTrue(reopened.flush(&fresh), "Appends after the tear");
+    reopened.close();
+
+    size_t valid = 0;
+    ecs::World check;
+    assertTrue(data::WorldJournal::replay(&check, path, &valid) == 2, "Both records readable after repair");
+
+    removeJournalFiles(path);
+}
+
 // ==================== Phase 5 Continued: 200-Ship Multi-System Stress Test ====================
 
 void testStress200ShipMultiSystem() {
@@ -1532,6 +1960,217 @@ void testSnapshotMultipleClients() {
     assertTrue(srs.getTrackedClientCount() == 2, "Two clients tracked");
 }
 
+void testSnapshotBinaryDelta() {
+    std::cout << "\n=== Snapshot: Binary Delta Encoding ===" << std::endl;
+    using namespace atlas::network;
+    using SRS = systems::SnapshotReplicationSystem;
+
+    ecs::World world;
+    SRS srs(&world);
+
+    auto* e = world.createEntity("ship_1");
+    auto* pos = addComp<components::Position>(e);
+    pos->x = 1500.25f; pos->y = -20.0f; pos->z = 7.5f; pos->rotation = 0.5f;
+    auto* hp = addComp<components::Health>(e);
+    hp->shield_hp = 400.0f; hp->shield_max = 500.0f;
+
+    std::string json = srs.buildFullUpdate(2, 1);
+    std::string bin = srs.buildDeltaUpdateBinary(1, 1);
+    assertTrue(bin.size() < json.size() / 2, "Binary update is under half the JSON size");
+
+    WireFrame frame;
+    size_t consumed = 0;
+    assertTrue(decodeFrame(bin.data(), bin.size(), frame, consumed) == FrameStatus::OK &&
+               frame.type == MessageType::STATE_UPDATE, "Binary update is a STATE_UPDATE frame");
+
+    WireReader r(frame.payload);
+    uint64_t seq = 0, ts = 0, count = 0, net_id = 0;
+    uint8_t flags = 0, mask = 0;
+    std::string id;
+    float x = 0, y = 0, z = 0, rot = 0;
+    bool ok = r.readVarUInt(seq) && r.readVarUInt(ts) && r.readU8(flags) &&
+              r.readVarUInt(count) && r.readVarUInt(net_id) && r.readU8(mask);
+    assertTrue(ok && seq == 1 && count == 1 && (flags & SRS::kWireDelta), "Header decodes");
+    assertTrue((mask & SRS::kWireNewEntity) && (mask & SRS::kFieldPosition) &&
+               (mask & SRS::kFieldHealth) && !(mask & SRS::kFieldVelocity),
+               "First appearance introduces the entity with its present fields");
+    ok = r.readString(id) && r.readQuantized(x, kWirePositionStep) &&
+         r.readQuantized(y, kWirePositionStep) && r.readQuantized(z, kWirePositionStep) &&
+         r.readQuantized(rot, kWireRotationStep);
+    assertTrue(ok && id == "ship_1" && approxEqual(x, 1500.25f) && approxEqual(y, -20.0f) &&
+               approxEqual(z, 7.5f) && approxEqual(rot, 0.5f), "Entity ID and position decode");
+
+    // Unchanged → no entities; moved → net ID only, position only
+    bin = srs.buildDeltaUpdateBinary(1, 2);
+    decodeFrame(bin.data(), bin.size(), frame, consumed);
+    WireReader empty(frame.payload);
+    ok = empty.readVarUInt(seq) && empty.readVarUInt(ts) && empty.readU8(flags) &&
+         empty.readVarUInt(count);
+    assertTrue(ok && count == 0 && empty.atEnd(), "No-change binary delta is empty");
+
+    pos->x = 1600.0f;
+    bin = srs.buildDeltaUpdateBinary(1, 3);
+    decodeFrame(bin.data(), bin.size(), frame, consumed);
+    WireReader moved(frame.payload);
+    uint64_t moved_id = 0;
+    ok = moved.readVarUInt(seq) && moved.readVarUInt(ts) && moved.readU8(flags) &&
+         moved.readVarUInt(count) && moved.readVarUInt(moved_id) && moved.readU8(mask);
+    assertTrue(ok && count == 1 && moved_id == net_id && mask == SRS::kFieldPosition,
+               "Later deltas reuse the net ID and carry only changed fields");
+
+    bin = srs.buildFullUpdateBinary(1, 4);
+    decodeFrame(bin.data(), bin.size(), frame, consumed);
+    WireReader full(frame.payload);
+    ok = full.readVarUInt(seq) && full.readVarUInt(ts) && full.readU8(flags);
+    assertTrue(ok && (flags & SRS::kWireReset), "Full binary update tells the client to reset");
+}
+
+void testSnapshotSharedBlocks() {
+    std::cout << "\n=== Snapshot: Blocks Shared Across Clients ===" << std::endl;
+
+    ecs::World world;
+    systems::SnapshotReplicationSystem srs(&world);
+
+    std::vector<components::Position*> positions;
+    for (int i = 0; i < 20; ++i) {
+        auto* e = world.createEntity("ship_" + std::to_string(i));
+        auto* pos = addComp<components::Position>(e);
+        pos->x = static_cast<float>(i) * 100.0f;
+        positions.push_back(pos);
+    }
+
+    srs.update(0.0f);
+    for (int c = 0; c < 10; ++c) srs.buildDeltaUpdate(c, 1);
+    assertTrue(srs.getBlocksEncoded() == 20, "Full state encoded once for ten new clients");
+
+    positions[3]->x += 50.0f;
+    positions[7]->x += 50.0f;
+    srs.update(0.0f);
+    std::string first;
+    bool identical = true;
+    for (int c = 0; c < 10; ++c) {
+        std::string msg = srs.buildDeltaUpdate(c, 2);
+        std::string entities = msg.substr(msg.find("\"entities\""));
+        if (c == 0) first = entities;
+        identical = identical && entities == first;
+    }
+    assertTrue(srs.getBlocksEncoded() == 22, "Only the two changed entities are encoded");
+    assertTrue(identical && first.find("ship_3") != std::string::npos &&
+               first.find("ship_7") != std::string::npos &&
+               first.find("ship_4") == std::string::npos,
+               "Every client receives the same changed entities");
+}
+
+void testSnapshotLaggingClient() {
+    std::cout << "\n=== Snapshot: Lagging Client Catches Up ===" << std::endl;
+
+    ecs::World world;
+    systems::SnapshotReplicationSystem srs(&world);
+    srs.setHistorySize(4);
+
+    auto* a = world.createEntity("ship_a");
+    auto* pa = addComp<components::Position>(a);
+    auto* b = world.createEntity("ship_b");
+    auto* hb = addComp<components::Health>(b);
+    hb->hull_hp = 100.0f;
+    addComp<components::Position>(b);
+
+    srs.update(0.0f);
+    srs.buildDeltaUpdate(1, 1);                 // up to date at snapshot 1
+    srs.buildDeltaUpdate(2, 1);
+
+    // Client 1 skips two snapshots that change different entities
+    pa->x = 10.0f;
+    srs.update(0.0f);
+    srs.buildDeltaUpdate(2, 2);
+    hb->hull_hp = 50.0f;
+    srs.update(0.0f);
+    srs.buildDeltaUpdate(2, 3);
+    auto* c = world.createEntity("ship_c");
+    addComp<components::Position>(c);
+    srs.update(0.0f);
+
+    std::string msg = srs.buildDeltaUpdate(1, 4);
+    assertTrue(msg.find("ship_a") != std::string::npos && msg.find("ship_b") != std::string::npos &&
+               msg.find("ship_c") != std::string::npos, "Union of missed snapshots is sent");
+    assertTrue(msg.find("\"health\"") != std::string::npos &&
+               msg.find("\"hull\":50") != std::string::npos, "Latest published values are sent");
+    assertTrue(srs.getClientBaseline(1) == srs.getLatestSnapshotId(), "Baseline advances");
+
+    // Fall further behind than the ring: every entity is scanned instead
+    for (int i = 0; i < 6; ++i) {
+        pa->x += 5.0f;
+        srs.update(0.0f);
+    }
+    msg = srs.buildDeltaUpdate(1, 5);
+    assertTrue(msg.find("ship_a") != std::string::npos && msg.find("ship_b") == std::string::npos,
+               "Baseline older than the ring still gets exactly the changed entities");
+
+    world.destroyEntity("ship_c");
+    srs.update(0.0f);
+    assertTrue(srs.getTrackedEntityCount(1) == 2, "Destroyed entity is no longer tracked");
+}
+
+void testSnapshotInterestTiers() {
+    std::cout << "\n=== Snapshot: Interest Tiers, Spawn and Despawn ===" << std::endl;
+
+    ecs::World world;
+    systems::InterestManagementSystem ims(&world);
+    systems::SnapshotReplicationSystem srs(&world);
+    ims.setNearRange(100.0f);
+    ims.setMidRange(1000.0f);
+    ims.setFarRange(5000.0f);
+    srs.setInterestManagement(&ims);
+    srs.setTierIntervals(2, 4);
+
+    addComp<components::Position>(world.createEntity("me"));
+    auto* near_pos = addComp<components::Position>(world.createEntity("near"));
+    near_pos->x = 50.0f;
+    auto* far_pos = addComp<components::Position>(world.createEntity("far"));
+    far_pos->x = 3000.0f;
+    auto* out_pos = addComp<components::Position>(world.createEntity("out"));
+    out_pos->x = 9000.0f;
+
+    ims.registerClient(0, "me");
+    auto tick = [&]() { ims.update(0.0f); srs.update(0.0f); };
+
+    tick();
+    std::string msg = srs.buildDeltaUpdate(0, 1);
+    const auto& spawned = srs.getLastSpawned();
+    assertTrue(spawned.size() == 3 && msg.find("\"out\"") == std::string::npos,
+               "Only relevant entities are spawned and sent");
+    assertTrue(srs.getTrackedEntityCount(0) == 3, "Client knows three entities");
+
+    // Both move: near is sent every build, far every fourth
+    int near_sends = 0, far_sends = 0;
+    for (int i = 0; i < 8; ++i) {
+        near_pos->y += 10.0f;
+        far_pos->y += 10.0f;
+        tick();
+        msg = srs.buildDeltaUpdate(0, 2 + i);
+        if (msg.find("\"near\"") != std::string::npos) ++near_sends;
+        if (msg.find("\"far\"") != std::string::npos) ++far_sends;
+    }
+    assertTrue(near_sends == 8 && far_sends == 2, "Far tier refreshes at its own rate");
+
+    // Entering and leaving the relevance set
+    out_pos->x = 60.0f;
+    far_pos->x = 20000.0f;
+    tick();
+    msg = srs.buildDeltaUpdate(0, 20);
+    assertTrue(srs.getLastSpawned().size() == 1 && srs.getLastSpawned()[0] == "out" &&
+               msg.find("\"out\"") != std::string::npos, "Entity entering range is spawned with full state");
+    assertTrue(srs.getLastDespawned().size() == 1 && srs.getLastDespawned()[0] == "far",
+               "Entity leaving range is despawned");
+
+    world.destroyEntity("near");
+    tick();
+    srs.buildDeltaUpdate(0, 21);
+    assertTrue(srs.getLastDespawned().size() == 1 && srs.getLastDespawned()[0] == "near",
+               "Destroyed entity is despawned");
+    assertTrue(srs.getTrackedEntityCount(0) == 2, "Client now knows two entities");
+}
+
 // ==================== Wreck Persistence System Tests ====================
 
 void testWreckPersistenceDefaults() {
@@ -1993,6 +2632,15 @@ void run_persistence_tests() {
     testSerializeDeserializeEconomyComponents();
     testPersistenceCompressedSaveLoad();
     testPersistenceCompressedSmaller();
+    testWorldCloneForSave();
+    testAsyncWorldSaverWritesCapturedState();
+    testBinarySaveRoundTrip();
+    testBinarySaveSchemaMigration();
+    testBinarySaveRejectsBadInput();
+    testLoadWorldFileDetectsFormat();
+    testJournalWritesOnlyChanges();
+    testJournalReplayRecoversState();
+    testJournalCompactionAndTornTail();
     testStress200ShipMultiSystem();
     testStress200ShipPersistence();
     testSnapshotDeltaFirstSendFull();
@@ -2003,6 +2651,10 @@ void run_persistence_tests() {
     testSnapshotClearClient();
     testSnapshotEpsilonFiltering();
     testSnapshotMultipleClients();
+    testSnapshotBinaryDelta();
+    testSnapshotSharedBlocks();
+    testSnapshotLaggingClient();
+    testSnapshotInterestTiers();
     testWreckPersistenceDefaults();
     testWreckPersistenceExpires();
     testWreckPersistenceAssignNPC();
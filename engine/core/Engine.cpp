@@ -460,11 +460,10 @@ void Engine::RunServer() {
             const auto& timeCtx = m_timeModel.Context();
             m_world.Update(timeCtx.sim.fixedDeltaTime);
 
-            // Periodically snapshot world state for rollback support.
             // Snapshot every tick so the server can roll back as needed.
-            auto ecsData = m_world.Serialize();
-            auto snapshot = m_worldState.TakeSnapshot(timeCtx.sim.tick, ecsData);
-            m_worldState.PushSnapshot(std::move(snapshot));
+            // Only the pages that changed since last tick are stored.
+            m_world.SerializeInto(m_tickState);
+            m_worldState.CaptureTick(timeCtx.sim.tick, m_tickState);
             if (m_frameCallback) m_frameCallback(dt);
         });
         m_net.Flush();
@@ -480,10 +479,9 @@ void Engine::RunServer() {
 }
 
 bool Engine::RollbackToTick(uint64_t tick) {
-    const auto* snapshot = m_worldState.SnapshotAtTick(tick);
-    if (!snapshot) return false;
+    if (!m_worldState.RestoreTick(tick, m_tickState)) return false;
 
-    if (!m_world.Deserialize(snapshot->ecsData)) return false;
+    if (!m_world.Deserialize(m_tickState)) return false;
 
     m_timeModel.SetTick(tick);
     return true;
@@ -493,9 +491,8 @@ bool Engine::RollbackAndVerify(uint64_t snapshotTick, uint64_t targetTick) {
     if (snapshotTick >= targetTick) return false;
 
     // Capture the target snapshot hash before rollback.
-    const auto* targetSnap = m_worldState.SnapshotAtTick(targetTick);
-    if (!targetSnap) return false;
-    uint64_t expectedHash = targetSnap->stateHash;
+    uint64_t expectedHash = 0;
+    if (!m_worldState.StateHashAtTick(targetTick, expectedHash)) return false;
 
     // Rollback to the earlier snapshot.
     if (!RollbackToTick(snapshotTick)) return false;
@@ -508,8 +505,8 @@ bool Engine::RollbackAndVerify(uint64_t snapshotTick, uint64_t targetTick) {
     }
 
     // Take a fresh snapshot and compare hashes.
-    auto ecsData = m_world.Serialize();
-    auto replaySnap = m_worldState.TakeSnapshot(targetTick, ecsData);
+    m_world.SerializeInto(m_tickState);
+    auto replaySnap = m_worldState.TakeSnapshot(targetTick, m_tickState);
 
     return replaySnap.stateHash == expectedHash;
 }
@@ -143,6 +143,7 @@ private:
     std::vector<std::string> m_systemOrder;
     std::function<void(float)> m_frameCallback;
     uint64_t m_tickCount = 0;
+    std::vector<uint8_t> m_tickState;  ///< Reused serialize/restore buffer
     int32_t m_mouseX = 0;
     int32_t m_mouseY = 0;
 };
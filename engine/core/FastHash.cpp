@@ -0,0 +1,215 @@
+#include "FastHash.h"
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define ATLAS_FASTHASH_SSE2 1
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+  #include <arm_neon.h>
+  #define ATLAS_FASTHASH_NEON 1
+#endif
+
+namespace atlas {
+
+namespace {
+
+constexpr uint64_t kP0 = 0xa0761d6478bd642fULL;
+constexpr uint64_t kP1 = 0xe7037ed1a0b428dbULL;
+constexpr uint64_t kP2 = 0x8ebc6af09c88c6e3ULL;
+constexpr uint64_t kP3 = 0x589965cc75374cc3ULL;
+constexpr uint64_t kPrime32 = 0x9E3779B1ULL;
+
+constexpr size_t kLanes = 8;
+constexpr size_t kStripe = kLanes * 8;            // 64 bytes
+constexpr size_t kStripesPerBlock = 16;           // 1 KiB per block
+constexpr size_t kSecretWords = kStripesPerBlock + kLanes + 2;
+constexpr size_t kShortLimit = 256;
+
+inline uint64_t Read64(const uint8_t* p) {
+    if constexpr (std::endian::native == std::endian::little) {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    } else {
+        uint64_t v = 0;
+        for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+        return v;
+    }
+}
+
+inline uint64_t Read32(const uint8_t* p) {
+    if constexpr (std::endian::native == std::endian::little) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    } else {
+        return static_cast<uint64_t>(p[0]) | (static_cast<uint64_t>(p[1]) << 8) |
+               (static_cast<uint64_t>(p[2]) << 16) | (static_cast<uint64_t>(p[3]) << 24);
+    }
+}
+
+/// 64x64 -> 128 multiply, folded to 64 bits.
+inline uint64_t Mum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    return lo ^ hi;
+#endif
+}
+
+inline uint64_t Avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t HashShort(const uint8_t* p, size_t size, uint64_t seed) {
+    seed ^= Mum(seed ^ kP0, kP1);
+    uint64_t a, b;
+    if (size <= 16) {
+        if (size >= 4) {
+            size_t mid = (size >> 3) << 2;
+            a = (Read32(p) << 32) | Read32(p + mid);
+            b = (Read32(p + size - 4) << 32) | Read32(p + size - 4 - mid);
+        } else if (size > 0) {
+            a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = size;
+        if (i > 48) {
+            uint64_t s1 = seed, s2 = seed;
+            do {
+                seed = Mum(Read64(p) ^ kP1, Read64(p + 8) ^ seed);
+                s1 = Mum(Read64(p + 16) ^ kP2, Read64(p + 24) ^ s1);
+                s2 = Mum(Read64(p + 32) ^ kP3, Read64(p + 40) ^ s2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= s1 ^ s2;
+        }
+        while (i > 16) {
+            seed = Mum(Read64(p) ^ kP1, Read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = Read64(p + i - 16);
+        b = Read64(p + i - 8);
+    }
+    a ^= kP1;
+    b ^= seed;
+    uint64_t r = Mum(a, b);
+    return Mum(r ^ kP0 ^ size, kP1 ^ b ^ a);
+}
+
+// One stripe: for each lane i, acc[i] += lo32(k) * hi32(k) with
+// k = data ^ key, and the raw data word goes to the neighbour lane.
+// The SIMD versions compute exactly the same values.
+#if defined(ATLAS_FASTHASH_SSE2) && !defined(ATLAS_FASTHASH_SCALAR)
+inline void Accumulate(uint64_t* acc, const uint8_t* stripe, const uint64_t* key) {
+    auto* a = reinterpret_cast<__m128i*>(acc);
+    for (size_t i = 0; i < kLanes / 2; ++i) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stripe) + i);
+        __m128i k = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i));
+        __m128i product = _mm_mul_epu32(k, _mm_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, swapped));
+    }
+}
+#elif defined(ATLAS_FASTHASH_NEON) && !defined(ATLAS_FASTHASH_SCALAR)
+inline void Accumulate(uint64_t* acc, const uint8_t* stripe, const uint64_t* key) {
+    for (size_t i = 0; i < kLanes / 2; ++i) {
+        uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(stripe + 16 * i));
+        uint64x2_t k = veorq_u64(data, vld1q_u64(key + 2 * i));
+        uint32x2_t lo = vmovn_u64(k);
+        uint32x2_t hi = vshrn_n_u64(k, 32);
+        uint64x2_t product = vmull_u32(lo, hi);
+        uint64x2_t swapped = vextq_u64(data, data, 1);
+        uint64x2_t a = vld1q_u64(acc + 2 * i);
+        vst1q_u64(acc + 2 * i, vaddq_u64(a, vaddq_u64(product, swapped)));
+    }
+}
+#else
+inline void Accumulate(uint64_t* acc, const uint8_t* stripe, const uint64_t* key) {
+    for (size_t i = 0; i < kLanes; ++i) {
+        uint64_t v = Read64(stripe + 8 * i);
+        uint64_t k = v ^ key[i];
+        acc[i ^ 1] += v;
+        acc[i] += (k & 0xFFFFFFFFULL) * (k >> 32);
+    }
+}
+#endif
+
+inline void Scramble(uint64_t* acc, const uint64_t* key) {
+    for (size_t i = 0; i < kLanes; ++i) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= key[i];
+        acc[i] = a * kPrime32;
+    }
+}
+
+uint64_t HashLong(const uint8_t* p, size_t size, uint64_t seed) {
+    uint64_t secret[kSecretWords];
+    uint64_t s = seed ^ kP2;
+    for (size_t i = 0; i < kSecretWords; ++i) {
+        s += kP0;
+        secret[i] = Mum(s, s ^ kP1);
+    }
+
+    alignas(16) uint64_t acc[kLanes] = {
+        kPrime32, kP0, kP1, kP2, kP3, 0x85EBCA77C2B2AE63ULL, 0x27D4EB2F165667C5ULL, kPrime32 * kPrime32,
+    };
+
+    const size_t blockBytes = kStripe * kStripesPerBlock;
+    size_t blocks = (size - 1) / blockBytes;
+    for (size_t n = 0; n < blocks; ++n) {
+        const uint8_t* block = p + n * blockBytes;
+        for (size_t s = 0; s < kStripesPerBlock; ++s) {
+            Accumulate(acc, block + s * kStripe, secret + s);
+        }
+        Scramble(acc, secret + kStripesPerBlock);
+    }
+
+    // Whole stripes of the last block, then its final 64 bytes (which
+    // may overlap stripes already read).
+    const uint8_t* tail = p + blocks * blockBytes;
+    size_t stripes = (size - 1 - blocks * blockBytes) / kStripe;
+    for (size_t s = 0; s < stripes; ++s) {
+        Accumulate(acc, tail + s * kStripe, secret + s);
+    }
+    Accumulate(acc, p + size - kStripe, secret + kStripesPerBlock + 1);
+
+    uint64_t h = static_cast<uint64_t>(size) * kP0 ^ seed;
+    for (size_t i = 0; i < kLanes; i += 2) {
+        h += Mum(acc[i] ^ secret[i + 2], acc[i + 1] ^ secret[i + 3]);
+    }
+    return Avalanche(h);
+}
+
+}  // namespace
+
+uint64_t FastHash64(const void* data, size_t size, uint64_t seed) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    return size <= kShortLimit ? HashShort(p, size, seed) : HashLong(p, size, seed);
+}
+
+uint64_t FastHashMix(uint64_t a, uint64_t b) {
+    return Mum(a ^ kP0, b ^ kP1);
+}
+
+}  // namespace atlas
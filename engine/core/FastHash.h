@@ -0,0 +1,36 @@
+#pragma once
+// ============================================================
+// Atlas Fast Hash — 64-bit Non-Cryptographic Buffer Hash
+// ============================================================
+//
+// Seedable 64-bit hash for large buffers (world state, snapshots).
+// Values are identical on every platform: input is read as
+// little-endian words whatever the host byte order.
+//
+//   up to 256 bytes — 16 bytes per step through a 64x64->128
+//                     multiply-fold (wyhash style)
+//   above 256 bytes — 8 independent lanes over 64-byte stripes,
+//                     each lane a 32x32->64 multiply-accumulate
+//                     (xxHash3 style). The lanes have no
+//                     dependency on each other, so compilers
+//                     turn the loop into SSE2 / AVX2 / NEON code.
+//
+// Every stripe in a 1 KiB block is keyed differently and the
+// lanes are scrambled between blocks, so reordering stripes
+// changes the hash.
+//
+// Not a persistent format: save files and asset hashes keep
+// FNV-1a (sim::StateHasher::HashCombine).
+
+#include <cstddef>
+#include <cstdint>
+
+namespace atlas {
+
+/// Hash `size` bytes at `data` with `seed`.
+uint64_t FastHash64(const void* data, size_t size, uint64_t seed = 0);
+
+/// Mix two 64-bit values into one (for chaining hashes).
+uint64_t FastHashMix(uint64_t a, uint64_t b);
+
+}  // namespace atlas
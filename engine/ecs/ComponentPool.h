@@ -0,0 +1,204 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+
+namespace atlas::ecs {
+
+using EntityID = uint32_t;
+using ComponentTypeID = uint32_t;
+
+namespace detail {
+ComponentTypeID NextComponentTypeID();
+}
+
+/// Dense, process-wide index of component type T, assigned on first use.
+/// Only stable for the lifetime of the process; never persist it.
+template<typename T>
+ComponentTypeID ComponentTypeOf() {
+    static const ComponentTypeID id = detail::NextComponentTypeID();
+    return id;
+}
+
+/// Type-erased sparse set for one component type.
+///
+/// Entities are addressed by their World slot. The sparse array maps
+/// slot -> dense position; the dense arrays hold the slots and (in the
+/// typed pool) the component values side by side. Removal swaps the
+/// last element into the hole, so dense order is not stable.
+class IComponentPool {
+public:
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+    explicit IComponentPool(std::type_index type) : m_type(type) {}
+    virtual ~IComponentPool() = default;
+
+    IComponentPool(const IComponentPool&) = delete;
+    IComponentPool& operator=(const IComponentPool&) = delete;
+
+    std::type_index Type() const { return m_type; }
+
+    bool Has(uint32_t slot) const {
+        return slot < m_sparse.size() && m_sparse[slot] != npos;
+    }
+
+    size_t Size() const { return m_slots.size(); }
+
+    /// Bumped by every change, and by World on any mutable access
+    /// (GetComponent, View), since a write through the returned
+    /// pointer cannot be seen. Equal versions mean equal contents.
+    uint64_t Version() const { return m_version; }
+    void MarkChanged() { ++m_version; }
+
+    /// Dense slot array, parallel to the typed pool's Data().
+    const std::vector<uint32_t>& Slots() const { return m_slots; }
+
+    virtual bool Remove(uint32_t slot) = 0;
+    virtual void Clear() = 0;
+
+    // --- Serialization (set up by World::RegisterComponent) ---
+
+    bool Serializable() const { return m_serializable; }
+    uint32_t TypeTag() const { return m_typeTag; }
+    void SetTypeTag(uint32_t tag) {
+        m_typeTag = tag;
+        m_serializable = true;
+    }
+
+    virtual size_t ElementSize() const = 0;
+
+    /// Append the raw bytes of the component at `slot` (must be present).
+    virtual void WriteBytes(uint32_t slot, std::vector<uint8_t>& out) const = 0;
+
+    /// Set the component at `slot` from raw bytes. False if `size` is short.
+    virtual bool ReadBytes(uint32_t slot, const uint8_t* data, size_t size) = 0;
+
+    /// Dense component bytes (ElementSize() apart, parallel to Slots()),
+    /// or nullptr if the type is not stored as raw bytes.
+    virtual const uint8_t* RawData() const = 0;
+
+    // Cached by World::HashComponents()
+    uint64_t hashedVersion = ~uint64_t{0};
+    uint64_t hash = 0;
+
+protected:
+    std::vector<uint32_t> m_sparse;   ///< slot -> dense index
+    std::vector<uint32_t> m_slots;    ///< dense index -> slot
+    uint64_t m_version = 0;
+
+private:
+    std::type_index m_type;
+    uint32_t m_typeTag = 0;
+    bool m_serializable = false;
+};
+
+/// Contiguous storage for components of type T.
+///
+/// Values live in one dense vector, so adding a T may move every other
+/// T: pointers from Get() are valid until the next add or remove of
+/// the same component type.
+template<typename T>
+class ComponentPool final : public IComponentPool {
+public:
+    ComponentPool() : IComponentPool(typeid(T)) {}
+
+    T* Get(uint32_t slot) {
+        return Has(slot) ? &m_data[m_sparse[slot]] : nullptr;
+    }
+
+    const T* Get(uint32_t slot) const {
+        return Has(slot) ? &m_data[m_sparse[slot]] : nullptr;
+    }
+
+    /// Component for a slot known to be present (no membership check).
+    T& At(uint32_t slot) { return m_data[m_sparse[slot]]; }
+
+    /// Insert or overwrite the component for `slot`.
+    T& Set(uint32_t slot, const T& value) {
+        ++m_version;
+        if (Has(slot)) {
+            T& existing = m_data[m_sparse[slot]];
+            existing = value;
+            return existing;
+        }
+        if (slot >= m_sparse.size()) m_sparse.resize(slot + 1, npos);
+        m_sparse[slot] = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back(slot);
+        m_data.push_back(value);
+        return m_data.back();
+    }
+
+    bool Remove(uint32_t slot) override {
+        if (!Has(slot)) return false;
+        ++m_version;
+        uint32_t index = m_sparse[slot];
+        uint32_t last = static_cast<uint32_t>(m_slots.size() - 1);
+        if (index != last) {
+            m_data[index] = std::move(m_data[last]);
+            m_slots[index] = m_slots[last];
+            m_sparse[m_slots[index]] = index;
+        }
+        m_data.pop_back();
+        m_slots.pop_back();
+        m_sparse[slot] = npos;
+        return true;
+    }
+
+    void Clear() override {
+        ++m_version;
+        m_sparse.clear();
+        m_slots.clear();
+        m_data.clear();
+    }
+
+    /// Dense component array, parallel to Slots().
+    std::vector<T>& Data() { return m_data; }
+    const std::vector<T>& Data() const { return m_data; }
+
+    size_t ElementSize() const override { return sizeof(T); }
+
+    const uint8_t* RawData() const override {
+        if constexpr (kRawBytes) {
+            return reinterpret_cast<const uint8_t*>(m_data.data());
+        } else {
+            return nullptr;
+        }
+    }
+
+    void WriteBytes(uint32_t slot, std::vector<uint8_t>& out) const override {
+        if constexpr (kRawBytes) {
+            size_t pos = out.size();
+            out.resize(pos + sizeof(T));
+            std::memcpy(out.data() + pos, &m_data[m_sparse[slot]], sizeof(T));
+        } else {
+            (void)slot;
+            (void)out;
+        }
+    }
+
+    bool ReadBytes(uint32_t slot, const uint8_t* data, size_t size) override {
+        if constexpr (kRawBytes) {
+            if (size < sizeof(T)) return false;
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            Set(slot, value);
+            return true;
+        } else {
+            (void)slot;
+            (void)data;
+            (void)size;
+            return false;
+        }
+    }
+
+    /// Whether T can be serialized as its raw bytes.
+    static constexpr bool kRawBytes =
+        std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+
+private:
+    std::vector<T> m_data;
+};
+
+}
@@ -1,25 +1,107 @@
 #include "ECS.h"
+#include "../core/FastHash.h"
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 
 namespace atlas::ecs {
 
+namespace detail {
+ComponentTypeID NextComponentTypeID() {
+    static std::atomic<ComponentTypeID> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+}
+
+// ---------------------------------------------------------------------------
+// Entity table
+// ---------------------------------------------------------------------------
+
+const World::EntityRecord* World::FindRecord(EntityID id) const {
+    size_t page = id >> kPageBits;
+    if (page >= m_recordPages.size() || !m_recordPages[page]) return nullptr;
+    return &m_recordPages[page][id & ((1u << kPageBits) - 1)];
+}
+
+World::EntityRecord& World::Record(EntityID id) {
+    size_t page = id >> kPageBits;
+    if (page >= m_recordPages.size()) m_recordPages.resize(page + 1);
+    if (!m_recordPages[page]) {
+        m_recordPages[page] = std::make_unique<EntityRecord[]>(size_t{1} << kPageBits);
+    }
+    return m_recordPages[page][id & ((1u << kPageBits) - 1)];
+}
+
+uint32_t World::SlotOf(EntityID id) const {
+    const EntityRecord* record = FindRecord(id);
+    return record ? record->slot : kNoSlot;
+}
+
+uint32_t World::Spawn(EntityID id) {
+    EntityRecord& record = Record(id);
+    if (record.slot != kNoSlot) return record.slot;
+
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_slotEntity.size());
+        m_slotEntity.push_back(0);
+        m_slotDense.push_back(0);
+    }
+    m_slotEntity[slot] = id;
+    m_slotDense[slot] = static_cast<uint32_t>(m_entities.size());
+    m_entities.push_back(id);
+    record.slot = slot;
+    ++m_entityVersion;
+    return slot;
+}
+
+void World::ClearEntities() {
+    for (EntityID id : m_entities) {
+        Record(id).slot = kNoSlot;
+    }
+    m_entities.clear();
+    m_slotEntity.clear();
+    m_slotDense.clear();
+    m_freeSlots.clear();
+    for (auto& pool : m_pools) {
+        if (pool) pool->Clear();
+    }
+    ++m_entityVersion;
+}
+
 EntityID World::CreateEntity() {
     EntityID id = m_nextID++;
-    m_entities.push_back(id);
+    Spawn(id);
     return id;
 }
 
 void World::DestroyEntity(EntityID id) {
-    m_entities.erase(
-        std::remove(m_entities.begin(), m_entities.end(), id),
-        m_entities.end()
-    );
-    m_components.erase(id);
+    uint32_t slot = SlotOf(id);
+    if (slot == kNoSlot) return;
+
+    for (auto& pool : m_pools) {
+        if (pool) pool->Remove(slot);
+    }
+
+    // Swap-remove from the dense entity list.
+    uint32_t index = m_slotDense[slot];
+    EntityID last = m_entities.back();
+    m_entities[index] = last;
+    m_slotDense[SlotOf(last)] = index;
+    m_entities.pop_back();
+
+    m_freeSlots.push_back(slot);
+    ++m_entityVersion;
+    EntityRecord& record = Record(id);
+    record.slot = kNoSlot;
+    ++record.generation;
 }
 
 bool World::IsAlive(EntityID id) const {
-    return std::find(m_entities.begin(), m_entities.end(), id) != m_entities.end();
+    return SlotOf(id) != kNoSlot;
 }
 
 std::vector<EntityID> World::GetEntities() const {
@@ -30,6 +112,11 @@ size_t World::EntityCount() const {
     return m_entities.size();
 }
 
+uint32_t World::Generation(EntityID id) const {
+    const EntityRecord* record = FindRecord(id);
+    return record ? record->generation : 0;
+}
+
 void World::Update(float dt) {
     if (m_tickCallback) {
         m_tickCallback(dt);
@@ -40,55 +127,114 @@ void World::SetTickCallback(std::function<void(float)> cb) {
     m_tickCallback = std::move(cb);
 }
 
+// ---------------------------------------------------------------------------
+// Component pools
+// ---------------------------------------------------------------------------
+
 std::vector<std::type_index> World::GetComponentTypes(EntityID id) const {
     std::vector<std::type_index> types;
-    auto it = m_components.find(id);
-    if (it != m_components.end()) {
-        for (const auto& pair : it->second) {
-            types.push_back(pair.first);
+    uint32_t slot = SlotOf(id);
+    if (slot == kNoSlot) return types;
+    for (const auto& pool : m_pools) {
+        if (pool && pool->Has(slot)) {
+            types.push_back(pool->Type());
         }
     }
     return types;
 }
 
+IComponentPool* World::FindPool(std::type_index key) const {
+    auto it = m_poolsByType.find(key);
+    return it == m_poolsByType.end() ? nullptr : it->second;
+}
+
+void World::RegisterPool(IComponentPool& pool, uint32_t typeTag) {
+    if (pool.Serializable()) {
+        auto it = m_poolsByTag.find(pool.TypeTag());
+        if (it != m_poolsByTag.end() && it->second == &pool) m_poolsByTag.erase(it);
+    }
+    pool.SetTypeTag(typeTag);
+    m_poolsByTag[typeTag] = &pool;
+
+    m_serialPools.erase(std::remove(m_serialPools.begin(), m_serialPools.end(), &pool),
+                        m_serialPools.end());
+    m_serialPools.push_back(&pool);
+    std::stable_sort(m_serialPools.begin(), m_serialPools.end(),
+                     [](const IComponentPool* a, const IComponentPool* b) {
+                         return a->TypeTag() < b->TypeTag();
+                     });
+}
+
 bool World::HasSerializer(std::type_index key) const {
-    return m_serializers.find(key) != m_serializers.end();
+    const IComponentPool* pool = FindPool(key);
+    return pool && pool->Serializable();
 }
 
 uint32_t World::GetTypeTag(std::type_index key) const {
-    auto it = m_serializers.find(key);
-    if (it == m_serializers.end()) return 0;
-    return it->second.typeTag;
+    const IComponentPool* pool = FindPool(key);
+    return pool && pool->Serializable() ? pool->TypeTag() : 0;
 }
 
 std::vector<uint8_t> World::SerializeComponent(EntityID id, std::type_index key) const {
-    auto eit = m_components.find(id);
-    if (eit == m_components.end()) return {};
-    auto cit = eit->second.find(key);
-    if (cit == eit->second.end()) return {};
-    auto sit = m_serializers.find(key);
-    if (sit == m_serializers.end()) return {};
-    return sit->second.serialize(cit->second);
+    std::vector<uint8_t> bytes;
+    const IComponentPool* pool = FindPool(key);
+    uint32_t slot = SlotOf(id);
+    if (pool && pool->Serializable() && pool->Has(slot)) {
+        pool->WriteBytes(slot, bytes);
+    }
+    return bytes;
 }
 
 bool World::DeserializeComponent(EntityID id, uint32_t typeTag, const uint8_t* data, size_t size) {
-    // Find the serializer matching this typeTag
-    for (const auto& [key, ser] : m_serializers) {
-        if (ser.typeTag != typeTag) continue;
+    auto it = m_poolsByTag.find(typeTag);
+    if (it == m_poolsByTag.end()) return false;
+    IComponentPool* pool = it->second;
+    if (size < pool->ElementSize()) return false;
+
+    // Ensure entity exists
+    uint32_t slot = Spawn(id);
+    if (id >= m_nextID) {
+        m_nextID = id + 1;
+        ++m_entityVersion;
+    }
 
-        auto val = ser.deserialize(data, size);
-        if (!val.has_value()) return false;
+    return pool->ReadBytes(slot, data, size);
+}
 
-        // Ensure entity exists
-        if (!IsAlive(id)) {
-            m_entities.push_back(id);
-            if (id >= m_nextID) m_nextID = id + 1;
+// ---------------------------------------------------------------------------
+// State hashing
+// ---------------------------------------------------------------------------
+
+void World::HashComponents(std::vector<ComponentHash>& out) {
+    out.clear();
+
+    // A part's hash is a sum over its entities, so it does not depend on
+    // dense order, which differs after swap-removes and Deserialize().
+    for (IComponentPool* pool : m_serialPools) {
+        if (pool->hashedVersion != pool->Version()) {
+            const uint8_t* bytes = pool->RawData();
+            const size_t size = pool->ElementSize();
+            const auto& slots = pool->Slots();
+            uint64_t sum = 0;
+            for (size_t i = 0; i < slots.size(); ++i) {
+                EntityID id = m_slotEntity[slots[i]];
+                sum += bytes ? FastHash64(bytes + i * size, size, id) : FastHashMix(id, 0);
+            }
+            pool->hash = FastHashMix(sum, slots.size());
+            pool->hashedVersion = pool->Version();
         }
+        out.push_back({pool->TypeTag(), pool->hash});
+    }
 
-        m_components[id][key] = std::move(val);
-        return true;
+    if (m_entityHashVersion != m_entityVersion) {
+        uint64_t sum = 0;
+        for (EntityID id : m_entities) {
+            sum += FastHashMix(id, kEntityTableTag);
+        }
+        m_entityHash = FastHashMix(FastHashMix(sum, m_entities.size()), m_nextID);
+        m_entityHashVersion = m_entityVersion;
     }
-    return false;
+    out.push_back({kEntityTableTag, m_entityHash});
 }
 
 // Binary format:
@@ -101,9 +247,17 @@ bool World::DeserializeComponent(EntityID id, uint32_t typeTag, const uint8_t* d
 //       [uint32_t typeTag]
 //       [uint32_t dataSize]
 //       [uint8_t data[dataSize]]
+//
+// Components are written in type tag order.
 
 std::vector<uint8_t> World::Serialize() const {
     std::vector<uint8_t> buf;
+    SerializeInto(buf);
+    return buf;
+}
+
+void World::SerializeInto(std::vector<uint8_t>& buf) const {
+    buf.clear();
 
     auto writeU32 = [&](uint32_t v) {
         size_t pos = buf.size();
@@ -116,36 +270,22 @@ std::vector<uint8_t> World::Serialize() const {
 
     for (EntityID eid : m_entities) {
         writeU32(eid);
+        uint32_t slot = SlotOf(eid);
 
-        auto cit = m_components.find(eid);
-        if (cit == m_components.end()) {
-            writeU32(0);
-            continue;
-        }
-
-        // Count serializable components
+        // Patched once the entity's components are written
+        size_t countPos = buf.size();
+        writeU32(0);
         uint32_t count = 0;
-        for (const auto& [typeIdx, val] : cit->second) {
-            if (m_serializers.find(typeIdx) != m_serializers.end()) {
-                ++count;
-            }
-        }
-        writeU32(count);
-
-        for (const auto& [typeIdx, val] : cit->second) {
-            auto sit = m_serializers.find(typeIdx);
-            if (sit == m_serializers.end()) continue;
-
-            writeU32(sit->second.typeTag);
-            auto data = sit->second.serialize(val);
-            writeU32(static_cast<uint32_t>(data.size()));
-            size_t pos = buf.size();
-            buf.resize(pos + data.size());
-            std::memcpy(buf.data() + pos, data.data(), data.size());
+
+        for (const IComponentPool* pool : m_serialPools) {
+            if (!pool->Has(slot)) continue;
+            writeU32(pool->TypeTag());
+            writeU32(static_cast<uint32_t>(pool->ElementSize()));
+            pool->WriteBytes(slot, buf);
+            ++count;
         }
+        std::memcpy(buf.data() + countPos, &count, sizeof(uint32_t));
     }
-
-    return buf;
 }
 
 bool World::Deserialize(const std::vector<uint8_t>& data) {
@@ -159,52 +299,53 @@ bool World::Deserialize(const std::vector<uint8_t>& data) {
         return true;
     };
 
-    // Build reverse lookup: typeTag -> (type_index, deserializer)
-    std::unordered_map<uint32_t, std::pair<std::type_index, const ComponentSerializer*>> tagLookup;
-    for (const auto& [typeIdx, cs] : m_serializers) {
-        tagLookup.emplace(cs.typeTag, std::make_pair(typeIdx, &cs));
-    }
-
     uint32_t nextID = 0;
     if (!readU32(nextID)) return false;
 
     uint32_t entityCount = 0;
     if (!readU32(entityCount)) return false;
 
-    // Clear current state
-    m_entities.clear();
-    m_components.clear();
+    // Clear current state. Entities that do not come back count as
+    // destroyed (see Generation()).
+    std::vector<EntityID> previous = m_entities;
+    ClearEntities();
 
     m_nextID = nextID;
 
-    for (uint32_t i = 0; i < entityCount; ++i) {
-        uint32_t eid = 0;
-        if (!readU32(eid)) return false;
-        m_entities.push_back(eid);
+    auto load = [&]() -> bool {
+        for (uint32_t i = 0; i < entityCount; ++i) {
+            uint32_t eid = 0;
+            if (!readU32(eid)) return false;
+            uint32_t slot = Spawn(eid);
+            // Never hand out a loaded ID again, even if nextID says so
+            if (eid >= m_nextID) m_nextID = eid + 1;
 
-        uint32_t compCount = 0;
-        if (!readU32(compCount)) return false;
+            uint32_t compCount = 0;
+            if (!readU32(compCount)) return false;
 
-        for (uint32_t j = 0; j < compCount; ++j) {
-            uint32_t tag = 0;
-            if (!readU32(tag)) return false;
-            uint32_t size = 0;
-            if (!readU32(size)) return false;
+            for (uint32_t j = 0; j < compCount; ++j) {
+                uint32_t tag = 0;
+                if (!readU32(tag)) return false;
+                uint32_t size = 0;
+                if (!readU32(size)) return false;
 
-            if (offset + size > data.size()) return false;
+                if (offset + size > data.size()) return false;
 
-            auto tit = tagLookup.find(tag);
-            if (tit != tagLookup.end()) {
-                auto val = tit->second.second->deserialize(data.data() + offset, size);
-                if (val.has_value()) {
-                    m_components[eid][tit->second.first] = std::move(val);
+                auto it = m_poolsByTag.find(tag);
+                if (it != m_poolsByTag.end()) {
+                    it->second->ReadBytes(slot, data.data() + offset, size);
                 }
+                offset += size;
             }
-            offset += size;
         }
-    }
+        return true;
+    };
+    bool ok = load();
 
-    return true;
+    for (EntityID id : previous) {
+        if (!IsAlive(id)) ++Record(id).generation;
+    }
+    return ok;
 }
 
 }
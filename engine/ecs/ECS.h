@@ -1,29 +1,93 @@
 #pragma once
+#include "ComponentPool.h"
 #include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <typeindex>
 #include <memory>
 #include <functional>
-#include <any>
 #include <string>
-#include <cstring>
+#include <tuple>
 
 namespace atlas::ecs {
 
-using EntityID = uint32_t;
-using ComponentTypeID = uint32_t;
-
 struct ComponentData {
     std::vector<uint8_t> data;
     size_t elementSize = 0;
 };
 
-// Type-erased serializer for a single component type
-struct ComponentSerializer {
-    uint32_t typeTag = 0;
-    std::function<std::vector<uint8_t>(const std::any&)> serialize;
-    std::function<std::any(const uint8_t*, size_t)> deserialize;
+/// Hash of one part of the serializable state, from World::HashComponents().
+struct ComponentHash {
+    uint32_t typeTag = 0;   ///< Registered type tag, or kEntityTableTag
+    uint64_t hash = 0;
+};
+
+/// ComponentHash::typeTag of the entry covering the entity table.
+constexpr uint32_t kEntityTableTag = 0xFFFFFFFFu;
+
+/// Entities that have every component in Ts, from World::View<Ts...>().
+///
+/// Walks the dense slots of the smallest pool and probes the others.
+/// Entities must not be created or destroyed, nor Ts added or removed,
+/// while a view is being iterated.
+template<typename... Ts>
+class ComponentView {
+    static_assert(sizeof...(Ts) > 0, "a view needs at least one component type");
+
+public:
+    class Iterator {
+    public:
+        Iterator(const ComponentView* view, size_t index) : m_view(view), m_index(index) { Skip(); }
+        EntityID operator*() const { return (*m_view->m_slotEntity)[m_view->m_lead->Slots()[m_index]]; }
+        Iterator& operator++() { ++m_index; Skip(); return *this; }
+        bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        void Skip() {
+            if (!m_view->m_lead) return;
+            const auto& slots = m_view->m_lead->Slots();
+            while (m_index < slots.size() && !m_view->Matches(slots[m_index])) ++m_index;
+        }
+
+        const ComponentView* m_view;
+        size_t m_index;
+    };
+
+    ComponentView(const std::vector<EntityID>* slotEntity, ComponentPool<Ts>*... pools)
+        : m_slotEntity(slotEntity), m_pools(pools...) {
+        if ((... && pools)) {
+            for (IComponentPool* pool : {static_cast<IComponentPool*>(pools)...}) {
+                if (!m_lead || pool->Size() < m_lead->Size()) m_lead = pool;
+            }
+        }
+    }
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, m_lead ? m_lead->Size() : 0); }
+
+    /// Call fn(EntityID, Ts&...) for every matching entity.
+    template<typename Fn>
+    void Each(Fn&& fn) const {
+        if (!m_lead) return;
+        const auto& slots = m_lead->Slots();
+        for (size_t i = 0; i < slots.size(); ++i) {
+            uint32_t slot = slots[i];
+            if (!Matches(slot)) continue;
+            fn((*m_slotEntity)[slot], std::get<ComponentPool<Ts>*>(m_pools)->At(slot)...);
+        }
+    }
+
+    /// Upper bound on the number of matches (size of the smallest pool).
+    size_t SizeHint() const { return m_lead ? m_lead->Size() : 0; }
+
+private:
+    bool Matches(uint32_t slot) const {
+        return (... && std::get<ComponentPool<Ts>*>(m_pools)->Has(slot));
+    }
+
+    const std::vector<EntityID>* m_slotEntity;
+    std::tuple<ComponentPool<Ts>*...> m_pools;
+    IComponentPool* m_lead = nullptr;
 };
 
 class World {
@@ -35,70 +99,81 @@ public:
     std::vector<EntityID> GetEntities() const;
     size_t EntityCount() const;
 
+    /// Number of times `id` has been destroyed, including by Deserialize()
+    /// dropping it. IDs handed out after a snapshot are handed out again
+    /// once the world is rolled back to it; an (id, generation) pair
+    /// taken earlier no longer matches the new entity.
+    uint32_t Generation(EntityID id) const;
+
     void Update(float dt);
 
     void SetTickCallback(std::function<void(float)> cb);
 
-    // Component management
+    // Component management. Each component type has its own dense pool,
+    // so a pointer from GetComponent<T>() is only valid until the next
+    // AddComponent/RemoveComponent of T. Components can only be added to
+    // live entities.
     template<typename T>
     void AddComponent(EntityID id, const T& component) {
-        auto key = std::type_index(typeid(T));
-        m_components[id][key] = component;
+        uint32_t slot = SlotOf(id);
+        if (slot == kNoSlot) return;
+        AcquirePool<T>().Set(slot, component);
     }
 
     template<typename T>
     T* GetComponent(EntityID id) {
-        auto it = m_components.find(id);
-        if (it == m_components.end()) return nullptr;
-        auto key = std::type_index(typeid(T));
-        auto cit = it->second.find(key);
-        if (cit == it->second.end()) return nullptr;
-        return std::any_cast<T>(&cit->second);
+        auto* pool = FindPool<T>();
+        if (!pool) return nullptr;
+        T* component = pool->Get(SlotOf(id));
+        if (component) pool->MarkChanged();
+        return component;
     }
 
     template<typename T>
     bool HasComponent(EntityID id) const {
-        auto it = m_components.find(id);
-        if (it == m_components.end()) return false;
-        auto key = std::type_index(typeid(T));
-        return it->second.find(key) != it->second.end();
+        const auto* pool = FindPool<T>();
+        return pool && pool->Has(SlotOf(id));
     }
 
     template<typename T>
     void RemoveComponent(EntityID id) {
-        auto it = m_components.find(id);
-        if (it == m_components.end()) return;
-        auto key = std::type_index(typeid(T));
-        it->second.erase(key);
+        if (auto* pool = FindPool<T>()) pool->Remove(SlotOf(id));
     }
 
     std::vector<std::type_index> GetComponentTypes(EntityID id) const;
 
-    // Component serializer registration (for POD types)
+    /// Iterate the entities that have all of Ts:
+    ///   for (EntityID e : world.View<Position, Velocity>()) ...
+    ///   world.View<Position, Velocity>().Each([](EntityID e, Position& p, Velocity& v) { ... });
+    template<typename... Ts>
+    ComponentView<Ts...> View() {
+        (MarkChanged(FindPool<Ts>()), ...);
+        return ComponentView<Ts...>(&m_slotEntity, FindPool<Ts>()...);
+    }
+
+    // Component serializer registration (for trivially copyable types,
+    // which are serialized as their raw bytes)
     template<typename T>
     void RegisterComponent(uint32_t typeTag) {
-        auto key = std::type_index(typeid(T));
-        ComponentSerializer cs;
-        cs.typeTag = typeTag;
-        cs.serialize = [](const std::any& val) -> std::vector<uint8_t> {
-            const T& v = std::any_cast<const T&>(val);
-            std::vector<uint8_t> buf(sizeof(T));
-            std::memcpy(buf.data(), &v, sizeof(T));
-            return buf;
-        };
-        cs.deserialize = [](const uint8_t* data, size_t size) -> std::any {
-            if (size < sizeof(T)) return {};
-            T v;
-            std::memcpy(&v, data, sizeof(T));
-            return v;
-        };
-        m_serializers[key] = std::move(cs);
+        static_assert(ComponentPool<T>::kRawBytes,
+                      "registered components must be trivially copyable and default-constructible");
+        RegisterPool(AcquirePool<T>(), typeTag);
     }
 
     // ECS state serialization (for snapshot/rollback)
     std::vector<uint8_t> Serialize() const;
+    /// Serialize into `out`, reusing its capacity (for per-tick capture).
+    void SerializeInto(std::vector<uint8_t>& out) const;
     bool Deserialize(const std::vector<uint8_t>& data);
 
+    /// Hash the serializable state by part: one entry per registered
+    /// component type in type tag order, then the entity table. Each
+    /// hash covers the (entity ID, bytes) pairs of its type and does not
+    /// depend on storage order, so equal states hash equal after a
+    /// Deserialize(). Parts whose version has not moved since the last
+    /// call are not rehashed. `out` is overwritten.
+    void HashComponents(std::vector<ComponentHash>& out);
+
     // Query registered serializer info
     bool HasSerializer(std::type_index key) const;
     uint32_t GetTypeTag(std::type_index key) const;
@@ -108,15 +183,68 @@ public:
     bool DeserializeComponent(EntityID id, uint32_t typeTag, const uint8_t* data, size_t size);
 
 private:
+    static constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+    static constexpr uint32_t kPageBits = 12;
+
+    /// Per-ID entry in the paged ID table.
+    struct EntityRecord {
+        uint32_t slot = kNoSlot;    ///< kNoSlot while not alive
+        uint32_t generation = 0;
+    };
+
+    const EntityRecord* FindRecord(EntityID id) const;
+    EntityRecord& Record(EntityID id);
+    uint32_t SlotOf(EntityID id) const;
+
+    /// Make `id` alive if it is not already.
+    uint32_t Spawn(EntityID id);
+    void ClearEntities();
+
+    template<typename T>
+    ComponentPool<T>* FindPool() const {
+        ComponentTypeID type = ComponentTypeOf<T>();
+        if (type >= m_pools.size()) return nullptr;
+        return static_cast<ComponentPool<T>*>(m_pools[type].get());
+    }
+
+    template<typename T>
+    ComponentPool<T>& AcquirePool() {
+        if (auto* pool = FindPool<T>()) return *pool;
+        ComponentTypeID type = ComponentTypeOf<T>();
+        if (type >= m_pools.size()) m_pools.resize(type + 1);
+        auto* pool = new ComponentPool<T>();
+        m_pools[type].reset(pool);
+        m_poolsByType[pool->Type()] = pool;
+        return *pool;
+    }
+
+    IComponentPool* FindPool(std::type_index key) const;
+    void RegisterPool(IComponentPool& pool, uint32_t typeTag);
+    static void MarkChanged(IComponentPool* pool) {
+        if (pool) pool->MarkChanged();
+    }
+
     EntityID m_nextID = 1;
-    std::vector<EntityID> m_entities;
+    std::vector<EntityID> m_entities;   ///< Alive entities, dense
+    uint64_t m_entityVersion = 0;       ///< Bumped when the alive set or m_nextID changes
+    uint64_t m_entityHashVersion = ~uint64_t{0};
+    uint64_t m_entityHash = 0;
     std::function<void(float)> m_tickCallback;
 
-    // Component storage: entity -> (type -> data)
-    std::unordered_map<EntityID, std::unordered_map<std::type_index, std::any>> m_components;
+    // ID -> EntityRecord, allocated 4096 entries at a time so a stray
+    // large ID (e.g. from a packet) costs one page, not a huge array.
+    std::vector<std::unique_ptr<EntityRecord[]>> m_recordPages;
+
+    // Per slot. Slots of destroyed entities are reused.
+    std::vector<EntityID> m_slotEntity;
+    std::vector<uint32_t> m_slotDense;  ///< Index in m_entities
+    std::vector<uint32_t> m_freeSlots;
 
-    // Registered component serializers: type_index -> serializer
-    std::unordered_map<std::type_index, ComponentSerializer> m_serializers;
+    // Component pools, indexed by ComponentTypeOf<T>()
+    std::vector<std::unique_ptr<IComponentPool>> m_pools;
+    std::unordered_map<std::type_index, IComponentPool*> m_poolsByType;
+    std::unordered_map<uint32_t, IComponentPool*> m_poolsByTag;
+    std::vector<IComponentPool*> m_serialPools;   ///< Registered pools in type tag order
 };
 
 }
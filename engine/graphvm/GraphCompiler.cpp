@@ -1,4 +1,6 @@
 #include "GraphCompiler.h"
+#include <algorithm>
+#include <string>
 
 namespace atlas::vm {
 
@@ -13,6 +15,12 @@ Bytecode GraphCompiler::Compile(const graph::Graph& graph) {
     return m_bc;
 }
 
+RegisterProgram GraphCompiler::CompileProgram(const graph::Graph& graph) {
+    RegisterProgram program;
+    Lower(Compile(graph), program);
+    return program;
+}
+
 void GraphCompiler::EmitNode(const graph::Node& node) {
     switch (node.type) {
         case graph::NodeType::Constant: {
@@ -52,4 +60,269 @@ void GraphCompiler::EmitNode(const graph::Node& node) {
     }
 }
 
+// ---------------------------------------------------------------------------
+// Lowering to register code
+// ---------------------------------------------------------------------------
+
+namespace {
+
+bool IsBinary(OpCode op) {
+    switch (op) {
+        case OpCode::ADD: case OpCode::SUB: case OpCode::MUL: case OpCode::DIV:
+        case OpCode::CMP_EQ: case OpCode::CMP_LT: case OpCode::CMP_GT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+RegOp BinaryRegOp(OpCode op) {
+    switch (op) {
+        case OpCode::ADD: return RegOp::ADD;
+        case OpCode::SUB: return RegOp::SUB;
+        case OpCode::MUL: return RegOp::MUL;
+        case OpCode::DIV: return RegOp::DIV;
+        case OpCode::CMP_EQ: return RegOp::CMP_EQ;
+        case OpCode::CMP_LT: return RegOp::CMP_LT;
+        default: return RegOp::CMP_GT;
+    }
+}
+
+/// Stack depth after `inst`, given the depth before it. Popping an empty
+/// stack reads zero and leaves it empty.
+int32_t DepthAfter(const Instruction& inst, int32_t depth) {
+    switch (inst.opcode) {
+        case OpCode::LOAD_CONST:
+        case OpCode::LOAD_VAR:
+        case OpCode::LOAD_ENTITY:
+        case OpCode::LOAD_TICK:
+            return depth + 1;
+        case OpCode::STORE_VAR:
+        case OpCode::JUMP_IF_FALSE:
+            return std::max(depth - 1, 0);
+        default:
+            return IsBinary(inst.opcode) ? std::max(depth - 2, 0) + 1 : depth;
+    }
+}
+
+}
+
+bool GraphCompiler::Lower(const Bytecode& bc, RegisterProgram& out) {
+    out.code.clear();
+    out.constants.assign(bc.constants.begin(), bc.constants.end());
+    out.localIds.clear();
+    out.error.clear();
+
+    const auto n = static_cast<uint32_t>(bc.instructions.size());
+
+    // Pass 1: stack depth at each reachable instruction, and every local
+    // the code names.
+    std::vector<int32_t> depth(n, -1);
+    std::vector<uint8_t> isTarget(n, 0);
+    std::vector<uint32_t> work;
+    int32_t maxDepth = 0;
+    uint32_t conflict = n;
+    auto reach = [&](uint32_t ip, int32_t d) {
+        if (ip >= n) return;
+        if (depth[ip] == -1) {
+            depth[ip] = d;
+            work.push_back(ip);
+        } else if (depth[ip] != d) {
+            conflict = ip;
+        }
+    };
+    reach(0, 0);
+    while (!work.empty() && conflict == n) {
+        uint32_t ip = work.back();
+        work.pop_back();
+        const Instruction& inst = bc.instructions[ip];
+        int32_t after = DepthAfter(inst, depth[ip]);
+        maxDepth = std::max(maxDepth, after);
+
+        if (inst.opcode == OpCode::JUMP || inst.opcode == OpCode::JUMP_IF_FALSE) {
+            if (inst.a < n) isTarget[inst.a] = 1;
+            reach(inst.a, after);
+        }
+        if (inst.opcode != OpCode::JUMP && inst.opcode != OpCode::END) {
+            reach(ip + 1, after);
+        }
+        if (inst.opcode == OpCode::LOAD_VAR || inst.opcode == OpCode::STORE_VAR) {
+            out.localIds.push_back(inst.a);
+        }
+    }
+    if (conflict != n) {
+        out.error = "instruction " + std::to_string(conflict) +
+                    " is reached with different stack depths";
+        return false;
+    }
+    std::sort(out.localIds.begin(), out.localIds.end());
+    out.localIds.erase(std::unique(out.localIds.begin(), out.localIds.end()), out.localIds.end());
+
+    uint64_t frameSize = 1 + uint64_t{out.localIds.size()} + out.constants.size() +
+                         static_cast<uint64_t>(maxDepth);
+    if (frameSize > GraphVM::kMaxRegisters) {
+        out.error = "program needs " + std::to_string(frameSize) + " registers, limit is " +
+                    std::to_string(GraphVM::kMaxRegisters);
+        return false;
+    }
+    out.localBase = 1;
+    out.constBase = out.localBase + out.LocalCount();
+    out.tempBase = out.constBase + static_cast<uint32_t>(out.constants.size());
+    out.frameSize = static_cast<uint32_t>(frameSize);
+
+    auto localReg = [&](uint32_t id) {
+        auto it = std::lower_bound(out.localIds.begin(), out.localIds.end(), id);
+        return out.localBase + static_cast<uint32_t>(it - out.localIds.begin());
+    };
+    auto temp = [&](size_t d) { return out.tempBase + static_cast<uint32_t>(d); };
+
+    // Pass 2: emit. `stack[d]` is the register currently holding stack
+    // entry d. It is temp(d) unless the entry is a constant or local that
+    // has not been copied yet. Every jump and jump target sees the
+    // canonical layout (all temps), so the copies happen there at the
+    // latest.
+    std::vector<uint32_t> stack;
+    std::vector<uint32_t> start(n + 1, 0);
+    struct Fixup {
+        uint32_t at;        // code index of the jump; its .a is still a bytecode index
+        uint32_t depth;     // stack depth it leaves with
+    };
+    std::vector<Fixup> fixups;
+    size_t fence = 0;               // code before this may be a jump target
+
+    auto emit = [&](RegOp op, uint32_t d, uint32_t a, uint32_t b) {
+        out.code.push_back({op, d, a, b});
+    };
+    auto flush = [&]() {
+        for (size_t d = 0; d < stack.size(); ++d) {
+            if (stack[d] != temp(d)) {
+                emit(RegOp::MOV, temp(d), stack[d], 0);
+                stack[d] = temp(d);
+            }
+        }
+    };
+    auto pop = [&]() -> uint32_t {
+        if (stack.empty()) return 0;
+        uint32_t r = stack.back();
+        stack.pop_back();
+        return r;
+    };
+
+    bool live = true;   // the previous instruction can fall through
+    for (uint32_t ip = 0; ip < n; ++ip) {
+        if (depth[ip] < 0) {
+            start[ip] = static_cast<uint32_t>(out.code.size());
+            live = false;
+            continue;
+        }
+        if (isTarget[ip] || !live) {
+            if (live) flush();
+            stack.clear();
+            for (int32_t d = 0; d < depth[ip]; ++d) stack.push_back(temp(static_cast<size_t>(d)));
+            fence = out.code.size();
+        }
+        start[ip] = static_cast<uint32_t>(out.code.size());
+        live = true;
+
+        const Instruction& inst = bc.instructions[ip];
+        switch (inst.opcode) {
+            case OpCode::NOP:
+                break;
+
+            case OpCode::LOAD_CONST:
+                stack.push_back(inst.a < out.constants.size() ? out.constBase + inst.a : 0);
+                break;
+
+            case OpCode::LOAD_VAR:
+                stack.push_back(localReg(inst.a));
+                break;
+
+            case OpCode::LOAD_ENTITY:
+            case OpCode::LOAD_TICK: {
+                uint32_t dst = temp(stack.size());
+                emit(inst.opcode == OpCode::LOAD_ENTITY ? RegOp::LOAD_ENTITY : RegOp::LOAD_TICK, dst, 0, 0);
+                stack.push_back(dst);
+                break;
+            }
+
+            case OpCode::STORE_VAR: {
+                uint32_t value = pop();
+                uint32_t local = localReg(inst.a);
+                // Entries still reading the old value get their own copy
+                for (size_t d = 0; d < stack.size(); ++d) {
+                    if (stack[d] == local) {
+                        emit(RegOp::MOV, temp(d), local, 0);
+                        stack[d] = temp(d);
+                    }
+                }
+                if (value == local) break;
+                // Write the result straight into the local when its
+                // producer is the instruction just emitted
+                if (value == temp(stack.size()) && out.code.size() > fence &&
+                    out.code.back().d == value && out.code.back().op != RegOp::JUMP_IF_FALSE) {
+                    out.code.back().d = local;
+                } else {
+                    emit(RegOp::MOV, local, value, 0);
+                }
+                break;
+            }
+
+            case OpCode::JUMP:
+                flush();
+                fixups.push_back({static_cast<uint32_t>(out.code.size()), static_cast<uint32_t>(stack.size())});
+                emit(RegOp::JUMP, 0, inst.a, 0);
+                live = false;
+                break;
+
+            case OpCode::JUMP_IF_FALSE: {
+                uint32_t cond = pop();
+                flush();
+                fixups.push_back({static_cast<uint32_t>(out.code.size()), static_cast<uint32_t>(stack.size())});
+                emit(RegOp::JUMP_IF_FALSE, cond, inst.a, 0);
+                break;
+            }
+
+            case OpCode::EMIT_EVENT:
+                emit(RegOp::EMIT_EVENT, 0, inst.a, 0);
+                break;
+
+            case OpCode::END:
+                flush();
+                emit(RegOp::END, 0, static_cast<uint32_t>(stack.size()), 0);
+                live = false;
+                break;
+
+            default: {
+                if (!IsBinary(inst.opcode)) break;
+                uint32_t b = pop();
+                uint32_t a = pop();
+                uint32_t dst = temp(stack.size());
+                emit(BinaryRegOp(inst.opcode), dst, a, b);
+                stack.push_back(dst);
+                break;
+            }
+        }
+    }
+
+    // Running off the end, or jumping past it, ends the program. A jump
+    // out that leaves a different stack depth gets its own END.
+    if (live) flush();
+    start[n] = static_cast<uint32_t>(out.code.size());
+    uint32_t endDepth = live ? static_cast<uint32_t>(stack.size()) : 0;
+    emit(RegOp::END, 0, endDepth, 0);
+
+    for (const Fixup& fixup : fixups) {
+        uint32_t target = out.code[fixup.at].a;
+        if (target < n) {
+            out.code[fixup.at].a = start[target];
+        } else if (fixup.depth == endDepth) {
+            out.code[fixup.at].a = start[n];
+        } else {
+            out.code[fixup.at].a = static_cast<uint32_t>(out.code.size());
+            emit(RegOp::END, 0, fixup.depth, 0);
+        }
+    }
+    return true;
+}
+
 }
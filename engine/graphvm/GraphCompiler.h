@@ -8,6 +8,16 @@ class GraphCompiler {
 public:
     Bytecode Compile(const graph::Graph& graph);
 
+    /// Compile straight to register code.
+    RegisterProgram CompileProgram(const graph::Graph& graph);
+
+    /// Translate stack bytecode to register code. Each stack depth gets
+    /// a register, constants and locals are read in place rather than
+    /// copied onto the stack, and a result stored to a local is written
+    /// there directly. Fails (out.error) if two paths reach the same
+    /// instruction with different stack depths. `out`'s buffers are reused.
+    static bool Lower(const Bytecode& bytecode, RegisterProgram& out);
+
 private:
     void EmitNode(const graph::Node& node);
 
@@ -1,123 +1,176 @@
 #include "GraphVM.h"
-#include <cassert>
+#include "GraphCompiler.h"
+#include <algorithm>
+
+// Dispatch through a table of label addresses where the compiler
+// supports it: each handler jumps straight to the next one, instead of
+// every op going back through one shared switch branch.
+#if !defined(ATLAS_VM_NO_COMPUTED_GOTO) && (defined(__GNUC__) || defined(__clang__))
+  #define ATLAS_VM_COMPUTED_GOTO 1
+#else
+  #define ATLAS_VM_COMPUTED_GOTO 0
+#endif
 
 namespace atlas::vm {
 
-void GraphVM::Push(Value v) {
-    m_stack.push_back(v);
+uint32_t RegisterProgram::LocalSlot(uint32_t id) const {
+    auto it = std::lower_bound(localIds.begin(), localIds.end(), id);
+    if (it == localIds.end() || *it != id) return npos;
+    return static_cast<uint32_t>(it - localIds.begin());
 }
 
-Value GraphVM::Pop() {
-    assert(!m_stack.empty());
-    Value v = m_stack.back();
-    m_stack.pop_back();
-    return v;
+GraphVM::GraphVM() : m_frame(kMaxRegisters, 0) {}
+
+void GraphVM::Execute(const Bytecode& bc, VMContext& ctx) {
+    m_stack.clear();
+    if (!GraphCompiler::Lower(bc, m_lowered)) {
+        m_last = nullptr;
+        m_lastError = m_lowered.error;
+        return;
+    }
+    Execute(m_lowered, ctx);
 }
 
-bool GraphVM::PopBool() {
-    return Pop() != 0;
+void GraphVM::Execute(const RegisterProgram& program, VMContext& ctx) {
+    ExecuteBatch(program, &ctx, 1);
 }
 
-void GraphVM::Execute(const Bytecode& bc, VMContext& ctx) {
+bool GraphVM::Prepare(const RegisterProgram& program) {
     m_stack.clear();
-    m_locals.clear();
-
-    uint32_t ip = 0;
-
-    while (ip < bc.instructions.size()) {
-        const Instruction& inst = bc.instructions[ip];
-
-        switch (inst.opcode) {
-            case OpCode::NOP:
-                break;
-
-            case OpCode::LOAD_CONST:
-                Push(bc.constants[inst.a]);
-                break;
-
-            case OpCode::LOAD_VAR:
-                Push(m_locals[inst.a]);
-                break;
-
-            case OpCode::STORE_VAR:
-                m_locals[inst.a] = Pop();
-                break;
-
-            case OpCode::ADD: {
-                auto b = Pop();
-                auto a = Pop();
-                Push(a + b);
-                break;
-            }
-
-            case OpCode::SUB: {
-                auto b = Pop();
-                auto a = Pop();
-                Push(a - b);
-                break;
-            }
-
-            case OpCode::MUL: {
-                auto b = Pop();
-                auto a = Pop();
-                Push(a * b);
-                break;
-            }
-
-            case OpCode::DIV: {
-                auto b = Pop();
-                auto a = Pop();
-                Push(b != 0 ? a / b : 0);
-                break;
-            }
-
-            case OpCode::CMP_EQ: {
-                auto b = Pop();
-                auto a = Pop();
-                Push(a == b ? 1 : 0);
-                break;
-            }
-
-            case OpCode::CMP_LT: {
-                auto b = Pop();
-                auto a = Pop();
-                Push(a < b ? 1 : 0);
-                break;
-            }
-
-            case OpCode::CMP_GT: {
-                auto b = Pop();
-                auto a = Pop();
-                Push(a > b ? 1 : 0);
-                break;
-            }
-
-            case OpCode::JUMP:
-                ip = inst.a;
-                continue;
-
-            case OpCode::JUMP_IF_FALSE:
-                if (!PopBool()) {
-                    ip = inst.a;
-                    continue;
-                }
-                break;
-
-            case OpCode::EMIT_EVENT:
-                // Stub: will be routed to ECS / EventBus
-                break;
-
-            case OpCode::END:
-                return;
-        }
-
-        ++ip;
+    if (!program.Valid() || program.frameSize > kMaxRegisters) {
+        m_last = nullptr;
+        m_lastError = program.error.empty() ? "program was not lowered" : program.error;
+        return false;
+    }
+    m_last = &program;
+    m_lastError.clear();
+
+    m_frame[0] = 0;
+    std::copy(program.constants.begin(), program.constants.end(),
+              m_frame.begin() + program.constBase);
+    return true;
+}
+
+void GraphVM::ExecuteBatch(const RegisterProgram& program, const VMContext* contexts,
+                           size_t count, Value* locals) {
+    if (!Prepare(program)) return;
+
+    const uint32_t localCount = program.LocalCount();
+    Value* frameLocals = m_frame.data() + program.localBase;
+    for (size_t i = 0; i < count; ++i) {
+        Value* row = locals ? locals + i * localCount : nullptr;
+        if (row) std::copy(row, row + localCount, frameLocals);
+        else std::fill(frameLocals, frameLocals + localCount, Value{0});
+
+        Run(program, contexts[i]);
+
+        if (row) std::copy(frameLocals, frameLocals + localCount, row);
     }
 }
 
+void GraphVM::Run(const RegisterProgram& program, const VMContext& ctx) {
+    Value* r = m_frame.data();
+    const RegInstruction* code = program.code.data();
+    const RegInstruction* pc = code;
+
+#if ATLAS_VM_COMPUTED_GOTO
+    // Same order as RegOp
+    static void* const kHandlers[] = {
+        &&op_MOV, &&op_ADD, &&op_SUB, &&op_MUL, &&op_DIV,
+        &&op_CMP_EQ, &&op_CMP_LT, &&op_CMP_GT,
+        &&op_LOAD_ENTITY, &&op_LOAD_TICK,
+        &&op_JUMP, &&op_JUMP_IF_FALSE, &&op_EMIT_EVENT, &&op_END,
+    };
+    static_assert(sizeof(kHandlers) / sizeof(kHandlers[0]) == static_cast<size_t>(RegOp::COUNT),
+                  "GraphVM dispatch table is out of date");
+
+    #define VM_CASE(name) op_##name:
+    #define VM_DISPATCH() goto *kHandlers[static_cast<size_t>(pc->op)]
+    #define VM_NEXT() do { ++pc; VM_DISPATCH(); } while (0)
+    #define VM_JUMP(target) do { pc = code + (target); VM_DISPATCH(); } while (0)
+
+    VM_DISPATCH();
+#else
+    #define VM_CASE(name) case RegOp::name:
+    #define VM_NEXT() do { ++pc; goto dispatch; } while (0)
+    #define VM_JUMP(target) do { pc = code + (target); goto dispatch; } while (0)
+
+dispatch:
+    switch (pc->op) {
+    default:
+#endif
+
+    VM_CASE(MOV)
+        r[pc->d] = r[pc->a];
+        VM_NEXT();
+
+    VM_CASE(ADD)
+        r[pc->d] = r[pc->a] + r[pc->b];
+        VM_NEXT();
+
+    VM_CASE(SUB)
+        r[pc->d] = r[pc->a] - r[pc->b];
+        VM_NEXT();
+
+    VM_CASE(MUL)
+        r[pc->d] = r[pc->a] * r[pc->b];
+        VM_NEXT();
+
+    VM_CASE(DIV) {
+        Value b = r[pc->b];
+        r[pc->d] = b != 0 ? r[pc->a] / b : 0;
+        VM_NEXT();
+    }
+
+    VM_CASE(CMP_EQ)
+        r[pc->d] = r[pc->a] == r[pc->b] ? 1 : 0;
+        VM_NEXT();
+
+    VM_CASE(CMP_LT)
+        r[pc->d] = r[pc->a] < r[pc->b] ? 1 : 0;
+        VM_NEXT();
+
+    VM_CASE(CMP_GT)
+        r[pc->d] = r[pc->a] > r[pc->b] ? 1 : 0;
+        VM_NEXT();
+
+    VM_CASE(LOAD_ENTITY)
+        r[pc->d] = static_cast<Value>(ctx.entity);
+        VM_NEXT();
+
+    VM_CASE(LOAD_TICK)
+        r[pc->d] = static_cast<Value>(ctx.tick);
+        VM_NEXT();
+
+    VM_CASE(JUMP)
+        VM_JUMP(pc->a);
+
+    VM_CASE(JUMP_IF_FALSE)
+        if (r[pc->d] == 0) VM_JUMP(pc->a);
+        VM_NEXT();
+
+    VM_CASE(EMIT_EVENT)
+        // Stub: will be routed to ECS / EventBus
+        VM_NEXT();
+
+    VM_CASE(END)
+        m_stack.assign(r + program.tempBase, r + program.tempBase + pc->a);
+        return;
+
+#if !ATLAS_VM_COMPUTED_GOTO
+    }
+#endif
+
+    #undef VM_CASE
+    #undef VM_NEXT
+    #undef VM_JUMP
+    #undef VM_DISPATCH
+}
+
 Value GraphVM::GetLocal(uint32_t idx) const {
-    auto it = m_locals.find(idx);
-    return it != m_locals.end() ? it->second : 0;
+    if (!m_last) return 0;
+    uint32_t slot = m_last->LocalSlot(idx);
+    return slot == RegisterProgram::npos ? 0 : m_frame[m_last->localBase + slot];
 }
 
 }
@@ -1,13 +1,17 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
-#include <unordered_map>
 
 namespace atlas::vm {
 
 using EntityID = uint32_t;
 using Value = int64_t;
 
+/// Stack bytecode. This is the portable form: it is what AssetBinary
+/// saves and what tools write by hand. GraphVM lowers it to register
+/// code (RegisterProgram) before running it.
 enum class OpCode : uint8_t {
     NOP = 0,
     LOAD_CONST,
@@ -27,7 +31,10 @@ enum class OpCode : uint8_t {
     JUMP_IF_FALSE,
 
     EMIT_EVENT,
-    END
+    END,
+
+    LOAD_ENTITY,    // Push VMContext::entity
+    LOAD_TICK,      // Push VMContext::tick
 };
 
 struct Instruction {
@@ -47,20 +54,109 @@ struct VMContext {
     uint64_t tick = 0;
 };
 
+// ============================================================
+// Register code
+// ============================================================
+//
+// Operands are frame register indices. The frame is laid out as
+//
+//   [0]                     always zero (reads of an empty stack)
+//   [localBase, constBase)  locals, in ascending local-ID order
+//   [constBase, tempBase)   the constant pool, copied in per run
+//   [tempBase, frameSize)   one register per stack depth
+
+enum class RegOp : uint8_t {
+    MOV,            // r[d] = r[a]
+    ADD,            // r[d] = r[a] op r[b]
+    SUB,
+    MUL,
+    DIV,            // 0 when r[b] == 0
+    CMP_EQ,
+    CMP_LT,
+    CMP_GT,
+    LOAD_ENTITY,    // r[d] = ctx.entity
+    LOAD_TICK,      // r[d] = ctx.tick
+    JUMP,           // ip = a
+    JUMP_IF_FALSE,  // if r[d] == 0: ip = a
+    EMIT_EVENT,     // event a (stub: will be routed to ECS / EventBus)
+    END,            // stop; a = values left on the stack
+
+    COUNT
+};
+
+struct RegInstruction {
+    RegOp op;
+    uint32_t d;
+    uint32_t a;
+    uint32_t b;
+};
+
+/// Register program, built by GraphCompiler::Lower / CompileProgram.
+/// Always ends in END and only names registers below frameSize.
+struct RegisterProgram {
+    std::vector<RegInstruction> code;
+    std::vector<Value> constants;
+    std::vector<uint32_t> localIds;   ///< Local ID of each local register
+    uint32_t localBase = 1;
+    uint32_t constBase = 1;
+    uint32_t tempBase = 1;
+    uint32_t frameSize = 1;
+    std::string error;                ///< Why lowering failed, empty if valid
+
+    bool Valid() const { return error.empty() && !code.empty(); }
+    uint32_t LocalCount() const { return static_cast<uint32_t>(localIds.size()); }
+
+    /// Position of local `id` in a batch locals row, or npos if the
+    /// program never touches it.
+    uint32_t LocalSlot(uint32_t id) const;
+
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+};
+
 class GraphVM {
 public:
+    /// Largest frame a program may use.
+    static constexpr uint32_t kMaxRegisters = 4096;
+
+    GraphVM();
+
+    /// Lower `bytecode` and run it. The lowered code is kept in the VM
+    /// and its buffers are reused, but lowering is O(instructions) on
+    /// every call; code that runs every tick should lower once with
+    /// GraphCompiler and call the RegisterProgram overload.
     void Execute(const Bytecode& bytecode, VMContext& ctx);
 
+    /// Run a lowered program. Does not allocate. Locals start at zero.
+    void Execute(const RegisterProgram& program, VMContext& ctx);
+
+    /// Run `program` once for each of `count` contexts. If `locals` is
+    /// set it holds `count` rows of program.LocalCount() values (see
+    /// RegisterProgram::LocalSlot): row i seeds the locals for
+    /// contexts[i] and receives them back afterwards. Without it every
+    /// run starts from zeroed locals.
+    void ExecuteBatch(const RegisterProgram& program, const VMContext* contexts,
+                      size_t count, Value* locals = nullptr);
+
+    /// Local of the most recent run; 0 if it was never stored. After a
+    /// RegisterProgram run this reads through that program, which must
+    /// still be alive.
     Value GetLocal(uint32_t idx) const;
+
+    /// Values left on the stack when the most recent run ended.
     const std::vector<Value>& GetStack() const { return m_stack; }
 
+    /// Why the last Execute did not run, empty if it did.
+    const std::string& LastError() const { return m_lastError; }
+
 private:
-    std::vector<Value> m_stack;
-    std::unordered_map<uint32_t, Value> m_locals;
+    bool Prepare(const RegisterProgram& program);
+    void Run(const RegisterProgram& program, const VMContext& ctx);
 
-    bool PopBool();
-    Value Pop();
-    void Push(Value v);
+    std::vector<Value> m_frame;     ///< kMaxRegisters, allocated once
+    std::vector<Value> m_stack;
+    RegisterProgram m_lowered;      ///< Scratch for Execute(Bytecode)
+    const RegisterProgram* m_last = nullptr;
+    std::string m_lastError;
 };
 
 }
@@ -1,8 +1,87 @@
 #include "DeltaCompression.h"
+#include "Replication.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace atlas::net {
 
+namespace {
+
+// LSB-first bit stream used by the per-peer packets
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void Write(uint32_t value, int bits) {
+        for (int i = 0; i < bits; ++i) {
+            if (m_bit == 0) m_out.push_back(0);
+            if (value & (1u << i)) m_out.back() |= static_cast<uint8_t>(1u << m_bit);
+            m_bit = (m_bit + 1) & 7;
+        }
+    }
+
+    // 6-bit width, then that many bits
+    void WriteVar(uint32_t value) {
+        int width = 0;
+        while (width < 32 && (value >> width) != 0) ++width;
+        Write(static_cast<uint32_t>(width), 6);
+        Write(value, width);
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    int m_bit = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const std::vector<uint8_t>& in) : m_in(in) {}
+
+    uint32_t Read(int bits) {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; ++i) {
+            size_t byte = m_pos >> 3;
+            if (byte >= m_in.size()) { m_failed = true; return 0; }
+            if (m_in[byte] & (1u << (m_pos & 7))) value |= 1u << i;
+            ++m_pos;
+        }
+        return value;
+    }
+
+    uint32_t ReadVar() {
+        uint32_t width = Read(6);
+        if (width > 32) { m_failed = true; return 0; }
+        return Read(static_cast<int>(width));
+    }
+
+    bool Failed() const { return m_failed; }
+
+private:
+    const std::vector<uint8_t>& m_in;
+    size_t m_pos = 0;
+    bool m_failed = false;
+};
+
+uint32_t ZigZag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+int32_t UnZigZag(uint32_t v) {
+    return static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+// Field index -> quantisation group
+constexpr SnapshotField kFieldGroup[7] = {
+    SnapshotField::Position, SnapshotField::Position, SnapshotField::Position,
+    SnapshotField::Velocity, SnapshotField::Velocity, SnapshotField::Velocity,
+    SnapshotField::Rotation
+};
+
+constexpr float kDefaultSteps[3] = {0.01f, 0.01f, 0.1f};
+
+} // namespace
+
 DeltaCompression::DeltaCompression(uint32_t keyframeInterval)
     : m_keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1)
 {}
@@ -157,6 +236,279 @@ void DeltaCompression::Clear() {
     m_forceAll = false;
 }
 
+// ── Per-peer acked baselines ───────────────────────────────────────
+
+void DeltaCompression::AddPeer(uint32_t peerId) {
+    Peer& peer = m_peers[peerId];
+    peer.history.assign(m_historyWindow, HistoryEntry{});
+    peer.acked = 0;
+}
+
+void DeltaCompression::RemovePeer(uint32_t peerId) {
+    m_peers.erase(peerId);
+}
+
+std::vector<uint8_t> DeltaCompression::EncodeForPeer(
+    uint32_t peerId, uint32_t sequence,
+    const std::vector<EntitySnapshot>& snapshots)
+{
+    if (!HasPeer(peerId)) AddPeer(peerId);
+    Peer& peer = m_peers[peerId];
+
+    HistoryEntry current;
+    current.sequence = sequence;
+    quantize(snapshots, current.entities);
+
+    // Delta against the newest acked snapshot still in the window;
+    // anything older (or no ack at all) means a keyframe
+    const HistoryEntry* base = findEntry(peer.history, peer.acked);
+    static const std::vector<QuantizedEntity> kEmpty;
+    const std::vector<QuantizedEntity>& baseEntities = base ? base->entities : kEmpty;
+
+    // Pair current entities with their baseline state (both sorted by id)
+    struct Change { size_t cur; const QuantizedEntity* prev; };
+    std::vector<Change> changes;
+    std::vector<uint32_t> removed;
+    size_t b = 0;
+    for (size_t c = 0; c < current.entities.size(); ++c) {
+        const QuantizedEntity& q = current.entities[c];
+        while (b < baseEntities.size() && baseEntities[b].entityId < q.entityId) {
+            removed.push_back(baseEntities[b++].entityId);
+        }
+        if (b < baseEntities.size() && baseEntities[b].entityId == q.entityId) {
+            const QuantizedEntity& prev = baseEntities[b++];
+            if (!std::equal(q.field, q.field + kFieldCount, prev.field)) {
+                changes.push_back({c, &prev});
+            }
+        } else {
+            changes.push_back({c, nullptr});
+        }
+    }
+    for (; b < baseEntities.size(); ++b) removed.push_back(baseEntities[b].entityId);
+
+    std::vector<uint8_t> packet;
+    BitWriter out(packet);
+    out.Write(sequence, 32);
+    out.Write(base ? base->sequence : 0, 32);
+
+    out.WriteVar(static_cast<uint32_t>(changes.size()));
+    uint32_t prevId = 0;
+    for (const Change& ch : changes) {
+        const QuantizedEntity& q = current.entities[ch.cur];
+        out.WriteVar(q.entityId - prevId);
+        prevId = q.entityId;
+        out.Write(ch.prev ? 1 : 0, 1);
+        if (ch.prev) {
+            uint32_t mask = 0;
+            for (int f = 0; f < kFieldCount; ++f) {
+                if (q.field[f] != ch.prev->field[f]) mask |= 1u << f;
+            }
+            out.Write(mask, kFieldCount);
+            for (int f = 0; f < kFieldCount; ++f) {
+                if (!(mask & (1u << f))) continue;
+                uint32_t d = static_cast<uint32_t>(q.field[f]) -
+                             static_cast<uint32_t>(ch.prev->field[f]);
+                out.WriteVar(ZigZag(static_cast<int32_t>(d)));
+            }
+        } else {
+            for (int f = 0; f < kFieldCount; ++f) out.WriteVar(ZigZag(q.field[f]));
+        }
+    }
+
+    out.WriteVar(static_cast<uint32_t>(removed.size()));
+    prevId = 0;
+    for (uint32_t id : removed) {
+        out.WriteVar(id - prevId);
+        prevId = id;
+    }
+
+    peer.history[sequence % m_historyWindow] = std::move(current);
+    return packet;
+}
+
+void DeltaCompression::Acknowledge(uint32_t peerId, uint32_t sequence) {
+    auto it = m_peers.find(peerId);
+    if (it == m_peers.end()) return;
+    Peer& peer = it->second;
+    if (sequence <= peer.acked) return;                        // stale / duplicate ack
+    if (!findEntry(peer.history, sequence)) return;            // never sent or already evicted
+    peer.acked = sequence;
+}
+
+uint32_t DeltaCompression::AckedSequence(uint32_t peerId) const {
+    auto it = m_peers.find(peerId);
+    return it != m_peers.end() ? it->second.acked : 0;
+}
+
+bool DeltaCompression::DecodePacket(const std::vector<uint8_t>& packet,
+                                    std::vector<EntitySnapshot>& out,
+                                    PeerPacketHeader* header)
+{
+    BitReader in(packet);
+    PeerPacketHeader hdr;
+    hdr.sequence = in.Read(32);
+    hdr.baseline = in.Read(32);
+    if (in.Failed() || hdr.sequence == 0) return false;
+
+    if (m_received.size() != m_historyWindow) {
+        m_received.assign(m_historyWindow, HistoryEntry{});
+    }
+
+    static const std::vector<QuantizedEntity> kEmpty;
+    const std::vector<QuantizedEntity>* baseEntities = &kEmpty;
+    if (hdr.baseline != 0) {
+        const HistoryEntry* base = findEntry(m_received, hdr.baseline);
+        if (!base) return false;
+        baseEntities = &base->entities;
+    }
+    const auto& baseList = *baseEntities;
+    auto findBase = [&](uint32_t id) -> const QuantizedEntity* {
+        auto it = std::lower_bound(baseList.begin(), baseList.end(), id,
+            [](const QuantizedEntity& e, uint32_t v) { return e.entityId < v; });
+        return (it != baseList.end() && it->entityId == id) ? &*it : nullptr;
+    };
+
+    std::vector<QuantizedEntity> changed;
+    uint32_t count = in.ReadVar();
+    uint32_t id = 0;
+    for (uint32_t i = 0; i < count && !in.Failed(); ++i) {
+        QuantizedEntity q;
+        id += in.ReadVar();
+        q.entityId = id;
+        if (in.Read(1)) {
+            const QuantizedEntity* prev = findBase(id);
+            if (!prev) return false;
+            uint32_t mask = in.Read(kFieldCount);
+            for (int f = 0; f < kFieldCount; ++f) {
+                q.field[f] = prev->field[f];
+                if (mask & (1u << f)) {
+                    uint32_t d = static_cast<uint32_t>(UnZigZag(in.ReadVar()));
+                    q.field[f] = static_cast<int32_t>(static_cast<uint32_t>(q.field[f]) + d);
+                }
+            }
+        } else {
+            for (int f = 0; f < kFieldCount; ++f) q.field[f] = UnZigZag(in.ReadVar());
+        }
+        changed.push_back(q);
+    }
+
+    std::vector<uint32_t> removed;
+    count = in.ReadVar();
+    id = 0;
+    for (uint32_t i = 0; i < count && !in.Failed(); ++i) {
+        id += in.ReadVar();
+        removed.push_back(id);
+    }
+    if (in.Failed()) return false;
+
+    // Baseline, minus removals, overlaid with changed/new entities
+    HistoryEntry entry;
+    entry.sequence = hdr.sequence;
+    entry.entities.reserve(baseList.size() + changed.size());
+    size_t c = 0, r = 0;
+    for (const QuantizedEntity& q : baseList) {
+        while (c < changed.size() && changed[c].entityId < q.entityId) {
+            entry.entities.push_back(changed[c++]);
+        }
+        while (r < removed.size() && removed[r] < q.entityId) ++r;
+        if (c < changed.size() && changed[c].entityId == q.entityId) {
+            entry.entities.push_back(changed[c++]);
+        } else if (r >= removed.size() || removed[r] != q.entityId) {
+            entry.entities.push_back(q);
+        }
+    }
+    while (c < changed.size()) entry.entities.push_back(changed[c++]);
+
+    out.clear();
+    out.reserve(entry.entities.size());
+    for (const QuantizedEntity& q : entry.entities) {
+        out.push_back(dequantize(q, hdr.sequence));
+    }
+    if (header) *header = hdr;
+
+    // Keep it as a future baseline unless a newer packet owns the slot
+    HistoryEntry& slot = m_received[hdr.sequence % m_historyWindow];
+    if (slot.sequence < hdr.sequence) slot = std::move(entry);
+    return true;
+}
+
+void DeltaCompression::SetHistoryWindow(uint32_t window) {
+    m_historyWindow = window > 0 ? window : 1;
+    for (auto& [id, peer] : m_peers) {
+        peer.history.assign(m_historyWindow, HistoryEntry{});
+        peer.acked = 0;
+    }
+    m_received.clear();
+}
+
+void DeltaCompression::SetQuantization(SnapshotField field, float step) {
+    auto idx = static_cast<size_t>(field);
+    m_steps[idx] = step > 0.0f ? step : kDefaultSteps[idx];
+}
+
+float DeltaCompression::Quantization(SnapshotField field) const {
+    return m_steps[static_cast<size_t>(field)];
+}
+
+void DeltaCompression::ApplyRule(SnapshotField field, const ReplicationRule& rule) {
+    SetQuantization(field, rule.quantizeStep);
+}
+
+// ── Per-peer internals ─────────────────────────────────────────────
+
+const DeltaCompression::HistoryEntry* DeltaCompression::findEntry(
+    const std::vector<HistoryEntry>& ring, uint32_t sequence) const
+{
+    if (sequence == 0 || ring.empty()) return nullptr;
+    const HistoryEntry& e = ring[sequence % ring.size()];
+    return e.sequence == sequence ? &e : nullptr;
+}
+
+void DeltaCompression::quantize(const std::vector<EntitySnapshot>& in,
+                                std::vector<QuantizedEntity>& out) const
+{
+    out.clear();
+    out.reserve(in.size());
+    for (const auto& snap : in) {
+        const float values[kFieldCount] = {
+            snap.posX, snap.posY, snap.posZ,
+            snap.velX, snap.velY, snap.velZ, snap.rotYaw
+        };
+        QuantizedEntity q;
+        q.entityId = snap.entityId;
+        for (int f = 0; f < kFieldCount; ++f) {
+            double v = std::round(static_cast<double>(values[f]) /
+                                  m_steps[static_cast<size_t>(kFieldGroup[f])]);
+            v = std::clamp(v, static_cast<double>(std::numeric_limits<int32_t>::min()),
+                              static_cast<double>(std::numeric_limits<int32_t>::max()));
+            q.field[f] = std::isnan(v) ? 0 : static_cast<int32_t>(v);
+        }
+        out.push_back(q);
+    }
+    // Sorted, one entry per id (first occurrence wins)
+    std::stable_sort(out.begin(), out.end(),
+        [](const QuantizedEntity& a, const QuantizedEntity& b) { return a.entityId < b.entityId; });
+    out.erase(std::unique(out.begin(), out.end(),
+        [](const QuantizedEntity& a, const QuantizedEntity& b) { return a.entityId == b.entityId; }),
+        out.end());
+}
+
+EntitySnapshot DeltaCompression::dequantize(const QuantizedEntity& q,
+                                            uint32_t tick) const
+{
+    float v[kFieldCount];
+    for (int f = 0; f < kFieldCount; ++f) {
+        v[f] = static_cast<float>(q.field[f]) * m_steps[static_cast<size_t>(kFieldGroup[f])];
+    }
+    EntitySnapshot snap;
+    snap.entityId = q.entityId;
+    snap.tick     = tick;
+    snap.posX = v[0]; snap.posY = v[1]; snap.posZ = v[2];
+    snap.velX = v[3]; snap.velY = v[4]; snap.velZ = v[5];
+    snap.rotYaw = v[6];
+    return snap;
+}
+
 // ── Internals ──────────────────────────────────────────────────────
 
 bool DeltaCompression::needsKeyframe(uint32_t entityId,
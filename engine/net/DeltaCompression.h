@@ -6,6 +6,8 @@
 
 namespace atlas::net {
 
+struct ReplicationRule;
+
 /**
  * Frame type for delta-compressed snapshots.
  *   Keyframe  — full snapshot (baseline), sent periodically
@@ -48,6 +50,19 @@ struct CompressedFrame {
     std::vector<CompressedSnapshot> entries;
 };
 
+/** Field groups of an EntitySnapshot that carry their own quantisation. */
+enum class SnapshotField : uint8_t {
+    Position = 0,
+    Velocity = 1,
+    Rotation = 2
+};
+
+/** Header of a bit-packed peer packet (see EncodeForPeer). */
+struct PeerPacketHeader {
+    uint32_t sequence = 0;
+    uint32_t baseline = 0;   ///< 0 = keyframe
+};
+
 /**
  * @brief Server-side delta compression for entity state snapshots.
  *
@@ -69,6 +84,23 @@ struct CompressedFrame {
  *   1. Each server tick, call Encode() with the full snapshots.
  *   2. Serialise the returned CompressedFrame into a Packet payload.
  *   3. On the client, call Decode() to reconstruct full snapshots.
+ *
+ * Encode()/Decode() assume every frame arrives.  For lossy links use the
+ * per-peer API instead (Quake 3 style):
+ *   1. Server: EncodeForPeer(peer, sequence, snapshots) each tick.  The
+ *      packet is a delta against the last snapshot the peer acknowledged,
+ *      or a keyframe when there is no ack inside the history window.
+ *   2. Client: DecodePacket() rebuilds the full snapshot set from its own
+ *      copy of that baseline, then acks the packet's sequence.
+ *   3. Server: Acknowledge(peer, sequence) moves the peer's baseline.
+ * A dropped packet just means the next one is diffed against an older
+ * baseline; nothing needs resending and no keyframe is forced.
+ *
+ * Peer packets are bit-packed.  Only entities whose quantised state
+ * differs from the baseline are written, each with a 7-bit field mask
+ * and every changed field as a zig-zag delta prefixed by its bit width.
+ * Entities missing from the current set are listed as removed.  Steps
+ * come from SetQuantization() / ApplyRule() and must match on both ends.
  */
 class DeltaCompression {
 public:
@@ -101,6 +133,49 @@ public:
     /** Get the keyframe interval. */
     uint32_t KeyframeInterval() const { return m_keyframeInterval; }
 
+    // ── Per-peer acked-baseline encoding ───────────────────────────
+
+    /** Start tracking a peer (EncodeForPeer adds unknown peers itself). */
+    void AddPeer(uint32_t peerId);
+
+    /** Forget a peer and its history. */
+    void RemovePeer(uint32_t peerId);
+
+    bool HasPeer(uint32_t peerId) const { return m_peers.count(peerId) > 0; }
+
+    /**
+     * Encode `snapshots` (the full current set) for one peer.  `sequence`
+     * must increase with every call for that peer and never be 0.
+     */
+    std::vector<uint8_t> EncodeForPeer(uint32_t peerId, uint32_t sequence,
+                                       const std::vector<EntitySnapshot>& snapshots);
+
+    /** Record that the peer received `sequence`; older acks are ignored. */
+    void Acknowledge(uint32_t peerId, uint32_t sequence);
+
+    /** Newest usable ack for the peer (0 = none). */
+    uint32_t AckedSequence(uint32_t peerId) const;
+
+    /**
+     * Client side: decode a peer packet into the full snapshot set.
+     * Returns false for a malformed packet or one whose baseline is no
+     * longer in this decoder's history.
+     */
+    bool DecodePacket(const std::vector<uint8_t>& packet,
+                      std::vector<EntitySnapshot>& out,
+                      PeerPacketHeader* header = nullptr);
+
+    /** Snapshots kept per peer (and by the decoder); default 32. */
+    void SetHistoryWindow(uint32_t window);
+    uint32_t HistoryWindow() const { return m_historyWindow; }
+
+    /** Precision of a field group on the wire, in units per step. */
+    void SetQuantization(SnapshotField field, float step);
+    float Quantization(SnapshotField field) const;
+
+    /** Take a field group's precision from a replication rule's quantizeStep. */
+    void ApplyRule(SnapshotField field, const ReplicationRule& rule);
+
     // Quantisation helpers (public for testability)
     static int32_t QuantizePosition(float v);
     static float   DequantizePosition(int32_t v);
@@ -122,6 +197,36 @@ private:
     std::unordered_map<uint32_t, Baseline> m_baselines;
     uint32_t m_keyframeInterval;
     bool m_forceAll = false;
+
+    static constexpr int kFieldCount = 7;
+
+    /// One entity's state in wire units, kept in entityId order
+    struct QuantizedEntity {
+        uint32_t entityId = 0;
+        int32_t  field[kFieldCount] = {};
+    };
+
+    /// A snapshot as sent (server) or received (client), by sequence
+    struct HistoryEntry {
+        uint32_t sequence = 0;   // 0 = empty
+        std::vector<QuantizedEntity> entities;
+    };
+
+    struct Peer {
+        std::vector<HistoryEntry> history;   // ring, index sequence % window
+        uint32_t acked = 0;
+    };
+
+    const HistoryEntry* findEntry(const std::vector<HistoryEntry>& ring,
+                                  uint32_t sequence) const;
+    void quantize(const std::vector<EntitySnapshot>& in,
+                  std::vector<QuantizedEntity>& out) const;
+    EntitySnapshot dequantize(const QuantizedEntity& q, uint32_t tick) const;
+
+    std::unordered_map<uint32_t, Peer> m_peers;
+    std::vector<HistoryEntry> m_received;
+    uint32_t m_historyWindow = 32;
+    float m_steps[3] = {1.0f / kPositionScale, 1.0f / kPositionScale, 1.0f / kRotationScale};
 };
 
 } // namespace atlas::net
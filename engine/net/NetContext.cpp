@@ -9,7 +9,8 @@ namespace atlas::net {
 void NetContext::Init(NetMode mode) {
     m_mode = mode;
     m_peers.clear();
-    m_snapshots.clear();
+    m_history.Clear();
+    m_snapshotViewValid = false;
     m_inputHistory.clear();
     m_nextPeerID = 1;
     m_hardening = nullptr;
@@ -22,7 +23,8 @@ void NetContext::Init(NetMode mode) {
 
 void NetContext::Shutdown() {
     m_peers.clear();
-    m_snapshots.clear();
+    m_history.Clear();
+    m_snapshotViewValid = false;
     m_inputHistory.clear();
     while (!m_outgoing.empty()) m_outgoing.pop();
     while (!m_incoming.empty()) m_incoming.pop();
@@ -150,34 +152,23 @@ void NetContext::SetInputApplyCallback(std::function<void(const InputFrame&)> cb
 }
 
 void NetContext::SaveSnapshot(uint32_t tick) {
-    WorldSnapshot snap;
-    snap.tick = tick;
     if (m_world) {
-        snap.ecsState = m_world->Serialize();
+        m_world->SerializeInto(m_stateScratch);
+    } else {
+        m_stateScratch.clear();
     }
-    m_snapshots.push_back(std::move(snap));
+    m_history.Capture(tick, m_stateScratch);
+    m_snapshotViewValid = false;
 }
 
 void NetContext::RollbackTo(uint32_t tick) {
-    // Find the snapshot for the requested tick
-    const WorldSnapshot* target = nullptr;
-    for (const auto& snap : m_snapshots) {
-        if (snap.tick == tick) {
-            target = &snap;
-            break;
-        }
-    }
-
-    if (target && m_world && !target->ecsState.empty()) {
-        m_world->Deserialize(target->ecsState);
+    if (m_world && m_history.Restore(tick, m_stateScratch) && !m_stateScratch.empty()) {
+        m_world->Deserialize(m_stateScratch);
     }
 
     // Remove snapshots after the rollback tick
-    m_snapshots.erase(
-        std::remove_if(m_snapshots.begin(), m_snapshots.end(),
-            [tick](const WorldSnapshot& s) { return s.tick > tick; }),
-        m_snapshots.end()
-    );
+    m_history.DiscardAfter(tick);
+    m_snapshotViewValid = false;
 }
 
 void NetContext::ReplayFrom(uint32_t tick) {
@@ -195,8 +186,25 @@ void NetContext::ReplayFrom(uint32_t tick) {
     }
 }
 
+void NetContext::SetSnapshotWindow(size_t ticks) {
+    m_history.SetCapacity(ticks);
+    m_snapshotViewValid = false;
+}
+
+size_t NetContext::SnapshotWindow() const {
+    return m_history.Capacity();
+}
+
 const std::vector<WorldSnapshot>& NetContext::Snapshots() const {
-    return m_snapshots;
+    if (!m_snapshotViewValid) {
+        m_snapshotView.resize(m_history.Count());
+        for (size_t i = 0; i < m_snapshotView.size(); ++i) {
+            m_snapshotView[i].tick = static_cast<uint32_t>(m_history.TickAt(i));
+            m_history.Restore(m_history.TickAt(i), m_snapshotView[i].ecsState);
+        }
+        m_snapshotViewValid = true;
+    }
+    return m_snapshotView;
 }
 
 void NetContext::BroadcastSaveTick(uint32_t tick, uint64_t stateHash) {
@@ -1,4 +1,5 @@
 #pragma once
+#include "../sim/RollbackBuffer.h"
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -90,6 +91,13 @@ public:
     void RollbackTo(uint32_t tick);
     void ReplayFrom(uint32_t tick);
 
+    /// Number of ticks SaveSnapshot() keeps (default 120). Older
+    /// snapshots are dropped as new ones are saved.
+    void SetSnapshotWindow(size_t ticks);
+    size_t SnapshotWindow() const;
+
+    /// Every retained snapshot, rebuilt in full. For inspection and
+    /// tests; rollback does not go through this.
     const std::vector<WorldSnapshot>& Snapshots() const;
 
     // Save tick broadcasting
@@ -118,7 +126,10 @@ public:
 private:
     NetMode m_mode = NetMode::Standalone;
     std::vector<NetPeer> m_peers;
-    std::vector<WorldSnapshot> m_snapshots;
+    sim::RollbackBuffer m_history{120};
+    std::vector<uint8_t> m_stateScratch;   ///< Reused serialize/restore buffer
+    mutable std::vector<WorldSnapshot> m_snapshotView;
+    mutable bool m_snapshotViewValid = false;
     std::vector<InputFrame> m_inputHistory;
     uint32_t m_nextPeerID = 1;
 
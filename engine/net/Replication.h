@@ -29,6 +29,8 @@ struct ReplicationRule {
     ReplicateDirection direction = ReplicateDirection::ServerToClient;
     bool reliable = true;
     uint8_t priority = 128;
+    // Wire precision for float fields, in world units per step (0 = codec default)
+    float quantizeStep = 0.0f;
 };
 
 class ReplicationManager {
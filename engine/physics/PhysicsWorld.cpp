@@ -1,18 +1,37 @@
 #include "PhysicsWorld.h"
 #include <algorithm>
+#include <chrono>
+#include <limits>
 
 namespace atlas::physics {
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+}
+
 void PhysicsWorld::Init() {
-    m_bodies.clear();
-    m_collisions.clear();
+    Shutdown();
     m_nextId = 1;
     m_initialized = true;
 }
 
 void PhysicsWorld::Shutdown() {
     m_bodies.clear();
+    m_indexById.clear();
     m_collisions.clear();
+    m_awakeOrder.clear();
+    m_awake.clear();
+    m_resting.clear();
+    m_restingLast.clear();
+    m_restingPairs.clear();
+    m_restingMaxWidth = 0.0f;
+    m_stats = {};
     m_initialized = false;
 }
 
@@ -22,28 +41,34 @@ BodyID PhysicsWorld::CreateBody(float mass, bool isStatic) {
     body.mass = mass > 0.0f ? mass : 1.0f;
     body.isStatic = isStatic;
     m_bodies.push_back(body);
+
+    if (m_indexById.size() <= body.id) m_indexById.resize(body.id + 1, 0);
+    m_indexById[body.id] = static_cast<uint32_t>(m_bodies.size());
     return body.id;
 }
 
 void PhysicsWorld::DestroyBody(BodyID id) {
-    m_bodies.erase(
-        std::remove_if(m_bodies.begin(), m_bodies.end(),
-            [id](const RigidBody& b) { return b.id == id; }),
-        m_bodies.end());
+    if (id >= m_indexById.size() || m_indexById[id] == 0) return;
+    size_t index = m_indexById[id] - 1;
+    m_bodies.erase(m_bodies.begin() + static_cast<std::ptrdiff_t>(index));
+    m_indexById[id] = 0;
+    RebuildIndex(index);
 }
 
-RigidBody* PhysicsWorld::GetBody(BodyID id) {
-    for (auto& body : m_bodies) {
-        if (body.id == id) return &body;
+void PhysicsWorld::RebuildIndex(size_t from) {
+    for (size_t i = from; i < m_bodies.size(); ++i) {
+        m_indexById[m_bodies[i].id] = static_cast<uint32_t>(i + 1);
     }
-    return nullptr;
+}
+
+RigidBody* PhysicsWorld::GetBody(BodyID id) {
+    if (id >= m_indexById.size() || m_indexById[id] == 0) return nullptr;
+    return &m_bodies[m_indexById[id] - 1];
 }
 
 const RigidBody* PhysicsWorld::GetBody(BodyID id) const {
-    for (auto& body : m_bodies) {
-        if (body.id == id) return &body;
-    }
-    return nullptr;
+    if (id >= m_indexById.size() || m_indexById[id] == 0) return nullptr;
+    return &m_bodies[m_indexById[id] - 1];
 }
 
 size_t PhysicsWorld::BodyCount() const {
@@ -54,6 +79,7 @@ void PhysicsWorld::SetPosition(BodyID id, float x, float y, float z) {
     auto* body = GetBody(id);
     if (body) {
         body->position = {x, y, z};
+        WakeBody(id);
     }
 }
 
@@ -61,6 +87,7 @@ void PhysicsWorld::SetVelocity(BodyID id, float vx, float vy, float vz) {
     auto* body = GetBody(id);
     if (body) {
         body->velocity = {vx, vy, vz};
+        WakeBody(id);
     }
 }
 
@@ -68,21 +95,79 @@ void PhysicsWorld::ApplyForce(BodyID id, float fx, float fy, float fz) {
     auto* body = GetBody(id);
     if (body && !body->isStatic && body->mass > 0.0f) {
         body->acceleration = body->acceleration + Vec3{fx / body->mass, fy / body->mass, fz / body->mass};
+        WakeBody(id);
     }
 }
 
 void PhysicsWorld::SetGravity(float x, float y, float z) {
     m_gravity = {x, y, z};
+    // A body that settled under the old gravity may not be at rest now
+    for (auto& body : m_bodies) {
+        body.sleeping = false;
+        body.stillSteps = 0;
+    }
 }
 
 Vec3 PhysicsWorld::GetGravity() const {
     return m_gravity;
 }
 
-void PhysicsWorld::Step(float dt) {
-    // Integrate velocities and positions
+void PhysicsWorld::SetSleepThreshold(float speed, uint32_t steps) {
+    m_sleepSpeed = speed;
+    m_sleepSteps = steps;
+    if (steps == 0) {
+        for (auto& body : m_bodies) {
+            body.sleeping = false;
+            body.stillSteps = 0;
+        }
+    }
+}
+
+void PhysicsWorld::WakeBody(BodyID id) {
+    auto* body = GetBody(id);
+    if (body) {
+        body->sleeping = false;
+        body->stillSteps = 0;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Step
+// ---------------------------------------------------------------------------
+
+PhysicsWorld::Proxy PhysicsWorld::MakeProxy(const RigidBody& body, uint32_t index) {
+    const Vec3& p = body.position;
+    float r = body.radius;
+    Proxy proxy{p.x - r, p.x + r, p.y - r, p.y + r, p.z - r, p.z + r,
+                index, body.id, body.isStatic};
+    // NaN would break the sort order. Such a body never touches anything
+    // in the narrowphase, so park it at the far end of the axis.
+    if (std::isnan(proxy.minX) || std::isnan(proxy.maxX)) {
+        proxy.minX = proxy.maxX = std::numeric_limits<float>::infinity();
+    }
+    return proxy;
+}
+
+bool PhysicsWorld::Overlaps(const Proxy& a, const Proxy& b) {
+    return a.minX <= b.maxX && b.minX <= a.maxX &&
+           a.minY <= b.maxY && b.minY <= a.maxY &&
+           a.minZ <= b.maxZ && b.minZ <= a.maxZ;
+}
+
+bool PhysicsWorld::Touching(const RigidBody& a, const RigidBody& b) {
+    Vec3 diff = a.position - b.position;
+    return diff.Length() < a.radius + b.radius;
+}
+
+CollisionPair PhysicsWorld::MakePair(BodyID a, BodyID b) {
+    return a < b ? CollisionPair{a, b} : CollisionPair{b, a};
+}
+
+void PhysicsWorld::Integrate(float dt) {
+    size_t awake = 0;
     for (auto& body : m_bodies) {
-        if (body.isStatic || !body.active) continue;
+        if (body.isStatic || !body.active || body.sleeping) continue;
+        ++awake;
 
         // Apply gravity
         body.velocity = body.velocity + m_gravity * dt;
@@ -95,26 +180,167 @@ void PhysicsWorld::Step(float dt) {
 
         // Clear per-frame acceleration
         body.acceleration = {0, 0, 0};
+
+        if (m_sleepSteps > 0 && body.velocity.Length() < m_sleepSpeed) {
+            if (++body.stillSteps >= m_sleepSteps) {
+                body.sleeping = true;
+                body.velocity = {0, 0, 0};
+            }
+        } else {
+            body.stillSteps = 0;
+        }
     }
+    m_stats.awakeBodies = awake;
+}
 
-    // Simple AABB collision detection
-    m_collisions.clear();
-    float bodyRadius = 0.5f;
-    for (size_t i = 0; i < m_bodies.size(); i++) {
-        for (size_t j = i + 1; j < m_bodies.size(); j++) {
-            if (!m_bodies[i].active || !m_bodies[j].active) continue;
-
-            Vec3 diff = m_bodies[i].position - m_bodies[j].position;
-            float dist = diff.Length();
-            if (dist < bodyRadius * 2.0f) {
-                m_collisions.push_back({m_bodies[i].id, m_bodies[j].id});
+void PhysicsWorld::UpdateResting() {
+    m_restingScratch.clear();
+    for (size_t i = 0; i < m_bodies.size(); ++i) {
+        const RigidBody& body = m_bodies[i];
+        if (!body.active || !(body.isStatic || body.sleeping)) continue;
+        m_restingScratch.push_back(MakeProxy(body, static_cast<uint32_t>(i)));
+    }
+    m_stats.restingBodies = m_restingScratch.size();
+
+    // Bodies can be moved through GetBody(), so compare the bounds rather
+    // than trusting that nothing resting was touched.
+    auto same = [](const Proxy& a, const Proxy& b) {
+        return a.index == b.index && a.id == b.id && a.isStatic == b.isStatic &&
+               a.minX == b.minX && a.maxX == b.maxX && a.minY == b.minY &&
+               a.maxY == b.maxY && a.minZ == b.minZ && a.maxZ == b.maxZ;
+    };
+    bool unchanged = m_restingScratch.size() == m_restingLast.size() &&
+        std::equal(m_restingScratch.begin(), m_restingScratch.end(), m_restingLast.begin(), same);
+    m_stats.restingRebuilt = !unchanged;
+    if (unchanged) return;
+
+    m_restingLast.swap(m_restingScratch);
+    m_resting = m_restingLast;
+    std::sort(m_resting.begin(), m_resting.end(), [](const Proxy& a, const Proxy& b) {
+        return a.minX < b.minX || (a.minX == b.minX && a.id < b.id);
+    });
+
+    m_restingMaxWidth = 0.0f;
+    for (const Proxy& p : m_resting) {
+        m_restingMaxWidth = std::max(m_restingMaxWidth, p.maxX - p.minX);
+    }
+
+    // Pairs among resting bodies hold until the set changes. Two static
+    // bodies are never reported.
+    m_restingPairs.clear();
+    for (size_t i = 0; i < m_resting.size(); ++i) {
+        const Proxy& a = m_resting[i];
+        for (size_t j = i + 1; j < m_resting.size() && m_resting[j].minX <= a.maxX; ++j) {
+            const Proxy& b = m_resting[j];
+            if (a.isStatic && b.isStatic) continue;
+            if (Overlaps(a, b) && Touching(m_bodies[a.index], m_bodies[b.index])) {
+                m_restingPairs.push_back(MakePair(a.id, b.id));
+            }
+        }
+    }
+}
+
+void PhysicsWorld::SortAwake() {
+    m_seen.assign(m_bodies.size(), 0);
+    m_awake.clear();
+
+    // Last step's order first, so the sort below has little to do
+    for (BodyID id : m_awakeOrder) {
+        uint32_t slot = id < m_indexById.size() ? m_indexById[id] : 0;
+        if (slot == 0) continue;
+        const RigidBody& body = m_bodies[slot - 1];
+        if (!body.active || body.isStatic || body.sleeping) continue;
+        m_seen[slot - 1] = 1;
+        m_awake.push_back(MakeProxy(body, slot - 1));
+    }
+    size_t kept = m_awake.size();
+    for (size_t i = 0; i < m_bodies.size(); ++i) {
+        const RigidBody& body = m_bodies[i];
+        if (m_seen[i] || !body.active || body.isStatic || body.sleeping) continue;
+        m_awake.push_back(MakeProxy(body, static_cast<uint32_t>(i)));
+    }
+
+    auto less = [](const Proxy& a, const Proxy& b) {
+        return a.minX < b.minX || (a.minX == b.minX && a.id < b.id);
+    };
+    if (m_awake.size() - kept > kept) {
+        // Mostly new bodies: no order worth keeping
+        std::sort(m_awake.begin(), m_awake.end(), less);
+    } else {
+        for (size_t i = 1; i < m_awake.size(); ++i) {
+            Proxy p = m_awake[i];
+            size_t j = i;
+            while (j > 0 && less(p, m_awake[j - 1])) {
+                m_awake[j] = m_awake[j - 1];
+                --j;
             }
+            m_awake[j] = p;
         }
     }
+
+    m_awakeOrder.clear();
+    for (const Proxy& p : m_awake) {
+        m_awakeOrder.push_back(p.id);
+    }
+}
+
+void PhysicsWorld::Step(float dt) {
+    auto start = Clock::now();
+    Integrate(dt);
+    m_stats.integrateMs = MsSince(start);
+
+    // Broadphase: candidate pairs whose bounds overlap
+    start = Clock::now();
+    UpdateResting();
+    SortAwake();
+
+    m_candidates.clear();
+    for (size_t i = 0; i < m_awake.size(); ++i) {
+        const Proxy& a = m_awake[i];
+        for (size_t j = i + 1; j < m_awake.size() && m_awake[j].minX <= a.maxX; ++j) {
+            if (Overlaps(a, m_awake[j])) {
+                m_candidates.push_back({a.index, m_awake[j].index});
+            }
+        }
+
+        // Any resting proxy that reaches a.minX starts at most one
+        // max-width before it.
+        auto it = std::lower_bound(m_resting.begin(), m_resting.end(), a.minX - m_restingMaxWidth,
+            [](const Proxy& p, float x) { return p.minX < x; });
+        for (; it != m_resting.end() && it->minX <= a.maxX; ++it) {
+            if (Overlaps(a, *it)) {
+                m_candidates.push_back({a.index, it->index});
+            }
+        }
+    }
+    m_stats.candidatePairs = m_candidates.size();
+    m_stats.broadphaseMs = MsSince(start);
+
+    // Narrowphase: sphere test, then a fixed order so replays hash the same
+    start = Clock::now();
+    m_collisions.clear();
+    for (const auto& [ia, ib] : m_candidates) {
+        const RigidBody& a = m_bodies[ia];
+        const RigidBody& b = m_bodies[ib];
+        if (Touching(a, b)) {
+            m_collisions.push_back(MakePair(a.id, b.id));
+        }
+    }
+    m_collisions.insert(m_collisions.end(), m_restingPairs.begin(), m_restingPairs.end());
+    std::sort(m_collisions.begin(), m_collisions.end(),
+        [](const CollisionPair& x, const CollisionPair& y) {
+            return x.a < y.a || (x.a == y.a && x.b < y.b);
+        });
+    m_stats.collisions = m_collisions.size();
+    m_stats.narrowphaseMs = MsSince(start);
 }
 
 const std::vector<CollisionPair>& PhysicsWorld::GetCollisions() const {
     return m_collisions;
 }
 
+const PhysicsStepStats& PhysicsWorld::GetStepStats() const {
+    return m_stats;
+}
+
 }
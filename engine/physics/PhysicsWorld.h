@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <utility>
 #include <vector>
 #include <cmath>
 
@@ -22,8 +23,11 @@ struct RigidBody {
     Vec3 acceleration;
     float mass = 1.0f;
     float restitution = 0.5f;
+    float radius = 0.5f;          ///< Collision sphere radius
     bool isStatic = false;
     bool active = true;
+    bool sleeping = false;        ///< Skipped by integration until woken
+    uint32_t stillSteps = 0;      ///< Consecutive steps below the sleep speed
 };
 
 struct AABB {
@@ -32,10 +36,22 @@ struct AABB {
 };
 
 struct CollisionPair {
-    BodyID a = 0;
+    BodyID a = 0;   ///< Always the lower ID
     BodyID b = 0;
 };
 
+/// Counters for the most recent Step().
+struct PhysicsStepStats {
+    size_t awakeBodies = 0;       ///< Active dynamic bodies that were integrated
+    size_t restingBodies = 0;     ///< Active static or sleeping bodies
+    size_t candidatePairs = 0;    ///< AABB overlaps sent to the narrowphase
+    size_t collisions = 0;
+    bool restingRebuilt = false;  ///< The resting set changed and was re-sorted
+    double integrateMs = 0.0;
+    double broadphaseMs = 0.0;
+    double narrowphaseMs = 0.0;
+};
+
 class PhysicsWorld {
 public:
     void Init();
@@ -54,13 +70,62 @@ public:
     void SetGravity(float x, float y, float z);
     Vec3 GetGravity() const;
 
+    /// A dynamic body falls asleep after `steps` consecutive steps with
+    /// speed below `speed`. Moving it, setting its velocity or applying a
+    /// force wakes it. steps == 0 disables sleeping.
+    void SetSleepThreshold(float speed, uint32_t steps);
+    void WakeBody(BodyID id);
+
     void Step(float dt);
 
+    /// Overlapping pairs from the last Step(), sorted by (a, b).
     const std::vector<CollisionPair>& GetCollisions() const;
 
+    const PhysicsStepStats& GetStepStats() const;
+
 private:
+    /// Sphere bounds on the x axis plus what the overlap test needs.
+    struct Proxy {
+        float minX, maxX;
+        float minY, maxY;
+        float minZ, maxZ;
+        uint32_t index;     ///< Into m_bodies
+        BodyID id;
+        bool isStatic;
+    };
+
+    static Proxy MakeProxy(const RigidBody& body, uint32_t index);
+    static bool Overlaps(const Proxy& a, const Proxy& b);
+    static bool Touching(const RigidBody& a, const RigidBody& b);
+    static CollisionPair MakePair(BodyID a, BodyID b);
+
+    void Integrate(float dt);
+    void UpdateResting();
+    void SortAwake();
+    void RebuildIndex(size_t from);
+
     std::vector<RigidBody> m_bodies;
+    std::vector<uint32_t> m_indexById;   ///< id -> index + 1, 0 = none
     std::vector<CollisionPair> m_collisions;
+
+    // Broadphase (sweep and prune on x). Awake bodies are re-sorted every
+    // step by insertion sort over last step's order, which is close to
+    // linear while bodies move coherently. Static and sleeping bodies do
+    // not move, so their sorted list and the pairs among them are kept
+    // until the resting set changes.
+    std::vector<BodyID> m_awakeOrder;
+    std::vector<Proxy> m_awake;
+    std::vector<Proxy> m_resting;        ///< Sorted by minX
+    std::vector<Proxy> m_restingLast;    ///< Body order, to detect changes
+    std::vector<Proxy> m_restingScratch;
+    std::vector<CollisionPair> m_restingPairs;
+    std::vector<uint8_t> m_seen;
+    float m_restingMaxWidth = 0.0f;
+    std::vector<std::pair<uint32_t, uint32_t>> m_candidates;   ///< Body indices
+
+    PhysicsStepStats m_stats;
+    float m_sleepSpeed = 0.01f;
+    uint32_t m_sleepSteps = 60;
     Vec3 m_gravity = {0.0f, -9.81f, 0.0f};
     BodyID m_nextId = 1;
     bool m_initialized = false;
@@ -0,0 +1,252 @@
+#include "RollbackBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace atlas::sim {
+
+RollbackBuffer::RollbackBuffer(size_t capacity, size_t pageSize)
+    : m_slots(capacity > 0 ? capacity : 1),
+      m_pageSize(pageSize > 0 ? pageSize : 1) {}
+
+void RollbackBuffer::SetCapacity(size_t capacity) {
+    if (capacity == 0) capacity = 1;
+    if (capacity == m_slots.size()) return;
+    while (m_count > capacity) {
+        EvictOldest();
+    }
+
+    // Re-pack the live slots at the front of the new ring.
+    std::vector<Slot> slots(capacity);
+    for (size_t i = 0; i < m_count; ++i) {
+        slots[i] = std::move(SlotAt(i));
+    }
+    m_slots = std::move(slots);
+    m_first = 0;
+}
+
+size_t RollbackBuffer::Capacity() const {
+    return m_slots.size();
+}
+
+size_t RollbackBuffer::PageSize() const {
+    return m_pageSize;
+}
+
+RollbackBuffer::Slot& RollbackBuffer::SlotAt(size_t index) {
+    return m_slots[(m_first + index) % m_slots.size()];
+}
+
+const RollbackBuffer::Slot& RollbackBuffer::SlotAt(size_t index) const {
+    return m_slots[(m_first + index) % m_slots.size()];
+}
+
+void RollbackBuffer::Capture(uint64_t tick, const uint8_t* data, size_t size, uint64_t stateHash) {
+    while (m_count > 0 && LatestTick() >= tick) {
+        if (m_count == 1) Clear();
+        else DropNewest();
+    }
+    if (m_count == m_slots.size()) {
+        EvictOldest();
+    }
+
+    Slot& slot = SlotAt(m_count);
+    ResetDiff(slot);
+    slot.tick = tick;
+    slot.hash = stateHash;
+    slot.size = size;
+
+    if (m_count == 0) {
+        // First tick in the window: it is both ends.
+        size_t padded = (size + m_pageSize - 1) / m_pageSize * m_pageSize;
+        m_head.assign(padded, 0);
+        if (size > 0) std::memcpy(m_head.data(), data, size);
+        m_base = m_head;
+        m_stats.lastDirtyPages = 0;
+        m_stats.lastDiffBytes = 0;
+    } else {
+        DiffIntoHead(slot, data, size);
+    }
+
+    ++m_count;
+    ++m_stats.captures;
+}
+
+void RollbackBuffer::Capture(uint64_t tick, const std::vector<uint8_t>& data, uint64_t stateHash) {
+    Capture(tick, data.data(), data.size(), stateHash);
+}
+
+void RollbackBuffer::DiffIntoHead(Slot& slot, const uint8_t* data, size_t size) {
+    const size_t P = m_pageSize;
+    size_t padded = (size + P - 1) / P * P;
+    if (m_head.size() < padded) m_head.resize(padded, 0);
+
+    size_t pageCount = m_head.size() / P;
+    for (size_t p = 0; p < pageCount; ++p) {
+        size_t off = p * P;
+        size_t live = off < size ? std::min(P, size - off) : 0;
+        uint8_t* head = m_head.data() + off;
+
+        // Past the end of the new image the page must read as zeros.
+        bool same = live == 0 || std::memcmp(head, data + off, live) == 0;
+        for (size_t j = live; same && j < P; ++j) {
+            same = head[j] == 0;
+        }
+        if (same) continue;
+
+        slot.pages.push_back(static_cast<uint32_t>(p));
+        size_t pos = slot.diff.size();
+        slot.diff.resize(pos + P);
+        uint8_t* out = slot.diff.data() + pos;
+        for (size_t j = 0; j < P; ++j) {
+            uint8_t next = j < live ? data[off + j] : 0;
+            out[j] = head[j] ^ next;
+            head[j] = next;
+        }
+    }
+    // Whole pages past the new end are zero now; drop them.
+    m_head.resize(padded);
+
+    m_stats.lastDirtyPages = slot.pages.size();
+    m_stats.lastDiffBytes = slot.diff.size();
+    m_stats.retainedDiffBytes += slot.diff.size();
+}
+
+void RollbackBuffer::ApplyDiff(const Slot& slot, std::vector<uint8_t>& buf) const {
+    const size_t P = m_pageSize;
+    for (size_t k = 0; k < slot.pages.size(); ++k) {
+        size_t off = static_cast<size_t>(slot.pages[k]) * P;
+        if (buf.size() < off + P) buf.resize(off + P, 0);
+        const uint8_t* diff = slot.diff.data() + k * P;
+        uint8_t* dst = buf.data() + off;
+        for (size_t j = 0; j < P; ++j) {
+            dst[j] ^= diff[j];
+        }
+    }
+}
+
+void RollbackBuffer::ResetDiff(Slot& slot) {
+    m_stats.retainedDiffBytes -= slot.diff.size();
+    slot.pages.clear();
+    slot.diff.clear();
+}
+
+void RollbackBuffer::EvictOldest() {
+    if (m_count <= 1) {
+        Clear();
+        return;
+    }
+    // The second-oldest tick becomes the keyframe.
+    Slot& next = SlotAt(1);
+    ApplyDiff(next, m_base);
+    m_base.resize((next.size + m_pageSize - 1) / m_pageSize * m_pageSize);
+    ResetDiff(next);
+
+    ResetDiff(SlotAt(0));
+    m_first = (m_first + 1) % m_slots.size();
+    --m_count;
+}
+
+void RollbackBuffer::DropNewest() {
+    Slot& last = SlotAt(m_count - 1);
+    ApplyDiff(last, m_head);
+    ResetDiff(last);
+    --m_count;
+    const Slot& prev = SlotAt(m_count - 1);
+    m_head.resize((prev.size + m_pageSize - 1) / m_pageSize * m_pageSize);
+}
+
+size_t RollbackBuffer::IndexOf(uint64_t tick) const {
+    // Ticks are strictly increasing from oldest to newest.
+    size_t lo = 0, hi = m_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (SlotAt(mid).tick < tick) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < m_count && SlotAt(lo).tick == tick) return lo;
+    return m_count;
+}
+
+bool RollbackBuffer::Restore(uint64_t tick, std::vector<uint8_t>& out) const {
+    size_t index = IndexOf(tick);
+    if (index == m_count) return false;
+
+    size_t forward = 0, backward = 0;
+    for (size_t i = 1; i <= index; ++i) forward += SlotAt(i).pages.size();
+    for (size_t i = index + 1; i < m_count; ++i) backward += SlotAt(i).pages.size();
+
+    if (forward <= backward) {
+        out.assign(m_base.begin(), m_base.end());
+        for (size_t i = 1; i <= index; ++i) ApplyDiff(SlotAt(i), out);
+    } else {
+        out.assign(m_head.begin(), m_head.end());
+        for (size_t i = m_count - 1; i > index; --i) ApplyDiff(SlotAt(i), out);
+    }
+    out.resize(SlotAt(index).size);
+
+    m_stats.lastRestorePages = std::min(forward, backward);
+    ++m_stats.restores;
+    return true;
+}
+
+bool RollbackBuffer::Contains(uint64_t tick) const {
+    return IndexOf(tick) != m_count;
+}
+
+bool RollbackBuffer::HashAt(uint64_t tick, uint64_t& outHash) const {
+    size_t index = IndexOf(tick);
+    if (index == m_count) return false;
+    outHash = SlotAt(index).hash;
+    return true;
+}
+
+size_t RollbackBuffer::Count() const {
+    return m_count;
+}
+
+bool RollbackBuffer::Empty() const {
+    return m_count == 0;
+}
+
+uint64_t RollbackBuffer::TickAt(size_t index) const {
+    return index < m_count ? SlotAt(index).tick : 0;
+}
+
+uint64_t RollbackBuffer::OldestTick() const {
+    return TickAt(0);
+}
+
+uint64_t RollbackBuffer::LatestTick() const {
+    return m_count > 0 ? SlotAt(m_count - 1).tick : 0;
+}
+
+void RollbackBuffer::DiscardAfter(uint64_t tick) {
+    while (m_count > 0 && LatestTick() > tick) {
+        if (m_count == 1) Clear();
+        else DropNewest();
+    }
+}
+
+void RollbackBuffer::DiscardBefore(uint64_t tick) {
+    while (m_count > 0 && OldestTick() < tick) {
+        EvictOldest();
+    }
+}
+
+void RollbackBuffer::Clear() {
+    for (auto& slot : m_slots) {
+        slot.pages.clear();
+        slot.diff.clear();
+    }
+    m_first = 0;
+    m_count = 0;
+    m_base.clear();
+    m_head.clear();
+    m_stats.retainedDiffBytes = 0;
+}
+
+const RollbackBuffer::Stats& RollbackBuffer::GetStats() const {
+    return m_stats;
+}
+
+}  // namespace atlas::sim
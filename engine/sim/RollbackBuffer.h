@@ -0,0 +1,119 @@
+#pragma once
+// ============================================================
+// Atlas Rollback Buffer — Paged XOR Tick History
+// ============================================================
+//
+// Keeps a window of serialized states, one per tick, without a
+// full copy per tick:
+//
+//   base  — full image of the oldest retained tick (the keyframe)
+//   head  — full image of the newest retained tick
+//   slots — fixed ring; slot i holds the pages that changed between
+//           tick i-1 and tick i, stored as old XOR new
+//
+// XOR diffs apply in both directions, so a tick is rebuilt from
+// whichever end is closer: base plus the diffs forward, or head
+// with the diffs undone backward. Evicting the oldest tick folds
+// its successor's diff into the base, so there is never a second
+// keyframe to take.
+//
+// Capture compares the new image with head one page at a time
+// (memcmp) and only copies pages that differ, so bytes written and
+// bytes retained follow what changed. Slot storage is reused when
+// the ring wraps; once warm, a capture does not allocate.
+//
+// Images may grow or shrink between ticks. Buffers are zero-padded
+// to whole pages and each slot records its image's real size.
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace atlas::sim {
+
+class RollbackBuffer {
+public:
+    struct Stats {
+        size_t lastDirtyPages = 0;    ///< Pages that differed in the last capture
+        size_t lastDiffBytes = 0;     ///< Diff bytes stored by the last capture
+        size_t retainedDiffBytes = 0; ///< Diff bytes across the whole window
+        size_t lastRestorePages = 0;  ///< Pages applied by the last restore
+        uint64_t captures = 0;
+        uint64_t restores = 0;
+    };
+
+    static constexpr size_t kDefaultPageSize = 256;
+
+    explicit RollbackBuffer(size_t capacity = 60, size_t pageSize = kDefaultPageSize);
+
+    /// Number of ticks retained. Shrinking evicts the oldest ticks.
+    void SetCapacity(size_t capacity);
+    size_t Capacity() const;
+    size_t PageSize() const;
+
+    /// Record the image for `tick`. Ticks at or after `tick` are
+    /// discarded first, so re-simulating after a rollback overwrites
+    /// the old future. Evicts the oldest tick when the ring is full.
+    void Capture(uint64_t tick, const uint8_t* data, size_t size, uint64_t stateHash = 0);
+    void Capture(uint64_t tick, const std::vector<uint8_t>& data, uint64_t stateHash = 0);
+
+    /// Rebuild the image for `tick` into `out` (its capacity is reused).
+    /// Returns false if the tick is not in the window.
+    bool Restore(uint64_t tick, std::vector<uint8_t>& out) const;
+
+    bool Contains(uint64_t tick) const;
+
+    /// Hash recorded with the tick's capture.
+    bool HashAt(uint64_t tick, uint64_t& outHash) const;
+
+    size_t Count() const;
+    bool Empty() const;
+
+    /// Tick of the i-th retained state, 0 = oldest.
+    uint64_t TickAt(size_t index) const;
+    uint64_t OldestTick() const;
+    uint64_t LatestTick() const;
+
+    /// Drop every tick after `tick`; head becomes that tick's image.
+    void DiscardAfter(uint64_t tick);
+
+    /// Drop every tick before `tick`.
+    void DiscardBefore(uint64_t tick);
+
+    void Clear();
+
+    const Stats& GetStats() const;
+
+private:
+    struct Slot {
+        uint64_t tick = 0;
+        uint64_t hash = 0;
+        size_t size = 0;                ///< Logical image size at this tick
+        std::vector<uint32_t> pages;    ///< Indices of the pages in `diff`
+        std::vector<uint8_t> diff;      ///< pages.size() * pageSize XOR bytes
+    };
+
+    Slot& SlotAt(size_t index);
+    const Slot& SlotAt(size_t index) const;
+
+    /// Index (0 = oldest) of `tick`, or Count() if absent.
+    size_t IndexOf(uint64_t tick) const;
+
+    void ApplyDiff(const Slot& slot, std::vector<uint8_t>& buf) const;
+    void DiffIntoHead(Slot& slot, const uint8_t* data, size_t size);
+    void EvictOldest();
+    void DropNewest();
+    void ResetDiff(Slot& slot);
+
+    std::vector<Slot> m_slots;
+    size_t m_first = 0;
+    size_t m_count = 0;
+    size_t m_pageSize;
+
+    std::vector<uint8_t> m_base;
+    std::vector<uint8_t> m_head;
+
+    mutable Stats m_stats;   ///< Restore() is const but counts itself
+};
+
+}  // namespace atlas::sim
@@ -0,0 +1,126 @@
+#include "StateHashTree.h"
+#include "../core/FastHash.h"
+#include <algorithm>
+
+namespace atlas::sim {
+
+namespace {
+
+// Padding leaves of a non power-of-two tree; never equal to a real
+// partition's hash in practice, and the same on every peer.
+constexpr uint64_t kEmptyLeaf = 0x9E3779B97F4A7C15ULL;
+
+}
+
+void StateHashTree::Assign(const uint32_t* keys, const uint64_t* hashes, size_t count) {
+    bool sameKeys = count == m_keys.size() && std::equal(keys, keys + count, m_keys.begin());
+    if (!sameKeys) {
+        m_keys.assign(keys, keys + count);
+        m_leaves.assign(hashes, hashes + count);
+        m_structureDirty = true;
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        SetLeaf(i, hashes[i]);
+    }
+}
+
+void StateHashTree::SetLeaf(size_t index, uint64_t hash) {
+    if (index >= m_leaves.size() || m_leaves[index] == hash) return;
+    m_leaves[index] = hash;
+    if (!m_structureDirty) m_dirty.push_back(index);
+}
+
+size_t StateHashTree::LeafCount() const {
+    return m_leaves.size();
+}
+
+uint32_t StateHashTree::LeafKey(size_t index) const {
+    return m_keys[index];
+}
+
+uint64_t StateHashTree::LeafHash(size_t index) const {
+    return m_leaves[index];
+}
+
+void StateHashTree::Rebuild() const {
+    m_width = 1;
+    while (m_width < m_leaves.size()) m_width <<= 1;
+    m_nodes.assign(2 * m_width, kEmptyLeaf);
+    std::copy(m_leaves.begin(), m_leaves.end(), m_nodes.begin() + static_cast<std::ptrdiff_t>(m_width));
+    for (size_t i = m_width - 1; i >= 1; --i) {
+        m_nodes[i] = FastHashMix(m_nodes[2 * i], m_nodes[2 * i + 1]);
+    }
+    m_dirty.clear();
+    m_structureDirty = false;
+}
+
+uint64_t StateHashTree::Root() const {
+    if (m_leaves.empty()) return 0;
+    if (m_structureDirty) {
+        Rebuild();
+    } else if (!m_dirty.empty()) {
+        for (size_t leaf : m_dirty) {
+            m_nodes[m_width + leaf] = m_leaves[leaf];
+        }
+        // Walk each changed path up; a parent shared by two changed
+        // leaves is simply hashed twice.
+        for (size_t leaf : m_dirty) {
+            for (size_t i = (m_width + leaf) / 2; i >= 1; i /= 2) {
+                m_nodes[i] = FastHashMix(m_nodes[2 * i], m_nodes[2 * i + 1]);
+            }
+        }
+        m_dirty.clear();
+    }
+    // A single leaf is mixed once more so the root never equals a leaf
+    return m_width == 1 ? FastHashMix(m_nodes[1], kEmptyLeaf) : m_nodes[1];
+}
+
+void StateHashTree::DiffNode(const StateHashTree& other, size_t node,
+                             std::vector<uint32_t>& out) const {
+    if (m_nodes[node] == other.m_nodes[node]) return;
+    if (node >= m_width) {
+        size_t leaf = node - m_width;
+        if (leaf < m_keys.size()) out.push_back(m_keys[leaf]);
+        return;
+    }
+    DiffNode(other, 2 * node, out);
+    DiffNode(other, 2 * node + 1, out);
+}
+
+std::vector<uint32_t> StateHashTree::Diff(const StateHashTree& other) const {
+    std::vector<uint32_t> out;
+    if (m_keys == other.m_keys) {
+        if (m_keys.empty()) return out;
+        Root();
+        other.Root();
+        DiffNode(other, 1, out);
+        return out;
+    }
+
+    // Different partitions: merge the two key lists
+    size_t i = 0, j = 0;
+    while (i < m_keys.size() || j < other.m_keys.size()) {
+        if (j == other.m_keys.size() || (i < m_keys.size() && m_keys[i] < other.m_keys[j])) {
+            out.push_back(m_keys[i++]);
+        } else if (i == m_keys.size() || other.m_keys[j] < m_keys[i]) {
+            out.push_back(other.m_keys[j++]);
+        } else {
+            if (m_leaves[i] != other.m_leaves[j]) out.push_back(m_keys[i]);
+            ++i;
+            ++j;
+        }
+    }
+    return out;
+}
+
+void StateHashTree::Clear() {
+    m_keys.clear();
+    m_leaves.clear();
+    m_nodes.clear();
+    m_dirty.clear();
+    m_width = 0;
+    m_structureDirty = true;
+}
+
+}  // namespace atlas::sim
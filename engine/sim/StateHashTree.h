@@ -0,0 +1,63 @@
+#pragma once
+// ============================================================
+// Atlas State Hash Tree — Merkle Tree over State Partitions
+// ============================================================
+//
+// The world state hash is split into leaves, one per partition
+// (for the ECS: one per registered component type, plus the
+// entity table). Leaves are combined pairwise up to a root:
+//
+//   root = H(H(l0, l1), H(l2, l3)) ...
+//
+// Changing one leaf only rehashes its path to the root. Two trees
+// over the same leaf keys are compared top-down, descending only
+// into subtrees whose hashes differ, which names the partition
+// that diverged without comparing every leaf.
+//
+// See: StateHasher (chains the root per tick)
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace atlas::sim {
+
+class StateHashTree {
+public:
+    /// Replace the leaf set. `keys` identify the partitions and must be
+    /// strictly increasing; both arrays have `count` entries.
+    void Assign(const uint32_t* keys, const uint64_t* hashes, size_t count);
+
+    /// Update one leaf's hash.
+    void SetLeaf(size_t index, uint64_t hash);
+
+    size_t LeafCount() const;
+    uint32_t LeafKey(size_t index) const;
+    uint64_t LeafHash(size_t index) const;
+
+    /// Hash of all leaves (0 for an empty tree). Recomputes only the
+    /// paths above leaves changed since the last call.
+    uint64_t Root() const;
+
+    /// Keys of the leaves that differ between the two trees, in key
+    /// order. A key present in only one tree counts as differing.
+    std::vector<uint32_t> Diff(const StateHashTree& other) const;
+
+    void Clear();
+
+private:
+    void Rebuild() const;
+    void DiffNode(const StateHashTree& other, size_t node, std::vector<uint32_t>& out) const;
+
+    std::vector<uint32_t> m_keys;
+    std::vector<uint64_t> m_leaves;
+
+    // Heap layout: node 1 is the root, node i has children 2i, 2i+1,
+    // leaves start at m_width. Rebuilt lazily by Root().
+    mutable std::vector<uint64_t> m_nodes;
+    mutable std::vector<size_t> m_dirty;
+    mutable size_t m_width = 0;
+    mutable bool m_structureDirty = true;
+};
+
+}  // namespace atlas::sim
@@ -1,4 +1,5 @@
 #include "StateHasher.h"
+#include "../core/FastHash.h"
 
 namespace atlas::sim {
 
@@ -16,10 +17,43 @@ uint64_t StateHasher::HashCombine(uint64_t prev,
     return h;
 }
 
+uint64_t StateHasher::Hash(HashBackend backend, uint64_t prev,
+                           const uint8_t* data, size_t size) {
+    if (backend == HashBackend::FNV1a) return HashCombine(prev, data, size);
+    return FastHash64(data, size, prev);
+}
+
 void StateHasher::Reset(uint64_t seed) {
-    m_currentHash = FNV_OFFSET ^ seed;
+    m_currentHash = m_backend == HashBackend::FNV1a ? FNV_OFFSET ^ seed
+                                                    : FastHashMix(FNV_OFFSET, seed);
     m_currentTick = 0;
     m_history.clear();
+    m_trees.clear();
+}
+
+void StateHasher::SetBackend(HashBackend backend) {
+    m_backend = backend;
+}
+
+HashBackend StateHasher::Backend() const {
+    return m_backend;
+}
+
+uint64_t StateHasher::MixTick(uint64_t h, uint64_t tick) const {
+    if (m_backend == HashBackend::FNV1a) {
+        return HashCombine(h, reinterpret_cast<const uint8_t*>(&tick), sizeof(tick));
+    }
+    return FastHashMix(h, tick);
+}
+
+void StateHasher::Push(uint64_t tick, uint64_t hash) {
+    m_currentHash = hash;
+    m_currentTick = tick;
+
+    HashEntry entry;
+    entry.tick = tick;
+    entry.hash = hash;
+    m_history.push_back(entry);
 }
 
 void StateHasher::AdvanceTick(uint64_t tick,
@@ -29,26 +63,19 @@ void StateHasher::AdvanceTick(uint64_t tick,
     uint64_t h = m_currentHash;
 
     // Mix in the tick number itself for extra safety
-    auto tickBytes = reinterpret_cast<const uint8_t*>(&tick);
-    h = HashCombine(h, tickBytes, sizeof(tick));
+    h = MixTick(h, tick);
 
     // Mix in state
     if (stateData && stateSize > 0) {
-        h = HashCombine(h, stateData, stateSize);
+        h = Hash(m_backend, h, stateData, stateSize);
     }
 
     // Mix in inputs
     if (inputData && inputSize > 0) {
-        h = HashCombine(h, inputData, inputSize);
+        h = Hash(m_backend, h, inputData, inputSize);
     }
 
-    m_currentHash = h;
-    m_currentTick = tick;
-
-    HashEntry entry;
-    entry.tick = tick;
-    entry.hash = h;
-    m_history.push_back(entry);
+    Push(tick, h);
 }
 
 void StateHasher::AdvanceTick(uint64_t tick,
@@ -59,6 +86,60 @@ void StateHasher::AdvanceTick(uint64_t tick,
                 inputs.data(), inputs.size());
 }
 
+void StateHasher::AdvanceTick(uint64_t tick, const StateHashTree& state,
+                              const uint8_t* inputData, size_t inputSize) {
+    uint64_t h = MixTick(m_currentHash, tick);
+
+    uint64_t root = state.Root();
+    h = m_backend == HashBackend::FNV1a
+        ? HashCombine(h, reinterpret_cast<const uint8_t*>(&root), sizeof(root))
+        : FastHashMix(h, root);
+
+    if (inputData && inputSize > 0) {
+        h = Hash(m_backend, h, inputData, inputSize);
+    }
+    Push(tick, h);
+
+    if (m_treeWindow == 0) return;
+    // Reuse the oldest entry's buffers once the window is full
+    TreeEntry entry;
+    if (m_trees.size() >= m_treeWindow) {
+        entry = std::move(m_trees.front());
+        m_trees.pop_front();
+    }
+    entry.tick = tick;
+    entry.tree = state;
+    m_trees.push_back(std::move(entry));
+}
+
+void StateHasher::SetTreeWindow(size_t ticks) {
+    m_treeWindow = ticks;
+    while (m_trees.size() > m_treeWindow) m_trees.pop_front();
+}
+
+size_t StateHasher::TreeWindow() const {
+    return m_treeWindow;
+}
+
+const StateHashTree* StateHasher::TreeAtTick(uint64_t tick) const {
+    for (auto it = m_trees.rbegin(); it != m_trees.rend(); ++it) {
+        if (it->tick == tick) return &it->tree;
+    }
+    return nullptr;
+}
+
+bool StateHasher::RewindTo(uint64_t tick) {
+    size_t i = m_history.size();
+    while (i > 0 && m_history[i - 1].tick != tick) --i;
+    if (i == 0) return false;
+
+    m_history.resize(i);
+    m_currentHash = m_history.back().hash;
+    m_currentTick = tick;
+    while (!m_trees.empty() && m_trees.back().tick > tick) m_trees.pop_back();
+    return true;
+}
+
 uint64_t StateHasher::CurrentHash() const {
     return m_currentHash;
 }
@@ -86,4 +167,19 @@ int64_t StateHasher::FindDivergence(const StateHasher& other) const {
     return -1;  // No divergence in shared range
 }
 
+DivergencePoint StateHasher::FindDivergencePoint(const StateHasher& other) const {
+    DivergencePoint point;
+    point.tick = FindDivergence(other);
+    if (point.tick < 0) return point;
+
+    auto tick = static_cast<uint64_t>(point.tick);
+    const StateHashTree* mine = TreeAtTick(tick);
+    const StateHashTree* theirs = other.TreeAtTick(tick);
+    if (mine && theirs) {
+        point.keys = mine->Diff(*theirs);
+        point.treeCompared = true;
+    }
+    return point;
+}
+
 }  // namespace atlas::sim
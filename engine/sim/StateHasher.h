@@ -11,10 +11,19 @@
 // cause all subsequent hashes to differ, making desync detection
 // immediate and precise.
 //
+// The ladder hash is pluggable (HashBackend). The default, Fast,
+// is FastHash64; FNV1a reproduces ladders recorded before it.
+// State can also be given as a StateHashTree, whose root is
+// chained instead of the raw bytes. The trees of recent ticks are
+// kept so FindDivergence can name the partitions that differ.
+//
 // See: docs/ATLAS_CORE_CONTRACT.md
 //      docs/ATLAS_DETERMINISM_ENFORCEMENT.md
 
+#include "StateHashTree.h"
+
 #include <cstdint>
+#include <deque>
 #include <vector>
 #include <string>
 
@@ -26,6 +35,19 @@ struct HashEntry {
     uint64_t hash = 0;
 };
 
+/// Hash function used for the ladder.
+enum class HashBackend : uint8_t {
+    FNV1a,   ///< Byte-at-a-time FNV-1a (HashCombine)
+    Fast,    ///< FastHash64: vectorized, several GB/s
+};
+
+/// Where two ladders first differ.
+struct DivergencePoint {
+    int64_t tick = -1;               ///< -1 = identical over the shared range
+    std::vector<uint32_t> keys;      ///< Tree leaves that differ at `tick`
+    bool treeCompared = false;       ///< Both sides still had that tick's tree
+};
+
 /// Deterministic state hasher implementing a hash ladder.
 ///
 /// Usage:
@@ -39,6 +61,10 @@ public:
     /// Reset the hash ladder with an initial seed.
     void Reset(uint64_t seed = 0);
 
+    /// Select the ladder hash. Takes effect at the next Reset().
+    void SetBackend(HashBackend backend);
+    HashBackend Backend() const;
+
     /// Advance the hash ladder by one tick.
     /// Computes H[n] = Hash(H[n-1] || state || inputs).
     void AdvanceTick(uint64_t tick,
@@ -50,6 +76,23 @@ public:
                      const std::vector<uint8_t>& state,
                      const std::vector<uint8_t>& inputs);
 
+    /// Advance with the state given as a hash tree:
+    /// H[n] = Hash(H[n-1] || tick || root || inputs). A copy of the
+    /// tree is kept for the last TreeWindow() ticks.
+    void AdvanceTick(uint64_t tick, const StateHashTree& state,
+                     const uint8_t* inputData = nullptr, size_t inputSize = 0);
+
+    /// Number of recent per-tick trees kept (default 64, 0 = none).
+    void SetTreeWindow(size_t ticks);
+    size_t TreeWindow() const;
+
+    /// Tree recorded at `tick`, or nullptr if it is no longer kept.
+    const StateHashTree* TreeAtTick(uint64_t tick) const;
+
+    /// Return to the ladder as it was after `tick`, dropping later
+    /// entries (for rollback). False if `tick` is not in the history.
+    bool RewindTo(uint64_t tick);
+
     /// Current hash value.
     uint64_t CurrentHash() const;
 
@@ -64,14 +107,34 @@ public:
     /// over the shared range.
     int64_t FindDivergence(const StateHasher& other) const;
 
-    /// Deterministic hash combining function (FNV-1a based).
+    /// As above, and when both sides kept the tree for that tick,
+    /// the keys of the leaves that differ.
+    DivergencePoint FindDivergencePoint(const StateHasher& other) const;
+
+    /// Deterministic hash combining function (FNV-1a based). This is
+    /// the hash stored in save files and asset metadata; do not change it.
     static uint64_t HashCombine(uint64_t prev,
                                 const uint8_t* data, size_t size);
 
+    /// Chain `data` onto `prev` with the given backend.
+    static uint64_t Hash(HashBackend backend, uint64_t prev,
+                         const uint8_t* data, size_t size);
+
 private:
+    struct TreeEntry {
+        uint64_t tick = 0;
+        StateHashTree tree;
+    };
+
+    uint64_t MixTick(uint64_t h, uint64_t tick) const;
+    void Push(uint64_t tick, uint64_t hash);
+
+    HashBackend m_backend = HashBackend::Fast;
     uint64_t m_currentHash = 0;
     uint64_t m_currentTick = 0;
     std::vector<HashEntry> m_history;
+    std::deque<TreeEntry> m_trees;
+    size_t m_treeWindow = 64;
 };
 
 }  // namespace atlas::sim
@@ -1,7 +1,6 @@
 #include "WorldState.h"
 #include "StateHasher.h"
 #include "../core/contract/SimulationGuard.h"
-#include <algorithm>
 
 namespace atlas::sim {
 
@@ -38,10 +37,12 @@ WorldSnapshot WorldState::TakeSnapshot(uint64_t tick,
     snap.ecsData = ecsData;
     snap.auxiliaryData = auxiliaryData;
 
-    // Compute hash over all simulated data.
-    uint64_t hash = StateHasher::HashCombine(0, ecsData.data(), ecsData.size());
+    // Compute hash over all simulated data. Snapshot hashes never leave
+    // the process, so they use the fast backend rather than the FNV-1a
+    // that save files persist.
+    uint64_t hash = StateHasher::Hash(HashBackend::Fast, 0, ecsData.data(), ecsData.size());
     if (!auxiliaryData.empty()) {
-        hash = StateHasher::HashCombine(hash, auxiliaryData.data(), auxiliaryData.size());
+        hash = StateHasher::Hash(HashBackend::Fast, hash, auxiliaryData.data(), auxiliaryData.size());
     }
     snap.stateHash = hash;
 
@@ -51,48 +52,90 @@ WorldSnapshot WorldState::TakeSnapshot(uint64_t tick,
 void WorldState::PushSnapshot(WorldSnapshot snapshot) {
     // Snapshots represent simulation state and should only be taken during ticks
     ATLAS_SIM_MUTATION_GUARD();
-    
-    m_snapshots.push_back(std::move(snapshot));
 
-    // Enforce max snapshot limit.
-    while (m_snapshots.size() > m_maxSnapshots && !m_snapshots.empty()) {
-        m_snapshots.erase(m_snapshots.begin());
+    m_ecsHistory.Capture(snapshot.tick, snapshot.ecsData, snapshot.stateHash);
+    m_auxHistory.Capture(snapshot.tick, snapshot.auxiliaryData);
+    m_viewValid = false;
+}
+
+uint64_t WorldState::CaptureTick(uint64_t tick,
+                                 const std::vector<uint8_t>& ecsData,
+                                 const std::vector<uint8_t>& auxiliaryData) {
+    ATLAS_SIM_MUTATION_GUARD();
+
+    // Same hash as TakeSnapshot().
+    uint64_t hash = StateHasher::Hash(HashBackend::Fast, 0, ecsData.data(), ecsData.size());
+    if (!auxiliaryData.empty()) {
+        hash = StateHasher::Hash(HashBackend::Fast, hash, auxiliaryData.data(), auxiliaryData.size());
     }
+
+    m_ecsHistory.Capture(tick, ecsData, hash);
+    m_auxHistory.Capture(tick, auxiliaryData);
+    m_viewValid = false;
+    return hash;
+}
+
+bool WorldState::RestoreTick(uint64_t tick, std::vector<uint8_t>& ecsData,
+                             std::vector<uint8_t>* auxiliaryData) const {
+    if (!m_ecsHistory.Restore(tick, ecsData)) return false;
+    if (auxiliaryData) m_auxHistory.Restore(tick, *auxiliaryData);
+    return true;
+}
+
+bool WorldState::StateHashAtTick(uint64_t tick, uint64_t& outHash) const {
+    return m_ecsHistory.HashAt(tick, outHash);
 }
 
 const WorldSnapshot* WorldState::LatestSnapshot() const {
-    if (m_snapshots.empty()) return nullptr;
-    return &m_snapshots.back();
+    if (m_ecsHistory.Empty()) return nullptr;
+    return SnapshotAtTick(m_ecsHistory.LatestTick());
 }
 
 const WorldSnapshot* WorldState::SnapshotAtTick(uint64_t tick) const {
-    for (const auto& s : m_snapshots) {
-        if (s.tick == tick) return &s;
-    }
-    return nullptr;
+    if (m_viewValid && m_view.tick == tick) return &m_view;
+    if (!m_ecsHistory.HashAt(tick, m_view.stateHash)) return nullptr;
+
+    m_ecsHistory.Restore(tick, m_view.ecsData);
+    m_auxHistory.Restore(tick, m_view.auxiliaryData);
+    m_view.tick = tick;
+    m_viewValid = true;
+    return &m_view;
 }
 
 size_t WorldState::SnapshotCount() const {
-    return m_snapshots.size();
+    return m_ecsHistory.Count();
 }
 
 void WorldState::SetMaxSnapshots(size_t max) {
-    m_maxSnapshots = max > 0 ? max : 1;
+    m_ecsHistory.SetCapacity(max);
+    m_auxHistory.SetCapacity(max);
+    m_viewValid = false;
 }
 
 size_t WorldState::MaxSnapshots() const {
-    return m_maxSnapshots;
+    return m_ecsHistory.Capacity();
 }
 
 void WorldState::ClearSnapshots() {
-    m_snapshots.clear();
+    m_ecsHistory.Clear();
+    m_auxHistory.Clear();
+    m_viewValid = false;
 }
 
 void WorldState::PruneSnapshotsBefore(uint64_t tick) {
-    m_snapshots.erase(
-        std::remove_if(m_snapshots.begin(), m_snapshots.end(),
-                        [tick](const WorldSnapshot& s) { return s.tick < tick; }),
-        m_snapshots.end());
+    m_ecsHistory.DiscardBefore(tick);
+    m_auxHistory.DiscardBefore(tick);
+    m_viewValid = false;
+}
+
+void WorldState::PruneSnapshotsAfter(uint64_t tick) {
+    m_ecsHistory.DiscardAfter(tick);
+    m_auxHistory.DiscardAfter(tick);
+    m_viewValid = false;
+}
+
+const RollbackBuffer::Stats& WorldState::HistoryStats() const {
+    return m_ecsHistory.GetStats();
 }
 
 void WorldState::SetDerivedRebuildCallback(std::function<void(const WorldSnapshot&)> cb) {
@@ -100,8 +143,9 @@ void WorldState::SetDerivedRebuildCallback(std::function<void(const WorldSnapsho
 }
 
 void WorldState::RebuildDerived() {
-    if (m_derivedRebuildCb && !m_snapshots.empty()) {
-        m_derivedRebuildCb(m_snapshots.back());
+    if (!m_derivedRebuildCb) return;
+    if (const WorldSnapshot* latest = LatestSnapshot()) {
+        m_derivedRebuildCb(*latest);
     }
 }
 
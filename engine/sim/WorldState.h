@@ -22,6 +22,7 @@
 // See: docs/ATLAS_CORE_CONTRACT.md
 //      docs/ATLAS_SIMULATION_PHILOSOPHY.md
 
+#include "RollbackBuffer.h"
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -73,13 +74,32 @@ public:
                                const std::vector<uint8_t>& ecsData,
                                const std::vector<uint8_t>& auxiliaryData = {}) const;
 
-    /// Store a snapshot for potential rollback.
+    /// Store a snapshot for potential rollback. Snapshots at or after
+    /// its tick are discarded first (see RollbackBuffer::Capture).
     void PushSnapshot(WorldSnapshot snapshot);
 
+    /// Hash and store the state for `tick` without building a
+    /// WorldSnapshot. Only the pages that changed since the previous
+    /// tick are copied. Returns the state hash.
+    uint64_t CaptureTick(uint64_t tick,
+                         const std::vector<uint8_t>& ecsData,
+                         const std::vector<uint8_t>& auxiliaryData = {});
+
+    /// Rebuild the stored state for `tick` into caller-owned buffers.
+    /// Returns false if the tick is outside the window.
+    bool RestoreTick(uint64_t tick, std::vector<uint8_t>& ecsData,
+                     std::vector<uint8_t>* auxiliaryData = nullptr) const;
+
+    /// State hash recorded for `tick`, without rebuilding the state.
+    bool StateHashAtTick(uint64_t tick, uint64_t& outHash) const;
+
     /// Retrieve the most recent snapshot, or nullptr if none.
+    /// The snapshot is rebuilt on demand; the pointer stays valid until
+    /// the next snapshot lookup or change to the stored snapshots.
     const WorldSnapshot* LatestSnapshot() const;
 
     /// Retrieve a snapshot at a specific tick, or nullptr if not found.
+    /// Same lifetime rules as LatestSnapshot().
     const WorldSnapshot* SnapshotAtTick(uint64_t tick) const;
 
     /// Number of stored snapshots.
@@ -95,6 +115,12 @@ public:
     /// Discard snapshots older than the given tick.
     void PruneSnapshotsBefore(uint64_t tick);
 
+    /// Discard snapshots newer than the given tick.
+    void PruneSnapshotsAfter(uint64_t tick);
+
+    /// Capture/restore statistics for the ECS history.
+    const RollbackBuffer::Stats& HistoryStats() const;
+
     // --- System mutation ownership ---
 
     /// Register that a system owns (may mutate) a component type.
@@ -124,8 +150,11 @@ public:
 
 private:
     std::vector<StateBlockInfo> m_blocks;
-    std::vector<WorldSnapshot> m_snapshots;
-    size_t m_maxSnapshots = 60;  ///< Default: ~2 seconds at 30 Hz.
+    // Default window: 60 ticks, ~2 seconds at 30 Hz.
+    RollbackBuffer m_ecsHistory{60};
+    RollbackBuffer m_auxHistory{60};   ///< Kept in step with m_ecsHistory.
+    mutable WorldSnapshot m_view;      ///< Last snapshot rebuilt by a lookup.
+    mutable bool m_viewValid = false;
     std::function<void(const WorldSnapshot&)> m_derivedRebuildCb;
 
     /// Maps component name → owning system name.
@@ -9,6 +9,11 @@ void test_division_by_zero();
 void test_comparison();
 void test_conditional_jump();
 void test_variables();
+void test_vm_loop_runs_in_registers();
+void test_vm_store_keeps_loaded_value();
+void test_vm_stack_left_at_end();
+void test_vm_batch_per_entity_locals();
+void test_vm_rejects_unbalanced_loop();
 
 // ECS tests
 void test_create_entity();
@@ -283,6 +288,10 @@ void test_physics_gravity();
 void test_physics_static_body();
 void test_physics_apply_force();
 void test_physics_collision_detection();
+void test_physics_broadphase_matches_brute_force();
+void test_physics_static_pairs_skipped();
+void test_physics_sleep_and_wake();
+void test_physics_pair_order_deterministic();
 
 // Audio tests
 void test_audio_load_sound();
@@ -581,6 +590,7 @@ void test_snapshot_without_world();
 void test_rollback_with_multiple_entities();
 void test_record_and_replay_input();
 void test_replay_applies_input_frames();
+void test_snapshot_window_bounds_history();
 
 // ECS Inspector tests
 void test_inspector_empty_world();
@@ -706,6 +716,10 @@ void test_replay_record_with_hash();
 void test_replay_save_load_with_hash();
 void test_replay_default_hash_zero();
 void test_hash_combine_deterministic();
+void test_hasher_backends_differ();
+void test_hash_tree_diff_names_leaf();
+void test_hasher_divergence_point_keys();
+void test_hasher_rewind();
 
 // Visual Diff tests
 void test_diff_identical();
@@ -842,6 +856,10 @@ void test_world_state_max_snapshots();
 void test_world_state_prune();
 void test_world_state_clear();
 void test_world_state_derived_rebuild();
+void test_rollback_buffer_restores_every_tick();
+void test_rollback_buffer_stores_only_changed_pages();
+void test_rollback_buffer_recapture_after_rollback();
+void test_world_state_capture_and_restore_tick();
 
 // Save System tests
 void test_save_system_save_and_load();
@@ -2060,6 +2078,11 @@ int main() {
     test_comparison();
     test_conditional_jump();
     test_variables();
+    test_vm_loop_runs_in_registers();
+    test_vm_store_keeps_loaded_value();
+    test_vm_stack_left_at_end();
+    test_vm_batch_per_entity_locals();
+    test_vm_rejects_unbalanced_loop();
 
     // ECS
     std::cout << "\n--- ECS ---" << std::endl;
@@ -2493,6 +2516,10 @@ int main() {
     test_physics_static_body();
     test_physics_apply_force();
     test_physics_collision_detection();
+    test_physics_broadphase_matches_brute_force();
+    test_physics_static_pairs_skipped();
+    test_physics_sleep_and_wake();
+    test_physics_pair_order_deterministic();
 
     // Audio
     std::cout << "\n--- Audio System ---" << std::endl;
@@ -2822,6 +2849,7 @@ int main() {
     test_rollback_with_multiple_entities();
     test_record_and_replay_input();
     test_replay_applies_input_frames();
+    test_snapshot_window_bounds_history();
 
     // ECS Inspector
     std::cout << "\n--- ECS Inspector ---" << std::endl;
@@ -2909,6 +2937,10 @@ int main() {
     test_replay_save_load_with_hash();
     test_replay_default_hash_zero();
     test_hash_combine_deterministic();
+    test_hasher_backends_differ();
+    test_hash_tree_diff_names_leaf();
+    test_hasher_divergence_point_keys();
+    test_hasher_rewind();
 
     // Visual Diff
     std::cout << "\n--- Visual Diff ---" << std::endl;
@@ -3060,6 +3092,10 @@ int main() {
     test_world_state_prune();
     test_world_state_clear();
     test_world_state_derived_rebuild();
+    test_rollback_buffer_restores_every_tick();
+    test_rollback_buffer_stores_only_changed_pages();
+    test_rollback_buffer_recapture_after_rollback();
+    test_world_state_capture_and_restore_tick();
 
     // Save System
     std::cout << "\n--- Save System ---" << std::endl;
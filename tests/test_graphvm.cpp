@@ -1,7 +1,10 @@
 #include "../engine/graphvm/GraphVM.h"
+#include "../engine/graphvm/GraphCompiler.h"
 #include <iostream>
 #include <cassert>
+#include <vector>
 
+using namespace atlas::graph;
 using namespace atlas::vm;
 
 void test_basic_arithmetic() {
@@ -172,3 +175,152 @@ void test_variables() {
     std::cout << "[PASS] test_variables" << std::endl;
 }
 
+
+void test_vm_loop_runs_in_registers() {
+    // sum = 0; i = 10; while (i > 0) { sum = sum + i; i = i - 1; }
+    Bytecode bc;
+    bc.constants = {0, 10, 1};
+    bc.instructions = {
+        {OpCode::LOAD_CONST, 0, 0, 0},      // 0
+        {OpCode::STORE_VAR, 0, 0, 0},       // 1: sum = 0
+        {OpCode::LOAD_CONST, 1, 0, 0},      // 2
+        {OpCode::STORE_VAR, 1, 0, 0},       // 3: i = 10
+        {OpCode::LOAD_VAR, 1, 0, 0},        // 4: loop head
+        {OpCode::LOAD_CONST, 0, 0, 0},      // 5
+        {OpCode::CMP_GT, 0, 0, 0},          // 6
+        {OpCode::JUMP_IF_FALSE, 17, 0, 0},  // 7
+        {OpCode::LOAD_VAR, 0, 0, 0},        // 8
+        {OpCode::LOAD_VAR, 1, 0, 0},        // 9
+        {OpCode::ADD, 0, 0, 0},             // 10
+        {OpCode::STORE_VAR, 0, 0, 0},       // 11
+        {OpCode::LOAD_VAR, 1, 0, 0},        // 12
+        {OpCode::LOAD_CONST, 2, 0, 0},      // 13
+        {OpCode::SUB, 0, 0, 0},             // 14
+        {OpCode::STORE_VAR, 1, 0, 0},       // 15
+        {OpCode::JUMP, 4, 0, 0},            // 16
+        {OpCode::END, 0, 0, 0}              // 17
+    };
+
+    RegisterProgram program;
+    assert(GraphCompiler::Lower(bc, program));
+    // Constants and locals are read in place: fewer instructions than
+    // the stack form
+    assert(program.code.size() < bc.instructions.size());
+
+    GraphVM vm;
+    VMContext ctx;
+    vm.Execute(program, ctx);
+    assert(vm.GetLocal(0) == 55);
+    assert(vm.GetLocal(1) == 0);
+    assert(vm.GetStack().empty());
+
+    // The stack form gives the same result
+    GraphVM stackVm;
+    stackVm.Execute(bc, ctx);
+    assert(stackVm.GetLocal(0) == 55);
+
+    std::cout << "[PASS] test_vm_loop_runs_in_registers" << std::endl;
+}
+
+void test_vm_store_keeps_loaded_value() {
+    // The value of var 0 pushed before it is overwritten must survive
+    Bytecode bc;
+    bc.constants = {7, 5, 1};
+    bc.instructions = {
+        {OpCode::LOAD_CONST, 0, 0, 0},
+        {OpCode::STORE_VAR, 0, 0, 0},   // var0 = 7
+        {OpCode::LOAD_VAR, 0, 0, 0},    // push 7
+        {OpCode::LOAD_CONST, 1, 0, 0},
+        {OpCode::STORE_VAR, 0, 0, 0},   // var0 = 5
+        {OpCode::LOAD_CONST, 2, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::STORE_VAR, 1, 0, 0},   // var1 = 7 + 1
+        {OpCode::END, 0, 0, 0}
+    };
+
+    GraphVM vm;
+    VMContext ctx;
+    vm.Execute(bc, ctx);
+    assert(vm.GetLocal(0) == 5);
+    assert(vm.GetLocal(1) == 8);
+
+    std::cout << "[PASS] test_vm_store_keeps_loaded_value" << std::endl;
+}
+
+void test_vm_stack_left_at_end() {
+    Graph g;
+    g.nodes = {
+        {0, NodeType::Constant, 15},
+        {1, NodeType::Constant, 25},
+        {2, NodeType::Add, 0},
+    };
+
+    GraphCompiler compiler;
+    RegisterProgram program = compiler.CompileProgram(g);
+    assert(program.Valid());
+
+    GraphVM vm;
+    VMContext ctx;
+    vm.Execute(program, ctx);
+    assert(vm.GetStack().size() == 1);
+    assert(vm.GetStack()[0] == 40);
+
+    std::cout << "[PASS] test_vm_stack_left_at_end" << std::endl;
+}
+
+void test_vm_batch_per_entity_locals() {
+    // var0 = var0 + entity * tick
+    Bytecode bc;
+    bc.instructions = {
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_ENTITY, 0, 0, 0},
+        {OpCode::LOAD_TICK, 0, 0, 0},
+        {OpCode::MUL, 0, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::STORE_VAR, 0, 0, 0},
+        {OpCode::END, 0, 0, 0}
+    };
+    RegisterProgram program;
+    assert(GraphCompiler::Lower(bc, program));
+    assert(program.LocalCount() == 1);
+    assert(program.LocalSlot(0) == 0);
+    assert(program.LocalSlot(3) == RegisterProgram::npos);
+
+    std::vector<VMContext> contexts = {{1, 10}, {2, 10}, {3, 10}};
+    std::vector<Value> locals = {100, 200, 300};
+
+    GraphVM vm;
+    vm.ExecuteBatch(program, contexts.data(), contexts.size(), locals.data());
+    assert(locals[0] == 110);
+    assert(locals[1] == 220);
+    assert(locals[2] == 330);
+    assert(vm.GetLocal(0) == 330);
+
+    // Without rows every run starts from zero
+    vm.ExecuteBatch(program, contexts.data(), contexts.size());
+    assert(vm.GetLocal(0) == 30);
+
+    std::cout << "[PASS] test_vm_batch_per_entity_locals" << std::endl;
+}
+
+void test_vm_rejects_unbalanced_loop() {
+    // Each pass round the loop would leave one more value on the stack
+    Bytecode bc;
+    bc.constants = {1};
+    bc.instructions = {
+        {OpCode::LOAD_CONST, 0, 0, 0},
+        {OpCode::JUMP, 0, 0, 0},
+    };
+
+    RegisterProgram program;
+    assert(!GraphCompiler::Lower(bc, program));
+    assert(!program.Valid());
+
+    GraphVM vm;
+    VMContext ctx;
+    vm.Execute(bc, ctx);
+    assert(!vm.LastError().empty());
+    assert(vm.GetLocal(0) == 0);
+
+    std::cout << "[PASS] test_vm_rejects_unbalanced_loop" << std::endl;
+}
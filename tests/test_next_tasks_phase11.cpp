@@ -194,6 +194,10 @@ void test_unity_convert_real_format() {
 // Phase 11 Task 2: ECS Inspector Enhancements
 // ============================================================
 
+// Local to this file: test_ecs_serialization.cpp has its own TestPosition
+// and TestVelocity, and the World's typed pools are instantiated per type.
+namespace {
+
 struct TestPosition {
     float x = 0, y = 0, z = 0;
 };
@@ -206,6 +210,8 @@ struct TestUnregisteredComp {
     int data = 0;
 };
 
+}  // namespace
+
 void test_ecs_component_value_inspection() {
     atlas::ecs::World world;
     world.RegisterComponent<TestPosition>(100);
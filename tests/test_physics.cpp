@@ -2,6 +2,8 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 using namespace atlas::physics;
 
@@ -102,3 +104,138 @@ void test_physics_collision_detection() {
 
     std::cout << "[PASS] test_physics_collision_detection" << std::endl;
 }
+
+void test_physics_broadphase_matches_brute_force() {
+    PhysicsWorld world;
+    world.Init();
+    world.SetGravity(0, 0, 0);
+
+    // Deterministic scatter of dynamic, static and larger bodies
+    uint32_t seed = 12345;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+    std::vector<BodyID> ids;
+    for (int i = 0; i < 400; ++i) {
+        BodyID id = world.CreateBody(1.0f, i % 5 == 0);
+        world.SetPosition(id, next() * 20.0f, next() * 20.0f, next() * 4.0f);
+        world.SetVelocity(id, next() - 0.5f, next() - 0.5f, 0.0f);
+        if (i % 7 == 0) world.GetBody(id)->radius = 1.5f;
+        ids.push_back(id);
+    }
+
+    for (int step = 0; step < 10; ++step) {
+        world.Step(0.1f);
+
+        std::vector<std::pair<BodyID, BodyID>> expected;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            for (size_t j = i + 1; j < ids.size(); ++j) {
+                const RigidBody* a = world.GetBody(ids[i]);
+                const RigidBody* b = world.GetBody(ids[j]);
+                if (a->isStatic && b->isStatic) continue;
+                if ((a->position - b->position).Length() < a->radius + b->radius) {
+                    expected.push_back({a->id, b->id});
+                }
+            }
+        }
+
+        const auto& pairs = world.GetCollisions();
+        assert(pairs.size() == expected.size());
+        for (size_t k = 0; k < pairs.size(); ++k) {
+            assert(pairs[k].a == expected[k].first);
+            assert(pairs[k].b == expected[k].second);
+        }
+        assert(world.GetStepStats().collisions == pairs.size());
+        assert(world.GetStepStats().candidatePairs < ids.size() * ids.size() / 4);
+    }
+
+    std::cout << "[PASS] test_physics_broadphase_matches_brute_force" << std::endl;
+}
+
+void test_physics_static_pairs_skipped() {
+    PhysicsWorld world;
+    world.Init();
+
+    BodyID a = world.CreateBody(1.0f, true);
+    BodyID b = world.CreateBody(1.0f, true);
+    BodyID c = world.CreateBody(1.0f);
+    world.SetPosition(a, 0, 0, 0);
+    world.SetPosition(b, 0.2f, 0, 0);
+    world.SetPosition(c, 50, 0, 0);
+
+    world.Step(0.01f);
+    assert(world.GetCollisions().empty());
+    assert(world.GetStepStats().restingBodies == 2);
+    assert(world.GetStepStats().awakeBodies == 1);
+    assert(world.GetStepStats().restingRebuilt);
+
+    // Nothing static moved, so the resting set is reused
+    world.Step(0.01f);
+    assert(!world.GetStepStats().restingRebuilt);
+
+    std::cout << "[PASS] test_physics_static_pairs_skipped" << std::endl;
+}
+
+void test_physics_sleep_and_wake() {
+    PhysicsWorld world;
+    world.Init();
+    world.SetGravity(0, 0, 0);
+    world.SetSleepThreshold(0.01f, 3);
+
+    BodyID a = world.CreateBody(1.0f);
+    BodyID b = world.CreateBody(1.0f);
+    world.SetPosition(a, 0, 0, 0);
+    world.SetPosition(b, 0.5f, 0, 0);
+
+    for (int i = 0; i < 3; ++i) world.Step(0.1f);
+    assert(world.GetBody(a)->sleeping);
+    assert(world.GetBody(b)->sleeping);
+
+    // Sleeping bodies are not integrated but still report their contacts
+    world.Step(0.1f);
+    assert(world.GetStepStats().awakeBodies == 0);
+    assert(world.GetCollisions().size() == 1);
+    assert(world.GetStepStats().restingBodies == 2);
+
+    world.ApplyForce(a, -100.0f, 0, 0);
+    assert(!world.GetBody(a)->sleeping);
+    world.Step(0.1f);
+    assert(world.GetBody(a)->position.x < 0.0f);
+    assert(world.GetBody(b)->sleeping);
+    assert(world.GetCollisions().empty());
+
+    std::cout << "[PASS] test_physics_sleep_and_wake" << std::endl;
+}
+
+void test_physics_pair_order_deterministic() {
+    // Bodies lie along x in the reverse of their ID order, so the sweep
+    // meets them backwards; pairs still come out sorted by ID.
+    auto run = []() {
+        PhysicsWorld world;
+        world.Init();
+        world.SetGravity(0, 0, 0);
+        std::vector<BodyID> ids;
+        for (int i = 0; i < 6; ++i) {
+            ids.push_back(world.CreateBody(1.0f));
+            world.SetPosition(ids.back(), static_cast<float>(5 - i) * 0.6f, 0, 0);
+        }
+        world.Step(0.01f);
+
+        std::vector<std::pair<BodyID, BodyID>> pairs;
+        for (const auto& p : world.GetCollisions()) {
+            pairs.push_back({p.a, p.b});
+        }
+        return std::make_pair(ids, pairs);
+    };
+
+    auto [ids, pairs] = run();
+    assert(pairs.size() == 5);
+    for (size_t k = 0; k < pairs.size(); ++k) {
+        assert(pairs[k].first == ids[k]);
+        assert(pairs[k].second == ids[k + 1]);
+    }
+    assert(run().second == pairs);
+
+    std::cout << "[PASS] test_physics_pair_order_deterministic" << std::endl;
+}
@@ -212,3 +212,37 @@ void test_replay_applies_input_frames() {
 
     std::cout << "[PASS] test_replay_applies_input_frames" << std::endl;
 }
+
+void test_snapshot_window_bounds_history() {
+    World world;
+    world.RegisterComponent<SnapPosition>(1);
+
+    NetContext net;
+    net.Init(NetMode::Server);
+    net.SetWorld(&world);
+    net.SetSnapshotWindow(4);
+    assert(net.SnapshotWindow() == 4);
+
+    EntityID e = world.CreateEntity();
+    world.AddComponent<SnapPosition>(e, {0.0f, 0.0f});
+
+    for (uint32_t tick = 1; tick <= 10; ++tick) {
+        world.GetComponent<SnapPosition>(e)->x = static_cast<float>(tick);
+        net.SaveSnapshot(tick);
+    }
+
+    // Only the last 4 ticks are kept
+    assert(net.Snapshots().size() == 4);
+    assert(net.Snapshots()[0].tick == 7);
+
+    net.RollbackTo(8);
+    assert(world.GetComponent<SnapPosition>(e)->x == 8.0f);
+    assert(net.Snapshots().size() == 2);
+
+    // Ticks that left the window cannot be restored
+    net.RollbackTo(3);
+    assert(world.GetComponent<SnapPosition>(e)->x == 8.0f);
+    assert(net.Snapshots().empty());
+
+    std::cout << "[PASS] test_snapshot_window_bounds_history" << std::endl;
+}
@@ -220,3 +220,123 @@ void test_hash_combine_deterministic() {
 
     std::cout << "[PASS] test_hash_combine_deterministic" << std::endl;
 }
+
+void test_hasher_backends_differ() {
+    std::vector<uint8_t> state = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<uint8_t> inputs = {42};
+
+    StateHasher fast, fast2, fnv;
+    fnv.SetBackend(HashBackend::FNV1a);
+    fast.Reset(7);
+    fast2.Reset(7);
+    fnv.Reset(7);
+    for (uint64_t t = 1; t <= 3; ++t) {
+        fast.AdvanceTick(t, state, inputs);
+        fast2.AdvanceTick(t, state, inputs);
+        fnv.AdvanceTick(t, state, inputs);
+    }
+    assert(fast.Backend() == HashBackend::Fast);
+    assert(fast.CurrentHash() == fast2.CurrentHash());
+    assert(fast.CurrentHash() != fnv.CurrentHash());
+
+    // The FNV1a backend is HashCombine
+    assert(StateHasher::Hash(HashBackend::FNV1a, 5, state.data(), state.size()) ==
+           StateHasher::HashCombine(5, state.data(), state.size()));
+
+    std::cout << "[PASS] test_hasher_backends_differ" << std::endl;
+}
+
+void test_hash_tree_diff_names_leaf() {
+    const uint32_t keys[] = {1, 4, 9, 12, 30};
+    uint64_t hashes[] = {11, 44, 99, 1212, 3030};
+
+    StateHashTree a, b;
+    a.Assign(keys, hashes, 5);
+    b.Assign(keys, hashes, 5);
+    assert(a.Root() == b.Root());
+    assert(a.Diff(b).empty());
+
+    b.SetLeaf(3, 1213);
+    assert(a.Root() != b.Root());
+    auto diff = a.Diff(b);
+    assert(diff.size() == 1 && diff[0] == 12);
+
+    // Setting it back restores the root
+    b.SetLeaf(3, 1212);
+    assert(a.Root() == b.Root());
+
+    // A key on only one side differs
+    StateHashTree c;
+    c.Assign(keys, hashes, 4);
+    diff = a.Diff(c);
+    assert(diff.size() == 1 && diff[0] == 30);
+
+    std::cout << "[PASS] test_hash_tree_diff_names_leaf" << std::endl;
+}
+
+void test_hasher_divergence_point_keys() {
+    const uint32_t keys[] = {1, 2, 3};
+    uint64_t hashes[] = {100, 200, 300};
+
+    StateHasher a, b;
+    a.Reset(1);
+    b.Reset(1);
+    StateHashTree tree;
+    for (uint64_t t = 1; t <= 10; ++t) {
+        hashes[0] = t;
+        tree.Assign(keys, hashes, 3);
+        a.AdvanceTick(t, tree);
+        if (t == 6) tree.SetLeaf(2, 301);
+        b.AdvanceTick(t, tree);
+    }
+
+    DivergencePoint point = a.FindDivergencePoint(b);
+    assert(point.tick == 6);
+    assert(point.treeCompared);
+    assert(point.keys.size() == 1 && point.keys[0] == 3);
+    assert(a.FindDivergence(b) == 6);
+
+    // Past the tree window only the tick is known
+    a.SetTreeWindow(2);
+    b.SetTreeWindow(2);
+    assert(a.TreeAtTick(6) == nullptr);
+    point = a.FindDivergencePoint(b);
+    assert(point.tick == 6);
+    assert(!point.treeCompared && point.keys.empty());
+
+    std::cout << "[PASS] test_hasher_divergence_point_keys" << std::endl;
+}
+
+void test_hasher_rewind() {
+    const uint32_t keys[] = {5};
+    uint64_t hashes[] = {0};
+
+    StateHasher hasher;
+    hasher.Reset(3);
+    StateHashTree tree;
+    std::vector<uint64_t> ladder;
+    for (uint64_t t = 1; t <= 5; ++t) {
+        hashes[0] = t * 17;
+        tree.Assign(keys, hashes, 1);
+        hasher.AdvanceTick(t, tree);
+        ladder.push_back(hasher.CurrentHash());
+    }
+
+    assert(hasher.RewindTo(3));
+    assert(hasher.CurrentTick() == 3);
+    assert(hasher.CurrentHash() == ladder[2]);
+    assert(hasher.History().size() == 3);
+    assert(hasher.TreeAtTick(4) == nullptr);
+    assert(hasher.TreeAtTick(3) != nullptr);
+    assert(!hasher.RewindTo(9));
+
+    // Re-simulating the same ticks gives the same ladder
+    for (uint64_t t = 4; t <= 5; ++t) {
+        hashes[0] = t * 17;
+        tree.Assign(keys, hashes, 1);
+        hasher.AdvanceTick(t, tree);
+    }
+    assert(hasher.CurrentHash() == ladder[4]);
+
+    std::cout << "[PASS] test_hasher_rewind" << std::endl;
+}
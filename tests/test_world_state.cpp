@@ -170,3 +170,124 @@ void test_world_state_derived_rebuild() {
 
     std::cout << "[PASS] test_world_state_derived_rebuild" << std::endl;
 }
+
+void test_rollback_buffer_restores_every_tick() {
+    RollbackBuffer buf(8, 16);
+
+    // Images grow and shrink across page boundaries.
+    std::vector<std::vector<uint8_t>> images;
+    for (uint64_t t = 0; t < 20; ++t) {
+        std::vector<uint8_t> img(20 + (t * 7) % 45);
+        for (size_t i = 0; i < img.size(); ++i) {
+            img[i] = static_cast<uint8_t>(i < 16 ? i : i * 3 + (t % 4 == 0 ? t : 0));
+        }
+        images.push_back(img);
+        buf.Capture(t, img, t + 100);
+    }
+
+    assert(buf.Count() == 8);
+    assert(buf.OldestTick() == 12);
+    assert(buf.LatestTick() == 19);
+    assert(!buf.Contains(11));
+
+    std::vector<uint8_t> out;
+    for (uint64_t t = 12; t < 20; ++t) {
+        assert(buf.Restore(t, out));
+        assert(out == images[t]);
+        uint64_t hash = 0;
+        assert(buf.HashAt(t, hash));
+        assert(hash == t + 100);
+    }
+    assert(!buf.Restore(5, out));
+
+    std::cout << "[PASS] test_rollback_buffer_restores_every_tick" << std::endl;
+}
+
+void test_rollback_buffer_stores_only_changed_pages() {
+    RollbackBuffer buf(60, 64);
+
+    std::vector<uint8_t> state(64 * 100, 7);
+    buf.Capture(1, state);
+    state[64 * 40 + 3] = 9;
+    buf.Capture(2, state);
+
+    assert(buf.GetStats().lastDirtyPages == 1);
+    assert(buf.GetStats().lastDiffBytes == 64);
+
+    buf.Capture(3, state);
+    assert(buf.GetStats().lastDirtyPages == 0);
+    assert(buf.GetStats().retainedDiffBytes == 64);
+
+    std::vector<uint8_t> out;
+    assert(buf.Restore(1, out));
+    assert(out[64 * 40 + 3] == 7);
+    assert(buf.Restore(3, out));
+    assert(out == state);
+
+    std::cout << "[PASS] test_rollback_buffer_stores_only_changed_pages" << std::endl;
+}
+
+void test_rollback_buffer_recapture_after_rollback() {
+    RollbackBuffer buf(10, 8);
+    for (uint64_t t = 1; t <= 5; ++t) {
+        buf.Capture(t, std::vector<uint8_t>(12, static_cast<uint8_t>(t)));
+    }
+
+    // Re-simulating tick 3 replaces ticks 3..5.
+    buf.Capture(3, std::vector<uint8_t>(30, 0xAB));
+    assert(buf.Count() == 3);
+    assert(buf.LatestTick() == 3);
+
+    std::vector<uint8_t> out;
+    assert(buf.Restore(2, out));
+    assert(out == std::vector<uint8_t>(12, 2));
+    assert(buf.Restore(3, out));
+    assert(out == std::vector<uint8_t>(30, 0xAB));
+
+    buf.DiscardAfter(1);
+    assert(buf.Count() == 1);
+    assert(buf.Restore(1, out));
+    assert(out == std::vector<uint8_t>(12, 1));
+
+    buf.DiscardBefore(2);
+    assert(buf.Empty());
+
+    std::cout << "[PASS] test_rollback_buffer_recapture_after_rollback" << std::endl;
+}
+
+void test_world_state_capture_and_restore_tick() {
+    WorldState ws;
+    ws.SetMaxSnapshots(4);
+
+    std::vector<uint8_t> ecs(1000, 1);
+    std::vector<uint8_t> aux = {9, 9};
+    uint64_t hashes[6] = {};
+
+    ATLAS_SIM_TICK_BEGIN();
+    for (uint64_t t = 0; t < 6; ++t) {
+        ecs[t * 100] = static_cast<uint8_t>(t + 2);
+        hashes[t] = ws.CaptureTick(t, ecs, aux);
+    }
+    ATLAS_SIM_TICK_END();
+
+    assert(ws.SnapshotCount() == 4);
+    assert(hashes[5] == ws.TakeSnapshot(5, ecs, aux).stateHash);
+
+    uint64_t hash = 0;
+    assert(ws.StateHashAtTick(3, hash));
+    assert(hash == hashes[3]);
+    assert(!ws.StateHashAtTick(1, hash));
+
+    std::vector<uint8_t> restored, restoredAux;
+    assert(ws.RestoreTick(3, restored, &restoredAux));
+    assert(restored[300] == 5);
+    assert(restored[400] == 1);
+    assert(restoredAux == aux);
+
+    ws.PruneSnapshotsAfter(3);
+    assert(ws.SnapshotCount() == 2);
+    assert(ws.LatestSnapshot()->tick == 3);
+    assert(ws.LatestSnapshot()->stateHash == hashes[3]);
+
+    std::cout << "[PASS] test_world_state_capture_and_restore_tick" << std::endl;
+}
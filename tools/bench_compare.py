@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Atlas Benchmark Compare
+
+Compares two AtlasBench JSON result files (``AtlasBench --out file.json``)
+and reports the change in ns/op for every benchmark present in both.
+
+Usage:
+    python tools/bench_compare.py <baseline.json> <current.json> [--threshold 10]
+
+Exits with status 1 if any benchmark got slower by more than the threshold
+(percent), so it can gate CI. Noise on a shared machine is typically a few
+percent; compare builds made with the same compiler and build type.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    """Load an AtlasBench JSON file.
+
+    Returns (context dict, dict mapping "name/size" -> result dict).
+    """
+    with open(path, "r") as f:
+        data = json.load(f)
+    results = {}
+    for entry in data.get("benchmarks", []):
+        results["{}/{}".format(entry["name"], entry["size"])] = entry
+    return data.get("context", {}), results
+
+
+def describe(context):
+    label = context.get("label") or "(no label)"
+    return "{} [{}, {}, {}]".format(label, context.get("compiler", "?"),
+                                    context.get("build", "?"),
+                                    context.get("date", "?"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two AtlasBench result files")
+    parser.add_argument("baseline", help="JSON from the reference build")
+    parser.add_argument("current", help="JSON from the build under test")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Percent slowdown that counts as a regression (default 10)")
+    parser.add_argument("--filter", default="",
+                        help="Only compare benchmarks whose name/size contains this")
+    args = parser.parse_args()
+
+    base_ctx, base = load_results(args.baseline)
+    cur_ctx, cur = load_results(args.current)
+
+    print("baseline: " + describe(base_ctx))
+    print("current:  " + describe(cur_ctx))
+    if base_ctx.get("build") != cur_ctx.get("build"):
+        print("warning: comparing a {} build against a {} build".format(
+            base_ctx.get("build"), cur_ctx.get("build")))
+    print()
+
+    regressions = []
+    print("{:<44} {:>14} {:>14} {:>9}".format("benchmark", "base ns/op", "cur ns/op", "change"))
+    for key in sorted(cur):
+        if args.filter and args.filter not in key:
+            continue
+        if key not in base:
+            print("{:<44} {:>14} {:>14.1f} {:>9}".format(key, "-", cur[key]["ns_per_op"], "new"))
+            continue
+        before = base[key]["ns_per_op"]
+        after = cur[key]["ns_per_op"]
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        marker = ""
+        if change > args.threshold:
+            marker = "  SLOWER"
+            regressions.append((key, change))
+        elif change < -args.threshold:
+            marker = "  faster"
+        print("{:<44} {:>14.1f} {:>14.1f} {:>+8.1f}%{}".format(key, before, after, change, marker))
+
+    removed = sorted(k for k in base if k not in cur and (not args.filter or args.filter in k))
+    for key in removed:
+        print("{:<44} {:>14.1f} {:>14} {:>9}".format(key, base[key]["ns_per_op"], "-", "removed"))
+
+    print()
+    if regressions:
+        print("{} benchmark(s) slower than the {:.0f}% threshold:".format(
+            len(regressions), args.threshold))
+        for key, change in regressions:
+            print("  {}: {:+.1f}%".format(key, change))
+        return 1
+    print("No regressions above {:.0f}%.".format(args.threshold))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())